@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DISTRIBUTED_DATA_FRAMEWORKS_COMMON_BATCH_QUEUE_H
+#define OHOS_DISTRIBUTED_DATA_FRAMEWORKS_COMMON_BATCH_QUEUE_H
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <vector>
+namespace OHOS {
+/**
+ * The items are pushed by many threads without lock, and taken all together by one consumer.
+ * 1. only the first push after the last take returns true, the caller schedules the consumer once for a batch;
+ * 2. the consumer takes the items in the order pushed, the item is merged into the previous one if the merger can;
+ * 3. once the pending size exceeds the limit, the queue overflows: the later pushes are dropped, and the consumer
+ *    takes only the first item with the overflowed flag.
+ */
+template<typename _Tp>
+class BatchQueue final {
+public:
+    // merge the next item into the previous one and return true, or return false to keep both.
+    using Merger = std::function<bool(_Tp &prev, _Tp &next)>;
+
+    explicit BatchQueue(uint32_t maxPending) : maxPending_(maxPending) {}
+    ~BatchQueue()
+    {
+        Node *node = head_.exchange(nullptr);
+        while (node != nullptr) {
+            Node *next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+    BatchQueue(const BatchQueue &) = delete;
+    BatchQueue &operator=(const BatchQueue &) = delete;
+
+    // Return true if the caller should schedule the consumer to take the batch.
+    bool Push(_Tp &&item, uint32_t size)
+    {
+        if (!overflowed_.load()) {
+            Node *node = new (std::nothrow) Node{ std::move(item), size, nullptr };
+            if (node == nullptr || pending_.fetch_add(size) + size > maxPending_) {
+                overflowed_.store(true);
+            }
+            if (node != nullptr) {
+                node->next = head_.load();
+                while (!head_.compare_exchange_weak(node->next, node)) {
+                }
+            }
+        }
+        return !scheduled_.exchange(true);
+    }
+
+    // The consumer could not be scheduled, the next push returns true again.
+    void Unschedule()
+    {
+        scheduled_.store(false);
+    }
+
+    // The items pushed after it are taken in the next batch.
+    std::vector<_Tp> Take(const Merger &merger, bool &overflowed)
+    {
+        scheduled_.store(false);
+        Node *node = Reverse(head_.exchange(nullptr));
+        overflowed = overflowed_.exchange(false);
+        std::vector<_Tp> items;
+        while (node != nullptr) {
+            if (items.empty() || (!overflowed && !(merger && merger(items.back(), node->item)))) {
+                items.push_back(std::move(node->item));
+            }
+            Node *next = node->next;
+            delete node;
+            node = next;
+        }
+        return items;
+    }
+
+private:
+    struct Node {
+        _Tp item;
+        uint32_t size;
+        Node *next;
+    };
+
+    // the list is pushed in the reverse order.
+    Node *Reverse(Node *node)
+    {
+        Node *ordered = nullptr;
+        while (node != nullptr) {
+            Node *next = node->next;
+            node->next = ordered;
+            ordered = node;
+            pending_.fetch_sub(node->size);
+            node = next;
+        }
+        return ordered;
+    }
+
+    uint32_t maxPending_;
+    std::atomic<Node *> head_ { nullptr };
+    std::atomic<uint32_t> pending_ { 0 };
+    std::atomic<bool> overflowed_ { false };
+    std::atomic<bool> scheduled_ { false };
+};
+} // namespace OHOS
+#endif // OHOS_DISTRIBUTED_DATA_FRAMEWORKS_COMMON_BATCH_QUEUE_H
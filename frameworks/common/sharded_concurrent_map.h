@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DISTRIBUTED_DATA_FRAMEWORKS_COMMON_SHARDED_CONCURRENT_MAP_H
+#define OHOS_DISTRIBUTED_DATA_FRAMEWORKS_COMMON_SHARDED_CONCURRENT_MAP_H
+#include <array>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+namespace OHOS {
+/**
+ * The same interfaces as ConcurrentMap, but the entries are spread to _Shards lock-striped shards by the hash of key,
+ * the read only interfaces(Find, Contains, Size, Empty) take the shared lock of one shard only.
+ * Differences with ConcurrentMap:
+ * 1. the lock is not recursive, the actions of ForEach/Compute/EraseIf must not access the same map;
+ * 2. ForEach visits the shards one by one, the entries are ordered only inside one shard.
+ */
+template<typename _Key, typename _Tp, typename _Container = std::map<_Key, _Tp>, size_t _Shards = 16,
+    typename _Hash = std::hash<_Key>>
+class ShardedConcurrentMap {
+public:
+    using key_type = typename _Container::key_type;
+    using mapped_type = typename _Container::mapped_type;
+    using value_type = typename _Container::value_type;
+    using size_type = typename _Container::size_type;
+    using reference = typename _Container::reference;
+    using const_reference = typename _Container::const_reference;
+    static_assert(_Shards > 0, "the shard count must not be zero");
+
+    ShardedConcurrentMap() = default;
+    ~ShardedConcurrentMap()
+    {
+        Clear();
+    }
+
+    ShardedConcurrentMap(const ShardedConcurrentMap &other)
+    {
+        operator=(other);
+    }
+
+    ShardedConcurrentMap &operator=(const ShardedConcurrentMap &other) noexcept
+    {
+        if (this == &other) {
+            return *this;
+        }
+        for (size_t i = 0; i < _Shards; ++i) {
+            auto tmp = other.shards_[i].Clone();
+            std::unique_lock<decltype(shards_[i].mutex)> lock(shards_[i].mutex);
+            shards_[i].entries = std::move(tmp);
+        }
+        return *this;
+    }
+
+    ShardedConcurrentMap(ShardedConcurrentMap &&other) noexcept
+    {
+        operator=(std::move(other));
+    }
+
+    ShardedConcurrentMap &operator=(ShardedConcurrentMap &&other) noexcept
+    {
+        if (this == &other) {
+            return *this;
+        }
+        for (size_t i = 0; i < _Shards; ++i) {
+            auto tmp = other.shards_[i].Steal();
+            std::unique_lock<decltype(shards_[i].mutex)> lock(shards_[i].mutex);
+            shards_[i].entries = std::move(tmp);
+        }
+        return *this;
+    }
+
+    template<typename... _Args>
+    bool Emplace(_Args &&...__args) noexcept
+    {
+        value_type value(std::forward<_Args>(__args)...);
+        auto &shard = GetShard(value.first);
+        std::unique_lock<decltype(shard.mutex)> lock(shard.mutex);
+        auto it = shard.entries.emplace(std::move(value));
+        return it.second;
+    }
+
+    std::pair<bool, mapped_type> Find(const key_type &key) const noexcept
+    {
+        auto &shard = GetShard(key);
+        std::shared_lock<decltype(shard.mutex)> lock(shard.mutex);
+        auto it = shard.entries.find(key);
+        if (it == shard.entries.end()) {
+            return std::pair { false, mapped_type() };
+        }
+
+        return std::pair { true, it->second };
+    }
+
+    bool Contains(const key_type &key) const noexcept
+    {
+        auto &shard = GetShard(key);
+        std::shared_lock<decltype(shard.mutex)> lock(shard.mutex);
+        return (shard.entries.find(key) != shard.entries.end());
+    }
+
+    template <typename _Obj>
+    bool InsertOrAssign(const key_type &key, _Obj &&obj) noexcept
+    {
+        auto &shard = GetShard(key);
+        std::unique_lock<decltype(shard.mutex)> lock(shard.mutex);
+        auto it = shard.entries.insert_or_assign(key, std::forward<_Obj>(obj));
+        return it.second;
+    }
+
+    bool Insert(const key_type &key, const mapped_type &value) noexcept
+    {
+        auto &shard = GetShard(key);
+        std::unique_lock<decltype(shard.mutex)> lock(shard.mutex);
+        auto it = shard.entries.insert(value_type { key, value });
+        return it.second;
+    }
+
+    size_type Erase(const key_type &key) noexcept
+    {
+        auto &shard = GetShard(key);
+        std::unique_lock<decltype(shard.mutex)> lock(shard.mutex);
+        return shard.entries.erase(key);
+    }
+
+    void Clear() noexcept
+    {
+        for (auto &shard : shards_) {
+            std::unique_lock<decltype(shard.mutex)> lock(shard.mutex);
+            shard.entries.clear();
+        }
+    }
+
+    bool Empty() const noexcept
+    {
+        for (auto &shard : shards_) {
+            std::shared_lock<decltype(shard.mutex)> lock(shard.mutex);
+            if (!shard.entries.empty()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_type Size() const noexcept
+    {
+        size_type size = 0;
+        for (auto &shard : shards_) {
+            std::shared_lock<decltype(shard.mutex)> lock(shard.mutex);
+            size += shard.entries.size();
+        }
+        return size;
+    }
+
+    // The action`s return true mains meet the erase condition
+    // The action`s return false mains not meet the erase condition
+    size_type EraseIf(const std::function<bool(const key_type &key, mapped_type &value)> &action) noexcept
+    {
+        if (action == nullptr) {
+            return 0;
+        }
+        size_type count = 0;
+        for (auto &shard : shards_) {
+            std::unique_lock<decltype(shard.mutex)> lock(shard.mutex);
+            for (auto it = shard.entries.begin(); it != shard.entries.end();) {
+                if (action((*it).first, (*it).second)) {
+                    it = shard.entries.erase(it);
+                    ++count;
+                } else {
+                    ++it;
+                }
+            }
+        }
+        return count;
+    }
+
+    mapped_type &operator[](const key_type &key) noexcept
+    {
+        auto &shard = GetShard(key);
+        std::unique_lock<decltype(shard.mutex)> lock(shard.mutex);
+        return shard.entries[key];
+    }
+
+    void ForEach(const std::function<bool(const key_type &, mapped_type &)> &action)
+    {
+        if (action == nullptr) {
+            return;
+        }
+        for (auto &shard : shards_) {
+            std::unique_lock<decltype(shard.mutex)> lock(shard.mutex);
+            for (auto &[key, value] : shard.entries) {
+                if (action(key, value)) {
+                    return;
+                }
+            }
+        }
+    }
+
+    // The action's return value mains that the element is keep in map or not; true mains keep, false mains remove.
+    bool Compute(const key_type &key, const std::function<bool(const key_type &, mapped_type &)> &action)
+    {
+        if (action == nullptr) {
+            return false;
+        }
+        auto &shard = GetShard(key);
+        std::unique_lock<decltype(shard.mutex)> lock(shard.mutex);
+        auto it = shard.entries.find(key);
+        if (it == shard.entries.end()) {
+            auto result = shard.entries.emplace(key, mapped_type());
+            it = result.second ? result.first : shard.entries.end();
+        }
+        if (it == shard.entries.end()) {
+            return false;
+        }
+        if (!action(it->first, it->second)) {
+            shard.entries.erase(key);
+        }
+        return true;
+    }
+
+    // The action's return value mains that the element is keep in map or not; true mains keep, false mains remove.
+    bool ComputeIfPresent(const key_type &key, const std::function<bool(const key_type &, mapped_type &)> &action)
+    {
+        if (action == nullptr) {
+            return false;
+        }
+        auto &shard = GetShard(key);
+        std::unique_lock<decltype(shard.mutex)> lock(shard.mutex);
+        auto it = shard.entries.find(key);
+        if (it == shard.entries.end()) {
+            return false;
+        }
+        if (!action(key, it->second)) {
+            shard.entries.erase(key);
+        }
+        return true;
+    }
+
+    bool ComputeIfAbsent(const key_type &key, const std::function<mapped_type(const key_type &)> &action)
+    {
+        if (action == nullptr) {
+            return false;
+        }
+        auto &shard = GetShard(key);
+        std::unique_lock<decltype(shard.mutex)> lock(shard.mutex);
+        auto it = shard.entries.find(key);
+        if (it != shard.entries.end()) {
+            return false;
+        }
+        shard.entries.emplace(key, action(key));
+        return true;
+    }
+
+private:
+    // one cache line at least for each shard, the shards do not false share.
+    struct alignas(64) Shard {
+        _Container Steal() noexcept
+        {
+            std::unique_lock<decltype(mutex)> lock(mutex);
+            return std::move(entries);
+        }
+
+        _Container Clone() const noexcept
+        {
+            std::shared_lock<decltype(mutex)> lock(mutex);
+            return entries;
+        }
+
+        mutable std::shared_mutex mutex;
+        _Container entries;
+    };
+
+    Shard &GetShard(const key_type &key) noexcept
+    {
+        return shards_[_Hash()(key) % _Shards];
+    }
+
+    const Shard &GetShard(const key_type &key) const noexcept
+    {
+        return shards_[_Hash()(key) % _Shards];
+    }
+
+    std::array<Shard, _Shards> shards_;
+};
+
+// For the keys those do not need ordering.
+template<typename _Key, typename _Tp, size_t _Shards = 16, typename _Hash = std::hash<_Key>>
+using ConcurrentHashMap = ShardedConcurrentMap<_Key, _Tp, std::unordered_map<_Key, _Tp, _Hash>, _Shards, _Hash>;
+} // namespace OHOS
+#endif // OHOS_DISTRIBUTED_DATA_FRAMEWORKS_COMMON_SHARDED_CONCURRENT_MAP_H
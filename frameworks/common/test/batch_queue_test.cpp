@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "BatchQueueTest"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "batch_queue.h"
+#include "gtest/gtest.h"
+
+using namespace testing::ext;
+template<typename _Tp> using BatchQueue = OHOS::BatchQueue<_Tp>;
+
+class BatchQueueTest : public testing::Test {
+public:
+    struct TestChange {
+        std::string device;
+        std::vector<int> values;
+    };
+    static constexpr uint32_t TEST_MAX_PENDING = 100;
+
+    static void SetUpTestCase(void) {}
+
+    static void TearDownTestCase(void) {}
+
+    // merge the changes of the same device, as the data observer of js does.
+    static bool MergeSameDevice(TestChange &prev, TestChange &next)
+    {
+        if (prev.device != next.device) {
+            return false;
+        }
+        prev.values.insert(prev.values.end(), next.values.begin(), next.values.end());
+        return true;
+    }
+
+protected:
+    void SetUp() {}
+
+    void TearDown() {}
+};
+
+/**
+* @tc.name: ScheduleOnce
+* @tc.desc: only the first push after the take schedules the consumer.
+* @tc.type: FUNC
+* @tc.require:
+* @tc.author: Sven Wang
+*/
+HWTEST_F(BatchQueueTest, ScheduleOnce, TestSize.Level0)
+{
+    BatchQueue<TestChange> queue(TEST_MAX_PENDING);
+    ASSERT_TRUE(queue.Push({ "a", { 0 } }, 1));
+    ASSERT_FALSE(queue.Push({ "a", { 1 } }, 1));
+    bool overflowed = true;
+    auto changes = queue.Take(MergeSameDevice, overflowed);
+    ASSERT_FALSE(overflowed);
+    ASSERT_EQ(changes.size(), 1);
+    ASSERT_TRUE(queue.Push({ "a", { 2 } }, 1));
+
+    // the schedule failed, the next push schedules again.
+    queue.Unschedule();
+    ASSERT_TRUE(queue.Push({ "a", { 3 } }, 1));
+    changes = queue.Take(MergeSameDevice, overflowed);
+    ASSERT_EQ(changes.size(), 1);
+    ASSERT_EQ(changes[0].values, std::vector<int>({ 2, 3 }));
+    changes = queue.Take(MergeSameDevice, overflowed);
+    ASSERT_TRUE(changes.empty());
+}
+
+/**
+* @tc.name: Coalesce
+* @tc.desc: the items are taken in the order pushed, the consecutive items of one device are merged.
+* @tc.type: FUNC
+* @tc.require:
+* @tc.author: Sven Wang
+*/
+HWTEST_F(BatchQueueTest, Coalesce, TestSize.Level0)
+{
+    BatchQueue<TestChange> queue(TEST_MAX_PENDING);
+    queue.Push({ "a", { 0, 1 } }, 2);
+    queue.Push({ "a", { 2 } }, 1);
+    queue.Push({ "b", { 3 } }, 1);
+    queue.Push({ "a", { 4 } }, 1);
+    queue.Push({ "a", { 5 } }, 1);
+    bool overflowed = true;
+    auto changes = queue.Take(MergeSameDevice, overflowed);
+    ASSERT_FALSE(overflowed);
+    ASSERT_EQ(changes.size(), 3);
+    ASSERT_EQ(changes[0].device, "a");
+    ASSERT_EQ(changes[0].values, std::vector<int>({ 0, 1, 2 }));
+    ASSERT_EQ(changes[1].device, "b");
+    ASSERT_EQ(changes[1].values, std::vector<int>({ 3 }));
+    ASSERT_EQ(changes[2].device, "a");
+    ASSERT_EQ(changes[2].values, std::vector<int>({ 4, 5 }));
+
+    queue.Push({ "a", { 6 } }, 1);
+    queue.Push({ "a", { 7 } }, 1);
+    changes = queue.Take(nullptr, overflowed);
+    ASSERT_EQ(changes.size(), 2);
+}
+
+/**
+* @tc.name: Overflow
+* @tc.desc: the pushes over the limit are dropped, only the first item is taken with the overflowed flag.
+* @tc.type: FUNC
+* @tc.require:
+* @tc.author: Sven Wang
+*/
+HWTEST_F(BatchQueueTest, Overflow, TestSize.Level0)
+{
+    BatchQueue<TestChange> queue(TEST_MAX_PENDING);
+    queue.Push({ "a", std::vector<int>(TEST_MAX_PENDING, 0) }, TEST_MAX_PENDING);
+    queue.Push({ "b", { 1 } }, 1);
+    queue.Push({ "c", { 2 } }, 1);
+    bool overflowed = false;
+    auto changes = queue.Take(MergeSameDevice, overflowed);
+    ASSERT_TRUE(overflowed);
+    ASSERT_EQ(changes.size(), 1);
+    ASSERT_EQ(changes[0].device, "a");
+
+    // the pending size is released by the take, the queue works again.
+    queue.Push({ "d", std::vector<int>(TEST_MAX_PENDING, 0) }, TEST_MAX_PENDING);
+    changes = queue.Take(MergeSameDevice, overflowed);
+    ASSERT_FALSE(overflowed);
+    ASSERT_EQ(changes.size(), 1);
+    ASSERT_EQ(changes[0].device, "d");
+}
+
+/**
+* @tc.name: ConcurrentPush
+* @tc.desc: the items pushed by many threads are all taken once, in the order pushed by each thread.
+* @tc.type: FUNC
+* @tc.require:
+* @tc.author: Sven Wang
+*/
+HWTEST_F(BatchQueueTest, ConcurrentPush, TestSize.Level0)
+{
+    constexpr int threadNum = 4;
+    constexpr int pushNum = 1000;
+    BatchQueue<TestChange> queue(threadNum * pushNum);
+    std::atomic<int> scheduled = 0;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadNum; ++t) {
+        threads.emplace_back([&queue, &scheduled, t]() {
+            for (int i = 0; i < pushNum; ++i) {
+                if (queue.Push({ std::to_string(t), { i } }, 1)) {
+                    scheduled++;
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(scheduled, 1);
+    bool overflowed = true;
+    auto changes = queue.Take(nullptr, overflowed);
+    ASSERT_FALSE(overflowed);
+    ASSERT_EQ(changes.size(), threadNum * pushNum);
+    std::vector<int> next(threadNum, 0);
+    for (const auto &change : changes) {
+        int t = std::stoi(change.device);
+        ASSERT_EQ(change.values[0], next[t]++);
+    }
+}
@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "ShardedConcurrentMapTest"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include "concurrent_map.h"
+#include "sharded_concurrent_map.h"
+#include "gtest/gtest.h"
+
+using namespace testing::ext;
+template<typename _Key, typename _Tp> using ShardedConcurrentMap = OHOS::ShardedConcurrentMap<_Key, _Tp>;
+template<typename _Key, typename _Tp> using ConcurrentHashMap = OHOS::ConcurrentHashMap<_Key, _Tp>;
+template<typename _Key, typename _Tp> using ConcurrentMap = OHOS::ConcurrentMap<_Key, _Tp>;
+
+class ShardedConcurrentMapTest : public testing::Test {
+public:
+    struct TestValue {
+        std::string id;
+        std::string name;
+        std::string testCase;
+    };
+    static constexpr int TEST_COUNT = 100;
+    static constexpr int BENCH_THREADS = 8;
+    static constexpr int BENCH_KEYS = 1024;
+    static constexpr int BENCH_LOOPS = 100000;
+
+    static void SetUpTestCase(void) {}
+
+    static void TearDownTestCase(void) {}
+
+    // 90% Find and 10% InsertOrAssign from every thread, returns the cost in microseconds.
+    template<typename _Map>
+    static int64_t ReadMostly(_Map &map)
+    {
+        for (int i = 0; i < BENCH_KEYS; ++i) {
+            map.InsertOrAssign(std::to_string(i), i);
+        }
+        auto begin = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < BENCH_THREADS; ++t) {
+            threads.emplace_back([&map, t]() {
+                for (int i = 0; i < BENCH_LOOPS; ++i) {
+                    auto key = std::to_string((i * BENCH_THREADS + t) % BENCH_KEYS);
+                    if (i % 10 == 0) { // one write in 10 operations
+                        map.InsertOrAssign(key, i);
+                    } else {
+                        map.Find(key);
+                    }
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+    }
+
+protected:
+    void SetUp()
+    {
+        values_.Clear();
+        for (int i = 0; i < TEST_COUNT; ++i) {
+            std::string key = std::string("test_") + std::to_string(i);
+            values_.Insert(key, {key, key, "case"});
+        }
+    }
+
+    void TearDown() {}
+
+    ShardedConcurrentMap<std::string, TestValue> values_;
+};
+
+/**
+* @tc.name: insert_find_erase
+* @tc.desc: Insert, find and erase the values of the sharded map.
+* @tc.type: FUNC
+* @tc.require:
+* @tc.author: Sven Wang
+*/
+HWTEST_F(ShardedConcurrentMapTest, insert_find_erase, TestSize.Level0)
+{
+    ASSERT_EQ(values_.Size(), TEST_COUNT);
+    ASSERT_FALSE(values_.Insert("test_0", {"test_0", "other", "case"}));
+    auto [found, value] = values_.Find("test_0");
+    ASSERT_TRUE(found);
+    ASSERT_EQ(value.name, "test_0");
+    ASSERT_FALSE(values_.InsertOrAssign("test_0", TestValue {"test_0", "other", "case"}));
+    ASSERT_EQ(values_.Find("test_0").second.name, "other");
+    ASSERT_TRUE(values_.Emplace("test_100", TestValue {"test_100", "test_100", "case"}));
+    ASSERT_TRUE(values_.Contains("test_100"));
+    ASSERT_EQ(values_.Erase("test_100"), 1);
+    ASSERT_FALSE(values_.Contains("test_100"));
+    values_.Clear();
+    ASSERT_TRUE(values_.Empty());
+}
+
+/**
+* @tc.name: compute
+* @tc.desc: Compute, ComputeIfPresent and ComputeIfAbsent keep the ConcurrentMap semantics.
+* @tc.type: FUNC
+* @tc.require:
+* @tc.author: Sven Wang
+*/
+HWTEST_F(ShardedConcurrentMapTest, compute, TestSize.Level0)
+{
+    ASSERT_TRUE(values_.Compute("test_200", [](const std::string &key, TestValue &value) {
+        value.id = key;
+        return true;
+    }));
+    ASSERT_EQ(values_.Find("test_200").second.id, "test_200");
+    ASSERT_TRUE(values_.ComputeIfPresent("test_200", [](const std::string &, TestValue &) {
+        return false;
+    }));
+    ASSERT_FALSE(values_.Contains("test_200"));
+    ASSERT_FALSE(values_.ComputeIfPresent("test_200", [](const std::string &, TestValue &) {
+        return true;
+    }));
+    ASSERT_FALSE(values_.ComputeIfAbsent("test_1", [](const std::string &key) {
+        return TestValue {key, key, "absent"};
+    }));
+    ASSERT_TRUE(values_.ComputeIfAbsent("test_201", [](const std::string &key) {
+        return TestValue {key, key, "absent"};
+    }));
+    ASSERT_EQ(values_.Find("test_201").second.testCase, "absent");
+}
+
+/**
+* @tc.name: for_each_erase_if
+* @tc.desc: ForEach visits every shard and EraseIf removes the matched values of all shards.
+* @tc.type: FUNC
+* @tc.require:
+* @tc.author: Sven Wang
+*/
+HWTEST_F(ShardedConcurrentMapTest, for_each_erase_if, TestSize.Level0)
+{
+    int count = 0;
+    values_.ForEach([&count](const std::string &, TestValue &) {
+        count++;
+        return false;
+    });
+    ASSERT_EQ(count, TEST_COUNT);
+    count = 0;
+    values_.ForEach([&count](const std::string &, TestValue &) {
+        count++;
+        return true;
+    });
+    ASSERT_EQ(count, 1);
+    auto erased = values_.EraseIf([](const std::string &key, TestValue &) {
+        return key.size() == std::string("test_0").size();
+    });
+    ASSERT_EQ(erased, 10);
+    ASSERT_EQ(values_.Size(), TEST_COUNT - 10);
+}
+
+/**
+* @tc.name: copy_move
+* @tc.desc: Copy and move the sharded map.
+* @tc.type: FUNC
+* @tc.require:
+* @tc.author: Sven Wang
+*/
+HWTEST_F(ShardedConcurrentMapTest, copy_move, TestSize.Level0)
+{
+    ShardedConcurrentMap<std::string, TestValue> copied(values_);
+    ASSERT_EQ(copied.Size(), TEST_COUNT);
+    ShardedConcurrentMap<std::string, TestValue> moved(std::move(copied));
+    ASSERT_EQ(moved.Size(), TEST_COUNT);
+    ASSERT_TRUE(copied.Empty());
+    ASSERT_TRUE(moved.Contains("test_99"));
+}
+
+/**
+* @tc.name: hash_map
+* @tc.desc: The hash based variant has the same interfaces.
+* @tc.type: FUNC
+* @tc.require:
+* @tc.author: Sven Wang
+*/
+HWTEST_F(ShardedConcurrentMapTest, hash_map, TestSize.Level0)
+{
+    ConcurrentHashMap<uint64_t, std::string> map;
+    for (uint64_t i = 0; i < TEST_COUNT; ++i) {
+        ASSERT_TRUE(map.Insert(i, std::to_string(i)));
+    }
+    ASSERT_EQ(map.Size(), TEST_COUNT);
+    ASSERT_EQ(map.Find(10).second, "10");
+    ASSERT_EQ(map.Erase(10), 1);
+    ASSERT_FALSE(map.Find(10).first);
+}
+
+/**
+* @tc.name: concurrent_compute
+* @tc.desc: Compute the same keys from multiple threads, no update is lost.
+* @tc.type: FUNC
+* @tc.require:
+* @tc.author: Sven Wang
+*/
+HWTEST_F(ShardedConcurrentMapTest, concurrent_compute, TestSize.Level1)
+{
+    ConcurrentHashMap<int, int> counters;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < BENCH_THREADS; ++t) {
+        threads.emplace_back([&counters]() {
+            for (int i = 0; i < TEST_COUNT * TEST_COUNT; ++i) {
+                counters.Compute(i % TEST_COUNT, [](const int &, int &value) {
+                    value++;
+                    return true;
+                });
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(counters.Size(), TEST_COUNT);
+    counters.ForEach([](const int &, int &value) {
+        EXPECT_EQ(value, BENCH_THREADS * TEST_COUNT);
+        return false;
+    });
+}
+
+/**
+* @tc.name: bench_read_mostly
+* @tc.desc: Micro-benchmark of the read-mostly concurrent access, ConcurrentMap vs the sharded variants.
+* @tc.type: PERF
+* @tc.require:
+* @tc.author: Sven Wang
+*/
+HWTEST_F(ShardedConcurrentMapTest, bench_read_mostly, TestSize.Level3)
+{
+    ConcurrentMap<std::string, int> single;
+    ShardedConcurrentMap<std::string, int> sharded;
+    ConcurrentHashMap<std::string, int> hashed;
+    auto singleCost = ReadMostly(single);
+    auto shardedCost = ReadMostly(sharded);
+    auto hashedCost = ReadMostly(hashed);
+    printf("read mostly, %d threads x %d ops: ConcurrentMap %lld us, ShardedConcurrentMap %lld us, "
+           "ConcurrentHashMap %lld us\n", BENCH_THREADS, BENCH_LOOPS, static_cast<long long>(singleCost),
+        static_cast<long long>(shardedCost), static_cast<long long>(hashedCost));
+    ASSERT_EQ(sharded.Size(), BENCH_KEYS);
+    ASSERT_EQ(hashed.Size(), BENCH_KEYS);
+}
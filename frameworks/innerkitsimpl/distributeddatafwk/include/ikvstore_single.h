@@ -132,8 +132,8 @@ private:
 
     int OnSubscribeRequest(MessageParcel &data, MessageParcel &reply);
     int OnUnSubscribeRequest(MessageParcel &data, MessageParcel &reply);
-    int WriteEntriesParcelable(MessageParcel &reply, Status status, std::vector<Entry> entries, int bufferSize);
-    int GetTotalEntriesSize(std::vector<Entry> entries);
+    int WriteEntriesParcelable(MessageParcel &reply, Status status, const std::vector<Entry> &entries, int bufferSize);
+    int GetTotalEntriesSize(const std::vector<Entry> &entries);
 
     using RequestHandler = int(SingleKvStoreStub::*)(MessageParcel&, MessageParcel&);
     static constexpr RequestHandler HANDLERS[SINGLE_CMD_LAST] = {
@@ -1076,7 +1076,7 @@ int SingleKvStoreStub::UnSubscribeKvStoreOnRemote(MessageParcel &data, MessagePa
     return 0;
 }
 int SingleKvStoreStub::WriteEntriesParcelable(MessageParcel &reply, Status status,
-    std::vector<Entry> entries, int bufferSize)
+    const std::vector<Entry> &entries, int bufferSize)
 {
     if (!reply.WriteInt32(static_cast<int>(status)) ||
         !reply.WriteInt32(entries.size()) ||
@@ -1093,7 +1093,7 @@ int SingleKvStoreStub::WriteEntriesParcelable(MessageParcel &reply, Status statu
     return 0;
 }
 
-int SingleKvStoreStub::GetTotalEntriesSize(std::vector<Entry> entries)
+int SingleKvStoreStub::GetTotalEntriesSize(const std::vector<Entry> &entries)
 {
     int bufferSize = 0;
     for (const auto &entry : entries) {
@@ -1334,7 +1334,7 @@ int SingleKvStoreStub::PutBatchOnRemote(MessageParcel &data, MessageParcel &repl
                 }
                 return 0;
             }
-            entries.push_back(*entry);
+            entries.push_back(std::move(*entry));
         }
         Status status = PutBatch(entries);
         if (!reply.WriteInt32(static_cast<int>(status))) {
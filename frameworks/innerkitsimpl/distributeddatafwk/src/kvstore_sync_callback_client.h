@@ -17,7 +17,7 @@
 #define KVSTORE_SYNC_CALLBACK_CLIENT_H
 
 #include <mutex>
-#include "concurrent_map.h"
+#include "sharded_concurrent_map.h"
 #include "ikvstore_sync_callback.h"
 #include "kvstore_sync_callback.h"
 
@@ -35,7 +35,7 @@ public:
 
     void DeleteSyncCallback(uint64_t sequenceId);
 private:
-    ConcurrentMap<uint64_t, std::shared_ptr<KvStoreSyncCallback>> syncCallbackInfo_;
+    ConcurrentHashMap<uint64_t, std::shared_ptr<KvStoreSyncCallback>> syncCallbackInfo_;
 };
 }  // namespace DistributedKv
 }  // namespace OHOS
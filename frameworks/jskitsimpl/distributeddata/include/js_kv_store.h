@@ -16,6 +16,7 @@
 #define OHOS_KV_STORE_H
 #include <mutex>
 #include <memory>
+#include "batch_queue.h"
 #include "napi_queue.h"
 #include "single_kvstore.h"
 #include "uv_queue.h"
@@ -58,13 +59,37 @@ public:
     static napi_value SetSyncRange(napi_env env, napi_callback_info info);
 
 private:
+    /*
+     * The changes are buffered and delivered to js in one batch after the latency budget, the consecutive changes
+     * of the same device are merged into one ChangeNotification. Once the buffered entries exceed the limit, the
+     * changes are dropped and one empty ChangeNotification is delivered, the application should query the data again.
+     */
     class DataObserver : public DistributedKv::KvStoreObserver, public JSObserver {
     public:
-        DataObserver(std::shared_ptr<UvQueue> uvQueue, napi_value callback) : JSObserver(uvQueue, callback) {};
+        static constexpr uint32_t DEFAULT_LATENCY_BUDGET = 20; // ms
+        static constexpr uint32_t DEFAULT_MAX_PENDING_ENTRIES = 10000;
+        DataObserver(std::shared_ptr<UvQueue> uvQueue, napi_value callback,
+            uint32_t latencyBudget = DEFAULT_LATENCY_BUDGET, uint32_t maxPendingEntries = DEFAULT_MAX_PENDING_ENTRIES)
+            : JSObserver(uvQueue, callback), latencyBudget_(latencyBudget), pending_(maxPendingEntries) {};
         virtual ~DataObserver() = default;
         void OnChange(const DistributedKv::ChangeNotification& notification,
                       std::shared_ptr<DistributedKv::KvStoreSnapshot> snapshot) override;
         void OnChange(const DistributedKv::ChangeNotification& notification) override;
+    private:
+        struct ChangeSet {
+            std::string deviceId;
+            std::vector<DistributedKv::Entry> insertEntries;
+            std::vector<DistributedKv::Entry> updateEntries;
+            std::vector<DistributedKv::Entry> deleteEntries;
+            uint32_t Size() const;
+            // merge the changes of the same device only.
+            bool Merge(ChangeSet &other);
+        };
+        void Deliver(napi_env env);
+
+        uint32_t latencyBudget_;
+        // pushed by the ipc threads, taken by the js main thread.
+        BatchQueue<ChangeSet> pending_;
     };
 
     class SyncObserver : public DistributedKv::KvStoreSyncCallback, public JSObserver {
@@ -26,6 +26,7 @@ public:
     void Clear();
 protected:
     void AsyncCall(UvQueue::NapiArgsGenerator genArgs = UvQueue::NapiArgsGenerator());
+    bool AsyncExec(UvQueue::NapiExecutor executor, uint32_t delayMs = 0);
 private:
     std::shared_ptr<UvQueue> uvQueue_;
     napi_ref callback_;
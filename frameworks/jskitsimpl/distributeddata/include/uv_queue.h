@@ -25,17 +25,29 @@ class UvQueue final {
 public:
     using NapiArgsGenerator = std::function<void(napi_env env, int& argc, napi_value* argv)>;
     using NapiCallbackGetter = std::function<napi_value(napi_env env)>;
+    using NapiExecutor = std::function<void(napi_env env)>;
     UvQueue(napi_env env);
     ~UvQueue();
 
     napi_env GetEnv();
     void AsyncCall(NapiCallbackGetter getter, NapiArgsGenerator genArgs = NapiArgsGenerator());
+    // the executor runs in js main thread after delayMs, the delay is a timer of the loop, no uv work thread waits.
+    // return false if nothing is scheduled.
+    bool AsyncExec(NapiExecutor executor, uint32_t delayMs = 0);
+    static void CallFunction(napi_env env, napi_value method, int argc, napi_value* argv);
 private:
     struct UvEntry {
         napi_env env;
         NapiCallbackGetter callback;
         NapiArgsGenerator args;
     };
+    struct UvExecEntry {
+        napi_env env;
+        NapiExecutor executor;
+        uint32_t delayMs;
+    };
+    static bool StartTimer(uv_loop_s* loop, UvExecEntry* entry);
+    static void CloseTimer(uv_timer_t* timer);
     napi_env env_ = nullptr;
     uv_loop_s* loop_ = nullptr;
 };
@@ -675,12 +675,62 @@ void JsKVStore::DataObserver::OnChange(const ChangeNotification& notification)
         notification.GetDeleteEntries().size());
     KvStoreObserver::OnChange(notification);
 
-    auto args = [notification](napi_env env, int& argc, napi_value* argv) {
-        // generate 1 arguments for callback function.
-        argc = 1;
-        JSUtil::SetValue(env, notification, argv[0]);
-    };
-    AsyncCall(args);
+    ChangeSet changes{ notification.GetDeviceId(), notification.GetInsertEntries(), notification.GetUpdateEntries(),
+        notification.GetDeleteEntries() };
+    uint32_t size = changes.Size();
+    if (!pending_.Push(std::move(changes), size)) {
+        return;
+    }
+    auto observer = std::static_pointer_cast<DataObserver>(shared_from_this());
+    if (!AsyncExec([observer](napi_env env) { observer->Deliver(env); }, latencyBudget_)) {
+        // nothing is scheduled, the next change schedules the delivery again.
+        pending_.Unschedule();
+    }
+}
+
+uint32_t JsKVStore::DataObserver::ChangeSet::Size() const
+{
+    return insertEntries.size() + updateEntries.size() + deleteEntries.size();
+}
+
+bool JsKVStore::DataObserver::ChangeSet::Merge(ChangeSet &other)
+{
+    if (deviceId != other.deviceId) {
+        return false;
+    }
+    std::move(other.insertEntries.begin(), other.insertEntries.end(), std::back_inserter(insertEntries));
+    std::move(other.updateEntries.begin(), other.updateEntries.end(), std::back_inserter(updateEntries));
+    std::move(other.deleteEntries.begin(), other.deleteEntries.end(), std::back_inserter(deleteEntries));
+    return true;
+}
+
+void JsKVStore::DataObserver::Deliver(napi_env env)
+{
+    // run in js main thread, the changes pushed after this are delivered in the next schedule.
+    bool overflowed = false;
+    auto batches = pending_.Take([](ChangeSet &prev, ChangeSet &next) { return prev.Merge(next); }, overflowed);
+    if (overflowed) {
+        // the re-query notification replaces all the dropped changes.
+        ZLOGW("too many pending changes, deliver the re-query notification instead.");
+        std::string deviceId = batches.empty() ? "" : batches.front().deviceId;
+        batches = { ChangeSet{ deviceId } };
+    }
+    for (auto& changes : batches) {
+        // Clear() runs in js main thread too, check the callback for each batch.
+        napi_ref callbackRef = GetCallback();
+        if (callbackRef == nullptr) {
+            return;
+        }
+        napi_value callback = nullptr;
+        napi_get_reference_value(env, callbackRef, &callback);
+        ChangeNotification notification(std::move(changes.insertEntries), std::move(changes.updateEntries),
+            std::move(changes.deleteEntries), changes.deviceId, false);
+        napi_value argv[1] = { nullptr };
+        if (JSUtil::SetValue(env, notification, argv[0]) != napi_ok) {
+            continue;
+        }
+        UvQueue::CallFunction(env, callback, 1, argv);
+    }
 }
 
 void JsKVStore::SyncObserver::SyncCompleted(const std::map<std::string, DistributedKv::Status>& results)
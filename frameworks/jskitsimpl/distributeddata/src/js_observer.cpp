@@ -57,4 +57,12 @@ void JSObserver::AsyncCall(UvQueue::NapiArgsGenerator genArgs)
         return callback;
         }, genArgs);
 }
+
+bool JSObserver::AsyncExec(UvQueue::NapiExecutor executor, uint32_t delayMs)
+{
+    if (callback_ == nullptr) {
+        return false;
+    }
+    return uvQueue_->AsyncExec(executor, delayMs);
+}
 } // namespace OHOS::DistributedData
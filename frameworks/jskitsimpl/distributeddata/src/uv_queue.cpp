@@ -65,14 +65,91 @@ void UvQueue::AsyncCall(NapiCallbackGetter getter, NapiArgsGenerator genArgs)
                 entry->args(entry->env, argc, argv);
             }
             ZLOGD("queue uv_after_work_cb");
-            napi_value global = nullptr;
-            napi_get_global(entry->env, &global);
-            napi_value result;
-            napi_status status = napi_call_function(entry->env, global, method, argc, argv, &result);
-            if (status != napi_ok) {
-                ZLOGE("notify data change failed status:%{public}d.", status);
+            CallFunction(entry->env, method, argc, argv);
+        });
+}
+
+bool UvQueue::AsyncExec(NapiExecutor executor, uint32_t delayMs)
+{
+    if (loop_ == nullptr || !executor) {
+        ZLOGE("loop_ or executor is nullptr");
+        return false;
+    }
+
+    uv_work_t* work = new (std::nothrow) uv_work_t;
+    if (work == nullptr) {
+        ZLOGE("no memory for uv_work_t");
+        return false;
+    }
+    auto entry = new (std::nothrow) UvExecEntry{ env_, std::move(executor), delayMs };
+    if (entry == nullptr) {
+        ZLOGE("no memory for UvExecEntry");
+        delete work;
+        return false;
+    }
+    work->data = entry;
+    int ret = uv_queue_work(
+        loop_, work, [](uv_work_t* work) {},
+        [](uv_work_t* work, int uvstatus) {
+            // the timer could be started in js main thread only.
+            auto entry = static_cast<UvExecEntry *>(work->data);
+            uv_loop_s* loop = work->loop;
+            delete work;
+            if (entry->delayMs > 0 && StartTimer(loop, entry)) {
+                return;
             }
+            entry->executor(entry->env);
+            delete entry;
         });
+    if (ret != 0) {
+        ZLOGE("uv_queue_work failed:%{public}d", ret);
+        delete entry;
+        delete work;
+        return false;
+    }
+    return true;
+}
+
+bool UvQueue::StartTimer(uv_loop_s* loop, UvExecEntry* entry)
+{
+    uv_timer_t* timer = new (std::nothrow) uv_timer_t;
+    if (timer == nullptr || uv_timer_init(loop, timer) != 0) {
+        ZLOGE("init timer failed, run the executor at once");
+        delete timer;
+        return false;
+    }
+    timer->data = entry;
+    int ret = uv_timer_start(
+        timer, [](uv_timer_t* timer) {
+            auto entry = static_cast<UvExecEntry *>(timer->data);
+            entry->executor(entry->env);
+            delete entry;
+            CloseTimer(timer);
+        }, entry->delayMs, 0);
+    if (ret != 0) {
+        ZLOGE("start timer failed:%{public}d, run the executor at once", ret);
+        CloseTimer(timer);
+        return false;
+    }
+    return true;
+}
+
+void UvQueue::CloseTimer(uv_timer_t* timer)
+{
+    uv_close(reinterpret_cast<uv_handle_t *>(timer), [](uv_handle_t* handle) {
+        delete reinterpret_cast<uv_timer_t *>(handle);
+    });
+}
+
+void UvQueue::CallFunction(napi_env env, napi_value method, int argc, napi_value* argv)
+{
+    napi_value global = nullptr;
+    napi_get_global(env, &global);
+    napi_value result;
+    napi_status status = napi_call_function(env, global, method, argc, argv, &result);
+    if (status != napi_ok) {
+        ZLOGE("notify data change failed status:%{public}d.", status);
+    }
 }
 
 napi_env UvQueue::GetEnv()
@@ -24,19 +24,16 @@ namespace OHOS {
 namespace DistributedKv {
 std::shared_ptr<KvStoreThreadPool> HiViewAdapter::pool_ = KvStoreThreadPool::GetPool(POOL_SIZE, true);
 
-std::mutex HiViewAdapter::visitMutex_;
-std::map<std::string, StatisticWrap<VisitStat>> HiViewAdapter::visitStat_;
+StatisticTable<VisitSlot> HiViewAdapter::visitStat_;
 
-std::mutex HiViewAdapter::trafficMutex_;
-std::map<std::string, StatisticWrap<TrafficStat>> HiViewAdapter::trafficStat_;
+StatisticTable<TrafficSlot> HiViewAdapter::trafficStat_;
 
 std::mutex HiViewAdapter::dbMutex_;
 std::map<std::string, StatisticWrap<DbStat>> HiViewAdapter::dbStat_;
 
-std::mutex HiViewAdapter::apiPerformanceMutex_;
-std::map<std::string, StatisticWrap<ApiPerformanceStat>> HiViewAdapter::apiPerformanceStat_;
+StatisticTable<ApiPerformanceSlot> HiViewAdapter::apiPerformanceStat_;
 
-bool HiViewAdapter::running_ = false;
+std::atomic<bool> HiViewAdapter::running_ = false;
 std::mutex HiViewAdapter::runMutex_;
 
 void HiViewAdapter::ReportFault(int dfxCode, const FaultMsg &msg)
@@ -116,96 +113,68 @@ void HiViewAdapter::InvokeDbSize()
 
 void HiViewAdapter::ReportTrafficStatistic(int dfxCode, const TrafficStat &stat)
 {
-    KvStoreTask task([=]() {
-        std::lock_guard<std::mutex> lock(trafficMutex_);
-        auto it = trafficStat_.find(stat.GetKey());
-        if (it != trafficStat_.end()) {
-            it->second.val.receivedSize += stat.receivedSize;
-            it->second.val.sendSize += stat.sendSize;
-        } else {
-            trafficStat_.insert({stat.GetKey(), {stat, 0, dfxCode}});
-        }
+    trafficStat_.Update(stat, dfxCode, [&stat](TrafficSlot &slot) {
+        slot.sendSize.fetch_add(static_cast<uint64_t>(stat.sendSize), std::memory_order_relaxed);
+        slot.receivedSize.fetch_add(static_cast<uint64_t>(stat.receivedSize), std::memory_order_relaxed);
     });
-    if (pool_ != nullptr) {
-        pool_->AddTask(std::move(task));
-    }
     StartTimerThread();
 }
 
 void HiViewAdapter::InvokeTraffic()
 {
-    std::lock_guard<std::mutex> lock(trafficMutex_);
     ValueHash vh;
-    for (auto const &kv : trafficStat_) {
+    trafficStat_.Drain([&vh](TrafficSlot &slot) {
+        uint64_t sendSize = slot.sendSize.exchange(0, std::memory_order_relaxed);
+        uint64_t receivedSize = slot.receivedSize.exchange(0, std::memory_order_relaxed);
+        if (sendSize == 0 && receivedSize == 0) {
+            return false;
+        }
         std::string deviceId;
-        if (!vh.CalcValueHash(kv.second.val.deviceId, deviceId)) {
-            continue;
+        if (!vh.CalcValueHash(slot.val.deviceId, deviceId)) {
+            return true;
         }
 
         OHOS::HiviewDFX::HiSysEvent::Write(OHOS::HiviewDFX::HiSysEvent::Domain::DISTRIBUTED_DATAMGR,
-            std::to_string(kv.second.code),
+            std::to_string(slot.code),
             OHOS::HiviewDFX::HiSysEvent::EventType::FAULT,
-            APP_ID, kv.second.val.appId,
+            APP_ID, slot.val.appId,
             DEVICE_ID, deviceId,
-            SEND_SIZE, kv.second.val.sendSize,
-            RECEIVED_SIZE, kv.second.val.receivedSize);
-    }
-    trafficStat_.clear();
+            SEND_SIZE, static_cast<int>(sendSize),
+            RECEIVED_SIZE, static_cast<int>(receivedSize));
+        return true;
+    });
 }
 
 void HiViewAdapter::ReportVisitStatistic(int dfxCode, const VisitStat &stat)
 {
-    KvStoreTask task([=]() {
-        std::lock_guard<std::mutex> lock(visitMutex_);
-        auto it = visitStat_.find(stat.GetKey());
-        if (it == visitStat_.end()) {
-            visitStat_.insert({stat.GetKey(), {stat, 1, dfxCode}});
-        } else {
-            it->second.times++;
-        }
+    visitStat_.Update(stat, dfxCode, [&stat](VisitSlot &slot) {
+        slot.times.fetch_add(static_cast<uint64_t>(stat.times), std::memory_order_relaxed);
     });
-    if (pool_ != nullptr) {
-        pool_->AddTask(std::move(task));
-    }
     StartTimerThread();
 }
 
 void HiViewAdapter::InvokeVisit()
 {
-    std::lock_guard<std::mutex> lock(visitMutex_);
-    for (auto const &kv : visitStat_) {
+    visitStat_.Drain([](VisitSlot &slot) {
+        uint64_t times = slot.times.exchange(0, std::memory_order_relaxed);
+        if (times == 0) {
+            return false;
+        }
         OHOS::HiviewDFX::HiSysEvent::Write(OHOS::HiviewDFX::HiSysEvent::Domain::DISTRIBUTED_DATAMGR,
-            std::to_string(kv.second.code),
+            std::to_string(slot.code),
             OHOS::HiviewDFX::HiSysEvent::EventType::FAULT,
-            APP_ID, kv.second.val.appId,
-            INTERFACE_NAME, kv.second.val.interfaceName,
-            TIMES, kv.second.times);
-    }
-    visitStat_.clear();
+            APP_ID, slot.val.appId,
+            INTERFACE_NAME, slot.val.interfaceName,
+            TIMES, static_cast<int>(times));
+        return true;
+    });
 }
 
 void HiViewAdapter::ReportApiPerformanceStatistic(int dfxCode, const ApiPerformanceStat &stat)
 {
-    KvStoreTask task([=]() {
-        std::lock_guard<std::mutex> lock(apiPerformanceMutex_);
-        auto it = apiPerformanceStat_.find(stat.GetKey());
-        if (it == apiPerformanceStat_.end()) {
-            apiPerformanceStat_.insert({stat.GetKey(), {stat, 1, dfxCode}}); // the init value of times is 1
-        } else {
-            it->second.times++;
-            it->second.val.costTime = stat.costTime;
-            if (it->second.times > 0) {
-                it->second.val.averageTime = (it->second.val.averageTime * (it->second.times - 1) + stat.costTime)
-                    / it->second.times;
-            }
-            if (stat.costTime > it->second.val.worstTime) {
-                it->second.val.worstTime = stat.costTime;
-            }
-        }
+    apiPerformanceStat_.Update(stat, dfxCode, [&stat](ApiPerformanceSlot &slot) {
+        slot.histogram.Add(stat.costTime);
     });
-    if (pool_ != nullptr) {
-        pool_->AddTask(std::move(task));
-    }
     StartTimerThread();
 }
 
@@ -213,23 +182,62 @@ void HiViewAdapter::InvokeApiPerformance()
 {
     std::string message;
     message.append("[");
-    std::lock_guard<std::mutex> lock(apiPerformanceMutex_);
-    for (auto const &kv : apiPerformanceStat_) {
-        message.append("{\"CODE\":\"").append(std::to_string(kv.second.code)).append("\",")
-        .append("\"").append(INTERFACE_NAME).append("\":\"").append(kv.second.val.interfaceName).append("\",")
-        .append("\"").append(TIMES).append("\":").append(std::to_string(kv.second.times)).append(",")
-        .append("\"").append(AVERAGE_TIMES).append("\":").append(std::to_string(kv.second.val.averageTime)).append(",")
-        .append("\"").append(WORST_TIMES).append("\":").append(std::to_string(kv.second.val.worstTime)).append("}");
-    }
+    apiPerformanceStat_.Drain([&message](ApiPerformanceSlot &slot) {
+        uint64_t times = 0;
+        uint64_t totalTime = 0;
+        uint64_t worstTime = 0;
+        std::array<uint64_t, LatencyHistogram::BUCKET_NUM> buckets {};
+        slot.histogram.Take(times, totalTime, worstTime, buckets);
+        if (times == 0) {
+            return false;
+        }
+        // the buckets after the last one counted are omitted
+        int bucketNum = LatencyHistogram::BUCKET_NUM;
+        while (bucketNum > 0 && buckets[bucketNum - 1] == 0) {
+            bucketNum--;
+        }
+        std::string histogram;
+        for (int i = 0; i < bucketNum; i++) {
+            histogram.append((i == 0) ? "" : ",").append(std::to_string(buckets[i]));
+        }
+        if (message.size() > 1) {
+            message.append(",");
+        }
+        message.append("{\"CODE\":\"").append(std::to_string(slot.code)).append("\",")
+        .append("\"").append(INTERFACE_NAME).append("\":\"").append(slot.val.interfaceName).append("\",")
+        .append("\"").append(TIMES).append("\":").append(std::to_string(times)).append(",")
+        .append("\"").append(AVERAGE_TIMES).append("\":").append(std::to_string(totalTime / times)).append(",")
+        .append("\"").append(WORST_TIMES).append("\":").append(std::to_string(worstTime)).append(",")
+        .append("\"").append(HISTOGRAM).append("\":[").append(histogram).append("]}");
+        return true;
+    });
     message.append("]");
     OHOS::HiviewDFX::HiSysEvent::Write(OHOS::HiviewDFX::HiSysEvent::Domain::DISTRIBUTED_DATAMGR,
         std::to_string(DfxCodeConstant::API_PERFORMANCE_STATISTIC),
         OHOS::HiviewDFX::HiSysEvent::EventType::FAULT,
         INTERFACES, message);
-    apiPerformanceStat_.clear();
     ZLOGI("DdsTrace interface: clean");
 }
 
+std::string HiViewAdapter::DumpStatistic()
+{
+    std::string dump;
+    visitStat_.ForEach([&dump](VisitSlot &slot) {
+        dump.append("visit ").append(slot.val.appId).append(" ").append(slot.val.interfaceName)
+            .append(" times=").append(std::to_string(slot.times.load(std::memory_order_relaxed))).append("\n");
+    });
+    trafficStat_.ForEach([&dump](TrafficSlot &slot) {
+        dump.append("traffic ").append(slot.val.appId)
+            .append(" send=").append(std::to_string(slot.sendSize.load(std::memory_order_relaxed)))
+            .append(" received=").append(std::to_string(slot.receivedSize.load(std::memory_order_relaxed)))
+            .append("\n");
+    });
+    apiPerformanceStat_.ForEach([&dump](ApiPerformanceSlot &slot) {
+        dump.append("api ").append(slot.val.interfaceName).append(" ").append(slot.histogram.Dump()).append("\n");
+    });
+    return dump;
+}
+
 void HiViewAdapter::StartTimerThread()
 {
     if (running_) {
@@ -16,6 +16,7 @@
 #ifndef DISTRIBUTEDDATAMGR_HI_VIEW_ADAPTER_H
 #define DISTRIBUTEDDATAMGR_HI_VIEW_ADAPTER_H
 
+#include <atomic>
 #include <map>
 #include <mutex>
 #include "dfx_types.h"
@@ -23,6 +24,7 @@
 #include "hisysevent.h"
 #include "kv_store_thread_pool.h"
 #include "kv_store_task.h"
+#include "statistic_table.h"
 #include "value_hash.h"
 
 namespace OHOS {
@@ -34,6 +36,52 @@ struct StatisticWrap {
     int code;
 };
 
+struct VisitSlot {
+    VisitSlot(const VisitStat &stat, int code) : val({stat.appId, stat.interfaceName, 0}), code(code) {}
+    static size_t Hash(const VisitStat &stat)
+    {
+        return CombineHash(std::hash<std::string>()(stat.appId), std::hash<std::string>()(stat.interfaceName));
+    }
+    bool IsSame(const VisitStat &stat) const
+    {
+        return val.appId == stat.appId && val.interfaceName == stat.interfaceName;
+    }
+    VisitStat val;
+    int code;
+    std::atomic<uint64_t> times {0};
+};
+
+struct TrafficSlot {
+    TrafficSlot(const TrafficStat &stat, int code) : val({stat.appId, stat.deviceId, 0, 0}), code(code) {}
+    static size_t Hash(const TrafficStat &stat)
+    {
+        return CombineHash(std::hash<std::string>()(stat.appId), std::hash<std::string>()(stat.deviceId));
+    }
+    bool IsSame(const TrafficStat &stat) const
+    {
+        return val.appId == stat.appId && val.deviceId == stat.deviceId;
+    }
+    TrafficStat val;
+    int code;
+    std::atomic<uint64_t> sendSize {0};
+    std::atomic<uint64_t> receivedSize {0};
+};
+
+struct ApiPerformanceSlot {
+    ApiPerformanceSlot(const ApiPerformanceStat &stat, int code) : val({stat.interfaceName, 0, 0, 0}), code(code) {}
+    static size_t Hash(const ApiPerformanceStat &stat)
+    {
+        return std::hash<std::string>()(stat.interfaceName);
+    }
+    bool IsSame(const ApiPerformanceStat &stat) const
+    {
+        return val.interfaceName == stat.interfaceName;
+    }
+    ApiPerformanceStat val;
+    int code;
+    LatencyHistogram histogram;
+};
+
 class HiViewAdapter {
 public:
     ~HiViewAdapter();
@@ -43,17 +91,19 @@ public:
     static void ReportDatabaseStatistic(int dfxCode, const DbStat &stat);
     static void ReportApiPerformanceStatistic(int dfxCode, const ApiPerformanceStat &stat);
     static void StartTimerThread();
+    // Dumps the statistics counted since the last report, for the local test and debug.
+    static std::string DumpStatistic();
 
 private:
     static constexpr int POOL_SIZE = 3;
     static std::shared_ptr<KvStoreThreadPool> pool_;
 
-    static std::mutex visitMutex_;
-    static std::map<std::string, StatisticWrap<VisitStat>> visitStat_;
+    // The visit, traffic and api performance statistics are counted on the calling thread with the atomics of the
+    // slots, and aggregated on the timer thread when reported. The slots idle since the last report are evicted then.
+    static StatisticTable<VisitSlot> visitStat_;
     static void InvokeVisit();
 
-    static std::mutex trafficMutex_;
-    static std::map<std::string, StatisticWrap<TrafficStat>> trafficStat_;
+    static StatisticTable<TrafficSlot> trafficStat_;
     static void InvokeTraffic();
 
     static std::mutex dbMutex_;
@@ -61,8 +111,7 @@ private:
     static void InvokeDbSize();
     static void ReportDbSize(const StatisticWrap<DbStat> &stat);
 
-    static std::mutex apiPerformanceMutex_;
-    static std::map<std::string, StatisticWrap<ApiPerformanceStat>> apiPerformanceStat_;
+    static StatisticTable<ApiPerformanceSlot> apiPerformanceStat_;
     static void InvokeApiPerformance();
 
 private:
@@ -90,10 +139,11 @@ private:
     static const inline std::string AVERAGE_TIMES = "AVERAGE_TIME";
     static const inline std::string WORST_TIMES = "WORST_TIME";
     static const inline std::string INTERFACES = "INTERFACES";
+    static const inline std::string HISTOGRAM = "HISTOGRAM";
 
 private:
     static std::mutex runMutex_;
-    static bool running_;
+    static std::atomic<bool> running_;
     static const inline int EXEC_TIME = 23;
     static const inline int SIXTY_SEC = 60;
 
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DISTRIBUTEDDATAMGR_STATISTIC_TABLE_H
+#define DISTRIBUTEDDATAMGR_STATISTIC_TABLE_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace OHOS {
+namespace DistributedKv {
+// Latency in microsecond, the bucket i counts the latency in [2^(i-1), 2^i), the last one counts the larger ones.
+class LatencyHistogram {
+public:
+    static constexpr int BUCKET_NUM = 24;
+
+    void Add(uint64_t costTime)
+    {
+        int index = (costTime == 0) ? 0 : (64 - __builtin_clzll(costTime)); // 64 bits
+        index = (index < BUCKET_NUM) ? index : (BUCKET_NUM - 1);
+        buckets_[index].fetch_add(1, std::memory_order_relaxed);
+        times_.fetch_add(1, std::memory_order_relaxed);
+        totalTime_.fetch_add(costTime, std::memory_order_relaxed);
+        uint64_t worstTime = worstTime_.load(std::memory_order_relaxed);
+        while (costTime > worstTime &&
+            !worstTime_.compare_exchange_weak(worstTime, costTime, std::memory_order_relaxed)) {
+        }
+    }
+
+    // Moves the counted values out and restarts the counting.
+    void Take(uint64_t &times, uint64_t &totalTime, uint64_t &worstTime, std::array<uint64_t, BUCKET_NUM> &buckets)
+    {
+        times = times_.exchange(0, std::memory_order_relaxed);
+        totalTime = totalTime_.exchange(0, std::memory_order_relaxed);
+        worstTime = worstTime_.exchange(0, std::memory_order_relaxed);
+        for (int i = 0; i < BUCKET_NUM; i++) {
+            buckets[i] = buckets_[i].exchange(0, std::memory_order_relaxed);
+        }
+    }
+
+    std::string Dump() const
+    {
+        uint64_t times = times_.load(std::memory_order_relaxed);
+        uint64_t average = (times == 0) ? 0 : (totalTime_.load(std::memory_order_relaxed) / times);
+        std::string dump = "times=" + std::to_string(times) + " average=" + std::to_string(average) +
+            " worst=" + std::to_string(worstTime_.load(std::memory_order_relaxed)) + " histogram=";
+        for (int i = 0; i < BUCKET_NUM; i++) {
+            dump.append((i == 0) ? "" : ",").append(std::to_string(buckets_[i].load(std::memory_order_relaxed)));
+        }
+        return dump;
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKET_NUM> buckets_ {};
+    std::atomic<uint64_t> times_ {0};
+    std::atomic<uint64_t> totalTime_ {0};
+    std::atomic<uint64_t> worstTime_ {0};
+};
+
+// The slots of the statistic, striped by the hash of the key so that the reporters seldom wait for each other.
+// The reporters count on the slot with the atomics within the shared lock of the stripe, only a new key takes the
+// exclusive lock. The slots idle in the whole period are evicted by Drain, and each stripe holds at most
+// MAX_SLOT_NUM slots, the reports of the new keys over it are dropped until the next drain.
+// Slot should provide: Slot(const Stat &stat, int code), static size_t Hash(const Stat &stat),
+// bool IsSame(const Stat &stat) const.
+template<typename Slot>
+class StatisticTable {
+public:
+    static constexpr size_t MAX_SLOT_NUM = 256;
+
+    // The action counts on the slot of the stat, it should not access the same table.
+    template<typename Stat, typename Action>
+    bool Update(const Stat &stat, int code, const Action &action)
+    {
+        size_t hash = Slot::Hash(stat);
+        Stripe &stripe = stripes_[hash % STRIPE_NUM];
+        {
+            std::shared_lock<std::shared_mutex> lock(stripe.mutex);
+            Slot *slot = Find(stripe, hash, stat);
+            if (slot != nullptr) {
+                action(*slot);
+                return true;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(stripe.mutex);
+        Slot *slot = Find(stripe, hash, stat);
+        if (slot == nullptr) {
+            if (stripe.slots.size() >= MAX_SLOT_NUM) {
+                return false;
+            }
+            slot = stripe.slots.emplace(hash, std::make_unique<Slot>(stat, code))->second.get();
+        }
+        action(*slot);
+        return true;
+    }
+
+    // The action is called within the shared lock of the stripe, it should not update the same table.
+    template<typename Action>
+    void ForEach(const Action &action)
+    {
+        for (auto &stripe : stripes_) {
+            std::shared_lock<std::shared_mutex> lock(stripe.mutex);
+            for (auto &[hash, slot] : stripe.slots) {
+                action(*slot);
+            }
+        }
+    }
+
+    // The action takes the counted values out of the slot and returns false if nothing was counted, then the slot
+    // is evicted. It is called within the exclusive lock of the stripe, it should not update the same table.
+    template<typename Action>
+    void Drain(const Action &action)
+    {
+        for (auto &stripe : stripes_) {
+            std::unique_lock<std::shared_mutex> lock(stripe.mutex);
+            for (auto it = stripe.slots.begin(); it != stripe.slots.end();) {
+                it = action(*it->second) ? std::next(it) : stripe.slots.erase(it);
+            }
+        }
+    }
+
+private:
+    static constexpr size_t STRIPE_NUM = 16;
+    struct Stripe {
+        std::shared_mutex mutex;
+        std::unordered_multimap<size_t, std::unique_ptr<Slot>> slots;
+    };
+
+    template<typename Stat>
+    static Slot *Find(Stripe &stripe, size_t hash, const Stat &stat)
+    {
+        auto range = stripe.slots.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second->IsSame(stat)) {
+                return it->second.get();
+            }
+        }
+        return nullptr;
+    }
+
+    std::array<Stripe, STRIPE_NUM> stripes_;
+};
+
+inline size_t CombineHash(size_t seed, size_t hash)
+{
+    constexpr size_t goldenRatio = 0x9e3779b9;
+    constexpr int leftShift = 6;
+    constexpr int rightShift = 2;
+    return seed ^ (hash + goldenRatio + (seed << leftShift) + (seed >> rightShift));
+}
+}  // namespace DistributedKv
+}  // namespace OHOS
+#endif // DISTRIBUTEDDATAMGR_STATISTIC_TABLE_H
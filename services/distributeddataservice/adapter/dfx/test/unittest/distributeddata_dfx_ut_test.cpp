@@ -17,6 +17,7 @@
 #include <string>
 #include "reporter.h"
 #include "fake_hiview.h"
+#include "hiview_adapter.h"
 #include "value_hash.h"
 
 using namespace testing::ext;
@@ -261,3 +262,78 @@ HWTEST_F(DistributedataDfxUTTest, Dfx007, TestSize.Level0)
     FakeHivew::Clear();
 }
 
+/**
+  * @tc.name: Dfx008
+  * @tc.desc: count the visit and api performance statistic, then dump them.
+  * @tc.type: statistic
+  * @tc.require: AR000DPVGP SR000DPVGH
+  * @tc.author: liwei
+  */
+HWTEST_F(DistributedataDfxUTTest, Dfx008, TestSize.Level0)
+{
+    /**
+     * @tc.steps:step1. report the visit of one interface 3 times and the api performance 2 times
+     * @tc.expected: step1. Expect report success.
+     */
+    auto vs = Reporter::GetInstance()->VisitStatistic();
+    ASSERT_NE(nullptr, vs);
+    EXPECT_TRUE(vs->Report({"appid008", "Get"}) == ReportStatus::SUCCESS);
+    EXPECT_TRUE(vs->Report({"appid008", "Get", 2}) == ReportStatus::SUCCESS);
+    auto ap = Reporter::GetInstance()->ApiPerformanceStatistic();
+    ASSERT_NE(nullptr, ap);
+    EXPECT_TRUE(ap->Report({"interface008", 3, 3, 3}) == ReportStatus::SUCCESS);
+    EXPECT_TRUE(ap->Report({"interface008", 100, 100, 100}) == ReportStatus::SUCCESS);
+
+    /**
+     * @tc.steps:step2. dump the statistic.
+     * @tc.expected: step2. Expect the visit times counted and the latency in the buckets of 3us and 100us.
+     */
+    std::string dump = HiViewAdapter::DumpStatistic();
+    EXPECT_NE(dump.find("visit appid008 Get times=3\n"), std::string::npos);
+    EXPECT_NE(dump.find("api interface008 times=2 average=51 worst=100 histogram=0,0,1,0,0,0,0,1,0"),
+        std::string::npos);
+}
+
+/**
+  * @tc.name: Dfx009
+  * @tc.desc: the statistic table evicts the idle slots when drained and bounds the slots of the new keys.
+  * @tc.type: statistic
+  * @tc.require: AR000DPVGP SR000DPVGH
+  * @tc.author: liwei
+  */
+HWTEST_F(DistributedataDfxUTTest, Dfx009, TestSize.Level0)
+{
+    /**
+     * @tc.steps:step1. count on 2 keys, then drain the table twice with only one key counted between.
+     * @tc.expected: step1. Expect the key not counted in the last period evicted.
+     */
+    StatisticTable<VisitSlot> table;
+    auto count = [](VisitSlot &slot) { slot.times.fetch_add(1, std::memory_order_relaxed); };
+    auto take = [](VisitSlot &slot) { return slot.times.exchange(0, std::memory_order_relaxed) != 0; };
+    EXPECT_TRUE(table.Update(VisitStat{"appid009", "Get"}, 0, count));
+    EXPECT_TRUE(table.Update(VisitStat{"appid009", "Put"}, 0, count));
+    table.Drain(take);
+    EXPECT_TRUE(table.Update(VisitStat{"appid009", "Get"}, 0, count));
+    table.Drain(take);
+    size_t slotNum = 0;
+    table.ForEach([&slotNum](VisitSlot &slot) {
+        EXPECT_EQ(slot.val.interfaceName, "Get");
+        slotNum++;
+    });
+    EXPECT_EQ(slotNum, 1);
+
+    /**
+     * @tc.steps:step2. count on more keys than the table could hold, then drain the table.
+     * @tc.expected: step2. Expect the keys over the limit dropped, and the slots released by the drain.
+     */
+    size_t dropped = 0;
+    for (size_t i = 0; i < StatisticTable<VisitSlot>::MAX_SLOT_NUM * 32; i++) { // 32 is more than the stripes
+        dropped += table.Update(VisitStat{"appid009", std::to_string(i)}, 0, count) ? 0 : 1;
+    }
+    EXPECT_GT(dropped, 0);
+    table.Drain(take);
+    table.Drain(take);
+    slotNum = 0;
+    table.ForEach([&slotNum](VisitSlot &slot) { slotNum++; });
+    EXPECT_EQ(slotNum, 0);
+}
@@ -82,6 +82,7 @@ struct FaultMsg {
 struct VisitStat {
     std::string appId;
     std::string interfaceName;
+    int times = 1; // the visits counted by the caller
     KVSTORE_API std::string GetKey() const
     {
         return appId + interfaceName;
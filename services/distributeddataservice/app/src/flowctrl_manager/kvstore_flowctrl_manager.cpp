@@ -16,59 +16,146 @@
 #define LOG_TAG "KvStoreFlowCtrlManager"
 
 #include "kvstore_flowctrl_manager.h"
+#include <chrono>
 #include <cinttypes>
-#include <sys/time.h>
 
 namespace OHOS {
 namespace DistributedKv {
-const int SECOND_TO_MICROSECOND = 1000;
-uint64_t CurrentTimeMicros()
+std::mutex KvStoreFlowCtrlManager::sharedMutex_;
+std::map<int32_t, std::weak_ptr<KvStoreFlowCtrlManager>> KvStoreFlowCtrlManager::sharedFlowCtrls_;
+
+// monotonic milliseconds, never goes back when the wall clock is changed.
+static uint64_t CurrentTimeMillis()
 {
-    struct timeval tv = { 0, 0 };
-    gettimeofday(&tv, nullptr);
-    return (tv.tv_sec * SECOND_TO_MICROSECOND + tv.tv_usec / SECOND_TO_MICROSECOND);
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    // 0 is reserved for the bucket never refreshed.
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now).count()) + 1;
 }
 
-KvStoreFlowCtrlManager::KvStoreFlowCtrlManager(const int burstCapacity, const int sustainedCapacity)
+TokenBucket::TokenBucket(int maxCapacity, uint64_t refreshTimeGap)
+    : maxCapacity_(maxCapacity), refreshTimeGap_(refreshTimeGap)
+{
+}
+
+bool TokenBucket::TryAcquire(uint64_t timestamp)
+{
+    uint64_t current = state_.load(std::memory_order_relaxed);
+    while (true) {
+        uint64_t refreshTime = current >> USED_BITS;
+        uint64_t used = current & USED_MASK;
+        // the first time to get token will be allowed;
+        // if the gap between this time to get token and the least time to fill the bucket
+        // to the full is larger than the refresh time gap, the bucket will be refreshed;
+        if (refreshTime == 0 || (timestamp > refreshTime && timestamp - refreshTime > refreshTimeGap_)) {
+            refreshTime = timestamp;
+            used = 0;
+        }
+        if (used >= static_cast<uint64_t>(maxCapacity_.load(std::memory_order_relaxed))) {
+            return false;
+        }
+        uint64_t next = (refreshTime << USED_BITS) | (used + 1);
+        if (state_.compare_exchange_weak(current, next, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+}
+
+void TokenBucket::Release(uint64_t timestamp)
 {
-    burstTokenBucket_.maxCapacity = burstCapacity;
-    burstTokenBucket_.refreshTimeGap = BURST_REFRESH_TIME;
-    sustainedTokenBucket_.maxCapacity = sustainedCapacity;
-    sustainedTokenBucket_.refreshTimeGap = SUSTAINED_REFRESH_TIME;
+    uint64_t current = state_.load(std::memory_order_relaxed);
+    while ((current & USED_MASK) != 0 && (current >> USED_BITS) <= timestamp) {
+        if (state_.compare_exchange_weak(current, current - 1, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            return;
+        }
+    }
 }
 
-void KvStoreFlowCtrlManager::RefreshTokenBucket(TokenBucket &tokenBucket, uint64_t timestamp)
+void TokenBucket::SetCapacity(int maxCapacity)
 {
-    tokenBucket.leftNumInTokenBucket = tokenBucket.maxCapacity;
-    tokenBucket.tokenBucketRefreshTime = timestamp;
+    if (maxCapacity < 0) {
+        maxCapacity = 0;
+    }
+    maxCapacity_.store(maxCapacity > MAX_CAPACITY ? MAX_CAPACITY : maxCapacity, std::memory_order_relaxed);
+}
+
+KvStoreFlowCtrlManager::KvStoreFlowCtrlManager(const int burstCapacity, const int sustainedCapacity)
+    : burstTokenBucket_(burstCapacity, BURST_REFRESH_TIME),
+      sustainedTokenBucket_(sustainedCapacity, SUSTAINED_REFRESH_TIME)
+{
+    SetCapacity(burstCapacity, sustainedCapacity);
 }
 
 bool KvStoreFlowCtrlManager::IsTokenEnough()
 {
-    uint64_t curTime = CurrentTimeMicros();
-    if (IsTokenEnoughSlice(burstTokenBucket_, curTime) && IsTokenEnoughSlice(sustainedTokenBucket_, curTime)) {
-        burstTokenBucket_.lastAccessTime = curTime;
-        burstTokenBucket_.leftNumInTokenBucket--;
-
-        sustainedTokenBucket_.lastAccessTime = curTime;
-        sustainedTokenBucket_.leftNumInTokenBucket--;
-        return true;
+    uint64_t curTime = CurrentTimeMillis();
+    if (!TryAcquire(curTime)) {
+        rejectedCount_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    auto sharedFlowCtrl = std::atomic_load(&sharedFlowCtrl_);
+    if (sharedFlowCtrl != nullptr && !sharedFlowCtrl->TryAcquire(curTime)) {
+        Release(curTime);
+        sharedFlowCtrl->rejectedCount_.fetch_add(1, std::memory_order_relaxed);
+        rejectedCount_.fetch_add(1, std::memory_order_relaxed);
+        return false;
     }
-    return false;
+    return true;
 }
 
-bool KvStoreFlowCtrlManager::IsTokenEnoughSlice(TokenBucket &tokenBucket, uint64_t timestamp)
+void KvStoreFlowCtrlManager::SetCapacity(const int burstCapacity, const int sustainedCapacity)
 {
-    // the first time to get token will be allowed;
-    // if the gap between this time to get token and the least time to fill the bucket
-    // to the full is larger than 10ms, this operation will be allowed;
-    if (tokenBucket.tokenBucketRefreshTime == 0 ||
-        timestamp - tokenBucket.tokenBucketRefreshTime > tokenBucket.refreshTimeGap) {
-        RefreshTokenBucket(tokenBucket, timestamp);
-        return true;
-    } else {
-        return tokenBucket.leftNumInTokenBucket >= 1;
+    burstTokenBucket_.SetCapacity(burstCapacity);
+    sustainedTokenBucket_.SetCapacity(sustainedCapacity);
+}
+
+void KvStoreFlowCtrlManager::SetSharedFlowCtrl(std::shared_ptr<KvStoreFlowCtrlManager> sharedFlowCtrl)
+{
+    if (sharedFlowCtrl.get() == this) {
+        return;
+    }
+    std::atomic_store(&sharedFlowCtrl_, std::move(sharedFlowCtrl));
+}
+
+uint64_t KvStoreFlowCtrlManager::GetRejectedCount() const
+{
+    return rejectedCount_.load(std::memory_order_relaxed);
+}
+
+std::shared_ptr<KvStoreFlowCtrlManager> KvStoreFlowCtrlManager::GetSharedFlowCtrl(int32_t uid,
+    const int burstCapacity, const int sustainedCapacity)
+{
+    std::lock_guard<std::mutex> lock(sharedMutex_);
+    for (auto it = sharedFlowCtrls_.begin(); it != sharedFlowCtrls_.end();) {
+        if (it->second.expired()) {
+            it = sharedFlowCtrls_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    auto sharedFlowCtrl = sharedFlowCtrls_[uid].lock();
+    if (sharedFlowCtrl == nullptr) {
+        sharedFlowCtrl = std::make_shared<KvStoreFlowCtrlManager>(burstCapacity, sustainedCapacity);
+        sharedFlowCtrls_[uid] = sharedFlowCtrl;
     }
+    return sharedFlowCtrl;
+}
+
+bool KvStoreFlowCtrlManager::TryAcquire(uint64_t timestamp)
+{
+    if (!burstTokenBucket_.TryAcquire(timestamp)) {
+        return false;
+    }
+    if (!sustainedTokenBucket_.TryAcquire(timestamp)) {
+        burstTokenBucket_.Release(timestamp);
+        return false;
+    }
+    return true;
+}
+
+void KvStoreFlowCtrlManager::Release(uint64_t timestamp)
+{
+    burstTokenBucket_.Release(timestamp);
+    sustainedTokenBucket_.Release(timestamp);
 }
 } // namespace DistributedKv
 } // namespace OHOS
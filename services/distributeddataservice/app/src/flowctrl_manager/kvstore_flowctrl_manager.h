@@ -17,19 +17,36 @@
 #define FOUNDATION_KVSTORE_FLOW_CTRL_MANAGER_H
 
 #include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
 
 namespace OHOS {
 namespace DistributedKv {
-struct TokenBucket {
-    uint64_t tokenBucketRefreshTime = 0; // last time to refresh the bucket
+// The refresh time(high bits) and the used tokens(low bits) are packed in one word, so one CAS updates both of them.
+class TokenBucket {
+public:
+    TokenBucket(int maxCapacity, uint64_t refreshTimeGap);
+
+    ~TokenBucket() = default;
 
-    uint64_t lastAccessTime = 0; // last time to access
+    bool TryAcquire(uint64_t timestamp);
 
-    volatile std::atomic<int> leftNumInTokenBucket {0}; // rest numbers of token in the bucket
+    // give back the token acquired in the same refresh period.
+    void Release(uint64_t timestamp);
 
-    int maxCapacity; // max capacity
+    void SetCapacity(int maxCapacity);
+
+private:
+    static constexpr uint32_t USED_BITS = 24;
+    static constexpr uint64_t USED_MASK = (1ULL << USED_BITS) - 1;
+    static constexpr int MAX_CAPACITY = static_cast<int>(USED_MASK);
 
-    uint64_t refreshTimeGap; // time gap between refreshing
+    std::atomic<uint64_t> state_ {0}; // (last time to refresh the bucket << USED_BITS) | used tokens
+
+    std::atomic<int> maxCapacity_; // max capacity
+
+    uint64_t refreshTimeGap_; // time gap between refreshing, in milliseconds
 };
 
 class KvStoreFlowCtrlManager {
@@ -42,18 +59,38 @@ public:
 
     bool IsTokenEnough();
 
+    // used to apply the configured policy, takes effect from the next refresh period.
+    void SetCapacity(const int burstCapacity, const int sustainedCapacity);
+
+    // the shared flow control is checked after this one, the token is taken from both or neither.
+    void SetSharedFlowCtrl(std::shared_ptr<KvStoreFlowCtrlManager> sharedFlowCtrl);
+
+    uint64_t GetRejectedCount() const;
+
+    // the flow control shared by all the stores of the calling uid, which lives as long as one store holds it.
+    static std::shared_ptr<KvStoreFlowCtrlManager> GetSharedFlowCtrl(int32_t uid, const int burstCapacity,
+        const int sustainedCapacity);
+
     static const int BURST_REFRESH_TIME = 1000;
 
     static const int SUSTAINED_REFRESH_TIME = 60000;
 
 private:
-    void RefreshTokenBucket(TokenBucket &tokenBucket, uint64_t timestamp);
+    bool TryAcquire(uint64_t timestamp);
 
-    bool IsTokenEnoughSlice(TokenBucket &tokenBucket, uint64_t timestamp);
+    void Release(uint64_t timestamp);
 
     TokenBucket burstTokenBucket_; // token bucket to deal with events in a burst
 
     TokenBucket sustainedTokenBucket_; // token bucket to deal with sustained events.
+
+    std::shared_ptr<KvStoreFlowCtrlManager> sharedFlowCtrl_;
+
+    std::atomic<uint64_t> rejectedCount_ {0};
+
+    static std::mutex sharedMutex_;
+
+    static std::map<int32_t, std::weak_ptr<KvStoreFlowCtrlManager>> sharedFlowCtrls_;
 };
 } // namespace DistributedKv
 } // namespace OHOS
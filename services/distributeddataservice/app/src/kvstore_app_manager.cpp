@@ -232,6 +232,7 @@ Status KvStoreAppManager::GetKvStore(const Options &options, const std::string &
         return Status::ERROR;
     }
     kvStore->SetCompatibleIdentify();
+    kvStore->SetFlowCtrlPolicy(uid_);
     auto result = singleStores_[type].emplace(storeId, kvStore);
     if (!result.second) {
         ZLOGE("emplace failed.");
@@ -55,6 +55,7 @@
 #include "user_delegate.h"
 #include "utils/block_integer.h"
 #include "utils/crypto.h"
+#include "utils/startup_orchestrator.h"
 
 namespace OHOS::DistributedKv {
 using json = nlohmann::json;
@@ -92,7 +93,7 @@ KvStoreDataService::~KvStoreDataService()
     deviceAccountMap_.clear();
 }
 
-void KvStoreDataService::Initialize()
+void KvStoreDataService::InitDbProcess()
 {
     ZLOGI("begin.");
 #ifndef UT_TEST
@@ -107,8 +108,10 @@ void KvStoreDataService::Initialize()
     };
     ret = DistributedDB::KvStoreDelegateManager::SetSyncActivationCheckCallback(syncActivationCheck);
     ZLOGI("set sync activation check callback ret:%{public}d.", static_cast<int>(ret));
+}
 
-    InitSecurityAdapter();
+void KvStoreDataService::InitMetaParameter()
+{
     KvStoreMetaManager::GetInstance().InitMetaParameter();
     std::thread th = std::thread([]() {
         if (KvStoreMetaManager::GetInstance().CheckRootKeyExist() == Status::SUCCESS) {
@@ -128,7 +131,10 @@ void KvStoreDataService::Initialize()
         }
     });
     th.detach();
+}
 
+void KvStoreDataService::InitListeners()
+{
     accountEventObserver_ = std::make_shared<KvStoreAccountObserver>(*this);
     AccountDelegate::GetInstance()->Subscribe(accountEventObserver_);
     deviceInnerListener_ = std::make_unique<KvStoreDeviceListener>(*this);
@@ -790,19 +796,7 @@ int KvStoreDataService::Dump(int fd, const std::vector<std::u16string> &args)
 void KvStoreDataService::OnStart()
 {
     ZLOGI("distributeddata service onStart");
-    static constexpr int32_t RETRY_TIMES = 10;
-    static constexpr int32_t RETRY_INTERVAL = 500 * 1000; // unit is ms
-    for (BlockInteger retry(RETRY_INTERVAL); retry < RETRY_TIMES; ++retry) {
-        if (!DeviceKvStoreImpl::GetLocalDeviceId().empty()) {
-            break;
-        }
-        ZLOGE("GetLocalDeviceId failed, retry count:%{public}d", static_cast<int>(retry));
-    }
     Initialize();
-    Bootstrap::GetInstance().LoadComponents();
-    Bootstrap::GetInstance().LoadDirectory();
-    Bootstrap::GetInstance().LoadCheckers();
-    Bootstrap::GetInstance().LoadNetworks();
     auto samgr = SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
     if (samgr != nullptr) {
         ZLOGI("samgr exist.");
@@ -817,6 +811,43 @@ void KvStoreDataService::OnStart()
     StartService();
 }
 
+void KvStoreDataService::Initialize()
+{
+    // The steps not depending on each other run at the same time, the meta store is opened here rather than
+    // when the service starts, so its sqlite open overlaps the other steps. The components are still loaded after
+    // the meta store and the listeners as before, the plugins may rely on them.
+    static constexpr uint32_t STARTUP_WORKERS = 2;
+    // The config is parsed once by the first call without lock, parse it before the steps read it together.
+    ConfigFactory::GetInstance();
+    StartupOrchestrator orchestrator;
+    orchestrator.AddStep("deviceId", []() {
+        static constexpr int32_t RETRY_TIMES = 10;
+        static constexpr int32_t RETRY_INTERVAL = 500 * 1000; // unit is ms
+        for (BlockInteger retry(RETRY_INTERVAL); retry < RETRY_TIMES; ++retry) {
+            if (!DeviceKvStoreImpl::GetLocalDeviceId().empty()) {
+                break;
+            }
+            ZLOGE("GetLocalDeviceId failed, retry count:%{public}d", static_cast<int>(retry));
+        }
+    });
+    orchestrator.AddStep("dbProcess", [this]() { InitDbProcess(); }, { "deviceId" });
+    orchestrator.AddStep("security", [this]() { InitSecurityAdapter(); }, { "dbProcess" });
+    orchestrator.AddStep("metaParameter", [this]() { InitMetaParameter(); });
+    orchestrator.AddStep("metaStore", []() { KvStoreMetaManager::GetInstance().InitMetaStore(); },
+        { "dbProcess", "security", "metaParameter" });
+    orchestrator.AddStep("listeners", [this]() { InitListeners(); }, { "security" });
+    orchestrator.AddStep("components", []() { Bootstrap::GetInstance().LoadComponents(); },
+        { "metaStore", "listeners" });
+    orchestrator.AddStep("directory", []() { Bootstrap::GetInstance().LoadDirectory(); });
+    orchestrator.AddStep("checkers", []() { Bootstrap::GetInstance().LoadCheckers(); }, { "components" });
+    orchestrator.AddStep("networks", []() { Bootstrap::GetInstance().LoadNetworks(); }, { "components" });
+    if (!orchestrator.Run(STARTUP_WORKERS)) {
+        ZLOGE("run the startup steps failed.");
+        return;
+    }
+    ZLOGI("startup timeline:\n%{public}s", orchestrator.DumpTimeline().c_str());
+}
+
 void KvStoreDataService::StartService()
 {
     // register this to ServiceManager.
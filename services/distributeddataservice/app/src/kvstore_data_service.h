@@ -138,6 +138,12 @@ private:
 
     void Initialize();
 
+    void InitDbProcess();
+
+    void InitMetaParameter();
+
+    void InitListeners();
+
     void StartService();
 
     void InitSecurityAdapter();
@@ -164,6 +164,12 @@ void KvStoreMetaManager::InitMetaParameter()
     vecAad_ = std::vector<uint8_t>(HKS_BLOB_TYPE_AAD, HKS_BLOB_TYPE_AAD + strlen(HKS_BLOB_TYPE_AAD));
 }
 
+void KvStoreMetaManager::InitMetaStore()
+{
+    auto metaDelegate = GetMetaKvStore();
+    ZLOGI("open meta store %{public}s.", (metaDelegate == nullptr) ? "failed" : "success");
+}
+
 KvStoreMetaManager::NbDelegate KvStoreMetaManager::GetMetaKvStore()
 {
     if (metaDelegate_ != nullptr) {
@@ -174,6 +174,7 @@ public:
     static KvStoreMetaManager &GetInstance();
 
     void InitMetaParameter();
+    void InitMetaStore();
     void InitMetaListener();
     void SubscribeMeta(const std::string &keyPrefix, const ChangeObserver &observer);
 
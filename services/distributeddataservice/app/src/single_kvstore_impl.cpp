@@ -16,11 +16,13 @@
 #define LOG_TAG "SingleKvStoreImpl"
 
 #include "single_kvstore_impl.h"
+#include <cinttypes>
 #include <fstream>
 #include "account_delegate.h"
 #include "auth_delegate.h"
 #include "backup_handler.h"
 #include "checker/checker_manager.h"
+#include "config_factory.h"
 #include "constant.h"
 #include "dds_trace.h"
 #include "device_kvstore_impl.h"
@@ -35,6 +37,23 @@
 
 namespace OHOS::DistributedKv {
 using namespace OHOS::DistributedData;
+// the trace labels and the interface names of the data path, built once rather than on every call.
+static const std::string TRACE_PUT = LOG_TAG "::Put";
+static const std::string TRACE_DELEGATE_PUT = LOG_TAG "Delegate::Put";
+static const std::string TRACE_DELETE = LOG_TAG "::Delete";
+static const std::string TRACE_DELEGATE_DELETE = LOG_TAG "Delegate::Delete";
+static const std::string TRACE_GET = LOG_TAG "::Get";
+static const std::string TRACE_DELEGATE_GET = LOG_TAG "Delegate::Get";
+static const std::string TRACE_GET_ENTRIES = LOG_TAG "::GetEntries";
+static const std::string TRACE_DELEGATE_GET_ENTRIES = LOG_TAG "Delegate::GetEntries";
+static const std::string TRACE_PUT_BATCH = LOG_TAG "::PutBatch";
+static const std::string TRACE_DELEGATE_PUT_BATCH = LOG_TAG "Delegate::PutBatch";
+static const std::string TRACE_DELETE_BATCH = LOG_TAG "::DeleteBatch";
+static const std::string TRACE_DELEGATE_DELETE_BATCH = LOG_TAG "Delegate::DeleteBatch";
+static const std::string INTERFACE_GET = "Get";
+static const std::string INTERFACE_PUT_BATCH = "PutBatch";
+static const std::string INTERFACE_DELETE_BATCH = "DeleteBatch";
+
 static bool TaskIsBackground(pid_t pid)
 {
     std::ifstream ifs("/proc/" + std::to_string(pid) + "/cgroup", std::ios::in);
@@ -62,6 +81,9 @@ static bool TaskIsBackground(pid_t pid)
 SingleKvStoreImpl::~SingleKvStoreImpl()
 {
     RemoveAllSyncOperation();
+    ReportVisit(getVisits_, INTERFACE_GET, true);
+    ReportVisit(putBatchVisits_, INTERFACE_PUT_BATCH, true);
+    ReportVisit(deleteBatchVisits_, INTERFACE_DELETE_BATCH, true);
     ZLOGI("destructor");
 }
 
@@ -81,9 +103,9 @@ Status SingleKvStoreImpl::Put(const Key &key, const Value &value)
         ZLOGE("flow control denied");
         return Status::EXCEED_MAX_ACCESS_RATE;
     }
-    DdsTrace trace(std::string(LOG_TAG "::") + std::string(__FUNCTION__));
+    DdsTrace trace(TRACE_PUT);
 
-    auto trimmedKey = Constant::TrimCopy<std::vector<uint8_t>>(key.Data());
+    DistributedDB::Key trimmedKey = Constant::TrimCopy<std::vector<uint8_t>>(key.Data());
     // Restrict key and value size to interface specification.
     if (trimmedKey.size() == 0 || trimmedKey.size() > Constant::MAX_KEY_LENGTH ||
         value.Size() > Constant::MAX_VALUE_LENGTH) {
@@ -95,12 +117,10 @@ Status SingleKvStoreImpl::Put(const Key &key, const Value &value)
         ZLOGE("kvstore is not open");
         return Status::ILLEGAL_STATE;
     }
-    DistributedDB::Key tmpKey = trimmedKey;
-    DistributedDB::Value tmpValue = value.Data();
     DistributedDB::DBStatus status;
     {
-        DdsTrace trace(std::string(LOG_TAG "Delegate::") + std::string(__FUNCTION__));
-        status = kvStoreNbDelegate_->Put(tmpKey, tmpValue);
+        DdsTrace trace(TRACE_DELEGATE_PUT);
+        status = kvStoreNbDelegate_->Put(trimmedKey, value.Data());
     }
     if (status == DistributedDB::DBStatus::OK) {
         ZLOGD("succeed.");
@@ -116,6 +136,18 @@ Status SingleKvStoreImpl::Put(const Key &key, const Value &value)
     return ConvertDbStatus(status);
 }
 
+void SingleKvStoreImpl::ReportVisit(std::atomic_uint32_t &visits, const std::string &interfaceName, bool flush)
+{
+    if (!flush && visits.fetch_add(1, std::memory_order_relaxed) + 1 < VISIT_REPORT_BATCH) {
+        return;
+    }
+    uint32_t times = visits.exchange(0, std::memory_order_relaxed);
+    if (times == 0) {
+        return;
+    }
+    Reporter::GetInstance()->VisitStatistic()->Report({bundleName_, interfaceName, static_cast<int>(times)});
+}
+
 Status SingleKvStoreImpl::ConvertDbStatus(DistributedDB::DBStatus status)
 {
     switch (status) {
@@ -157,12 +189,12 @@ Status SingleKvStoreImpl::ConvertDbStatus(DistributedDB::DBStatus status)
 
 Status SingleKvStoreImpl::Delete(const Key &key)
 {
-    DdsTrace trace(std::string(LOG_TAG "::") + std::string(__FUNCTION__));
+    DdsTrace trace(TRACE_DELETE);
     if (!flowCtrl_.IsTokenEnough()) {
         ZLOGE("flow control denied");
         return Status::EXCEED_MAX_ACCESS_RATE;
     }
-    auto trimmedKey = DistributedKv::Constant::TrimCopy<std::vector<uint8_t>>(key.Data());
+    DistributedDB::Key trimmedKey = DistributedKv::Constant::TrimCopy<std::vector<uint8_t>>(key.Data());
     if (trimmedKey.size() == 0 || trimmedKey.size() > Constant::MAX_KEY_LENGTH) {
         ZLOGW("invalid argument.");
         return Status::INVALID_ARGUMENT;
@@ -172,11 +204,10 @@ Status SingleKvStoreImpl::Delete(const Key &key)
         ZLOGE("kvstore is not open");
         return Status::ILLEGAL_STATE;
     }
-    DistributedDB::Key tmpKey = trimmedKey;
     DistributedDB::DBStatus status;
     {
-        DdsTrace trace(std::string(LOG_TAG "Delegate::") + std::string(__FUNCTION__));
-        status = kvStoreNbDelegate_->Delete(tmpKey);
+        DdsTrace trace(TRACE_DELEGATE_DELETE);
+        status = kvStoreNbDelegate_->Delete(trimmedKey);
     }
     if (status == DistributedDB::DBStatus::OK) {
         ZLOGD("succeed.");
@@ -192,12 +223,12 @@ Status SingleKvStoreImpl::Delete(const Key &key)
 
 Status SingleKvStoreImpl::Get(const Key &key, Value &value)
 {
-    DdsTrace trace(std::string(LOG_TAG "::") + std::string(__FUNCTION__));
+    DdsTrace trace(TRACE_GET);
     if (!flowCtrl_.IsTokenEnough()) {
         ZLOGE("flow control denied");
         return Status::EXCEED_MAX_ACCESS_RATE;
     }
-    auto trimmedKey = DistributedKv::Constant::TrimCopy<std::vector<uint8_t>>(key.Data());
+    DistributedDB::Key trimmedKey = DistributedKv::Constant::TrimCopy<std::vector<uint8_t>>(key.Data());
     if (trimmedKey.empty() || trimmedKey.size() > DistributedKv::Constant::MAX_KEY_LENGTH) {
         return Status::INVALID_ARGUMENT;
     }
@@ -206,19 +237,17 @@ Status SingleKvStoreImpl::Get(const Key &key, Value &value)
         ZLOGE("kvstore is not open");
         return Status::ILLEGAL_STATE;
     }
-    DistributedDB::Key tmpKey = trimmedKey;
     DistributedDB::Value tmpValue;
     DistributedDB::DBStatus status;
     {
-        DdsTrace trace(std::string(LOG_TAG "Delegate::") + std::string(__FUNCTION__));
-        status = kvStoreNbDelegate_->Get(tmpKey, tmpValue);
+        DdsTrace trace(TRACE_DELEGATE_GET);
+        status = kvStoreNbDelegate_->Get(trimmedKey, tmpValue);
     }
     ZLOGD("status: %d.", static_cast<int>(status));
     if (status == DistributedDB::DBStatus::OK) {
-        Reporter::GetInstance()->VisitStatistic()->Report({bundleName_, __FUNCTION__});
-        // Value don't have other write method.
-        Value tmpValueForCopy(tmpValue);
-        value = tmpValueForCopy;
+        ReportVisit(getVisits_, INTERFACE_GET);
+        // hand the buffer over to the Value, the data is not copied.
+        value = Value(std::move(tmpValue));
         return Status::SUCCESS;
     }
     if (status == DistributedDB::DBStatus::INVALID_PASSWD_OR_CORRUPTED_DB) {
@@ -362,12 +391,12 @@ Status SingleKvStoreImpl::UnSubscribeKvStore(const SubscribeType subscribeType,
 
 Status SingleKvStoreImpl::GetEntries(const Key &prefixKey, std::vector<Entry> &entries)
 {
-    DdsTrace trace(std::string(LOG_TAG "::") + std::string(__FUNCTION__));
+    DdsTrace trace(TRACE_GET_ENTRIES);
     if (!flowCtrl_.IsTokenEnough()) {
         ZLOGE("flow control denied");
         return Status::EXCEED_MAX_ACCESS_RATE;
     }
-    auto trimmedPrefix = Constant::TrimCopy<std::vector<uint8_t>>(prefixKey.Data());
+    DistributedDB::Key trimmedPrefix = Constant::TrimCopy<std::vector<uint8_t>>(prefixKey.Data());
     if (trimmedPrefix.size() > Constant::MAX_KEY_LENGTH) {
         return Status::INVALID_ARGUMENT;
     }
@@ -376,24 +405,20 @@ Status SingleKvStoreImpl::GetEntries(const Key &prefixKey, std::vector<Entry> &e
         ZLOGE("kvstore is not open");
         return Status::ILLEGAL_STATE;
     }
-    DistributedDB::Key tmpKeyPrefix = trimmedPrefix;
     std::vector<DistributedDB::Entry> dbEntries;
     DistributedDB::DBStatus status;
     {
-        DdsTrace trace(std::string(LOG_TAG "Delegate::") + std::string(__FUNCTION__));
-        status = kvStoreNbDelegate_->GetEntries(tmpKeyPrefix, dbEntries);
+        DdsTrace trace(TRACE_DELEGATE_GET_ENTRIES);
+        status = kvStoreNbDelegate_->GetEntries(trimmedPrefix, dbEntries);
     }
     ZLOGI("result DBStatus: %d", static_cast<int>(status));
     if (status == DistributedDB::DBStatus::OK) {
-        entries.reserve(dbEntries.size());
+        entries.reserve(entries.size() + dbEntries.size());
         ZLOGD("vector size: %zu status: %d.", dbEntries.size(), static_cast<int>(status));
-        for (auto const &dbEntry : dbEntries) {
-            Key tmpKey(dbEntry.key);
-            Value tmpValue(dbEntry.value);
-            Entry entry;
-            entry.key = tmpKey;
-            entry.value = tmpValue;
-            entries.push_back(entry);
+        for (auto &dbEntry : dbEntries) {
+            Entry &entry = entries.emplace_back();
+            entry.key = Key(std::move(dbEntry.key));
+            entry.value = Value(std::move(dbEntry.value));
         }
         return Status::SUCCESS;
     }
@@ -1254,7 +1279,7 @@ Status SingleKvStoreImpl::UnRegisterSyncCallback()
 
 Status SingleKvStoreImpl::PutBatch(const std::vector<Entry> &entries)
 {
-    DdsTrace trace(std::string(LOG_TAG "::") + std::string(__FUNCTION__));
+    DdsTrace trace(TRACE_PUT_BATCH);
 
     std::shared_lock<std::shared_mutex> lock(storeNbDelegateMutex_);
     if (kvStoreNbDelegate_ == nullptr) {
@@ -1268,22 +1293,19 @@ Status SingleKvStoreImpl::PutBatch(const std::vector<Entry> &entries)
 
     // temporary transform.
     std::vector<DistributedDB::Entry> dbEntries;
+    dbEntries.reserve(entries.size());
     for (auto &entry : entries) {
-        DistributedDB::Entry dbEntry;
-
-        std::vector<uint8_t> keyData = Constant::TrimCopy<std::vector<uint8_t>>(entry.key.Data());
-        if (keyData.size() == 0 || keyData.size() > Constant::MAX_KEY_LENGTH) {
+        DistributedDB::Entry &dbEntry = dbEntries.emplace_back();
+        dbEntry.key = Constant::TrimCopy<std::vector<uint8_t>>(entry.key.Data());
+        if (dbEntry.key.size() == 0 || dbEntry.key.size() > Constant::MAX_KEY_LENGTH) {
             ZLOGE("invalid key.");
             return Status::INVALID_ARGUMENT;
         }
-
-        dbEntry.key = keyData;
         dbEntry.value = entry.value.Data();
-        dbEntries.push_back(dbEntry);
     }
     DistributedDB::DBStatus status;
     {
-        DdsTrace trace(std::string(LOG_TAG "Delegate::") + std::string(__FUNCTION__));
+        DdsTrace trace(TRACE_DELEGATE_PUT_BATCH);
         status = kvStoreNbDelegate_->PutBatch(dbEntries);
     }
     if (status == DistributedDB::DBStatus::INVALID_PASSWD_OR_CORRUPTED_DB) {
@@ -1302,13 +1324,13 @@ Status SingleKvStoreImpl::PutBatch(const std::vector<Entry> &entries)
         return Status::DB_ERROR;
     }
 
-    Reporter::GetInstance()->VisitStatistic()->Report({bundleName_, __FUNCTION__});
+    ReportVisit(putBatchVisits_, INTERFACE_PUT_BATCH);
     return Status::SUCCESS;
 }
 
 Status SingleKvStoreImpl::DeleteBatch(const std::vector<Key> &keys)
 {
-    DdsTrace trace(std::string(LOG_TAG "::") + std::string(__FUNCTION__));
+    DdsTrace trace(TRACE_DELETE_BATCH);
 
     std::shared_lock<std::shared_mutex> lock(storeNbDelegateMutex_);
     if (kvStoreNbDelegate_ == nullptr) {
@@ -1322,19 +1344,18 @@ Status SingleKvStoreImpl::DeleteBatch(const std::vector<Key> &keys)
 
     // temporary transform.
     std::vector<DistributedDB::Key> dbKeys;
+    dbKeys.reserve(keys.size());
     for (auto &key : keys) {
         std::vector<uint8_t> keyData = Constant::TrimCopy<std::vector<uint8_t>>(key.Data());
         if (keyData.size() == 0 || keyData.size() > Constant::MAX_KEY_LENGTH) {
             ZLOGE("invalid key.");
             return Status::INVALID_ARGUMENT;
         }
-
-        DistributedDB::Key keyTmp = keyData;
-        dbKeys.push_back(keyTmp);
+        dbKeys.push_back(std::move(keyData));
     }
     DistributedDB::DBStatus status;
     {
-        DdsTrace trace(std::string(LOG_TAG "Delegate::") + std::string(__FUNCTION__));
+        DdsTrace trace(TRACE_DELEGATE_DELETE_BATCH);
         status = kvStoreNbDelegate_->DeleteBatch(dbKeys);
     }
     if (status == DistributedDB::DBStatus::INVALID_PASSWD_OR_CORRUPTED_DB) {
@@ -1353,7 +1374,7 @@ Status SingleKvStoreImpl::DeleteBatch(const std::vector<Key> &keys)
         return Status::DB_ERROR;
     }
 
-    Reporter::GetInstance()->VisitStatistic()->Report({bundleName_, __FUNCTION__});
+    ReportVisit(deleteBatchVisits_, INTERFACE_DELETE_BATCH);
     return Status::SUCCESS;
 }
 
@@ -1598,6 +1619,7 @@ void SingleKvStoreImpl::OnDump(int fd) const
     dprintf(fd, "%s------------------------------------------------------\n", prefix.c_str());
     dprintf(fd, "%sStoreID    : %s\n", prefix.c_str(), storeId_.c_str());
     dprintf(fd, "%sStorePath  : %s\n", prefix.c_str(), storePath_.c_str());
+    dprintf(fd, "%sRejected   : %" PRIu64 "\n", prefix.c_str(), flowCtrl_.GetRejectedCount());
 
     dprintf(fd, "%sOptions :\n", prefix.c_str());
     dprintf(fd, "%s    backup          : %d\n", prefix.c_str(), static_cast<int>(options_.backup));
@@ -1644,4 +1666,25 @@ void SingleKvStoreImpl::SetCompatibleIdentify()
     UpgradeManager::SetCompatibleIdentifyByType(kvStoreNbDelegate_, tuple, IDENTICAL_ACCOUNT_GROUP);
     UpgradeManager::SetCompatibleIdentifyByType(kvStoreNbDelegate_, tuple, PEER_TO_PEER_GROUP);
 }
+
+void SingleKvStoreImpl::SetFlowCtrlPolicy(int32_t uid)
+{
+    auto *config = ConfigFactory::GetInstance().GetFlowControlConfig();
+    if (config == nullptr) {
+        return;
+    }
+    auto *policy = config->GetPolicy(bundleName_, storeId_);
+    if (policy == nullptr) {
+        return;
+    }
+    if (policy->burstCapacity > 0 && policy->sustainedCapacity > 0) {
+        flowCtrl_.SetCapacity(policy->burstCapacity, policy->sustainedCapacity);
+    }
+    if (policy->sharedByUid && config->uidBurstCapacity > 0 && config->uidSustainedCapacity > 0) {
+        flowCtrl_.SetSharedFlowCtrl(KvStoreFlowCtrlManager::GetSharedFlowCtrl(uid, config->uidBurstCapacity,
+            config->uidSustainedCapacity));
+    }
+    ZLOGI("flow control of %{public}s burst:%{public}d sustained:%{public}d shared:%{public}d", storeId_.c_str(),
+        policy->burstCapacity, policy->sustainedCapacity, policy->sharedByUid);
+}
 }  // namespace OHOS::DistributedKv
@@ -79,6 +79,7 @@ public:
     void OnDump(int fd) const;
     void SetCompatibleIdentify(const std::string &changedDevice);
     void SetCompatibleIdentify();
+    void SetFlowCtrlPolicy(int32_t uid);
 
 protected:
     virtual KvStoreObserverImpl *CreateObserver(const SubscribeType subscribeType, sptr<IKvStoreObserver> observer);
@@ -87,6 +88,8 @@ protected:
 
 private:
     Status ConvertDbStatus(DistributedDB::DBStatus dbStatus);
+    // count the visit of the interface, the visits are reported in batch of VISIT_REPORT_BATCH or when flush.
+    void ReportVisit(std::atomic_uint32_t &visits, const std::string &interfaceName, bool flush = false);
     uint32_t GetSyncDelayTime(uint32_t allowedDelayMs) const;
     Status AddSync(const std::vector<std::string> &deviceIds, SyncMode mode, uint32_t delayMs,
                    uint64_t sequenceId);
@@ -157,6 +160,12 @@ private:
     KvStoreFlowCtrlManager flowCtrl_;
     static constexpr int BURST_CAPACITY = 1000;
     static constexpr int SUSTAINED_CAPACITY = 10000;
+
+    // the visits of the frequently called interfaces not reported yet.
+    static constexpr uint32_t VISIT_REPORT_BATCH = 64;
+    std::atomic_uint32_t getVisits_{ 0 };
+    std::atomic_uint32_t putBatchVisits_{ 0 };
+    std::atomic_uint32_t deleteBatchVisits_{ 0 };
 };
 }  // namespace OHOS::DistributedKv
 #endif  // SINGLE_KVSTORE_IMPL_H
@@ -18,6 +18,7 @@
 #include "flowctrl_manager/kvstore_flowctrl_manager.h"
 #include <memory>
 #include <thread>
+#include <vector>
 #include "time_utils.h"
 
 using namespace testing::ext;
@@ -278,3 +279,72 @@ HWTEST_F(KvStoreFlowCtrlManagerTest, KvStoreFlowCtrlManagerTest012, TestSize.Lev
     EXPECT_EQ(500, arr[1]);
 }
 
+/**
+* @tc.name: KvStoreFlowCtrlManagerTest013
+* @tc.desc: concurrent callers never take more tokens than the burst capacity
+* @tc.type: FUNC
+* @tc.require:
+* @tc.author: jishengwu
+*/
+HWTEST_F(KvStoreFlowCtrlManagerTest, KvStoreFlowCtrlManagerTest013, TestSize.Level1)
+{
+    auto ptr = std::make_shared<KvStoreFlowCtrlManager>(OPERATION_BURST_CAPACITY, OPERATION_SUSTAINED_CAPACITY);
+    std::atomic<int> allowed = 0;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([&ptr, &allowed]() {
+            for (int j = 0; j < 500; j++) {
+                allowed += ptr->IsTokenEnough() ? 1 : 0;
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(OPERATION_BURST_CAPACITY, allowed);
+    EXPECT_EQ(1000, ptr->GetRejectedCount());
+}
+
+/**
+* @tc.name: KvStoreFlowCtrlManagerTest014
+* @tc.desc: the stores of the same uid share the uid flow control
+* @tc.type: FUNC
+* @tc.require:
+* @tc.author: jishengwu
+*/
+HWTEST_F(KvStoreFlowCtrlManagerTest, KvStoreFlowCtrlManagerTest014, TestSize.Level1)
+{
+    const int32_t uid = 10000;
+    auto store1 = std::make_shared<KvStoreFlowCtrlManager>(OPERATION_BURST_CAPACITY, OPERATION_SUSTAINED_CAPACITY);
+    auto store2 = std::make_shared<KvStoreFlowCtrlManager>(OPERATION_BURST_CAPACITY, OPERATION_SUSTAINED_CAPACITY);
+    store1->SetSharedFlowCtrl(
+        KvStoreFlowCtrlManager::GetSharedFlowCtrl(uid, MANAGER_BURST_CAPACITY, MANAGER_SUSTAINED_CAPACITY));
+    store2->SetSharedFlowCtrl(
+        KvStoreFlowCtrlManager::GetSharedFlowCtrl(uid, MANAGER_BURST_CAPACITY, MANAGER_SUSTAINED_CAPACITY));
+    int arr[2] = {0, 0};
+    for (int i = 0; i < MANAGER_BURST_CAPACITY; i++) {
+        arr[store1->IsTokenEnough()]++;
+        arr[store2->IsTokenEnough()]++;
+    }
+    EXPECT_EQ(MANAGER_BURST_CAPACITY, arr[0]);
+    EXPECT_EQ(MANAGER_BURST_CAPACITY, arr[1]);
+}
+
+/**
+* @tc.name: KvStoreFlowCtrlManagerTest015
+* @tc.desc: the configured capacity replaces the default one
+* @tc.type: FUNC
+* @tc.require:
+* @tc.author: jishengwu
+*/
+HWTEST_F(KvStoreFlowCtrlManagerTest, KvStoreFlowCtrlManagerTest015, TestSize.Level1)
+{
+    auto ptr = std::make_shared<KvStoreFlowCtrlManager>(OPERATION_BURST_CAPACITY, OPERATION_SUSTAINED_CAPACITY);
+    ptr->SetCapacity(MANAGER_BURST_CAPACITY, MANAGER_SUSTAINED_CAPACITY);
+    int arr[2] = {0, 0};
+    for (int i = 0; i < 51; i++) {
+        arr[ptr->IsTokenEnough()]++;
+    }
+    EXPECT_EQ(1, arr[0]);
+    EXPECT_EQ(50, arr[1]);
+}
@@ -113,4 +113,36 @@ HWTEST_F(MetaDataManagerTest, MetaBasic_01, TestSize.Level1)
 
     ZLOGI("end");
 }
+
+/**
+* @tc.name: MetaCache_01
+* @tc.desc: the repeated load hits the cache, the save invalidates it
+* @tc.type: FUNC
+* @tc.require:
+* @tc.author: illybyy
+*/
+HWTEST_F(MetaDataManagerTest, MetaCache_01, TestSize.Level1)
+{
+    Student student;
+    student.name = TEST_KEY;
+    student.age = 21;
+    ASSERT_TRUE(MetaDataManager::GetInstance().SaveMeta(student.name, student));
+
+    Student student1;
+    auto before = MetaDataManager::GetInstance().GetCacheStatistic();
+    ASSERT_TRUE(MetaDataManager::GetInstance().LoadMeta(student.name, student1));
+    ASSERT_TRUE(MetaDataManager::GetInstance().LoadMeta(student.name, student1));
+    auto after = MetaDataManager::GetInstance().GetCacheStatistic();
+    EXPECT_EQ(after.misses, before.misses + 1);
+    EXPECT_EQ(after.hits, before.hits + 1);
+    EXPECT_EQ(student1.age, 21);
+
+    student.age = 22;
+    ASSERT_TRUE(MetaDataManager::GetInstance().SaveMeta(student.name, student));
+    ASSERT_TRUE(MetaDataManager::GetInstance().LoadMeta(student.name, student1));
+    EXPECT_EQ(student1.age, 22);
+
+    ASSERT_TRUE(MetaDataManager::GetInstance().DelMeta(student.name));
+    EXPECT_FALSE(MetaDataManager::GetInstance().LoadMeta(student.name, student1));
+}
 } // namespace
\ No newline at end of file
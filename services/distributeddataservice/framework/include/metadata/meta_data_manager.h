@@ -15,11 +15,15 @@
 
 #ifndef OHOS_DISTRIBUTED_DATA_SERVICES_FRAMEWORK_METADATA_META_DATA_MANAGER_H
 #define OHOS_DISTRIBUTED_DATA_SERVICES_FRAMEWORK_METADATA_META_DATA_MANAGER_H
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <typeinfo>
+#include <type_traits>
 
 #include "concurrent_map.h"
+#include "lru_bucket.h"
 #include "serializable/serializable.h"
 namespace DistributedDB {
 class KvStoreNbDelegate;
@@ -49,10 +53,41 @@ public:
     using Syncer = std::function<void(const std::shared_ptr<MetaStore> &, int32_t)>;
     using Backup = std::function<int32_t(const std::shared_ptr<MetaStore> &)>;
     using Bytes = std::vector<uint8_t>;
+    struct CacheStatistic {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        size_t size = 0;
+        size_t capacity = 0;
+    };
+    static constexpr size_t DEFAULT_CACHE_CAPACITY = 256;
     API_EXPORT static MetaDataManager &GetInstance();
     API_EXPORT void Initialize(std::shared_ptr<MetaStore> metaStore, const Backup &backup, const Syncer &syncer);
     API_EXPORT bool SaveMeta(const std::string &key, const Serializable &value, bool isLocal = false);
     API_EXPORT bool LoadMeta(const std::string &key, Serializable &value, bool isLocal = false);
+    // The deserialized object of the sync meta is kept in the cache, the later load of the same type just copies it.
+    template<class T, typename std::enable_if_t<std::is_base_of_v<Serializable, T>, int> = 0>
+    API_EXPORT bool LoadMeta(const std::string &key, T &value, bool isLocal = false)
+    {
+        if (!inited_) {
+            return false;
+        }
+        CacheEntry entry;
+        uint64_t generation = 0;
+        if (!LoadEntry(key, entry, generation, isLocal)) {
+            return false;
+        }
+        if (entry.object != nullptr && entry.type != nullptr && *entry.type == typeid(T)) {
+            value = *std::static_pointer_cast<T>(entry.object);
+            return true;
+        }
+        Serializable::Unmarshall(entry.data, value);
+        if (!isLocal) {
+            entry.object = std::make_shared<T>(value);
+            entry.type = &typeid(T);
+            SaveEntry(key, entry, generation);
+        }
+        return true;
+    }
     template<class T>
     API_EXPORT bool LoadMeta(const std::string &prefix, std::vector<T> &values, bool isLocal = false)
     {
@@ -74,16 +109,34 @@ public:
     API_EXPORT bool Subscribe(std::shared_ptr<Filter> filter, Observer observer);
     API_EXPORT bool Subscribe(std::string prefix, Observer observer);
     API_EXPORT bool Unsubscribe(std::string filter);
+    // capacity 0 disables the meta object cache.
+    API_EXPORT void SetCacheCapacity(size_t capacity);
+    API_EXPORT CacheStatistic GetCacheStatistic() const;
 private:
+    struct CacheEntry {
+        std::string data;
+        std::shared_ptr<void> object;
+        const std::type_info *type = nullptr;
+    };
     MetaDataManager();
     ~MetaDataManager();
 
     API_EXPORT bool GetEntries(const std::string &prefix, std::vector<Bytes> &entries, bool isLocal);
+    API_EXPORT bool LoadEntry(const std::string &key, CacheEntry &entry, uint64_t &generation, bool isLocal);
+    API_EXPORT void SaveEntry(const std::string &key, const CacheEntry &entry, uint64_t generation);
+    void Invalidate(const std::string &key);
 
     bool inited_ = false;
     std::mutex mutex_;
     std::shared_ptr<MetaStore> metaStore_;
     ConcurrentMap<std::string, std::shared_ptr<MetaObserver>> metaObservers_;
+    // only the sync meta is cached, the local meta is also written by others without notification.
+    std::mutex cacheMutex_;
+    uint64_t generation_ = 0;
+    LRUBucket<std::string, CacheEntry> cache_ { DEFAULT_CACHE_CAPACITY };
+    std::shared_ptr<MetaObserver> cacheObserver_;
+    std::atomic<uint64_t> hits_ = 0;
+    std::atomic<uint64_t> misses_ = 0;
     Backup backup_;
     Syncer syncer_;
 };
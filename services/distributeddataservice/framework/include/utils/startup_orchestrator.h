@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DISTRIBUTED_DATA_SERVICES_FRAMEWORK_UTILS_STARTUP_ORCHESTRATOR_H
+#define OHOS_DISTRIBUTED_DATA_SERVICES_FRAMEWORK_UTILS_STARTUP_ORCHESTRATOR_H
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+#include "visibility.h"
+namespace OHOS::DistributedData {
+// Runs the init steps of the service by their dependencies. A step starts once all the steps it depends on are done,
+// the independent steps run at the same time on the calling thread and the workers. The begin and end time of each
+// step are kept as the startup timeline.
+class StartupOrchestrator final {
+public:
+    struct Record {
+        std::string name;
+        uint64_t begin = 0; // in microseconds since the run started
+        uint64_t end = 0;
+        uint32_t worker = 0; // 0 is the thread called Run
+    };
+    using Action = std::function<void()>;
+
+    API_EXPORT StartupOrchestrator() = default;
+    API_EXPORT ~StartupOrchestrator() = default;
+
+    // Return false if the name is added already or the action is empty, the dependencies may be added later.
+    API_EXPORT bool AddStep(const std::string &name, Action action, const std::vector<std::string> &dependencies = {});
+
+    // Run all the steps and return when they are done. Nothing is run if a dependency is unknown or in a cycle.
+    API_EXPORT bool Run(uint32_t workers);
+
+    // The records in the order of the begin time.
+    API_EXPORT std::vector<Record> GetTimeline() const;
+
+    // One line of each step, "name begin~end(cost)us worker", to be put in the log.
+    API_EXPORT std::string DumpTimeline() const;
+
+private:
+    struct Step {
+        std::string name;
+        Action action;
+        std::vector<std::string> dependencies;
+    };
+
+    bool BuildGraph(std::vector<std::vector<size_t>> &children, std::vector<size_t> &waits) const;
+
+    std::vector<Step> steps_;
+    std::map<std::string, size_t> indexes_;
+    std::vector<Record> timeline_;
+};
+} // namespace OHOS::DistributedData
+#endif // OHOS_DISTRIBUTED_DATA_SERVICES_FRAMEWORK_UTILS_STARTUP_ORCHESTRATOR_H
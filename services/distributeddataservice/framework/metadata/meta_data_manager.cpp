@@ -101,6 +101,7 @@ MetaDataManager::MetaDataManager() = default;
 MetaDataManager::~MetaDataManager()
 {
     metaObservers_.Clear();
+    cacheObserver_ = nullptr;
 }
 
 void MetaDataManager::Initialize(std::shared_ptr<MetaStore> metaStore, const Backup &backup, const Syncer &syncer)
@@ -116,6 +117,12 @@ void MetaDataManager::Initialize(std::shared_ptr<MetaStore> metaStore, const Bac
     metaStore_ = std::move(metaStore);
     backup_ = backup;
     syncer_ = syncer;
+    // the sync-originated changes of the meta store must drop the cached objects too.
+    cacheObserver_ = std::make_shared<MetaObserver>(metaStore_, std::make_shared<Filter>(""),
+        [this](const std::string &key, const std::string &value, int32_t flag) {
+            Invalidate(key);
+            return true;
+        });
     inited_ = true;
 }
 
@@ -128,6 +135,9 @@ bool MetaDataManager::SaveMeta(const std::string &key, const Serializable &value
     auto data = Serializable::Marshall(value);
     auto status = isLocal ? metaStore_->PutLocal({ key.begin(), key.end() }, { data.begin(), data.end() })
                           : metaStore_->Put({ key.begin(), key.end() }, { data.begin(), data.end() });
+    if (!isLocal) {
+        Invalidate(key);
+    }
     if (status == DistributedDB::DBStatus::OK && backup_) {
         backup_(metaStore_);
     }
@@ -143,16 +153,74 @@ bool MetaDataManager::LoadMeta(const std::string &key, Serializable &value, bool
         return false;
     }
 
+    CacheEntry entry;
+    uint64_t generation = 0;
+    if (!LoadEntry(key, entry, generation, isLocal)) {
+        return false;
+    }
+    Serializable::Unmarshall(entry.data, value);
+    return true;
+}
+
+bool MetaDataManager::LoadEntry(const std::string &key, CacheEntry &entry, uint64_t &generation, bool isLocal)
+{
+    if (!isLocal) {
+        std::lock_guard<decltype(cacheMutex_)> lock(cacheMutex_);
+        generation = generation_;
+        if (cache_.Get(key, entry)) {
+            hits_++;
+            return true;
+        }
+        misses_++;
+    }
+
     DistributedDB::Value data;
     auto status = isLocal ? metaStore_->GetLocal({ key.begin(), key.end() }, data)
                           : metaStore_->Get({ key.begin(), key.end() }, data);
     if (status != DistributedDB::DBStatus::OK) {
         return false;
     }
-    Serializable::Unmarshall({ data.begin(), data.end() }, value);
+    entry.data = { data.begin(), data.end() };
+    if (!isLocal) {
+        SaveEntry(key, entry, generation);
+    }
     return true;
 }
 
+void MetaDataManager::SaveEntry(const std::string &key, const CacheEntry &entry, uint64_t generation)
+{
+    std::lock_guard<decltype(cacheMutex_)> lock(cacheMutex_);
+    // the meta has been changed after it was read, the entry may be stale.
+    if (generation != generation_) {
+        return;
+    }
+    cache_.Set(key, entry);
+}
+
+void MetaDataManager::Invalidate(const std::string &key)
+{
+    std::lock_guard<decltype(cacheMutex_)> lock(cacheMutex_);
+    generation_++;
+    cache_.Delete(key);
+}
+
+void MetaDataManager::SetCacheCapacity(size_t capacity)
+{
+    std::lock_guard<decltype(cacheMutex_)> lock(cacheMutex_);
+    generation_++;
+    cache_.ResetCapacity(capacity);
+}
+
+MetaDataManager::CacheStatistic MetaDataManager::GetCacheStatistic() const
+{
+    CacheStatistic statistic;
+    statistic.hits = hits_;
+    statistic.misses = misses_;
+    statistic.size = cache_.Size();
+    statistic.capacity = cache_.Capacity();
+    return statistic;
+}
+
 bool MetaDataManager::GetEntries(const std::string &prefix, std::vector<Bytes> &entries, bool isLocal)
 {
     std::vector<DistributedDB::Entry> dbEntries;
@@ -174,9 +242,11 @@ bool MetaDataManager::DelMeta(const std::string &key, bool isLocal)
         return false;
     }
 
-    DistributedDB::Value data;
     auto status = isLocal ? metaStore_->DeleteLocal({ key.begin(), key.end() })
                           : metaStore_->Delete({ key.begin(), key.end() });
+    if (!isLocal) {
+        Invalidate(key);
+    }
     if (status == DistributedDB::DBStatus::OK && backup_) {
         backup_(metaStore_);
     }
@@ -0,0 +1,124 @@
+/*
+* Copyright (c) 2022 Huawei Device Co., Ltd.
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "utils/startup_orchestrator.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <gtest/gtest.h>
+using namespace testing::ext;
+using namespace OHOS::DistributedData;
+class StartupOrchestratorTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+    void SetUp() {}
+    void TearDown() {}
+};
+
+/**
+* @tc.name: DependencyOrder
+* @tc.desc: the step runs after all the steps it depends on.
+* @tc.type: FUNC
+* @tc.require:
+* @tc.author: Sven Wang
+*/
+HWTEST_F(StartupOrchestratorTest, DependencyOrder, TestSize.Level0)
+{
+    StartupOrchestrator orchestrator;
+    std::mutex mutex;
+    std::vector<std::string> order;
+    auto step = [&mutex, &order](const std::string &name) {
+        return [&mutex, &order, name]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(name);
+        };
+    };
+    ASSERT_TRUE(orchestrator.AddStep("d", step("d"), { "b", "c" }));
+    ASSERT_TRUE(orchestrator.AddStep("b", step("b"), { "a" }));
+    ASSERT_TRUE(orchestrator.AddStep("c", step("c"), { "a" }));
+    ASSERT_TRUE(orchestrator.AddStep("a", step("a")));
+    ASSERT_FALSE(orchestrator.AddStep("a", step("a")));
+    ASSERT_FALSE(orchestrator.AddStep("e", nullptr));
+    ASSERT_TRUE(orchestrator.Run(2));
+    ASSERT_EQ(order.size(), 4);
+    ASSERT_EQ(order.front(), "a");
+    ASSERT_EQ(order.back(), "d");
+
+    auto timeline = orchestrator.GetTimeline();
+    ASSERT_EQ(timeline.size(), 4);
+    for (size_t i = 1; i < timeline.size(); i++) {
+        ASSERT_LE(timeline[i - 1].begin, timeline[i].begin);
+        ASSERT_LE(timeline[i].begin, timeline[i].end);
+    }
+    ASSERT_NE(orchestrator.DumpTimeline().find("d "), std::string::npos);
+}
+
+/**
+* @tc.name: Concurrent
+* @tc.desc: the independent steps run at the same time.
+* @tc.type: FUNC
+* @tc.require:
+* @tc.author: Sven Wang
+*/
+HWTEST_F(StartupOrchestratorTest, Concurrent, TestSize.Level0)
+{
+    StartupOrchestrator orchestrator;
+    std::mutex mutex;
+    std::condition_variable cv;
+    int arrived = 0;
+    std::atomic<int> met = 0;
+    auto meet = [&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+        arrived++;
+        cv.notify_all();
+        if (cv.wait_for(lock, std::chrono::seconds(5), [&arrived]() { return arrived == 2; })) {
+            met++;
+        }
+    };
+    ASSERT_TRUE(orchestrator.AddStep("left", meet));
+    ASSERT_TRUE(orchestrator.AddStep("right", meet));
+    ASSERT_TRUE(orchestrator.Run(1));
+    ASSERT_EQ(met, 2);
+    auto timeline = orchestrator.GetTimeline();
+    ASSERT_EQ(timeline.size(), 2);
+    ASSERT_NE(timeline[0].worker, timeline[1].worker);
+}
+
+/**
+* @tc.name: InvalidGraph
+* @tc.desc: nothing runs if a dependency is unknown or in a cycle.
+* @tc.type: FUNC
+* @tc.require:
+* @tc.author: Sven Wang
+*/
+HWTEST_F(StartupOrchestratorTest, InvalidGraph, TestSize.Level0)
+{
+    int count = 0;
+    auto step = [&count]() { count++; };
+    StartupOrchestrator unknown;
+    ASSERT_TRUE(unknown.AddStep("a", step));
+    ASSERT_TRUE(unknown.AddStep("b", step, { "none" }));
+    ASSERT_FALSE(unknown.Run(1));
+
+    StartupOrchestrator cycle;
+    ASSERT_TRUE(cycle.AddStep("a", step));
+    ASSERT_TRUE(cycle.AddStep("b", step, { "a", "c" }));
+    ASSERT_TRUE(cycle.AddStep("c", step, { "b" }));
+    ASSERT_FALSE(cycle.Run(1));
+    ASSERT_EQ(count, 0);
+    ASSERT_TRUE(cycle.GetTimeline().empty());
+}
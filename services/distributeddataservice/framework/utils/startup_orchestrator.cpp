@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define LOG_TAG "StartupOrchestrator"
+#include "utils/startup_orchestrator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "log_print.h"
+namespace OHOS::DistributedData {
+bool StartupOrchestrator::AddStep(const std::string &name, Action action, const std::vector<std::string> &dependencies)
+{
+    if (!action || indexes_.count(name) != 0) {
+        ZLOGE("invalid step:%{public}s", name.c_str());
+        return false;
+    }
+    indexes_[name] = steps_.size();
+    steps_.push_back({ name, std::move(action), dependencies });
+    return true;
+}
+
+bool StartupOrchestrator::Run(uint32_t workers)
+{
+    std::vector<std::vector<size_t>> children;
+    std::vector<size_t> waits;
+    if (!BuildGraph(children, waits)) {
+        return false;
+    }
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<size_t> ready;
+    size_t finished = 0;
+    for (size_t i = 0; i < steps_.size(); i++) {
+        if (waits[i] == 0) {
+            ready.push_back(i);
+        }
+    }
+    timeline_.clear();
+    auto start = std::chrono::steady_clock::now();
+    auto elapsed = [&start]() -> uint64_t {
+        auto now = std::chrono::steady_clock::now();
+        return std::chrono::duration_cast<std::chrono::microseconds>(now - start).count();
+    };
+    auto work = [&](uint32_t worker) {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            cv.wait(lock, [&]() { return !ready.empty() || finished == steps_.size(); });
+            if (ready.empty()) {
+                return;
+            }
+            size_t index = ready.front();
+            ready.pop_front();
+            lock.unlock();
+            Record record = { steps_[index].name, elapsed(), 0, worker };
+            steps_[index].action();
+            record.end = elapsed();
+            lock.lock();
+            timeline_.push_back(std::move(record));
+            finished++;
+            for (size_t child : children[index]) {
+                if (--waits[child] == 0) {
+                    ready.push_back(child);
+                }
+            }
+            cv.notify_all();
+        }
+    };
+    std::vector<std::thread> threads;
+    uint32_t threadNum = std::min<size_t>(workers, steps_.empty() ? 0 : steps_.size() - 1);
+    for (uint32_t i = 1; i <= threadNum; i++) {
+        threads.emplace_back(work, i);
+    }
+    work(0);
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    std::sort(timeline_.begin(), timeline_.end(), [](const Record &left, const Record &right) {
+        return left.begin < right.begin;
+    });
+    ZLOGI("%{public}zu steps done in %{public}" PRIu64 "us with %{public}u workers.", steps_.size(), elapsed(),
+        threadNum);
+    return true;
+}
+
+std::vector<StartupOrchestrator::Record> StartupOrchestrator::GetTimeline() const
+{
+    return timeline_;
+}
+
+std::string StartupOrchestrator::DumpTimeline() const
+{
+    std::string timeline;
+    for (const auto &record : timeline_) {
+        timeline += record.name + " " + std::to_string(record.begin) + "~" + std::to_string(record.end) + "(" +
+            std::to_string(record.end - record.begin) + ")us " + std::to_string(record.worker) + "\n";
+    }
+    return timeline;
+}
+
+bool StartupOrchestrator::BuildGraph(std::vector<std::vector<size_t>> &children, std::vector<size_t> &waits) const
+{
+    children.assign(steps_.size(), {});
+    waits.assign(steps_.size(), 0);
+    for (size_t i = 0; i < steps_.size(); i++) {
+        for (const auto &dependency : steps_[i].dependencies) {
+            auto it = indexes_.find(dependency);
+            if (it == indexes_.end()) {
+                ZLOGE("step:%{public}s depends on unknown:%{public}s", steps_[i].name.c_str(), dependency.c_str());
+                return false;
+            }
+            children[it->second].push_back(i);
+            waits[i]++;
+        }
+    }
+    // the steps never get ready are in a cycle
+    std::vector<size_t> remains = waits;
+    std::deque<size_t> ready;
+    for (size_t i = 0; i < steps_.size(); i++) {
+        if (remains[i] == 0) {
+            ready.push_back(i);
+        }
+    }
+    size_t visited = 0;
+    while (!ready.empty()) {
+        size_t index = ready.front();
+        ready.pop_front();
+        visited++;
+        for (size_t child : children[index]) {
+            if (--remains[child] == 0) {
+                ready.push_back(child);
+            }
+        }
+    }
+    if (visited != steps_.size()) {
+        ZLOGE("%{public}zu steps are in a dependency cycle", steps_.size() - visited);
+        return false;
+    }
+    return true;
+}
+} // namespace OHOS::DistributedData
@@ -100,6 +100,10 @@ public:
     static const std::string TRIGGER_REFERENCES_OLD;
 
     static const std::string UPDATE_META_FUNC;
+    static const std::string UPDATE_SUBSCRIBE_META_FUNC;
+
+    static const std::string SYNC_DIGEST_BUCKET_FUNC;
+    static const std::string SYNC_DIGEST_RECORD_FUNC;
 
     static const std::string SYSTEM_TABLE_PREFIX;
 
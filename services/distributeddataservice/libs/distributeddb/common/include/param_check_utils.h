@@ -42,6 +42,8 @@ public:
 
     static bool CheckSecOption(const SecurityOption &secOption);
 
+    static bool CheckStorageProfile(const StorageProfile &profile);
+
     static bool CheckObserver(const Key &key, unsigned int mode);
 
     static bool IsS3SECEOpt(const SecurityOption &secOpt);
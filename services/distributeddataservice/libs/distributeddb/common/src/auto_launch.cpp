@@ -1031,6 +1031,7 @@ int AutoLaunch::GetAutoLaunchKVProperties(const AutoLaunchParam &param,
             ParamCheckUtils::GetValidCompressionRate(param.option.compressionRate));
     }
     propertiesPtr->SetBoolProp(KvDBProperties::SYNC_DUAL_TUPLE_MODE, param.option.syncDualTupleMode);
+    propertiesPtr->SetBoolProp(KvDBProperties::DIGEST_SYNC, param.option.isNeedDigestSync);
     DBCommon::SetDatabaseIds(*propertiesPtr, param.appId, param.userId, param.storeId);
     return E_OK;
 }
@@ -63,6 +63,10 @@ const std::string DBConstant::TRIGGER_REFERENCES_NEW = "NEW.";
 const std::string DBConstant::TRIGGER_REFERENCES_OLD = "OLD.";
 
 const std::string DBConstant::UPDATE_META_FUNC = "update_meta_within_trigger";
+const std::string DBConstant::UPDATE_SUBSCRIBE_META_FUNC = "update_subscribe_meta_within_trigger";
+
+const std::string DBConstant::SYNC_DIGEST_BUCKET_FUNC = "sync_digest_bucket";
+const std::string DBConstant::SYNC_DIGEST_RECORD_FUNC = "sync_digest_record";
 
 const std::string DBConstant::SYSTEM_TABLE_PREFIX = "naturalbase_rdb_";
 const std::string DBConstant::RELATIONAL_PREFIX = "naturalbase_rdb_aux_";
@@ -123,6 +123,24 @@ bool ParamCheckUtils::CheckSecOption(const SecurityOption &secOption)
     return true;
 }
 
+bool ParamCheckUtils::CheckStorageProfile(const StorageProfile &profile)
+{
+    const int minPageSize = 512;
+    const int maxPageSize = 65536;
+    const int maxTempStore = 2; // 2 means memory
+    if (profile.pageSize > 0 && (profile.pageSize < minPageSize || profile.pageSize > maxPageSize ||
+        (profile.pageSize & (profile.pageSize - 1)) != 0)) {
+        LOGE("[DBCommon] Page size is invalid, page size is [%d].", profile.pageSize);
+        return false;
+    }
+    if (profile.pageSize == 0 || profile.tempStore > maxTempStore) {
+        LOGE("[DBCommon] Storage profile is invalid, page size [%d], temp store [%d].", profile.pageSize,
+            profile.tempStore);
+        return false;
+    }
+    return true;
+}
+
 bool ParamCheckUtils::CheckObserver(const Key &key, unsigned int mode)
 {
     if (key.size() > DBConstant::MAX_KEY_SIZE) {
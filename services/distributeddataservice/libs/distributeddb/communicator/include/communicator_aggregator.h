@@ -133,7 +133,8 @@ private:
     void TriggerCommunicatorNotFoundFeedback(const std::string &dstTarget, const LabelType &dstLabel, Message* &oriMsg);
 
     // Record the protocol version of remote target.
-    void SetRemoteCommunicatorVersion(const std::string &target, uint16_t version);
+    void SetRemoteCommunicatorVersion(const std::string &target, uint16_t version, bool isCrc32cSupport);
+    bool IsRemoteCrc32cSupport(const std::string &target) const;
 
     DECLARE_OBJECT_TAG(CommunicatorAggregator);
 
@@ -165,6 +166,7 @@ private:
     // Remote target version related
     mutable std::mutex versionMapMutex_;
     std::map<std::string, uint16_t> versionMap_;
+    std::map<std::string, bool> crc32cSupportMap_;
 
     // CommLack Callback related
     CommunicatorLackCallback onCommLackHandle_;
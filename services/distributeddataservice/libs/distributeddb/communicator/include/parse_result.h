@@ -146,6 +146,16 @@ public:
     {
         return dbVersion_;
     }
+
+    void SetCrc32cSupport(bool isSupport)
+    {
+        isCrc32cSupport_ = isSupport;
+    }
+
+    bool IsCrc32cSupport() const
+    {
+        return isCrc32cSupport_;
+    }
 private:
     // For CommPhyHeader
     uint32_t frameId_ = 0;
@@ -169,6 +179,7 @@ private:
     uint64_t labelExchangeSequenceId_ = 0; // For Both LabelExchange And LabelExchangeAck Frame
     std::set<LabelType> latestCommLabels_; // For Only LabelExchange Frame
     uint16_t dbVersion_ = 0;
+    bool isCrc32cSupport_ = false;
 };
 }
 
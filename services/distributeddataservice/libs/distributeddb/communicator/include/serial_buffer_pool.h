@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SERIAL_BUFFER_POOL_H
+#define SERIAL_BUFFER_POOL_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <vector>
+#include "macro_utils.h"
+
+namespace DistributedDB {
+struct SerialBufferPoolStat {
+    uint64_t allocCount = 0;
+    uint64_t hitCount = 0; // Allocations served by the idle blocks
+    uint64_t inUseBytes = 0; // Capacity of the blocks in use
+    uint64_t requestBytes = 0; // Requested length of the blocks in use, the rest of inUseBytes is the waste
+    uint64_t peakInUseBytes = 0;
+    uint64_t idleBytes = 0; // Idle blocks in the free lists and the thread caches
+    uint64_t idleLimit = 0;
+    uint64_t memoryLimit = 0; // Bound of inUseBytes
+};
+
+// The memory of the SerialBuffer. Blocks are rounded up to a power of two between MIN_BLOCK_SIZE and MAX_BLOCK_SIZE
+// and reused after release, so the large frames of sync not leave the heap fragmented. A block can be released on any
+// thread. Larger blocks are not pooled. Each user of the pool, the sync engine of each store, adds its memory share.
+// The blocks in use are bounded by the sum of the shares, but not less than MIN_MEMORY_LIMIT, and the idle blocks by a
+// tenth of the largest share, so the limits not depend on which store set its share last.
+class SerialBufferPool {
+public:
+    static SerialBufferPool *GetInstance();
+
+    // A private pool without the thread caches, the blocks are all freed with the pool
+    SerialBufferPool() = default;
+    ~SerialBufferPool();
+
+    // Return nullptr if out of memory or the memory limit, outBlockSize is the size that should be passed to Release
+    uint8_t *Allocate(uint32_t length, uint32_t &outBlockSize);
+    void Release(uint8_t *block, uint32_t blockSize, uint32_t length);
+
+    // The idle blocks exceed the new idle limit are freed at once
+    void AddMemoryShare(uint64_t share);
+    void RemoveMemoryShare(uint64_t share);
+    // Free all the idle blocks in the free lists, the blocks in the thread caches are freed when the thread exits
+    void ReleaseIdleBlocks();
+
+    SerialBufferPoolStat GetStat() const;
+
+    static constexpr uint32_t MIN_BLOCK_SIZE = 256;
+    static constexpr uint32_t MAX_BLOCK_SIZE = 8 * 1024 * 1024; // 8 MB, 1024 is scale
+    static constexpr uint64_t DEFAULT_MEMORY_SHARE = 160 * 1024 * 1024; // 160 MB, the default queue cache size
+    static constexpr uint64_t IDLE_SHARE_RATIO = 10; // The idle limit is a tenth of the largest share
+    static constexpr uint64_t MIN_MEMORY_LIMIT = 4 * MAX_BLOCK_SIZE; // A few of the largest frames can always be sent
+
+    DISABLE_COPY_ASSIGN_MOVE(SerialBufferPool);
+
+private:
+    class ThreadCache; // Keep a few small blocks of each thread to allocate without lock
+
+    static uint32_t GetClassIndex(uint32_t length);
+    static uint32_t GetBlockSize(uint32_t classIndex);
+    static ThreadCache &GetThreadCache();
+
+    bool TryReserveInUse(uint32_t blockSize);
+    bool TryReserveIdle(uint32_t blockSize);
+    void ReleaseToFreeList(uint32_t classIndex, uint8_t *block);
+    void ShrinkIdleBlocks(bool isReleaseAll);
+    void OnBlockOut(uint32_t length, bool isHit);
+    void UpdateLimits();
+
+    static constexpr uint32_t MIN_CLASS_SHIFT = 8; // 256 bytes
+    static constexpr uint32_t MAX_CLASS_SHIFT = 23; // 8 MB
+    static constexpr uint32_t CLASS_NUM = MAX_CLASS_SHIFT - MIN_CLASS_SHIFT + 1;
+    static constexpr uint32_t THREAD_CACHE_CLASS_NUM = 8; // Only the blocks not larger than 32 KB
+    static constexpr uint32_t THREAD_CACHE_BLOCK_NUM = 2; // Each class of each thread
+
+    mutable std::mutex freeListMutex_;
+    std::vector<uint8_t *> freeLists_[CLASS_NUM];
+    bool isThreadCached_ = false; // Only the instance keeps the thread caches
+
+    std::mutex shareMutex_;
+    std::multiset<uint64_t> shares_; // Empty means the one default share
+
+    std::atomic<uint64_t> idleLimit_ = DEFAULT_MEMORY_SHARE / IDLE_SHARE_RATIO;
+    std::atomic<uint64_t> memoryLimit_ = DEFAULT_MEMORY_SHARE;
+    std::atomic<uint64_t> idleBytes_ = 0;
+    std::atomic<uint64_t> allocCount_ = 0;
+    std::atomic<uint64_t> hitCount_ = 0;
+    std::atomic<uint64_t> inUseBytes_ = 0;
+    std::atomic<uint64_t> requestBytes_ = 0;
+    std::atomic<uint64_t> peakInUseBytes_ = 0;
+};
+} // namespace DistributedDB
+
+#endif // SERIAL_BUFFER_POOL_H
@@ -25,6 +25,7 @@
 #include "endian_convert.h"
 #include "protocol_proto.h"
 #include "communicator_linker.h"
+#include "serial_buffer_pool.h"
 
 namespace DistributedDB {
 namespace {
@@ -120,6 +121,11 @@ void CommunicatorAggregator::Finalize()
     commLinker_ = nullptr;
     retainer_.Finalize();
     combiner_.Finalize();
+    // The frames are all freed, give back the idle memory of the buffer pool
+    SerialBufferPoolStat stat = SerialBufferPool::GetInstance()->GetStat();
+    LOGI("[CommAggr][Final] BufferPool alloc=%llu, hit=%llu, peak=%llu, inUse=%llu, idle=%llu.", ULL(stat.allocCount),
+        ULL(stat.hitCount), ULL(stat.peakInUseBytes), ULL(stat.inUseBytes), ULL(stat.idleBytes));
+    SerialBufferPool::GetInstance()->ReleaseIdleBlocks();
 }
 
 ICommunicator *CommunicatorAggregator::AllocCommunicator(uint64_t commLabel, int &outErrorNo)
@@ -298,7 +304,8 @@ int CommunicatorAggregator::CreateSendTask(const std::string &dstTarget, SerialB
         LOGE("[CommAggr][Create] Exit ok but discard since localSourceId zero, thread=%s.", GetThreadId().c_str());
         return E_OK; // Returns E_OK here to indicate this buffer was accepted though discard immediately
     }
-    PhyHeaderInfo info{localSourceId_, incFrameId_.fetch_add(1, std::memory_order_seq_cst), inType};
+    PhyHeaderInfo info{localSourceId_, incFrameId_.fetch_add(1, std::memory_order_seq_cst), inType,
+        IsRemoteCrc32cSupport(dstTarget)};
     int errCode = ProtocolProto::SetPhyHeader(inBuff, info);
     if (errCode != E_OK) {
         LOGE("[CommAggr][Create] Set phyHeader fail, thread=%s, errCode=%d", GetThreadId().c_str(), errCode);
@@ -492,7 +499,7 @@ void CommunicatorAggregator::OnBytesReceive(const std::string &srcTarget, const
     }
 
     // Update version of remote target
-    SetRemoteCommunicatorVersion(srcTarget, packetResult.GetDbVersion());
+    SetRemoteCommunicatorVersion(srcTarget, packetResult.GetDbVersion(), packetResult.IsCrc32cSupport());
     if (packetResult.GetFrameTypeInfo() == FrameType::EMPTY) { // Empty frame will never be fragmented
         LOGI("[CommAggr][Receive] Empty frame, just ignore in this version of distributeddb.");
         return;
@@ -870,10 +877,24 @@ void CommunicatorAggregator::TriggerCommunicatorNotFoundFeedback(const std::stri
     }
 }
 
-void CommunicatorAggregator::SetRemoteCommunicatorVersion(const std::string &target, uint16_t version)
+void CommunicatorAggregator::SetRemoteCommunicatorVersion(const std::string &target, uint16_t version,
+    bool isCrc32cSupport)
 {
     std::lock_guard<std::mutex> versionMapLockGuard(versionMapMutex_);
     versionMap_[target] = version;
+    crc32cSupportMap_[target] = isCrc32cSupport;
+}
+
+bool CommunicatorAggregator::IsRemoteCrc32cSupport(const std::string &target) const
+{
+    // Only use crc32c when it is enabled in both devices, the remote support is unknown before any frame of remote
+    // is received
+    if (!ProtocolProto::IsCrc32cSumEnable()) {
+        return false;
+    }
+    std::lock_guard<std::mutex> versionMapLockGuard(versionMapMutex_);
+    auto iter = crc32cSupportMap_.find(target);
+    return iter != crc32cSupportMap_.end() && iter->second;
 }
 
 std::shared_ptr<ExtendHeaderHandle> CommunicatorAggregator::GetExtendHeaderHandle(const ExtendInfo &paramInfo)
@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frame_checksum.h"
+#include <cstring>
+#include "db_errno.h"
+#include "log_print.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define FRAME_CHECKSUM_X86
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#ifdef __ARM_FEATURE_CRC32
+#include <arm_acle.h>
+#endif
+#endif
+
+namespace DistributedDB {
+namespace {
+using XorSumFunc = uint64_t (*)(const uint8_t *bytes, uint32_t wordCount);
+using Crc32cFunc = uint32_t (*)(uint32_t crc, const uint8_t *bytes, uint32_t length);
+
+const uint32_t CRC32C_POLY = 0x82F63B78; // Reversed polynomial of crc32c
+const uint32_t CRC32C_INIT = 0xFFFFFFFF;
+const uint32_t CRC32C_TABLE_NUM = 8; // Eight tables to look up eight bytes at a time
+const uint32_t CRC32C_TABLE_SIZE = 256;
+const uint32_t BYTE_BITS = 8;
+const uint32_t BYTE_MASK = 0xFF;
+
+uint64_t LoadWord(const uint8_t *bytes)
+{
+    uint64_t word = 0;
+    std::memcpy(&word, bytes, sizeof(uint64_t));
+    return word;
+}
+
+uint64_t XorSumScalar(const uint8_t *bytes, uint32_t wordCount)
+{
+    // Independent sums let the cpu xor several words at the same time
+    uint64_t sum0 = 0;
+    uint64_t sum1 = 0;
+    uint64_t sum2 = 0;
+    uint64_t sum3 = 0;
+    uint32_t index = 0;
+    for (; index + 4 <= wordCount; index += 4) { // 4 words each loop
+        sum0 ^= LoadWord(bytes + index * sizeof(uint64_t));
+        sum1 ^= LoadWord(bytes + (index + 1) * sizeof(uint64_t));
+        sum2 ^= LoadWord(bytes + (index + 2) * sizeof(uint64_t)); // 2 is the third word
+        sum3 ^= LoadWord(bytes + (index + 3) * sizeof(uint64_t)); // 3 is the fourth word
+    }
+    for (; index < wordCount; index++) {
+        sum0 ^= LoadWord(bytes + index * sizeof(uint64_t));
+    }
+    return sum0 ^ sum1 ^ sum2 ^ sum3;
+}
+
+#if defined(FRAME_CHECKSUM_X86) && defined(__SSE2__)
+uint64_t XorSumSse2(const uint8_t *bytes, uint32_t wordCount)
+{
+    const uint32_t wordsPerLoop = 2 * sizeof(__m128i) / sizeof(uint64_t); // 2 vectors each loop
+    __m128i sum0 = _mm_setzero_si128();
+    __m128i sum1 = _mm_setzero_si128();
+    uint32_t index = 0;
+    for (; index + wordsPerLoop <= wordCount; index += wordsPerLoop) {
+        const uint8_t *ptr = bytes + index * sizeof(uint64_t);
+        sum0 = _mm_xor_si128(sum0, _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr)));
+        sum1 = _mm_xor_si128(sum1, _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr + sizeof(__m128i))));
+    }
+    uint64_t lanes[sizeof(__m128i) / sizeof(uint64_t)] = {0};
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), _mm_xor_si128(sum0, sum1));
+    return lanes[0] ^ lanes[1] ^ XorSumScalar(bytes + index * sizeof(uint64_t), wordCount - index);
+}
+#endif
+
+#if defined(FRAME_CHECKSUM_X86) && defined(__GNUC__)
+__attribute__((target("avx2"))) uint64_t XorSumAvx2(const uint8_t *bytes, uint32_t wordCount)
+{
+    const uint32_t wordsPerLoop = 2 * sizeof(__m256i) / sizeof(uint64_t); // 2 vectors each loop
+    __m256i sum0 = _mm256_setzero_si256();
+    __m256i sum1 = _mm256_setzero_si256();
+    uint32_t index = 0;
+    for (; index + wordsPerLoop <= wordCount; index += wordsPerLoop) {
+        const uint8_t *ptr = bytes + index * sizeof(uint64_t);
+        sum0 = _mm256_xor_si256(sum0, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr)));
+        sum1 = _mm256_xor_si256(sum1, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr + sizeof(__m256i))));
+    }
+    uint64_t lanes[sizeof(__m256i) / sizeof(uint64_t)] = {0};
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), _mm256_xor_si256(sum0, sum1));
+    uint64_t sum = 0;
+    for (uint64_t lane : lanes) {
+        sum ^= lane;
+    }
+    return sum ^ XorSumScalar(bytes + index * sizeof(uint64_t), wordCount - index);
+}
+
+__attribute__((target("sse4.2"))) uint32_t Crc32cSse42(uint32_t crc, const uint8_t *bytes, uint32_t length)
+{
+#if defined(__x86_64__)
+    uint64_t crcWord = crc;
+    for (; length >= sizeof(uint64_t); length -= sizeof(uint64_t)) {
+        crcWord = _mm_crc32_u64(crcWord, LoadWord(bytes));
+        bytes += sizeof(uint64_t);
+    }
+    crc = static_cast<uint32_t>(crcWord);
+#endif
+    for (; length > 0; length--) {
+        crc = _mm_crc32_u8(crc, *bytes++);
+    }
+    return crc;
+}
+#endif
+
+#if defined(__aarch64__)
+uint64_t XorSumNeon(const uint8_t *bytes, uint32_t wordCount)
+{
+    const uint32_t wordsPerLoop = 2 * sizeof(uint64x2_t) / sizeof(uint64_t); // 2 vectors each loop
+    uint64x2_t sum0 = vdupq_n_u64(0);
+    uint64x2_t sum1 = vdupq_n_u64(0);
+    uint32_t index = 0;
+    for (; index + wordsPerLoop <= wordCount; index += wordsPerLoop) {
+        const uint8_t *ptr = bytes + index * sizeof(uint64_t);
+        sum0 = veorq_u64(sum0, vreinterpretq_u64_u8(vld1q_u8(ptr)));
+        sum1 = veorq_u64(sum1, vreinterpretq_u64_u8(vld1q_u8(ptr + sizeof(uint64x2_t))));
+    }
+    sum0 = veorq_u64(sum0, sum1);
+    return vgetq_lane_u64(sum0, 0) ^ vgetq_lane_u64(sum0, 1) ^
+        XorSumScalar(bytes + index * sizeof(uint64_t), wordCount - index);
+}
+
+#ifdef __ARM_FEATURE_CRC32
+uint32_t Crc32cArm(uint32_t crc, const uint8_t *bytes, uint32_t length)
+{
+    for (; length >= sizeof(uint64_t); length -= sizeof(uint64_t)) {
+        crc = __crc32cd(crc, LoadWord(bytes));
+        bytes += sizeof(uint64_t);
+    }
+    for (; length > 0; length--) {
+        crc = __crc32cb(crc, *bytes++);
+    }
+    return crc;
+}
+#endif
+#endif
+
+XorSumFunc ChooseXorSumFunc()
+{
+#if defined(FRAME_CHECKSUM_X86) && defined(__GNUC__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return XorSumAvx2;
+    }
+#endif
+#if defined(FRAME_CHECKSUM_X86) && defined(__SSE2__)
+    return XorSumSse2;
+#elif defined(__aarch64__)
+    return XorSumNeon;
+#else
+    return XorSumScalar;
+#endif
+}
+
+// Return nullptr if the cpu has no crc32c instruction
+Crc32cFunc ChooseCrc32cFunc()
+{
+    Crc32cFunc func = nullptr;
+#if defined(FRAME_CHECKSUM_X86) && defined(__GNUC__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.2")) {
+        func = Crc32cSse42;
+    }
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+    func = Crc32cArm;
+#endif
+    return func;
+}
+
+// Slicing-by-8, the table k gives the crc of a byte followed by k zero bytes
+class Crc32cTable {
+public:
+    Crc32cTable()
+    {
+        for (uint32_t i = 0; i < CRC32C_TABLE_SIZE; i++) {
+            uint32_t crc = i;
+            for (uint32_t bit = 0; bit < BYTE_BITS; bit++) {
+                crc = ((crc & 1) != 0) ? ((crc >> 1) ^ CRC32C_POLY) : (crc >> 1);
+            }
+            table_[0][i] = crc;
+        }
+        for (uint32_t i = 0; i < CRC32C_TABLE_SIZE; i++) {
+            for (uint32_t k = 1; k < CRC32C_TABLE_NUM; k++) {
+                table_[k][i] = (table_[k - 1][i] >> BYTE_BITS) ^ table_[0][table_[k - 1][i] & BYTE_MASK];
+            }
+        }
+    }
+
+    uint32_t Update(uint32_t crc, const uint8_t *bytes, uint32_t length) const
+    {
+        for (; length >= CRC32C_TABLE_NUM; length -= CRC32C_TABLE_NUM) {
+            uint32_t low = crc ^ LoadLittleEndian32(bytes);
+            uint32_t high = LoadLittleEndian32(bytes + sizeof(uint32_t));
+            crc = LookUp(low, CRC32C_TABLE_NUM - 1) ^ LookUp(high, sizeof(uint32_t) - 1);
+            bytes += CRC32C_TABLE_NUM;
+        }
+        for (; length > 0; length--) {
+            crc = (crc >> BYTE_BITS) ^ table_[0][(crc ^ *bytes++) & BYTE_MASK];
+        }
+        return crc;
+    }
+
+private:
+    static uint32_t LoadLittleEndian32(const uint8_t *bytes)
+    {
+        uint32_t word = 0;
+        for (uint32_t i = 0; i < sizeof(uint32_t); i++) {
+            word |= static_cast<uint32_t>(bytes[i]) << (i * BYTE_BITS);
+        }
+        return word;
+    }
+
+    // The bytes of the word use the tables from firstTable down to firstTable - 3
+    uint32_t LookUp(uint32_t word, uint32_t firstTable) const
+    {
+        uint32_t crc = 0;
+        for (uint32_t i = 0; i < sizeof(uint32_t); i++) {
+            crc ^= table_[firstTable - i][(word >> (i * BYTE_BITS)) & BYTE_MASK];
+        }
+        return crc;
+    }
+
+    uint32_t table_[CRC32C_TABLE_NUM][CRC32C_TABLE_SIZE] = {{0}};
+};
+}
+
+int FrameChecksum::CalculateXorSum(const uint8_t *bytes, uint32_t length, uint64_t &outSum)
+{
+    if (length % sizeof(uint64_t) != 0) {
+        LOGE("[Checksum][CalcuXorSum] Length=%u not multiple of eight.", length);
+        return -E_LENGTH_ERROR;
+    }
+    static const XorSumFunc xorSumFunc = ChooseXorSumFunc();
+    outSum = xorSumFunc(bytes, length / sizeof(uint64_t));
+    return E_OK;
+}
+
+uint32_t FrameChecksum::CalculateCrc32c(const uint8_t *bytes, uint32_t length)
+{
+    static const Crc32cFunc crc32cFunc = ChooseCrc32cFunc();
+    if (crc32cFunc != nullptr) {
+        return crc32cFunc(CRC32C_INIT, bytes, length) ^ CRC32C_INIT;
+    }
+    static const Crc32cTable table;
+    return table.Update(CRC32C_INIT, bytes, length) ^ CRC32C_INIT;
+}
+
+bool FrameChecksum::IsCrc32cAccelerated()
+{
+    static const bool isAccelerated = (ChooseCrc32cFunc() != nullptr);
+    return isAccelerated;
+}
+} // namespace DistributedDB
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FRAME_CHECKSUM_H
+#define FRAME_CHECKSUM_H
+
+#include <cstdint>
+
+namespace DistributedDB {
+// The checksums of the packets. The implementation is chosen by the cpu at the first call, all the implementations
+// of the same checksum give the same result.
+class FrameChecksum {
+public:
+    // The xor of the 64-bit words in host endian, return -E_LENGTH_ERROR if length not multiple of eight.
+    static int CalculateXorSum(const uint8_t *bytes, uint32_t length, uint64_t &outSum);
+
+    // The crc32c(castagnoli) of the bytes.
+    static uint32_t CalculateCrc32c(const uint8_t *bytes, uint32_t length);
+
+    // Return true if the crc32c is calculated by the cpu instruction, otherwise it is calculated by table.
+    static bool IsCrc32cAccelerated();
+
+    FrameChecksum() = delete;
+    ~FrameChecksum() = delete;
+};
+} // namespace DistributedDB
+
+#endif // FRAME_CHECKSUM_H
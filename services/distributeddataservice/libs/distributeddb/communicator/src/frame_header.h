@@ -22,7 +22,8 @@
 namespace DistributedDB {
 /*
  * packetType: Bit0:   FragmentFlag: 1: Fragmented 0: Not Fragmented
- *             Bit1~3: Reserved
+ *             Bit1:   Crc32cFlag: 1: Sender use crc32c checkSum if receiver also set it 0: Only use xor checkSum
+ *             Bit2~3: Reserved
  *             Bit4~7: FrameType
  */
 struct CommPhyHeader {
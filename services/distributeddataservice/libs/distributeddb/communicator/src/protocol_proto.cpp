@@ -14,6 +14,7 @@
  */
 
 #include "protocol_proto.h"
+#include <atomic>
 #include <new>
 #include <iterator>
 #include "hash.h"
@@ -23,16 +24,19 @@
 #include "log_print.h"
 #include "macro_utils.h"
 #include "endian_convert.h"
+#include "frame_checksum.h"
 #include "header_converter.h"
 
 namespace DistributedDB {
 namespace {
 const uint16_t MAGIC_CODE = 0xAAAA;
 const uint16_t PROTOCOL_VERSION = 0;
+const uint16_t PROTOCOL_VERSION_CRC32C = 1; // Same layout as PROTOCOL_VERSION, but checkSum is crc32c of the packet
 // Compatibility Final Method. 3 Correspond To Version 1.1.4(104)
 const uint16_t DB_GLOBAL_VERSION = SOFTWARE_VERSION_CURRENT - SOFTWARE_VERSION_EARLIEST;
 const uint8_t PACKET_TYPE_FRAGMENTED = BITX(0); // Use bit 0
 const uint8_t PACKET_TYPE_NOT_FRAGMENTED = 0;
+const uint8_t PACKET_TYPE_CRC32C_SUPPORT = BITX(1); // Use bit 1
 const uint8_t MAX_PADDING_LEN = 7;
 const uint32_t LENGTH_BEFORE_SUM_RANGE = sizeof(uint64_t) + sizeof(uint64_t);
 const uint32_t MAX_FRAME_LEN = 32 * 1024 * 1024; // Max 32 MB, 1024 is scale
@@ -43,6 +47,12 @@ const uint32_t DISTINCT_VALUE_LEN = sizeof(uint64_t);
 const uint32_t SEQUENCE_ID_LEN = sizeof(uint64_t);
 // Note: COMM_LABEL_LENGTH is defined in communicator_type_define.h
 const uint32_t COMM_LABEL_COUNT_LEN = sizeof(uint64_t);
+// The crc32c is stronger but slower than the xor sum, only sent if enabled. It is always accepted in receive case.
+#ifdef USE_CRC32C_FRAME_CHECKSUM
+std::atomic<bool> g_isCrc32cSumEnable{true};
+#else
+std::atomic<bool> g_isCrc32cSumEnable{false};
+#endif
 // Local func to set and get frame Type from packet Type field
 void SetFrameType(uint8_t &inPacketType, FrameType inFrameType)
 {
@@ -430,12 +440,14 @@ int ProtocolProto::SetPhyHeader(SerialBuffer *inBuff, const PhyHeaderInfo &inInf
         return -E_INVALID_ARGS;
     }
 
+    uint16_t version = (inInfo.isCrc32cSum ? PROTOCOL_VERSION_CRC32C : PROTOCOL_VERSION);
     CommPhyHeader phyHeader;
     phyHeader.magic = MAGIC_CODE;
-    phyHeader.version = PROTOCOL_VERSION;
+    phyHeader.version = version;
     phyHeader.sourceId = inInfo.sourceId;
     phyHeader.frameId = inInfo.frameId;
-    phyHeader.packetType = 0;
+    // Tell remote that the crc32c checkSum can be checked in this device
+    phyHeader.packetType = (IsCrc32cSumEnable() ? PACKET_TYPE_CRC32C_SUPPORT : 0);
     phyHeader.dbIntVer = DB_GLOBAL_VERSION;
     FillPhyHeaderLenInfo(phyHeader, packetLen, 0, packetType, paddingLen); // Sum is calculated afterwards
     HeaderConverter::ConvertHostToNet(phyHeader, phyHeader);
@@ -446,7 +458,7 @@ int ProtocolProto::SetPhyHeader(SerialBuffer *inBuff, const PhyHeaderInfo &inInf
     }
 
     uint64_t sumResult = 0;
-    int errCode = CalculateXorSum(bufferByteLen.first + LENGTH_BEFORE_SUM_RANGE,
+    int errCode = CalculateSum(version, bufferByteLen.first + LENGTH_BEFORE_SUM_RANGE,
         bufferByteLen.second - LENGTH_BEFORE_SUM_RANGE, sumResult);
     if (errCode != E_OK) {
         return -E_SUM_CALCULATE_FAIL;
@@ -551,19 +563,25 @@ void ProtocolProto::DisplayPacketInformation(const uint8_t *bytes, uint32_t leng
     }
 }
 
-int ProtocolProto::CalculateXorSum(const uint8_t *bytes, uint32_t length, uint64_t &outSum)
+bool ProtocolProto::IsCrc32cSumEnable()
 {
-    if (length % sizeof(uint64_t) != 0) {
-        LOGE("[Proto][CalcuXorSum] Length=%d not multiple of eight.", length);
-        return -E_LENGTH_ERROR;
-    }
-    int count = length / sizeof(uint64_t);
-    auto array = reinterpret_cast<const uint64_t *>(bytes);
-    outSum = 0;
-    for (int i = 0; i < count; i++) {
-        outSum ^= array[i];
+    return g_isCrc32cSumEnable && FrameChecksum::IsCrc32cAccelerated();
+}
+
+void ProtocolProto::SetCrc32cSumEnable(bool isEnable)
+{
+    LOGI("[Proto][Crc32c] Set crc32c checkSum enable=%d, accelerated=%d.", isEnable,
+        FrameChecksum::IsCrc32cAccelerated());
+    g_isCrc32cSumEnable = isEnable;
+}
+
+int ProtocolProto::CalculateSum(uint16_t version, const uint8_t *bytes, uint32_t length, uint64_t &outSum)
+{
+    if (version == PROTOCOL_VERSION_CRC32C) {
+        outSum = FrameChecksum::CalculateCrc32c(bytes, length);
+        return E_OK;
     }
-    return E_OK;
+    return FrameChecksum::CalculateXorSum(bytes, length, outSum);
 }
 
 int ProtocolProto::CalculateDataSerializeLength(const Message *inMsg, uint32_t &outLength)
@@ -700,7 +718,7 @@ int ProtocolProto::ParseCommPhyHeaderCheckMagicAndVersion(const uint8_t *bytes,
         LOGE("[Proto][ParsePhyCheckVer] MagicCode=%u Error.", magic);
         return -E_PARSE_FAIL;
     }
-    if (version != PROTOCOL_VERSION) {
+    if (version != PROTOCOL_VERSION && version != PROTOCOL_VERSION_CRC32C) {
         LOGE("[Proto][ParsePhyCheckVer] Version=%u Error.", version);
         return -E_VERSION_NOT_SUPPORT;
     }
@@ -728,7 +746,8 @@ int ProtocolProto::ParseCommPhyHeaderCheckField(const std::string &srcTarget, co
         return -E_PARSE_FAIL;
     }
     uint64_t sumResult = 0;
-    int errCode = CalculateXorSum(bytes + LENGTH_BEFORE_SUM_RANGE, length - LENGTH_BEFORE_SUM_RANGE, sumResult);
+    int errCode = CalculateSum(phyHeader.version, bytes + LENGTH_BEFORE_SUM_RANGE, length - LENGTH_BEFORE_SUM_RANGE,
+        sumResult);
     if (errCode != E_OK) {
         LOGE("[Proto][ParsePhyCheck] Calculate Sum Fail.");
         return -E_SUM_CALCULATE_FAIL;
@@ -768,6 +787,7 @@ int ProtocolProto::ParseCommPhyHeader(const std::string &srcTarget, const uint8_
     inResult.SetPacketLen(phyHeader.packetLen);
     inResult.SetPaddingLen(phyHeader.paddingLen);
     inResult.SetDbVersion(phyHeader.dbIntVer);
+    inResult.SetCrc32cSupport((phyHeader.packetType & PACKET_TYPE_CRC32C_SUPPORT) != 0);
     if ((phyHeader.packetType & PACKET_TYPE_FRAGMENTED) != 0) {
         inResult.SetFragmentFlag(true);
     } // FragmentFlag default is false
@@ -1032,7 +1052,7 @@ int ProtocolProto::FillFragmentPacket(const CommPhyHeader &phyHeader, const Comm
 
     // Calculate sum and set sum field
     uint64_t sumResult = 0;
-    int errCode  = CalculateXorSum(outPacket.ptrPacket + LENGTH_BEFORE_SUM_RANGE,
+    int errCode  = CalculateSum(NetToHost(phyHeader.version), outPacket.ptrPacket + LENGTH_BEFORE_SUM_RANGE,
         outPacket.leftLength - LENGTH_BEFORE_SUM_RANGE, sumResult);
     if (errCode != E_OK) {
         return -E_SUM_CALCULATE_FAIL;
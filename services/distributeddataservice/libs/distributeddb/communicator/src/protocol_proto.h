@@ -31,6 +31,7 @@ struct PhyHeaderInfo {
     uint64_t sourceId;
     uint32_t frameId;
     FrameType frameType;
+    bool isCrc32cSum = false; // Use crc32c instead of xor sum as checkSum
 };
 
 struct FrameFragmentInfo {
@@ -95,13 +96,20 @@ public:
     // The CommPhyHeader had already been parsed into outResult
     static int CheckAndParseFrame(const SerialBuffer *inBuff, ParseResult &outResult);
 
+    // Return true if the crc32c checkSum is used when remote support it
+    static bool IsCrc32cSumEnable();
+
+    // The default is on if built with USE_CRC32C_FRAME_CHECKSUM. It is still off without the crc32c instruction.
+    static void SetCrc32cSumEnable(bool isEnable);
+
     // Dfx method for helping debugging
     static void DisplayPacketInformation(const uint8_t *bytes, uint32_t length);
 
     ProtocolProto() = delete;
     ~ProtocolProto() = delete;
 private:
-    static int CalculateXorSum(const uint8_t *bytes, uint32_t length, uint64_t &outSum);
+    // The checkSum algorithm is decided by the version of CommPhyHeader
+    static int CalculateSum(uint16_t version, const uint8_t *bytes, uint32_t length, uint64_t &outSum);
 
     // For handling application layer message
     static int CalculateDataSerializeLength(const Message *inMsg, uint32_t &outLength);
@@ -19,12 +19,13 @@
 #include "db_errno.h"
 #include "communicator_type_define.h"
 #include "log_print.h"
+#include "serial_buffer_pool.h"
 
 namespace DistributedDB {
 SerialBuffer::~SerialBuffer()
 {
     if (!isExternalStackMemory_ && oringinalBytes_ != nullptr) {
-        delete[] oringinalBytes_;
+        SerialBufferPool::GetInstance()->Release(oringinalBytes_, blockSize_, allocLen_);
     }
     oringinalBytes_ = nullptr;
     bytes_ = nullptr;
@@ -55,7 +56,7 @@ int SerialBuffer::AllocBufferByPayloadLength(uint32_t inPayloadLen, uint32_t inH
     if (totalLen_ == 0 || totalLen_ > MAX_TOTAL_LEN) {
         return -E_INVALID_ARGS;
     }
-    oringinalBytes_ = new (std::nothrow) uint8_t[totalLen_ + extendHeadLen_];
+    oringinalBytes_ = AllocBlock(totalLen_ + extendHeadLen_);
     if (oringinalBytes_ == nullptr) {
         return -E_OUT_OF_MEMORY;
     }
@@ -77,7 +78,7 @@ int SerialBuffer::AllocBufferByTotalLength(uint32_t inTotalLen, uint32_t inHeade
     headerLen_ = inHeaderLen;
     payloadLen_ = totalLen_ - headerLen_;
     paddingLen_ = 0;
-    bytes_ = new (std::nothrow) uint8_t[inTotalLen];
+    bytes_ = AllocBlock(inTotalLen);
     if (bytes_ == nullptr) {
         return -E_OUT_OF_MEMORY;
     }
@@ -114,13 +115,14 @@ SerialBuffer *SerialBuffer::Clone(int &outErrorNo)
     if (bytes_ == nullptr) {
         twinBuffer->bytes_ = nullptr;
     } else {
-        twinBuffer->bytes_ = new (std::nothrow) uint8_t[totalLen_];
+        twinBuffer->bytes_ = twinBuffer->AllocBlock(totalLen_);
         if (twinBuffer->bytes_ == nullptr) {
             outErrorNo = -E_OUT_OF_MEMORY;
             delete twinBuffer;
             twinBuffer = nullptr;
             return nullptr;
         }
+        twinBuffer->oringinalBytes_ = twinBuffer->bytes_; // So that the block is given back if copy fail
         errno_t errCode = memcpy_s(twinBuffer->bytes_, totalLen_, bytes_, totalLen_);
         if (errCode != EOK) {
             outErrorNo = -E_SECUREC_ERROR;
@@ -148,13 +150,13 @@ int SerialBuffer::ConvertForCrossThread()
         return E_OK;
     }
     // Logic guarantee all the member value: isExternalStackMemory_ is true; bytes_ is nullptr; totalLen_ is correct.
-    bytes_ = new (std::nothrow) uint8_t[totalLen_];
+    bytes_ = AllocBlock(totalLen_);
     if (bytes_ == nullptr) {
         return -E_OUT_OF_MEMORY;
     }
     errno_t errCode = memcpy_s(bytes_, totalLen_, externalBytes_, totalLen_);
     if (errCode != EOK) {
-        delete[] bytes_;
+        SerialBufferPool::GetInstance()->Release(bytes_, blockSize_, allocLen_);
         bytes_ = nullptr;
         return -E_SECUREC_ERROR;
     }
@@ -166,6 +168,15 @@ int SerialBuffer::ConvertForCrossThread()
     return E_OK;
 }
 
+uint8_t *SerialBuffer::AllocBlock(uint32_t length)
+{
+    uint8_t *block = SerialBufferPool::GetInstance()->Allocate(length, blockSize_);
+    if (block != nullptr) {
+        allocLen_ = length;
+    }
+    return block;
+}
+
 uint32_t SerialBuffer::GetSize() const
 {
     if (bytes_ == nullptr && externalBytes_ == nullptr) {
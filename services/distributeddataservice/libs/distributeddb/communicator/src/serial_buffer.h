@@ -63,6 +63,9 @@ public:
 
     static const uint32_t MAX_EXTEND_HEAD_LENGTH = 512;
 private:
+    // The block is from the SerialBufferPool, blockSize_ and allocLen_ are needed to give it back
+    uint8_t *AllocBlock(uint32_t length);
+
     uint8_t *oringinalBytes_ = nullptr; // all beytes start addr
     uint8_t *bytes_ = nullptr; // distributeddb start addr
     const uint8_t *externalBytes_ = nullptr;
@@ -73,6 +76,8 @@ private:
     // only apply message will use extend header
     uint32_t extendHeadLen_ = 0;
     bool isExternalStackMemory_ = false;
+    uint32_t blockSize_ = 0;
+    uint32_t allocLen_ = 0;
 };
 } // namespace DistributedDB
 
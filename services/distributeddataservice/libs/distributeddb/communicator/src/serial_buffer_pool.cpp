@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "serial_buffer_pool.h"
+#include <new>
+#include "log_print.h"
+
+namespace DistributedDB {
+class SerialBufferPool::ThreadCache {
+public:
+    ThreadCache() = default;
+    ~ThreadCache()
+    {
+        // The pool is never destructed, so the blocks can always be given back when the thread exits
+        SerialBufferPool *pool = SerialBufferPool::GetInstance();
+        for (uint32_t i = 0; i < THREAD_CACHE_CLASS_NUM; i++) {
+            for (uint8_t *block : blocks_[i]) {
+                pool->ReleaseToFreeList(i, block);
+            }
+            blocks_[i].clear();
+        }
+    }
+    DISABLE_COPY_ASSIGN_MOVE(ThreadCache);
+
+    uint8_t *Pop(uint32_t classIndex)
+    {
+        if (blocks_[classIndex].empty()) {
+            return nullptr;
+        }
+        uint8_t *block = blocks_[classIndex].back();
+        blocks_[classIndex].pop_back();
+        return block;
+    }
+
+    bool Push(uint32_t classIndex, uint8_t *block)
+    {
+        if (blocks_[classIndex].size() >= THREAD_CACHE_BLOCK_NUM) {
+            return false;
+        }
+        blocks_[classIndex].push_back(block);
+        return true;
+    }
+
+private:
+    std::vector<uint8_t *> blocks_[THREAD_CACHE_CLASS_NUM];
+};
+
+SerialBufferPool *SerialBufferPool::GetInstance()
+{
+    static char instMemory[sizeof(SerialBufferPool)];
+    static std::mutex instLock;
+    static std::atomic<SerialBufferPool *> instPtr = nullptr;
+    // For Double-Checked Locking, we need check insPtr twice
+    if (instPtr == nullptr) {
+        std::lock_guard<std::mutex> lock(instLock);
+        if (instPtr == nullptr) {
+            // Use instMemory to make sure this singleton not free before the thread caches and the SerialBuffers.
+            SerialBufferPool *pool = new (instMemory) SerialBufferPool;
+            pool->isThreadCached_ = true;
+            instPtr = pool;
+        }
+    }
+    return instPtr;
+}
+
+SerialBufferPool::~SerialBufferPool()
+{
+    for (auto &freeList : freeLists_) {
+        for (uint8_t *block : freeList) {
+            delete[] block;
+        }
+        freeList.clear();
+    }
+}
+
+SerialBufferPool::ThreadCache &SerialBufferPool::GetThreadCache()
+{
+    thread_local ThreadCache cache;
+    return cache;
+}
+
+uint32_t SerialBufferPool::GetClassIndex(uint32_t length)
+{
+    uint32_t classIndex = 0;
+    while (GetBlockSize(classIndex) < length) {
+        classIndex++;
+    }
+    return classIndex;
+}
+
+uint32_t SerialBufferPool::GetBlockSize(uint32_t classIndex)
+{
+    return 1u << (MIN_CLASS_SHIFT + classIndex);
+}
+
+uint8_t *SerialBufferPool::Allocate(uint32_t length, uint32_t &outBlockSize)
+{
+    // The larger blocks are not pooled, CLASS_NUM is out of the free lists and the thread caches
+    uint32_t classIndex = (length > MAX_BLOCK_SIZE) ? CLASS_NUM : GetClassIndex(length);
+    uint32_t blockSize = (length > MAX_BLOCK_SIZE) ? length : GetBlockSize(classIndex);
+    if (!TryReserveInUse(blockSize)) {
+        LOGE("[BufferPool][Alloc] Alloc block=%u over the limit, inUseBytes=%llu, memoryLimit=%llu.", blockSize,
+            ULL(inUseBytes_.load()), ULL(memoryLimit_.load()));
+        return nullptr;
+    }
+    uint8_t *block = nullptr;
+    if (isThreadCached_ && classIndex < THREAD_CACHE_CLASS_NUM) {
+        block = GetThreadCache().Pop(classIndex);
+    }
+    if (block == nullptr && classIndex < CLASS_NUM) {
+        std::lock_guard<std::mutex> freeListLockGuard(freeListMutex_);
+        if (!freeLists_[classIndex].empty()) {
+            block = freeLists_[classIndex].back();
+            freeLists_[classIndex].pop_back();
+        }
+    }
+    if (block != nullptr) {
+        idleBytes_ -= blockSize;
+        outBlockSize = blockSize;
+        OnBlockOut(length, true);
+        return block;
+    }
+    block = new (std::nothrow) uint8_t[blockSize];
+    if (block == nullptr) {
+        inUseBytes_ -= blockSize;
+        LOGE("[BufferPool][Alloc] Alloc block=%u fail, idleBytes=%llu.", blockSize, ULL(idleBytes_.load()));
+        return nullptr;
+    }
+    outBlockSize = blockSize;
+    OnBlockOut(length, false);
+    return block;
+}
+
+void SerialBufferPool::Release(uint8_t *block, uint32_t blockSize, uint32_t length)
+{
+    if (block == nullptr) {
+        return;
+    }
+    inUseBytes_ -= blockSize;
+    requestBytes_ -= length;
+    if (blockSize > MAX_BLOCK_SIZE || !TryReserveIdle(blockSize)) {
+        delete[] block;
+        return;
+    }
+    uint32_t classIndex = GetClassIndex(blockSize);
+    if (isThreadCached_ && classIndex < THREAD_CACHE_CLASS_NUM && GetThreadCache().Push(classIndex, block)) {
+        return;
+    }
+    std::lock_guard<std::mutex> freeListLockGuard(freeListMutex_);
+    freeLists_[classIndex].push_back(block);
+}
+
+void SerialBufferPool::AddMemoryShare(uint64_t share)
+{
+    {
+        std::lock_guard<std::mutex> shareLockGuard(shareMutex_);
+        shares_.insert(share);
+        UpdateLimits();
+    }
+    ShrinkIdleBlocks(false);
+}
+
+void SerialBufferPool::RemoveMemoryShare(uint64_t share)
+{
+    {
+        std::lock_guard<std::mutex> shareLockGuard(shareMutex_);
+        auto iter = shares_.find(share);
+        if (iter == shares_.end()) {
+            return;
+        }
+        shares_.erase(iter);
+        UpdateLimits();
+    }
+    ShrinkIdleBlocks(false);
+}
+
+void SerialBufferPool::ReleaseIdleBlocks()
+{
+    ShrinkIdleBlocks(true);
+}
+
+SerialBufferPoolStat SerialBufferPool::GetStat() const
+{
+    SerialBufferPoolStat stat;
+    stat.allocCount = allocCount_;
+    stat.hitCount = hitCount_;
+    stat.inUseBytes = inUseBytes_;
+    stat.requestBytes = requestBytes_;
+    stat.peakInUseBytes = peakInUseBytes_;
+    stat.idleBytes = idleBytes_;
+    stat.idleLimit = idleLimit_;
+    stat.memoryLimit = memoryLimit_;
+    return stat;
+}
+
+bool SerialBufferPool::TryReserveInUse(uint32_t blockSize)
+{
+    uint64_t curInUseBytes = inUseBytes_.load();
+    do {
+        if (curInUseBytes + blockSize > memoryLimit_) {
+            return false;
+        }
+    } while (!inUseBytes_.compare_exchange_weak(curInUseBytes, curInUseBytes + blockSize));
+    curInUseBytes += blockSize;
+    uint64_t peak = peakInUseBytes_.load();
+    while (curInUseBytes > peak && !peakInUseBytes_.compare_exchange_weak(peak, curInUseBytes)) {
+    }
+    return true;
+}
+
+bool SerialBufferPool::TryReserveIdle(uint32_t blockSize)
+{
+    uint64_t curIdleBytes = idleBytes_.load();
+    do {
+        if (curIdleBytes + blockSize > idleLimit_) {
+            return false;
+        }
+    } while (!idleBytes_.compare_exchange_weak(curIdleBytes, curIdleBytes + blockSize));
+    return true;
+}
+
+void SerialBufferPool::ReleaseToFreeList(uint32_t classIndex, uint8_t *block)
+{
+    std::lock_guard<std::mutex> freeListLockGuard(freeListMutex_);
+    freeLists_[classIndex].push_back(block);
+}
+
+void SerialBufferPool::ShrinkIdleBlocks(bool isReleaseAll)
+{
+    std::vector<uint8_t *> blocksToFree;
+    {
+        std::lock_guard<std::mutex> freeListLockGuard(freeListMutex_);
+        // Free the large blocks first, they are the ones that keep the memory high
+        for (uint32_t i = CLASS_NUM; i > 0; i--) {
+            std::vector<uint8_t *> &freeList = freeLists_[i - 1];
+            while (!freeList.empty() && (isReleaseAll || idleBytes_ > idleLimit_)) {
+                blocksToFree.push_back(freeList.back());
+                freeList.pop_back();
+                idleBytes_ -= GetBlockSize(i - 1);
+            }
+        }
+    }
+    for (uint8_t *block : blocksToFree) {
+        delete[] block;
+    }
+    if (!blocksToFree.empty()) {
+        LOGI("[BufferPool][Shrink] Free %zu blocks, idleBytes=%llu.", blocksToFree.size(), ULL(idleBytes_.load()));
+    }
+}
+
+void SerialBufferPool::OnBlockOut(uint32_t length, bool isHit)
+{
+    allocCount_++;
+    if (isHit) {
+        hitCount_++;
+    }
+    requestBytes_ += length;
+}
+
+void SerialBufferPool::UpdateLimits()
+{
+    if (shares_.empty()) {
+        idleLimit_ = DEFAULT_MEMORY_SHARE / IDLE_SHARE_RATIO;
+        memoryLimit_ = DEFAULT_MEMORY_SHARE;
+        return;
+    }
+    uint64_t sumShare = 0;
+    for (uint64_t share : shares_) {
+        sumShare += share;
+    }
+    idleLimit_ = *shares_.rbegin() / IDLE_SHARE_RATIO;
+    memoryLimit_ = (sumShare > MIN_MEMORY_LIMIT) ? sumShare : MIN_MEMORY_LIMIT;
+}
+} // namespace DistributedDB
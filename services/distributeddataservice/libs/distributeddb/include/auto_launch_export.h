@@ -38,6 +38,7 @@ struct AutoLaunchOption {
     bool isNeedRmCorruptedDb = false;
     bool isNeedCompressOnSync = false;
     uint8_t compressionRate = 100; // valid in [1, 100].
+    bool isNeedDigestSync = false;
     bool isAutoSync = true;
     StoreObserver *storeObserver = nullptr;
     bool syncDualTupleMode = false; // communicator label use dualTuple hash or not
@@ -163,6 +163,8 @@ struct SecurityOption {
 enum class ResultSetCacheMode : int {
     CACHE_FULL_ENTRY = 0,       // Ordinary mode efficient when sequential access, the default mode
     CACHE_ENTRY_ID_ONLY = 1,    // Special mode efficient when random access
+    CACHE_ENTRY_PREFETCH = 2,   // Cache the rowid and prefetch the entries in windows, efficient when sequential access
+                                // The prefetched entries are of the snapshot read when the result set is opened
 };
 
 struct RemotePushNotifyInfo {
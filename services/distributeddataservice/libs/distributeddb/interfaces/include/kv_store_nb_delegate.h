@@ -54,6 +54,8 @@ public:
         bool isNeedCompressOnSync = false;
         uint8_t compressionRate = 100; // Valid in [1, 100].
         bool syncDualTupleMode = false; // communicator label use dualTuple hash or not
+        bool isNeedDigestSync = false; // skip the data already same on the remote by the digest before push
+        StorageProfile profile; // The tuning of the sqlite connections, see StorageProfilePreset
     };
 
     DB_API virtual ~KvStoreNbDelegate() {}
@@ -29,6 +29,7 @@ public:
 
     struct Option {
         StoreObserver *observer = nullptr;
+        StorageProfile profile; // The tuning of the sqlite connections, see StorageProfilePreset
         // split mode
     };
 
@@ -111,6 +111,30 @@ enum ConflictResolvePolicy {
     DEVICE_COLLABORATION,
 };
 
+// The tuning of the sqlite connections of a store, applied to every connection the store opens. It only takes effect
+// when the store is opened the first time in the process. The negative value keeps the sqlite default.
+struct StorageProfile {
+    int cacheSize = -1; // The page cache of each connection, in KB
+    int mmapSize = -1; // The memory mapped I/O of each connection, in KB, 0 means disabled
+    int pageSize = -1; // In bytes, a power of two in [512, 65536], only used when the database file is created
+    int tempStore = -1; // Where the temp tables and indices are, 0 means default, 1 means file, 2 means memory
+    int walAutoCheckpoint = -1; // Checkpoint when the wal reaches the pages, 0 means disabled
+    int journalSizeLimit = -1; // The wal file is truncated to it after checkpoint, in KB
+    // Checkpoint the wal in the background instead of in the committing write, only for the kv store.
+    // walAutoCheckpoint is then the wal pages to start the checkpoint, or 1000 pages if it is not positive.
+    bool backgroundCheckpoint = false;
+};
+
+namespace StorageProfilePreset {
+// Mostly read: larger cache and the file mapped into the memory
+const StorageProfile READ_HEAVY = { 8192, 262144, -1, 2, -1, -1, false }; // 8MB cache, 256MB mmap, temp in memory
+// Mostly write: checkpoint less often and bound the wal left after it
+// 4MB cache, 4000 pages, 16MB wal kept, checkpoint in the background
+const StorageProfile WRITE_HEAVY = { 4096, -1, -1, 2, 4000, 16384, true };
+// Keep the memory small: small cache, no mmap, temp on file and the wal kept short
+const StorageProfile LOW_MEMORY = { 512, 0, -1, 1, 500, 1024, false }; // 512KB cache, 500 pages, 1MB wal kept
+} // namespace StorageProfilePreset
+
 struct TableStatus {
     std::string tableName;
     DBStatus status;
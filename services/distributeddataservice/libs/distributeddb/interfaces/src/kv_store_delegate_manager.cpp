@@ -109,6 +109,8 @@ namespace {
                 ParamCheckUtils::GetValidCompressionRate(option.compressionRate));
         }
         properties.SetBoolProp(KvDBProperties::SYNC_DUAL_TUPLE_MODE, option.syncDualTupleMode);
+        properties.SetBoolProp(KvDBProperties::DIGEST_SYNC, option.isNeedDigestSync);
+        properties.SetStorageProfile(option.profile);
     }
 
     bool CheckObserverConflictParam(const KvStoreNbDelegate::Option &option)
@@ -281,6 +283,10 @@ bool KvStoreDelegateManager::GetKvStoreParamCheck(const std::string &storeId, co
         callback(INVALID_ARGS, nullptr);
         return false;
     }
+    if (!ParamCheckUtils::CheckStorageProfile(option.profile)) {
+        callback(INVALID_ARGS, nullptr);
+        return false;
+    }
     return true;
 }
 
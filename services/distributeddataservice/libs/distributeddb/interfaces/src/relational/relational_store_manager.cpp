@@ -80,8 +80,13 @@ DB_API DBStatus RelationalStoreManager::OpenStore(const std::string &path, const
         return INVALID_ARGS;
     }
 
+    if (!ParamCheckUtils::CheckStorageProfile(option.profile)) {
+        return INVALID_ARGS;
+    }
+
     RelationalDBProperties properties;
     InitStoreProp(canonicalDir, appId_, userId_, storeId, properties);
+    properties.SetStorageProfile(option.profile);
 
     int errCode = E_OK;
     auto *conn = GetOneConnectionWithRetry(properties, errCode);
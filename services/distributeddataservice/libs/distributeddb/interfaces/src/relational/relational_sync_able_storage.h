@@ -131,6 +131,9 @@ private:
     int PutSyncData(const QueryObject &object, std::vector<DataItem> &dataItems, const std::string &deviceName);
     int SaveSyncDataItems(const QueryObject &object, std::vector<DataItem> &dataItems, const std::string &deviceName);
 
+    // device table
+    bool IsDeviceTableCreated(const std::string &device, const std::vector<std::string> &tableNames, int &errCode);
+
     // data
     SQLiteSingleRelationalStorageEngine *storageEngine_ = nullptr;
     KvDBProperties properties_;
@@ -141,6 +144,7 @@ private:
     RelationalObserverAction dataChangeDeviceCallback_;
     std::function<void()> heartBeatListener_;
     mutable std::mutex heartBeatMutex_;
+    RelationalDeviceTableManager deviceTableManager_;
 };
 }  // namespace DistributedDB
 #endif
@@ -18,6 +18,8 @@
 #include <map>
 #include <string>
 
+#include "store_types.h"
+
 namespace DistributedDB {
 class DBProperties {
 public:
@@ -42,6 +44,10 @@ public:
     // Set all indentifers
     void SetIdentifier(const std::string &userId, const std::string &appId, const std::string &storeId);
 
+    // The tuning of the sqlite connections, kept as the integer properties
+    void SetStorageProfile(const StorageProfile &profile);
+    StorageProfile GetStorageProfile() const;
+
     static const std::string CREATE_IF_NECESSARY;
     static const std::string DATABASE_TYPE;
     static const std::string DATA_DIR;
@@ -52,6 +58,13 @@ public:
     static const std::string IDENTIFIER_DIR;
     static const std::string DUAL_TUPLE_IDENTIFIER_DATA;
     static const std::string SYNC_DUAL_TUPLE_MODE;
+    static const std::string CACHE_SIZE;
+    static const std::string MMAP_SIZE;
+    static const std::string PAGE_SIZE;
+    static const std::string TEMP_STORE;
+    static const std::string WAL_AUTO_CHECKPOINT;
+    static const std::string JOURNAL_SIZE_LIMIT;
+    static const std::string BACKGROUND_CHECKPOINT;
 
 protected:
     DBProperties() = default;
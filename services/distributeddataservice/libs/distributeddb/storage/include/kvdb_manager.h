@@ -18,8 +18,8 @@
 
 #include <string>
 #include <map>
+#include <memory>
 #include <mutex>
-#include <set>
 #include <condition_variable>
 
 #include "db_errno.h"
@@ -125,9 +125,17 @@ private:
     static int TryLockDB(const KvDBProperties &kvDBProp, int retryTimes);
     static int UnlockDB(const KvDBProperties &kvDBProp);
 
+    // Latch of one identifier, the waiters of different identifiers never wake up each other.
+    struct DBOpenCloseLatch {
+        bool isBusy = false;
+        uint32_t refCount = 0;
+        std::condition_variable condition;
+    };
+
     static std::atomic<KvDBManager *> instance_;
     static std::mutex kvDBLock_;
     static std::mutex instanceLock_;
+    static std::mutex fileLocksMutex_;
     static std::map<std::string, OS::FileHandle> locks_;
 
     std::map<std::string, IKvDB *> localKvDBs_;
@@ -136,8 +144,7 @@ private:
 
     std::mutex corruptMutex_;
     std::mutex kvDBOpenMutex_;
-    std::condition_variable kvDBOpenCondition_;
-    std::set<std::string> kvDBOpenSet_;
+    std::map<std::string, std::shared_ptr<DBOpenCloseLatch>> kvDBOpenLatches_;
     KvStoreCorruptionHandler corruptHandler_;
 };
 } // namespace DistributedDB
@@ -21,6 +21,7 @@
 #include <list>
 #include <mutex>
 #include <atomic>
+#include <chrono>
 #include <string>
 #include <vector>
 #include <cstdint>
@@ -39,22 +40,43 @@ enum class VacuumTaskStatus {
     FINISH,
 };
 
+// The budget of zero means unlimited, so the default policy vacuums the databases one by one in one transaction.
+struct VacuumPolicy {
+    uint32_t maxConcurrentTasks = 1; // Databases vacuumed at the same time, each on one thread of the task pool
+    uint32_t sliceRowBudget = 0; // Rows changed in one transaction before it is committed
+    uint32_t sliceTimeBudget = 0; // Milliseconds of one transaction before it is committed
+};
+
+struct VacuumTaskStatistics {
+    uint64_t slicesCommitted = 0;
+    uint64_t recordsReclaimed = 0;
+    uint64_t commitsVacuumed = 0;
+    uint64_t pauseWaitCount = 0; // Pause that had to wait for the running task
+    uint64_t totalPauseWaitTime = 0; // In microsecond
+    uint64_t maxPauseWaitTime = 0; // In microsecond
+};
+
 struct VacuumTaskContext {
     VacuumTaskStatus status = VacuumTaskStatus::RUN_WAIT;
     bool launchErrorHappen = false;
     bool autoRelaunchOnce = false;
     bool immediatelyRelaunchable = true;
     uint64_t runWaitOrder = 0;
+    uint32_t passedOverCount = 0; // Times not chosen while waiting, to raise the priority of a small database
     uint64_t pauseNeedCount = 0;
     MultiVerVacuumExecutor *databaseHandle = nullptr;
     // Information to conduct the vacuum task and record the progress.
-    // When in RUN_NING, PAUSE_WAIT, ABORT_WAIT status, no other thread except the only one background task thread
-    // will access and change these field, so there is no concurrency risk accessing and changing it without a lock.
+    // When in RUN_NING, PAUSE_WAIT, ABORT_WAIT status, no other thread except the background task thread executing
+    // it will access and change these field, so there is no concurrency risk accessing and changing it without a lock.
     std::list<MultiVerCommitInfo> leftBranchCommits;
     std::list<MultiVerCommitInfo> rightBranchCommits;
     std::list<MultiVerRecordInfo> vacuumNeedRecords;
     std::list<MultiVerRecordInfo> shadowRecords;
     bool isTransactionStarted = false;
+    uint32_t sliceRowCount = 0;
+    std::chrono::steady_clock::time_point sliceStartTime;
+    // Changed within the lock since QueryStatistics may read it at any time.
+    VacuumTaskStatistics statistics;
 };
 
 // Pause and Continue should be call in pair for the same database. If Pause called more than Continue, then the task
@@ -86,7 +108,10 @@ public:
 
     int QueryStatus(const std::string &dbIdentifier, VacuumTaskStatus &outStatus) const;
 
+    int QueryStatistics(const std::string &dbIdentifier, VacuumTaskStatistics &outStatistics) const;
+
     MultiVerVacuum() = default;
+    explicit MultiVerVacuum(const VacuumPolicy &policy);
     ~MultiVerVacuum();
 private:
     void VacuumTaskExecutor();
@@ -108,6 +133,7 @@ private:
     // Only for reducing duplicated code
     void DoRollBackAndFinish(VacuumTaskContext &inTask);
     int DoCommitAndQuitIfWaitStatusObserved(VacuumTaskContext &inTask); // Return E_OK continue otherwise quit
+    int DoCommitAndYieldIfBudgetUsedUp(VacuumTaskContext &inTask); // Return E_OK continue otherwise quit
 
     // Call this immediately before changing the database
     int StartTransactionIfNotYet(VacuumTaskContext &inTask);
@@ -124,6 +150,8 @@ private:
     void AbortVacuumTask(VacuumTaskContext &inTask);
     void ResetNodeAndRecordContextInfo(VacuumTaskContext &inTask);
     int SearchVacuumTaskToExecute(std::string &outDbIdentifier);
+    uint64_t GetVacuumTaskPriority(const VacuumTaskContext &inTask) const;
+    bool IsOtherVacuumTaskWaiting() const;
     void ActivateBackgroundVacuumTaskExecution();
     void IncPauseNeedCount(VacuumTaskContext &inTask);
     void DecPauseNeedCount(VacuumTaskContext &inTask);
@@ -131,20 +159,22 @@ private:
 
     static std::atomic<bool> enabled_;
 
+    const VacuumPolicy policy_;
+
     mutable std::mutex vacuumTaskMutex_;
     std::condition_variable vacuumTaskCv_;
     uint64_t incRunWaitOrder_ = 0;
     std::map<std::string, VacuumTaskContext> dbMapVacuumTask_;
 
-    // the search of available vacuumtask, the change of isBackgroundVacuumTaskInExecution_, and the activation of
+    // the search of available vacuumtask, the change of backgroundExecutionCount_, and the activation of
     // background execution, should all be protected by vacuumTaskMutex_, In order to avoid malfunction caused by
     // concurrency situation which is described below:
     // 1:Background search vacuumtask return none so decided to exit.
     // 2:Foreground make vacuumtask available.
-    // 3:Foreground check isBackgroundVacuumTaskInExecution_ true so decided to nothing.
-    // 4:Background set isBackgroundVacuumTaskInExecution_ to false and exit.
+    // 3:Foreground check backgroundExecutionCount_ enough so decided to nothing.
+    // 4:Background decrease backgroundExecutionCount_ and exit.
     // In this situation, no background execution running with available vacuumtask needs to be done.
-    bool isBackgroundVacuumTaskInExecution_ = false;
+    uint32_t backgroundExecutionCount_ = 0;
 };
 } // namespace DistributedDB
 
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SYNC_DIGEST_H
+#define SYNC_DIGEST_H
+
+#include <cstdint>
+#include <vector>
+
+#include "db_types.h"
+
+namespace DistributedDB {
+// The hash tree of the sync data. The records are put into the leaf buckets by the leading bits of the hash key, the
+// digest of a bucket is the xor of the digests of its records, so it can be maintained when a record is written. The
+// nodes of the first level are the xor of their leaves, two devices compare the nodes first and then the leaves of
+// the different nodes.
+class SyncDigest {
+public:
+    static constexpr uint32_t NODE_NUM = 32;
+    static constexpr uint32_t LEAF_NUM_PER_NODE = 32;
+    static constexpr uint32_t LEAF_NUM = NODE_NUM * LEAF_NUM_PER_NODE;
+
+    SyncDigest();
+    ~SyncDigest() = default;
+
+    // The bucket of a record by its hash key.
+    static uint32_t GetBucket(const uint8_t *hashKey, uint32_t hashKeyLen);
+
+    // Only the hash key, the value and the delete flag of a record are digested, which are the same on all the devices.
+    static uint64_t CalcRecordDigest(const uint8_t *hashKey, uint32_t hashKeyLen, const uint8_t *value,
+        uint32_t valueLen, uint64_t flag);
+
+    void AddRecord(uint32_t bucket, uint64_t recordDigest);
+
+    void SetLeaf(uint32_t bucket, uint64_t digest);
+    uint64_t GetLeaf(uint32_t bucket) const;
+
+    std::vector<uint64_t> GetNodes() const;
+    std::vector<uint64_t> GetNodeLeaves(uint32_t node) const;
+
+    // The max timestamp of the sync data when the digest is read, the later records are not covered.
+    void SetTimestamp(Timestamp timestamp);
+    Timestamp GetTimestamp() const;
+
+private:
+    std::vector<uint64_t> leaves_;
+    Timestamp timestamp_ = 0;
+};
+} // namespace DistributedDB
+#endif // SYNC_DIGEST_H
@@ -15,11 +15,16 @@
 #ifndef SYNC_GENERIC_INTERFACE_H
 #define SYNC_GENERIC_INTERFACE_H
 
+#include <memory>
+
 #include "isync_interface.h"
 #include "single_ver_kv_entry.h"
 #include "query_object.h"
+#include "sync_digest.h"
 
 namespace DistributedDB {
+class SyncDataCompressCache;
+
 class SyncGenericInterface : public ISyncInterface {
 public:
     // Constructor/Destructor.
@@ -115,6 +120,24 @@ public:
         return -E_NOT_SUPPORT;
     }
 
+    // Return true if the data pushed may be changed for each device by the interceptor.
+    virtual bool HasDataInterceptor() const
+    {
+        return false;
+    }
+
+    // The compressed packets shared by the sync tasks of this store, nullptr if they are not shared.
+    virtual std::shared_ptr<SyncDataCompressCache> GetSyncDataCompressCache() const
+    {
+        return nullptr;
+    }
+
+    // Get the hash tree of all the sync data, only supported if the digest sync is enabled.
+    virtual int GetSyncDigest(SyncDigest &digest) const
+    {
+        return -E_NOT_SUPPORT;
+    }
+
     virtual int AddSubscribe(const std::string &subscribeId, const QueryObject &query, bool needCacheSubscribe)
     {
         return -E_NOT_SUPPORT;
@@ -27,6 +27,13 @@ const std::string DBProperties::IDENTIFIER_DATA = "identifier";
 const std::string DBProperties::IDENTIFIER_DIR = "identifierDir";
 const std::string DBProperties::DUAL_TUPLE_IDENTIFIER_DATA = "dualTupleIdentifier";
 const std::string DBProperties::SYNC_DUAL_TUPLE_MODE = "syncDualTuple";
+const std::string DBProperties::CACHE_SIZE = "cacheSize";
+const std::string DBProperties::MMAP_SIZE = "mmapSize";
+const std::string DBProperties::PAGE_SIZE = "pageSize";
+const std::string DBProperties::TEMP_STORE = "tempStore";
+const std::string DBProperties::WAL_AUTO_CHECKPOINT = "walAutoCheckpoint";
+const std::string DBProperties::JOURNAL_SIZE_LIMIT = "journalSizeLimit";
+const std::string DBProperties::BACKGROUND_CHECKPOINT = "backgroundCheckpoint";
 
 std::string DBProperties::GetStringProp(const std::string &name, const std::string &defaultValue) const
 {
@@ -80,4 +87,28 @@ void DBProperties::SetIdentifier(const std::string &userId, const std::string &a
     std::string dualIdentifier = DBCommon::TransferHashString(DBCommon::GenerateDualTupleIdentifierId(storeId, appId));
     SetStringProp(DBProperties::DUAL_TUPLE_IDENTIFIER_DATA, dualIdentifier);
 }
+
+void DBProperties::SetStorageProfile(const StorageProfile &profile)
+{
+    SetIntProp(DBProperties::CACHE_SIZE, profile.cacheSize);
+    SetIntProp(DBProperties::MMAP_SIZE, profile.mmapSize);
+    SetIntProp(DBProperties::PAGE_SIZE, profile.pageSize);
+    SetIntProp(DBProperties::TEMP_STORE, profile.tempStore);
+    SetIntProp(DBProperties::WAL_AUTO_CHECKPOINT, profile.walAutoCheckpoint);
+    SetIntProp(DBProperties::JOURNAL_SIZE_LIMIT, profile.journalSizeLimit);
+    SetBoolProp(DBProperties::BACKGROUND_CHECKPOINT, profile.backgroundCheckpoint);
+}
+
+StorageProfile DBProperties::GetStorageProfile() const
+{
+    StorageProfile profile;
+    profile.cacheSize = GetIntProp(DBProperties::CACHE_SIZE, profile.cacheSize);
+    profile.mmapSize = GetIntProp(DBProperties::MMAP_SIZE, profile.mmapSize);
+    profile.pageSize = GetIntProp(DBProperties::PAGE_SIZE, profile.pageSize);
+    profile.tempStore = GetIntProp(DBProperties::TEMP_STORE, profile.tempStore);
+    profile.walAutoCheckpoint = GetIntProp(DBProperties::WAL_AUTO_CHECKPOINT, profile.walAutoCheckpoint);
+    profile.journalSizeLimit = GetIntProp(DBProperties::JOURNAL_SIZE_LIMIT, profile.journalSizeLimit);
+    profile.backgroundCheckpoint = GetBoolProp(DBProperties::BACKGROUND_CHECKPOINT, profile.backgroundCheckpoint);
+    return profile;
+}
 }
\ No newline at end of file
@@ -28,6 +28,7 @@ const std::string KvDBManager::PROCESS_LABEL_CONNECTOR = "-";
 std::atomic<KvDBManager *> KvDBManager::instance_{nullptr};
 std::mutex KvDBManager::kvDBLock_;
 std::mutex KvDBManager::instanceLock_;
+std::mutex KvDBManager::fileLocksMutex_;
 std::map<std::string, OS::FileHandle> KvDBManager::locks_;
 
 namespace {
@@ -161,20 +162,39 @@ IKvDB *KvDBManager::OpenDatabase(const KvDBProperties &property, int &errCode)
     return manager->GetDataBase(property, errCode, true);
 }
 
+// Only the open/close of the same identifier is serialized, the slow open of one store(rekey, upgrade or
+// integrity check) does not block the other stores. The later comer of the same identifier finds the db in cache.
 void KvDBManager::EnterDBOpenCloseProcess(const std::string &identifier)
 {
     std::unique_lock<std::mutex> lock(kvDBOpenMutex_);
-    kvDBOpenCondition_.wait(lock, [this, &identifier]() {
-        return this->kvDBOpenSet_.count(identifier) == 0;
+    std::shared_ptr<DBOpenCloseLatch> &latch = kvDBOpenLatches_[identifier];
+    if (latch == nullptr) {
+        latch = std::make_shared<DBOpenCloseLatch>();
+    }
+    std::shared_ptr<DBOpenCloseLatch> holder = latch;
+    holder->refCount++;
+    holder->condition.wait(lock, [&holder]() {
+        return !holder->isBusy;
     });
-    (void)kvDBOpenSet_.insert(identifier);
+    holder->isBusy = true;
 }
 
 void KvDBManager::ExitDBOpenCloseProcess(const std::string &identifier)
 {
     std::unique_lock<std::mutex> lock(kvDBOpenMutex_);
-    (void)kvDBOpenSet_.erase(identifier);
-    kvDBOpenCondition_.notify_all();
+    auto iter = kvDBOpenLatches_.find(identifier);
+    if (iter == kvDBOpenLatches_.end() || iter->second == nullptr) {
+        LOGE("[KvDBManager] Exit open close process without enter.");
+        return;
+    }
+    std::shared_ptr<DBOpenCloseLatch> latch = iter->second;
+    latch->isBusy = false;
+    latch->refCount--;
+    if (latch->refCount == 0) {
+        kvDBOpenLatches_.erase(iter);
+        return;
+    }
+    latch->condition.notify_one();
 }
 
 // one time 100ms
@@ -194,9 +214,12 @@ int KvDBManager::TryLockDB(const KvDBProperties &kvDBProp, int retryTimes)
         return E_OK;
     }
 
-    if (locks_.count(id) != 0) {
-        LOGI("db has been locked!");
-        return E_OK;
+    {
+        std::lock_guard<std::mutex> lockGuard(fileLocksMutex_);
+        if (locks_.count(id) != 0) {
+            LOGI("db has been locked!");
+            return E_OK;
+        }
     }
 
     std::string hexHashId = DBCommon::TransferStringToHex((id));
@@ -211,6 +234,7 @@ int KvDBManager::TryLockDB(const KvDBProperties &kvDBProp, int retryTimes)
         errCode = OS::FileLock(handle, false); // not block process
         if (errCode == E_OK) {
             LOGI("[%s]locked!", STR_MASK(DBCommon::TransferStringToHex(KvDBManager::GenerateKvDBIdentifier(kvDBProp))));
+            std::lock_guard<std::mutex> lockGuard(fileLocksMutex_);
             locks_[id] = handle;
             return errCode;
         } else if (errCode == -E_BUSY) {
@@ -234,15 +258,17 @@ int KvDBManager::UnlockDB(const KvDBProperties &kvDBProp)
         return E_OK;
     }
     std::string identifierDir = KvDBManager::GenerateKvDBIdentifier(kvDBProp);
-    if (locks_.count(identifierDir) == 0) {
+    std::lock_guard<std::mutex> lockGuard(fileLocksMutex_);
+    auto iter = locks_.find(identifierDir);
+    if (iter == locks_.end()) {
         return E_OK;
     }
-    int errCode = OS::FileUnlock(locks_[identifierDir]);
+    int errCode = OS::FileUnlock(iter->second);
     LOGI("DB unlocked! errCode = [%d]", errCode);
     if (errCode != E_OK) {
         return errCode;
     }
-    locks_.erase(identifierDir);
+    locks_.erase(iter);
     return E_OK;
 }
 
@@ -418,10 +444,13 @@ int KvDBManager::CalculateKvStoreSize(const KvDBProperties &properties, uint64_t
         return -E_OUT_OF_MEMORY;
     }
 
-    std::lock_guard<std::mutex> lockGuard(kvDBLock_);
-    if (manager->IsOpenMemoryDb(properties, manager->singleVerNaturalStores_)) {
-        size = 0;
-        return E_OK;
+    {
+        // only hold the global lock for the cache lookup, the file size calculation is done without it.
+        std::lock_guard<std::mutex> lockGuard(kvDBLock_);
+        if (manager->IsOpenMemoryDb(properties, manager->singleVerNaturalStores_)) {
+            size = 0;
+            return E_OK;
+        }
     }
 
     IKvDBFactory *factory = IKvDBFactory::GetCurrent();
@@ -30,6 +30,7 @@ const std::string KvDBProperties::CHECK_INTEGRITY = "checkIntegrity";
 const std::string KvDBProperties::RM_CORRUPTED_DB = "rmCorruptedDb";
 const std::string KvDBProperties::COMPRESS_ON_SYNC = "needCompressOnSync";
 const std::string KvDBProperties::COMPRESSION_RATE = "compressionRate";
+const std::string KvDBProperties::DIGEST_SYNC = "needDigestSync";
 
 KvDBProperties::KvDBProperties()
     : cipherType_(CipherType::AES_256_GCM)
@@ -184,11 +184,13 @@ static int PutSliceCount(IKvDBConnection *kvDBConnection, const Key &sliceKey, u
     return errCode;
 }
 
-static int PutSlice(IKvDBConnection *kvDBConnection, const Key &key, const Value &value, bool isAddCount)
+static int PutSlice(IKvDBConnection *kvDBConnection, const Key &key, const Value &value, bool isAddCount,
+    bool &isExisted)
 {
     std::vector<Entry> entries;
     int errCode = GetEntries(kvDBConnection, key, entries);
     uint32_t dataCount = 1;
+    isExisted = (errCode == E_OK);
     switch (errCode) {
         case E_OK:
             if (entries.size() != EXPECT_ENTRIES_NUM) {
@@ -495,6 +497,34 @@ void MultiVerKvDataStorage::ReleaseSliceTransaction(SliceTransaction *&transacti
     return;
 }
 
+void MultiVerKvDataStorage::RecordValueSlice(size_t sliceSize, bool isDuplicated)
+{
+    std::lock_guard<std::mutex> lock(statisticsMutex_);
+    sliceStatistics_.sliceCount++;
+    sliceStatistics_.sliceBytes += sliceSize;
+    if (isDuplicated) {
+        sliceStatistics_.duplicatedCount++;
+        sliceStatistics_.duplicatedBytes += sliceSize;
+    }
+}
+
+void MultiVerKvDataStorage::RecordSyncValueSlice(size_t sliceSize, bool isSkipped)
+{
+    std::lock_guard<std::mutex> lock(statisticsMutex_);
+    if (isSkipped) {
+        sliceStatistics_.syncSkippedCount++;
+        return;
+    }
+    sliceStatistics_.syncReceivedCount++;
+    sliceStatistics_.syncReceivedBytes += sliceSize;
+}
+
+ValueSliceStatistics MultiVerKvDataStorage::GetValueSliceStatistics() const
+{
+    std::lock_guard<std::mutex> lock(statisticsMutex_);
+    return sliceStatistics_;
+}
+
 SliceTransaction::SliceTransaction(bool isWrite, IKvDBConnection *connect)
     : isWrite_(isWrite),
       connect_(connect)
@@ -511,12 +541,12 @@ int SliceTransaction::Close()
     return connect_->Close();
 }
 
-int SliceTransaction::PutData(const Key &key, const Value &value, bool isAddCount)
+int SliceTransaction::PutData(const Key &key, const Value &value, bool isAddCount, bool &isExisted)
 {
     if (!isWrite_) {
         return -E_INVALID_CONNECTION;
     }
-    return PutSlice(connect_, key, value, isAddCount);
+    return PutSlice(connect_, key, value, isAddCount, isExisted);
 }
 
 int SliceTransaction::GetData(const Key &key, Value &value) const
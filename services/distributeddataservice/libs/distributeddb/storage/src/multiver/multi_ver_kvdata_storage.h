@@ -29,7 +29,8 @@ public:
     SliceTransaction(bool isWrite, IKvDBConnection *connect);
     ~SliceTransaction();
     int Close();
-    int PutData(const Key &key, const Value &value, bool isAddCount);
+    // isExisted is true if the slice was stored before, then only its count is added
+    int PutData(const Key &key, const Value &value, bool isAddCount, bool &isExisted);
     int GetData(const Key &key, Value &value) const;
     int DeleteData(const Key &key);
     int StartTransaction();
@@ -40,6 +41,18 @@ private:
     IKvDBConnection *connect_;
 };
 
+// The slices of the values written locally, the duplicated ones are shared with the slices already stored.
+// The slices of the values synced, the ones already stored are skipped and only the others are received.
+struct ValueSliceStatistics {
+    uint64_t sliceCount = 0;
+    uint64_t sliceBytes = 0;
+    uint64_t duplicatedCount = 0;
+    uint64_t duplicatedBytes = 0;
+    uint64_t syncSkippedCount = 0;
+    uint64_t syncReceivedCount = 0;
+    uint64_t syncReceivedBytes = 0;
+};
+
 class MultiVerKvDataStorage {
 public:
     struct Property final {
@@ -67,6 +80,12 @@ public:
 
     void ReleaseSliceTransaction(SliceTransaction *&transaction);
 
+    void RecordValueSlice(size_t sliceSize, bool isDuplicated);
+
+    void RecordSyncValueSlice(size_t sliceSize, bool isSkipped);
+
+    ValueSliceStatistics GetValueSliceStatistics() const;
+
     int RunRekeyLogic(CipherType type, const CipherPassword &passwd);
 
     int RunExportLogic(CipherType type, const CipherPassword &passwd, const std::string &dbDir) const;
@@ -87,6 +106,8 @@ private:
     IKvDBConnection *metaStorageConnection_;
     mutable std::mutex metaDataMutex_;
     mutable std::mutex kvDataMutex_;
+    mutable std::mutex statisticsMutex_;
+    ValueSliceStatistics sliceStatistics_;
 };
 }
 
@@ -215,7 +215,8 @@ namespace {
     }
 }
 
-MultiVerVacuum MultiVerNaturalStore::shadowTrimmer_;
+// Vacuum two databases at the same time, commit every 256 rows or 50 ms so that the writer does not wait long.
+MultiVerVacuum MultiVerNaturalStore::shadowTrimmer_(VacuumPolicy {2, 256, 50});
 MultiVerNaturalStore::MultiVerNaturalStore()
     : multiVerData_(nullptr),
       commitHistory_(nullptr),
@@ -639,6 +640,10 @@ bool MultiVerNaturalStore::IsValueSliceExisted(const ValueSliceHash &value) cons
 
     bool result = handle->IsValueSliceExisted(value, errCode);
     ReleaseHandle(handle);
+    // only the value slice sync checks the slices, the existed ones are not requested from the remote
+    if (result && multiVerKvStorage_ != nullptr) {
+        multiVerKvStorage_->RecordSyncValueSlice(0, true);
+    }
     return result;
 }
 
@@ -665,6 +670,9 @@ int MultiVerNaturalStore::PutValueSlice(const ValueSliceHash &hashValue, const V
 
     errCode = handle->PutValueSlice(hashValue, sliceValue, false);
     ReleaseHandle(handle);
+    if (errCode == E_OK && multiVerKvStorage_ != nullptr) {
+        multiVerKvStorage_->RecordSyncValueSlice(sliceValue.size(), false);
+    }
     return errCode;
 }
 
@@ -826,6 +834,14 @@ uint64_t MultiVerNaturalStore::GetCurrentTimestamp()
     return GetTimestamp();
 }
 
+ValueSliceStatistics MultiVerNaturalStore::GetValueSliceStatistics() const
+{
+    if (multiVerKvStorage_ == nullptr) {
+        return {};
+    }
+    return multiVerKvStorage_->GetValueSliceStatistics();
+}
+
 int MultiVerNaturalStore::GetDiffEntries(const CommitID &begin, const CommitID &end, MultiVerDiffData &data) const
 {
     // Get one connection.
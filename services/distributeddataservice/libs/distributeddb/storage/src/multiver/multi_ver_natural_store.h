@@ -122,6 +122,8 @@ public:
 
     uint64_t GetCurrentTimestamp();
 
+    ValueSliceStatistics GetValueSliceStatistics() const;
+
     // Set the max timestamp
     void SetMaxTimestamp(Timestamp stamp);
 
@@ -16,11 +16,60 @@
 #ifndef OMIT_MULTI_VER
 #include "multi_ver_natural_store_transfer_data.h"
 
+#include <algorithm>
+#include <cstdint>
+
 #include "db_constant.h"
 #include "log_print.h"
 #include "db_errno.h"
 
 namespace DistributedDB {
+namespace {
+    constexpr int GEAR_TABLE_SIZE = 256;
+    constexpr int HASH_BITS = 64;
+    constexpr int NORMALIZATION_LEVEL = 1; // The strict mask has 1 more bit than the avg size, the loose 1 less
+
+    // The gear table must be the same on all the devices so the same content is cut at the same place,
+    // it is generated by splitmix64 from a fixed seed rather than random.
+    struct GearTable {
+        uint64_t gear[GEAR_TABLE_SIZE] = {};
+        constexpr GearTable()
+        {
+            uint64_t seed = 0x6A09E667F3BCC908ULL;
+            for (int i = 0; i < GEAR_TABLE_SIZE; i++) {
+                seed += 0x9E3779B97F4A7C15ULL;
+                uint64_t mixed = seed;
+                mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ULL; // 30 is the shift of splitmix64
+                mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBULL; // 27 is the shift of splitmix64
+                gear[i] = mixed ^ (mixed >> 31); // 31 is the shift of splitmix64
+            }
+        }
+    };
+    constexpr GearTable GEAR_TABLE;
+
+    // The high bits of the gear hash depend on the most bytes before, so the mask takes the high bits
+    uint64_t GetHighBitsMask(int bits)
+    {
+        if (bits <= 0) {
+            return 0;
+        }
+        if (bits >= HASH_BITS) {
+            return UINT64_MAX;
+        }
+        return ((1ULL << bits) - 1) << (HASH_BITS - bits);
+    }
+
+    int GetFloorLog2(size_t value)
+    {
+        int bits = -1;
+        while (value != 0) {
+            value >>= 1;
+            bits++;
+        }
+        return bits;
+    }
+}
+
 int MultiVerNaturalStoreTransferData::SegmentAndTransferValueToHash(const Value &oriValue,
     std::vector<Value> &partValues) const
 {
@@ -28,11 +77,47 @@ int MultiVerNaturalStoreTransferData::SegmentAndTransferValueToHash(const Value
         return -E_UNEXPECTED_DATA;
     }
 
-    const uint32_t sizeByte = blockSizeByte_;
-    if (sizeByte == 0) {
+    if (isContentDefined_) {
+        SegmentByContent(oriValue, partValues);
+        return E_OK;
+    }
+    if (blockSizeByte_ == 0) {
         return -E_UNEXPECTED_DATA;
     }
+    SegmentByFixedSize(oriValue, partValues);
+    return E_OK;
+}
+
+void MultiVerNaturalStoreTransferData::SetSliceLengthThreshold(size_t threshold)
+{
+    sliceLengthThreshold_ = threshold;
+}
+
+void MultiVerNaturalStoreTransferData::SetBlockSizeByte(size_t blockSize)
+{
+    blockSizeByte_ = blockSize;
+    isContentDefined_ = false;
+}
 
+int MultiVerNaturalStoreTransferData::SetContentDefinedSlice(size_t minSize, size_t avgSize, size_t maxSize)
+{
+    if (minSize == 0 || minSize >= avgSize || avgSize >= maxSize) {
+        LOGE("Invalid content defined slice size, min:%zu, avg:%zu, max:%zu.", minSize, avgSize, maxSize);
+        return -E_INVALID_ARGS;
+    }
+    int avgBits = GetFloorLog2(avgSize);
+    minSliceSize_ = minSize;
+    avgSliceSize_ = static_cast<size_t>(1) << avgBits;
+    maxSliceSize_ = maxSize;
+    strictMask_ = GetHighBitsMask(avgBits + NORMALIZATION_LEVEL);
+    looseMask_ = GetHighBitsMask(avgBits - NORMALIZATION_LEVEL);
+    isContentDefined_ = true;
+    return E_OK;
+}
+
+void MultiVerNaturalStoreTransferData::SegmentByFixedSize(const Value &oriValue, std::vector<Value> &partValues) const
+{
+    const size_t sizeByte = blockSizeByte_;
     const size_t partNum = oriValue.size() / sizeByte;
 
     for (size_t i = 0; i < partNum; i++) {
@@ -46,8 +131,40 @@ int MultiVerNaturalStoreTransferData::SegmentAndTransferValueToHash(const Value
     if (!tailValue.empty()) {
         partValues.push_back(tailValue);
     }
+}
 
-    return E_OK;
+void MultiVerNaturalStoreTransferData::SegmentByContent(const Value &oriValue, std::vector<Value> &partValues) const
+{
+    size_t offset = 0;
+    while (offset < oriValue.size()) {
+        size_t cut = GetContentDefinedCut(oriValue.data() + offset, oriValue.size() - offset);
+        partValues.emplace_back(oriValue.begin() + offset, oriValue.begin() + offset + cut);
+        offset += cut;
+    }
+}
+
+size_t MultiVerNaturalStoreTransferData::GetContentDefinedCut(const uint8_t *data, size_t length) const
+{
+    if (length <= minSliceSize_) {
+        return length;
+    }
+    size_t end = std::min(length, maxSliceSize_);
+    size_t normal = std::min(avgSliceSize_, end);
+    uint64_t hash = 0;
+    size_t i = minSliceSize_;
+    for (; i < normal; i++) {
+        hash = (hash << 1) + GEAR_TABLE.gear[data[i]];
+        if ((hash & strictMask_) == 0) {
+            return i + 1;
+        }
+    }
+    for (; i < end; i++) {
+        hash = (hash << 1) + GEAR_TABLE.gear[data[i]];
+        if ((hash & looseMask_) == 0) {
+            return i + 1;
+        }
+    }
+    return end;
 }
 } // namespace DistributedDB
 #endif
@@ -21,6 +21,12 @@
 #include "macro_utils.h"
 
 namespace DistributedDB {
+// The values written by the store are sliced by content once larger than the max slice, so an edit in a value only
+// changes the slices around it, the others are shared with the old value and need no transfer.
+constexpr size_t CONTENT_DEFINED_SLICE_MIN_SIZE = 16384; // 16K
+constexpr size_t CONTENT_DEFINED_SLICE_AVG_SIZE = 65536; // 64K
+constexpr size_t CONTENT_DEFINED_SLICE_MAX_SIZE = 262144; // 256K
+
 class MultiVerNaturalStoreTransferData {
 public:
     MultiVerNaturalStoreTransferData() {};
@@ -30,9 +36,28 @@ public:
 
     int SegmentAndTransferValueToHash(const Value &oriValue, std::vector<Value> &partValues) const;
 
+    // The value not longer than the threshold is not sliced.
+    void SetSliceLengthThreshold(size_t threshold);
+
+    // Slice by the fixed size, the default.
+    void SetBlockSizeByte(size_t blockSize);
+
+    // Slice by the gear rolling hash of the content, as FastCDC. The avgSize is rounded down to a power of 2.
+    int SetContentDefinedSlice(size_t minSize, size_t avgSize, size_t maxSize);
+
 private:
+    void SegmentByFixedSize(const Value &oriValue, std::vector<Value> &partValues) const;
+    void SegmentByContent(const Value &oriValue, std::vector<Value> &partValues) const;
+    size_t GetContentDefinedCut(const uint8_t *data, size_t length) const;
+
     size_t sliceLengthThreshold_ = 4194304; // 4MB
     size_t blockSizeByte_ = 4194304; // 4MB
+    bool isContentDefined_ = false;
+    size_t minSliceSize_ = 0;
+    size_t avgSliceSize_ = 0;
+    size_t maxSliceSize_ = 0;
+    uint64_t strictMask_ = 0; // Used before the avgSize, a cut is harder to find, so the slices are normalized
+    uint64_t looseMask_ = 0; // Used after the avgSize
 };
 } // namespace DistributedDB
 
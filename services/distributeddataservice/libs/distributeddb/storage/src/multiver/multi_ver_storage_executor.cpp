@@ -263,7 +263,8 @@ int MultiVerStorageExecutor::GetValueSlice(const ValueSliceHash &hashValue, Valu
 int MultiVerStorageExecutor::PutValueSlice(const ValueSliceHash &hashValue, const ValueSlice &sliceValue,
     bool isAddCount)
 {
-    return PutValueSliceInner(nullptr, hashValue, sliceValue, isAddCount);
+    bool isExisted = false;
+    return PutValueSliceInner(nullptr, hashValue, sliceValue, isAddCount, isExisted);
 }
 
 int MultiVerStorageExecutor::GetValueSliceInner(const SliceTransaction *sliceTransaction,
@@ -289,11 +290,11 @@ int MultiVerStorageExecutor::GetValueSliceInner(const SliceTransaction *sliceTra
 }
 
 int MultiVerStorageExecutor::PutValueSliceInner(SliceTransaction *sliceTransaction, const ValueSliceHash &hashValue,
-    const ValueSlice &sliceValue, bool isAddCount)
+    const ValueSlice &sliceValue, bool isAddCount, bool &isExisted)
 {
     int errCode;
     if (sliceTransaction != nullptr) {
-        errCode = sliceTransaction->PutData(hashValue, sliceValue, isAddCount);
+        errCode = sliceTransaction->PutData(hashValue, sliceValue, isAddCount, isExisted);
         return CheckCorruptedStatus(errCode);
     }
 
@@ -306,7 +307,7 @@ int MultiVerStorageExecutor::PutValueSliceInner(SliceTransaction *sliceTransacti
         return CheckCorruptedStatus(errCode);
     }
 
-    errCode = transaction->PutData(hashValue, sliceValue, isAddCount);
+    errCode = transaction->PutData(hashValue, sliceValue, isAddCount, isExisted);
     kvDataStorage_->ReleaseSliceTransaction(transaction);
     return CheckCorruptedStatus(errCode);
 }
@@ -435,7 +436,8 @@ int MultiVerStorageExecutor::AddSliceDataCount(const std::vector<Value> &values)
         valueObject.GetValueHash(valueHashList);
         for (auto &iter : valueHashList) {
             Value filledData;
-            errCode = PutValueSliceInner(sliceTransaction_, iter, filledData, true);
+            bool isExisted = false;
+            errCode = PutValueSliceInner(sliceTransaction_, iter, filledData, true, isExisted);
             if (errCode != E_OK) {
                 LOGE("Add the slice value count failed:%d", errCode);
                 return errCode;
@@ -1044,9 +1046,14 @@ int MultiVerStorageExecutor::TransferToValueObject(const Value &value, MultiVerV
 {
     MultiVerNaturalStoreTransferData splitData;
     std::vector<Value> partValues;
-    // Segment data into blocks by fixed size
-    // You can set Threshold and blocksize by SetSliceLengthThreshold, SetBlockSizeByte;
-    int errCode = splitData.SegmentAndTransferValueToHash(value, partValues);
+    // Segment data into blocks by content, so the value edited later shares the unchanged blocks
+    splitData.SetSliceLengthThreshold(CONTENT_DEFINED_SLICE_MAX_SIZE);
+    int errCode = splitData.SetContentDefinedSlice(CONTENT_DEFINED_SLICE_MIN_SIZE, CONTENT_DEFINED_SLICE_AVG_SIZE,
+        CONTENT_DEFINED_SLICE_MAX_SIZE);
+    if (errCode != E_OK) {
+        return errCode;
+    }
+    errCode = splitData.SegmentAndTransferValueToHash(value, partValues);
     if (errCode == E_OK) {
         valueObject.SetFlag(MultiVerValueObject::HASH_FLAG);
 
@@ -1057,11 +1064,13 @@ int MultiVerStorageExecutor::TransferToValueObject(const Value &value, MultiVerV
             if (DBCommon::CalcValueHash(partValue, hashValue) != E_OK) {
                 return -E_INTERNAL_ERROR;
             }
-            // Put hash value into table
-            errCode = PutValueSlice(hashValue, partValue, true);
+            // Put hash value into table, the slice already stored only adds its count
+            bool isExisted = false;
+            errCode = PutValueSliceInner(nullptr, hashValue, partValue, true, isExisted);
             if (errCode != E_OK) {
                 return errCode;
             }
+            kvDataStorage_->RecordValueSlice(partValue.size(), isExisted);
             hashValues.push_back(std::move(hashValue));
         }
 
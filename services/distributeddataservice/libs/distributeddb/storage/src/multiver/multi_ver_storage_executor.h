@@ -168,7 +168,7 @@ private:
         ValueSlice &sliceValue) const;
 
     int PutValueSliceInner(SliceTransaction *sliceTransaction, const ValueSliceHash &hashValue,
-        const ValueSlice &sliceValue, bool isAddCount);
+        const ValueSlice &sliceValue, bool isAddCount, bool &isExisted);
 
     int DeleteValueSliceInner(SliceTransaction *sliceTransaction, const ValueSliceHash &hashValue);
 
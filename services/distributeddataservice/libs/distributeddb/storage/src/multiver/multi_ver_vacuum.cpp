@@ -19,6 +19,7 @@
 #include <string>
 #include <vector>
 #include <cstdint>
+#include <algorithm>
 
 #include "db_errno.h"
 #include "db_common.h"
@@ -29,6 +30,10 @@
 namespace DistributedDB {
 std::atomic<bool> MultiVerVacuum::enabled_{true};
 
+MultiVerVacuum::MultiVerVacuum(const VacuumPolicy &policy) : policy_(policy)
+{
+}
+
 void MultiVerVacuum::Enable(bool isEnable)
 {
     enabled_ = isEnable;
@@ -89,6 +94,7 @@ int MultiVerVacuum::Pause(const std::string &dbIdentifier)
         dbMapVacuumTask_[dbIdentifier].status = VacuumTaskStatus::PAUSE_WAIT;
         dbMapVacuumTask_[dbIdentifier].immediatelyRelaunchable = false;
         IncPauseNeedCount(dbMapVacuumTask_[dbIdentifier]);
+        auto waitStartTime = std::chrono::steady_clock::now();
         vacuumTaskCv_.wait(vacuumTaskLockGuard, [this, &dbIdentifier] {
             // In concurrency scenario that executor is about to finish this task, the final status may be FINISH.
             // Even more, in case Abort be called immediately after task finished, the final status may be ABORT_DONE.
@@ -96,6 +102,12 @@ int MultiVerVacuum::Pause(const std::string &dbIdentifier)
                 dbMapVacuumTask_[dbIdentifier].status == VacuumTaskStatus::ABORT_DONE ||
                 dbMapVacuumTask_[dbIdentifier].status == VacuumTaskStatus::FINISH;
         });
+        uint64_t waitTime = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - waitStartTime).count());
+        VacuumTaskStatistics &statistics = dbMapVacuumTask_[dbIdentifier].statistics;
+        statistics.pauseWaitCount++;
+        statistics.totalPauseWaitTime += waitTime;
+        statistics.maxPauseWaitTime = std::max(statistics.maxPauseWaitTime, waitTime);
     } else if (dbMapVacuumTask_[dbIdentifier].status == VacuumTaskStatus::FINISH) {
         dbMapVacuumTask_[dbIdentifier].immediatelyRelaunchable = false;
         IncPauseNeedCount(dbMapVacuumTask_[dbIdentifier]);
@@ -245,6 +257,21 @@ int MultiVerVacuum::QueryStatus(const std::string &dbIdentifier, VacuumTaskStatu
     return E_OK;
 }
 
+int MultiVerVacuum::QueryStatistics(const std::string &dbIdentifier, VacuumTaskStatistics &outStatistics) const
+{
+    if (dbIdentifier.empty()) {
+        return -E_INVALID_ARGS;
+    }
+
+    std::lock_guard<std::mutex> vacuumTaskLockGuard(vacuumTaskMutex_);
+    if (dbMapVacuumTask_.count(dbIdentifier) == 0) {
+        return -E_NOT_FOUND;
+    }
+
+    outStatistics = dbMapVacuumTask_.at(dbIdentifier).statistics;
+    return E_OK;
+}
+
 MultiVerVacuum::~MultiVerVacuum()
 {
     // Mainly for stop the background task, resources automatically clean by this deconstruction
@@ -260,9 +287,9 @@ MultiVerVacuum::~MultiVerVacuum()
         }
         // For ABORT_WAIT, ABORT_DONE and FINISH, remain as it is.
     }
-    // Wait for background task to quit
+    // Wait for all background task to quit
     vacuumTaskCv_.wait(vacuumTaskLockGuard, [this] {
-        return !isBackgroundVacuumTaskInExecution_;
+        return backgroundExecutionCount_ == 0;
     });
 }
 
@@ -271,20 +298,22 @@ void MultiVerVacuum::VacuumTaskExecutor()
     // Endless loop until nothing to do
     while (true) {
         std::string nextDatabase;
+        VacuumTaskContext *nextTask = nullptr;
         {
             std::lock_guard<std::mutex> vacuumTaskLockGuard(vacuumTaskMutex_);
             int errCode = SearchVacuumTaskToExecute(nextDatabase);
             if (errCode != E_OK) {
                 LOGI("[Vacuum][Executor] No available task to execute, about to quit.");
-                isBackgroundVacuumTaskInExecution_ = false;
+                backgroundExecutionCount_--;
                 // Awake the deconstruction that background thread is about to quit
                 vacuumTaskCv_.notify_all();
                 return;
             }
+            // No thread will remove entry from dbMapVacuumTask_, so the task is concurrency safe to use after unlock.
+            nextTask = &dbMapVacuumTask_[nextDatabase];
         }
-        // No thread will remove entry from dbMapVacuumTask_, so here is concurrency safe.
         LOGI("[Vacuum][Executor] Execute vacuum task for database=%s.", nextDatabase.c_str());
-        ExecuteSpecificVacuumTask(dbMapVacuumTask_[nextDatabase]);
+        ExecuteSpecificVacuumTask(*nextTask);
         // Awake foreground thread at this task switch point
         vacuumTaskCv_.notify_all();
     }
@@ -395,6 +424,7 @@ int MultiVerVacuum::DealWithLeftBranchVacuumNeedRecord(VacuumTaskContext &inTask
         DoRollBackAndFinish(inTask);
         return errCode;
     }
+    inTask.sliceRowCount++;
     // Pop out this vacuumNeedRecord
     inTask.vacuumNeedRecords.pop_front();
     return E_OK;
@@ -462,6 +492,11 @@ int MultiVerVacuum::DoDealCommitOfLeftOrRight(VacuumTaskContext &inTask, std::li
         DoRollBackAndFinish(inTask);
         return errCode;
     }
+    inTask.sliceRowCount++;
+    {
+        std::lock_guard<std::mutex> vacuumTaskLockGuard(vacuumTaskMutex_);
+        inTask.statistics.commitsVacuumed++;
+    }
     // Pop out this commit
     commitList.pop_front();
     return E_OK;
@@ -492,6 +527,11 @@ int MultiVerVacuum::DoDeleteRecordOfLeftShadowOrRightVacuumNeed(VacuumTaskContex
         DoRollBackAndFinish(inTask);
         return errCode;
     }
+    inTask.sliceRowCount++;
+    {
+        std::lock_guard<std::mutex> vacuumTaskLockGuard(vacuumTaskMutex_);
+        inTask.statistics.recordsReclaimed++;
+    }
     // Pop out this shadowRecord or vacuumNeedRecord
     recordList.pop_front();
     return E_OK;
@@ -533,6 +573,33 @@ int MultiVerVacuum::DoCommitAndQuitIfWaitStatusObserved(VacuumTaskContext &inTas
         inTask.status = VacuumTaskStatus::PAUSE_DONE;
         return -E_TASK_BREAK_OFF;
     }
+    return DoCommitAndYieldIfBudgetUsedUp(inTask);
+}
+
+int MultiVerVacuum::DoCommitAndYieldIfBudgetUsedUp(VacuumTaskContext &inTask)
+{
+    if (!inTask.isTransactionStarted) {
+        return E_OK;
+    }
+    bool rowBudgetUsedUp = (policy_.sliceRowBudget != 0 && inTask.sliceRowCount >= policy_.sliceRowBudget);
+    bool timeBudgetUsedUp = (policy_.sliceTimeBudget != 0 && std::chrono::steady_clock::now() -
+        inTask.sliceStartTime >= std::chrono::milliseconds(policy_.sliceTimeBudget));
+    if (!rowBudgetUsedUp && !timeBudgetUsedUp) {
+        return E_OK;
+    }
+    // Commit the slice so that the writer pausing this task later only waits for a short transaction
+    int errCode = CommitTransactionIfNeed(inTask);
+    std::lock_guard<std::mutex> vacuumTaskLockGuard(vacuumTaskMutex_);
+    if (errCode != E_OK) {
+        FinishVaccumTask(inTask);
+        return errCode;
+    }
+    // Keep the progress and queue at the back, so the waiting database with more vacuum need can be executed first
+    if (inTask.status == VacuumTaskStatus::RUN_NING && IsOtherVacuumTaskWaiting()) {
+        inTask.status = VacuumTaskStatus::RUN_WAIT;
+        inTask.runWaitOrder = incRunWaitOrder_++;
+        return -E_TASK_BREAK_OFF;
+    }
     return E_OK;
 }
 
@@ -545,6 +612,8 @@ int MultiVerVacuum::StartTransactionIfNotYet(VacuumTaskContext &inTask)
             return errCode;
         }
         inTask.isTransactionStarted = true;
+        inTask.sliceRowCount = 0;
+        inTask.sliceStartTime = std::chrono::steady_clock::now();
     }
     return E_OK;
 }
@@ -559,6 +628,8 @@ int MultiVerVacuum::CommitTransactionIfNeed(VacuumTaskContext &inTask)
             LOGE("[Vacuum][CommitTransact] CommitTransactionForVacuum fail, errCode=%d.", errCode);
             return errCode;
         }
+        std::lock_guard<std::mutex> vacuumTaskLockGuard(vacuumTaskMutex_);
+        inTask.statistics.slicesCommitted++;
     }
     return E_OK;
 }
@@ -609,11 +680,14 @@ void MultiVerVacuum::ResetNodeAndRecordContextInfo(VacuumTaskContext &inTask)
     inTask.vacuumNeedRecords.clear();
     inTask.shadowRecords.clear();
     inTask.isTransactionStarted = false;
+    inTask.sliceRowCount = 0;
 }
 
 int MultiVerVacuum::SearchVacuumTaskToExecute(std::string &outDbIdentifier)
 {
-    // Find a vacuum task with the smallest runWaitOrder among tasks that is in RUN_WAIT Status(Except In Error).
+    // Find a vacuum task with the highest priority among tasks that is in RUN_WAIT Status(Except In Error), the one
+    // with the smallest runWaitOrder is chosen among the same priority.
+    uint64_t maxPriority = 0;
     uint64_t minRunWaitOrder = UINT64_MAX;
     for (auto &eachTask : dbMapVacuumTask_) {
         LOGD("[Vacuum][Search] db=%s, status=%d, error=%d, relaunch=%d, immediate=%d, runWait=%llu, pauseCount=%llu.",
@@ -621,23 +695,74 @@ int MultiVerVacuum::SearchVacuumTaskToExecute(std::string &outDbIdentifier)
             eachTask.second.autoRelaunchOnce, eachTask.second.immediatelyRelaunchable,
             ULL(eachTask.second.runWaitOrder), ULL(eachTask.second.pauseNeedCount));
         if (eachTask.second.status == VacuumTaskStatus::RUN_WAIT && !eachTask.second.launchErrorHappen) {
-            if (eachTask.second.runWaitOrder < minRunWaitOrder) {
+            uint64_t priority = GetVacuumTaskPriority(eachTask.second);
+            if (priority > maxPriority || (priority == maxPriority && eachTask.second.runWaitOrder < minRunWaitOrder)) {
+                maxPriority = priority;
                 minRunWaitOrder = eachTask.second.runWaitOrder;
                 outDbIdentifier = eachTask.first;
             }
         }
     }
     if (!outDbIdentifier.empty()) {
+        for (auto &eachTask : dbMapVacuumTask_) {
+            if (eachTask.second.status == VacuumTaskStatus::RUN_WAIT && eachTask.first != outDbIdentifier) {
+                eachTask.second.passedOverCount++;
+            }
+        }
         dbMapVacuumTask_[outDbIdentifier].status = VacuumTaskStatus::RUN_NING;
+        dbMapVacuumTask_[outDbIdentifier].passedOverCount = 0;
         return E_OK;
     } else {
         return -E_NOT_FOUND;
     }
 }
 
+uint64_t MultiVerVacuum::GetVacuumTaskPriority(const VacuumTaskContext &inTask) const
+{
+    // The vacuum able commits of a newly launched task are unknown, get them first since it costs little.
+    uint64_t commitDepth = inTask.leftBranchCommits.size() + inTask.rightBranchCommits.size();
+    if (commitDepth == 0) {
+        return UINT64_MAX;
+    }
+    // The reclaimable size is estimated by the records reclaimed for each commit in the past.
+    const VacuumTaskStatistics &statistics = inTask.statistics;
+    uint64_t recordsPerCommit = (statistics.commitsVacuumed == 0) ? 1 :
+        std::max<uint64_t>(statistics.recordsReclaimed / statistics.commitsVacuumed, 1);
+    uint64_t priority = commitDepth * recordsPerCommit;
+    // Doubled each time it is passed over, so the small database waits for a few slices of the large one at most.
+    for (uint32_t i = 0; i < inTask.passedOverCount; i++) {
+        if (priority > (UINT64_MAX >> 1)) {
+            return UINT64_MAX;
+        }
+        priority <<= 1;
+    }
+    return priority;
+}
+
+bool MultiVerVacuum::IsOtherVacuumTaskWaiting() const
+{
+    for (const auto &eachTask : dbMapVacuumTask_) {
+        if (eachTask.second.status == VacuumTaskStatus::RUN_WAIT && !eachTask.second.launchErrorHappen) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void MultiVerVacuum::ActivateBackgroundVacuumTaskExecution()
 {
-    if (!isBackgroundVacuumTaskInExecution_) {
+    // Each background execution executes one task at a time, more are activated if the tasks waiting need them.
+    uint32_t needCount = 0;
+    for (const auto &eachTask : dbMapVacuumTask_) {
+        VacuumTaskStatus status = eachTask.second.status;
+        if ((status == VacuumTaskStatus::RUN_WAIT && !eachTask.second.launchErrorHappen) ||
+            status == VacuumTaskStatus::RUN_NING || status == VacuumTaskStatus::PAUSE_WAIT ||
+            status == VacuumTaskStatus::ABORT_WAIT) {
+            needCount++;
+        }
+    }
+    uint32_t maxCount = std::max<uint32_t>(policy_.maxConcurrentTasks, 1);
+    while (backgroundExecutionCount_ < std::min(needCount, maxCount)) {
         TaskAction backgroundTask = [this]() {
             LOGI("[Vacuum][Activate] Begin Background Execution.");
             VacuumTaskExecutor();
@@ -648,7 +773,7 @@ void MultiVerVacuum::ActivateBackgroundVacuumTaskExecution()
             LOGE("[Vacuum][Activate] ScheduleTask failed, errCode = %d.", errCode);
             return;
         }
-        isBackgroundVacuumTaskInExecution_ = true;
+        backgroundExecutionCount_++;
     }
 }
 
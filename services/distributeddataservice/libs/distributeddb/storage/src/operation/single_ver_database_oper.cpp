@@ -512,6 +512,7 @@ void SingleVerDatabaseOper::InitDataBaseOption(OpenDbProperties &option) const
     option.subdir = dirPath;
     option.securityOpt = securityOpt;
     option.conflictReslovePolicy = properties.GetIntProp(KvDBProperties::CONFLICT_RESOLVE_POLICY, 0);
+    option.profile = properties.GetStorageProfile();
 }
 
 int SingleVerDatabaseOper::RunRekeyLogic(CipherType type, const CipherPassword &passwd)
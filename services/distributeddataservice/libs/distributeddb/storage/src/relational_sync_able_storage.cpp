@@ -491,7 +491,20 @@ int RelationalSyncAbleStorage::LocalDataChanged(int notifyEvent, std::vector<Que
 int RelationalSyncAbleStorage::CreateDistributedDeviceTable(const std::string &device,
     const RelationalSyncStrategy &syncStrategy)
 {
+    std::vector<std::string> tableNames;
+    for (const auto &[table, strategy] : syncStrategy) {
+        if (strategy.permitSync) {
+            tableNames.push_back(table);
+        }
+    }
     int errCode = E_OK;
+    if (IsDeviceTableCreated(device, tableNames, errCode)) {
+        return E_OK;
+    }
+    if (errCode != E_OK) {
+        return errCode;
+    }
+
     auto *handle = GetHandle(true, errCode, OperatePerm::NORMAL_PERM);
     if (handle == nullptr) {
         return errCode;
@@ -504,28 +517,50 @@ int RelationalSyncAbleStorage::CreateDistributedDeviceTable(const std::string &d
         return errCode;
     }
 
-    for (const auto &[table, strategy] : syncStrategy) {
-        if (!strategy.permitSync) {
-            continue;
+    // All the DDL of the device is committed together, the other connections only see the schema changed once
+    int beginVersion = 0;
+    errCode = handle->GetSchemaVersion(beginVersion);
+    for (const auto &table : tableNames) {
+        if (errCode != E_OK) {
+            break;
         }
-
-        errCode = handle->CreateDistributedDeviceTable(device, storageEngine_->GetSchemaRef().GetTable(table));
+        errCode = handle->CreateDistributedDeviceTable(device, storageEngine_->GetSchemaRef().GetTable(table),
+            deviceTableManager_);
         if (errCode != E_OK) {
             LOGE("Create distributed device table failed. %d", errCode);
-            break;
         }
     }
+    int endVersion = 0;
+    if (errCode == E_OK) {
+        errCode = handle->GetSchemaVersion(endVersion);
+    }
 
     if (errCode == E_OK) {
         errCode = handle->Commit();
     } else {
         (void)handle->Rollback();
     }
+    if (errCode == E_OK) {
+        deviceTableManager_.SetCreated(device, tableNames, beginVersion, endVersion);
+    }
 
     ReleaseHandle(handle);
     return errCode;
 }
 
+bool RelationalSyncAbleStorage::IsDeviceTableCreated(const std::string &device,
+    const std::vector<std::string> &tableNames, int &errCode)
+{
+    auto *handle = GetHandle(false, errCode, OperatePerm::NORMAL_PERM);
+    if (handle == nullptr) {
+        return false;
+    }
+    int schemaVersion = 0;
+    errCode = handle->GetSchemaVersion(schemaVersion);
+    ReleaseHandle(handle);
+    return errCode == E_OK && deviceTableManager_.IsCreated(device, tableNames, schemaVersion);
+}
+
 int RelationalSyncAbleStorage::RegisterSchemaChangedCallback(const std::function<void()> &callback)
 {
     std::lock_guard lock(onSchemaChangedMutex_);
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef RELATIONAL_STORE
+#include "relational_device_table_manager.h"
+#include "db_errno.h"
+#include "log_print.h"
+#include "sqlite_utils.h"
+
+namespace DistributedDB {
+bool RelationalDeviceTableManager::IsCreated(const std::string &device, const std::vector<std::string> &tableNames,
+    int schemaVersion)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    CheckSchemaVersion(schemaVersion);
+    auto iter = createdTables_.find(device);
+    if (iter == createdTables_.end()) {
+        return false;
+    }
+    for (const auto &tableName : tableNames) {
+        if (iter->second.count(tableName) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void RelationalDeviceTableManager::SetCreated(const std::string &device, const std::vector<std::string> &tableNames,
+    int beginVersion, int endVersion)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    CheckSchemaVersion(beginVersion);
+    // The version is only changed by the DDL of this transaction, what is kept before is still valid
+    schemaVersion_ = endVersion;
+    createdTables_[device].insert(tableNames.begin(), tableNames.end());
+}
+
+void RelationalDeviceTableManager::CheckSchemaVersion(int schemaVersion)
+{
+    if (schemaVersion == schemaVersion_) {
+        return;
+    }
+    if (schemaVersion_ != -1) {
+        LOGI("[DeviceTableMgr] Schema version changed %d to %d, check the device tables again.", schemaVersion_,
+            schemaVersion);
+    }
+    createdTables_.clear();
+    ddls_.clear();
+    schemaVersion_ = schemaVersion;
+}
+
+int RelationalDeviceTableManager::GetCreateSql(sqlite3 *db, const TableInfo &baseTbl,
+    const std::string &deviceTableName, std::string &sql)
+{
+    std::string tableInfo = baseTbl.ToTableInfoString();
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = ddls_.find(baseTbl.GetTableName());
+    if (iter == ddls_.end() || iter->second.tableInfo != tableInfo) {
+        DeviceTableDdl ddl;
+        int errCode = LoadIndexes(db, baseTbl.GetTableName(), ddl.indexes);
+        if (errCode != E_OK) {
+            LOGE("[DeviceTableMgr] Load the indexes of base table failed. %d", errCode);
+            return errCode;
+        }
+        ddl.tableInfo = std::move(tableInfo);
+        ddl.fieldsDefine = SQLiteUtils::GetTableFieldsDefine(baseTbl);
+        iter = ddls_.insert_or_assign(baseTbl.GetTableName(), std::move(ddl)).first;
+    }
+    const DeviceTableDdl &ddl = iter->second;
+    sql = "CREATE TABLE IF NOT EXISTS " + deviceTableName + "(" + ddl.fieldsDefine + ");";
+    for (const auto &index : ddl.indexes) {
+        sql += "CREATE " + std::string(index.isUnique ? "UNIQUE " : "") + "INDEX IF NOT EXISTS " + deviceTableName +
+            "_" + index.name + " ON " + deviceTableName + "(" + index.fields + ");";
+    }
+    return E_OK;
+}
+
+int RelationalDeviceTableManager::LoadIndexes(sqlite3 *db, const std::string &tableName,
+    std::vector<IndexDefine> &indexes)
+{
+    // Same as SQLiteUtils::CloneIndexes, only the indexes created by CREATE INDEX are cloned
+    const std::string sql = "SELECT il.'unique', il.name, GROUP_CONCAT(ii.name) "
+        "FROM sqlite_master AS m,"
+            "pragma_index_list(m.name) AS il,"
+            "pragma_index_info(il.name) AS ii "
+        "WHERE m.type='table' AND m.name=? AND il.origin='c' "
+        "GROUP BY il.name;";
+    sqlite3_stmt *stmt = nullptr;
+    int errCode = SQLiteUtils::GetStatement(db, sql, stmt);
+    if (errCode != E_OK) {
+        return errCode;
+    }
+    errCode = SQLiteUtils::BindTextToStatement(stmt, 1, tableName); // 1 means table name index
+    while (errCode == E_OK) {
+        errCode = SQLiteUtils::StepWithRetry(stmt, false);
+        if (errCode != SQLiteUtils::MapSQLiteErrno(SQLITE_ROW)) {
+            break;
+        }
+        IndexDefine index;
+        index.isUnique = (sqlite3_column_int(stmt, 0) != 0);
+        (void)SQLiteUtils::GetColumnTextValue(stmt, 1, index.name); // 1 means index name
+        (void)SQLiteUtils::GetColumnTextValue(stmt, 2, index.fields); // 2 means index fields
+        indexes.push_back(std::move(index));
+        errCode = E_OK;
+    }
+    if (errCode == SQLiteUtils::MapSQLiteErrno(SQLITE_DONE)) {
+        errCode = E_OK;
+    }
+    SQLiteUtils::ResetStatement(stmt, true, errCode);
+    return errCode;
+}
+} // namespace DistributedDB
+#endif
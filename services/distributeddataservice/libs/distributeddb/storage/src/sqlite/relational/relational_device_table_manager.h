@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef RELATIONAL_DEVICE_TABLE_MANAGER_H
+#define RELATIONAL_DEVICE_TABLE_MANAGER_H
+#ifdef RELATIONAL_STORE
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+#include "macro_utils.h"
+#include "relational_schema_object.h"
+#include "sqlite_import.h"
+
+namespace DistributedDB {
+// Keep the device tables created at the schema version, so the ability sync of a known device not run the DDL again.
+// Any DDL from others changes the schema version and drops what is kept, the device tables are checked again then.
+class RelationalDeviceTableManager {
+public:
+    RelationalDeviceTableManager() = default;
+    ~RelationalDeviceTableManager() = default;
+
+    DISABLE_COPY_ASSIGN_MOVE(RelationalDeviceTableManager);
+
+    bool IsCreated(const std::string &device, const std::vector<std::string> &tableNames, int schemaVersion);
+
+    // The schema version before and after the device tables are created in the same transaction
+    void SetCreated(const std::string &device, const std::vector<std::string> &tableNames, int beginVersion,
+        int endVersion);
+
+    // The DDL of the device table and its indexes, the DDL of the base table is generated only once for its schema
+    int GetCreateSql(sqlite3 *db, const TableInfo &baseTbl, const std::string &deviceTableName, std::string &sql);
+
+private:
+    struct IndexDefine {
+        bool isUnique = false;
+        std::string name;
+        std::string fields;
+    };
+    struct DeviceTableDdl {
+        std::string tableInfo; // The base table which the DDL is generated from
+        std::string fieldsDefine;
+        std::vector<IndexDefine> indexes;
+    };
+
+    static int LoadIndexes(sqlite3 *db, const std::string &tableName, std::vector<IndexDefine> &indexes);
+    void CheckSchemaVersion(int schemaVersion);
+
+    std::mutex mutex_;
+    int schemaVersion_ = -1;
+    std::map<std::string, std::set<std::string>> createdTables_; // <device, table names>
+    std::map<std::string, DeviceTableDdl> ddls_; // <base table name, DDL>
+};
+} // namespace DistributedDB
+#endif
+#endif // RELATIONAL_DEVICE_TABLE_MANAGER_H
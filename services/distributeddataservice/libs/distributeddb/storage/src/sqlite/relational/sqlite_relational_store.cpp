@@ -61,6 +61,9 @@ static void InitDataBaseOption(const RelationalDBProperties &properties, OpenDbP
 {
     option.uri = properties.GetStringProp(DBProperties::DATA_DIR, "");
     option.createIfNecessary = properties.GetBoolProp(DBProperties::CREATE_IF_NECESSARY, false);
+    option.profile = properties.GetStorageProfile();
+    // The app writes through its own connections, which would never checkpoint if the store did not
+    option.profile.backgroundCheckpoint = false;
 }
 
 int SQLiteRelationalStore::InitStorageEngine(const RelationalDBProperties &properties)
@@ -169,7 +169,8 @@ SQLiteSingleVerNaturalStore::SQLiteSingleVerNaturalStore()
       autoLifeTime_(DBConstant::DEF_LIFE_CYCLE_TIME),
       createDBTime_(0),
       dataInterceptor_(nullptr),
-      maxLogSize_(DBConstant::MAX_LOG_SIZE_DEFAULT)
+      maxLogSize_(DBConstant::MAX_LOG_SIZE_DEFAULT),
+      syncDataCompressCache_(std::make_shared<SyncDataCompressCache>())
 {}
 
 SQLiteSingleVerNaturalStore::~SQLiteSingleVerNaturalStore()
@@ -452,6 +453,12 @@ int SQLiteSingleVerNaturalStore::Open(const KvDBProperties &kvDBProp)
         goto ERROR;
     }
 
+    errCode = InitSyncDigest(kvDBProp.GetBoolProp(KvDBProperties::DIGEST_SYNC, false), false);
+    if (errCode != E_OK) {
+        LOGE("[SqlSinStore][Open] init sync digest fail! errCode = [%d]", errCode);
+        goto ERROR;
+    }
+
     // Here, the dbfile is created or opened, and upgrade of table structure has done.
     // More, Upgrade of schema is also done in upgrader call in InitDatabaseContext, schema in dbfile updated if need.
     // If inputSchema is empty, upgrader do nothing of schema, isReadOnly will be true if dbfile contain schema before.
@@ -467,6 +474,7 @@ int SQLiteSingleVerNaturalStore::Open(const KvDBProperties &kvDBProp)
     UpdateSecProperties(MyProp(), isReadOnly, savedSchemaObj, storageEngine_);
 
     StartSyncer();
+    StartWalCheckpointer();
     OnKill([this]() { ReleaseResources(); });
 
     errCode = SaveCreateDBTimeIfNotExisted();
@@ -630,6 +638,7 @@ void SQLiteSingleVerNaturalStore::CommitAndReleaseNotifyData(SingleVerNaturalSto
     bool isNeedCommit, int eventType)
 {
     if (isNeedCommit) {
+        syncDataReadCache_.Invalidate();
         if (committedData != nullptr) {
             if (!committedData->IsChangedDataEmpty()) {
                 CommitNotify(eventType, committedData);
@@ -695,15 +704,16 @@ int SQLiteSingleVerNaturalStore::GetSyncData(Timestamp begin, Timestamp end, std
     }
 
     int errCode = E_OK;
-    SQLiteSingleVerStorageExecutor *handle = GetHandle(false, errCode);
+    SQLiteSingleVerStorageExecutor *handle = nullptr;
+    if (syncDataReadCache_.Get(begin, end, dataSizeInfo, dataItems, errCode)) {
+        goto ERROR;
+    }
+    handle = GetHandle(false, errCode);
     if (handle == nullptr) {
         goto ERROR;
     }
 
-    errCode = handle->GetSyncDataByTimestamp(dataItems, GetAppendedLen(), begin, end, dataSizeInfo);
-    if (errCode == -E_FINISHED) {
-        errCode = E_OK;
-    }
+    errCode = GetSyncDataByTimestamp(handle, begin, end, dataSizeInfo, dataItems);
 
 ERROR:
     if (errCode != -E_UNFINISHED  && errCode != E_OK) {
@@ -850,17 +860,20 @@ int SQLiteSingleVerNaturalStore::GetSyncDataNext(std::vector<DataItem> &dataItem
     }
 
     int errCode = E_OK;
+    if (syncDataReadCache_.Get(token->GetQueryBeginTime(), token->GetQueryEndTime(), dataSizeInfo, dataItems,
+        errCode)) {
+        ProcessContinueToken(dataItems, errCode, token);
+        continueStmtToken = static_cast<ContinueToken>(token);
+        return errCode;
+    }
     SQLiteSingleVerStorageExecutor *handle = GetHandle(false, errCode);
     if (handle == nullptr) {
         ReleaseContinueToken(continueStmtToken);
         return errCode;
     }
 
-    errCode = handle->GetSyncDataByTimestamp(dataItems, GetAppendedLen(), token->GetQueryBeginTime(),
-        token->GetQueryEndTime(), dataSizeInfo);
-    if (errCode == -E_FINISHED) {
-        errCode = E_OK;
-    }
+    errCode = GetSyncDataByTimestamp(handle, token->GetQueryBeginTime(), token->GetQueryEndTime(), dataSizeInfo,
+        dataItems);
 
     ProcessContinueToken(dataItems, errCode, token);
     continueStmtToken = static_cast<ContinueToken>(token);
@@ -869,6 +882,19 @@ int SQLiteSingleVerNaturalStore::GetSyncDataNext(std::vector<DataItem> &dataItem
     return errCode;
 }
 
+int SQLiteSingleVerNaturalStore::GetSyncDataByTimestamp(SQLiteSingleVerStorageExecutor *handle, Timestamp begin,
+    Timestamp end, const DataSizeSpecInfo &dataSizeInfo, std::vector<DataItem> &dataItems) const
+{
+    // the version is taken before the read, a change committed during the read drops the result.
+    uint64_t version = syncDataReadCache_.GetVersion();
+    int errCode = handle->GetSyncDataByTimestamp(dataItems, GetAppendedLen(), begin, end, dataSizeInfo);
+    if (errCode == -E_FINISHED) {
+        errCode = E_OK;
+    }
+    syncDataReadCache_.Put(version, begin, end, dataSizeInfo, dataItems, errCode);
+    return errCode;
+}
+
 void SQLiteSingleVerNaturalStore::ReleaseContinueToken(ContinueToken &continueStmtToken) const
 {
     auto token = static_cast<SQLiteSingleVerContinueToken *>(continueStmtToken);
@@ -924,6 +950,8 @@ void SQLiteSingleVerNaturalStore::GetMaxTimestamp(Timestamp &stamp) const
 
 int SQLiteSingleVerNaturalStore::SetMaxTimestamp(Timestamp timestamp)
 {
+    // each write of the sync data takes a new timestamp, the cached reads may miss it.
+    syncDataReadCache_.Invalidate();
     std::lock_guard<std::mutex> lock(maxTimestampMutex_);
     if (timestamp > currentMaxTimestamp_) {
         currentMaxTimestamp_ = timestamp;
@@ -972,6 +1000,7 @@ int SQLiteSingleVerNaturalStore::RemoveDeviceData(const std::string &deviceName,
     } else {
         errCode = RemoveDeviceDataNormally(deviceName, isNeedNotify);
     }
+    syncDataReadCache_.Invalidate();
     if (errCode != E_OK) {
         LOGE("[SingleVerNStore] RemoveDeviceData failed:%d", errCode);
     }
@@ -1135,6 +1164,7 @@ void SQLiteSingleVerNaturalStore::ReleaseResources()
         UnRegisterNotificationEventType(static_cast<EventType>(SQLITE_GENERAL_CONFLICT_EVENT));
         notificationConflictEventsRegistered_ = false;
     }
+    walCheckpointer_.Stop();
     {
         std::lock_guard<std::mutex> lock(syncerMutex_);
         if (storageEngine_ != nullptr) {
@@ -1355,6 +1385,7 @@ int SQLiteSingleVerNaturalStore::Rekey(const CipherPassword &passwd)
     }
     LOGI("Stop the syncer for rekey");
     StopSyncer(true);
+    walCheckpointer_.Stop();
     std::this_thread::sleep_for(std::chrono::milliseconds(5));  // wait for 5 ms
     errCode = storageEngine_->TryToDisable(true, OperatePerm::REKEY_MONOPOLIZE_PERM);
     if (errCode != E_OK) {
@@ -1381,6 +1412,7 @@ END:
         errCode = E_OK;
     }
     StartSyncer();
+    StartWalCheckpointer();
     return errCode;
 }
 
@@ -1446,6 +1478,7 @@ int SQLiteSingleVerNaturalStore::Import(const std::string &filePath, const Ciphe
         return errCode;
     }
     StopSyncer(true);
+    walCheckpointer_.Stop();
     std::this_thread::sleep_for(std::chrono::milliseconds(5)); // wait for 5 ms
     std::unique_ptr<SingleVerDatabaseOper> operation;
 
@@ -1471,11 +1504,17 @@ int SQLiteSingleVerNaturalStore::Import(const std::string &filePath, const Ciphe
     // Save create db time.
     storageEngine_->Enable(OperatePerm::IMPORT_MONOPOLIZE_PERM);
     errCode = SaveCreateDBTime();
+    if (errCode == E_OK) {
+        // the imported sync data is not digested by the triggers.
+        errCode = InitSyncDigest(MyProp().GetBoolProp(KvDBProperties::DIGEST_SYNC, false), true);
+    }
 
 END:
     // restore the storage engine and the syncer.
+    syncDataReadCache_.Invalidate();
     storageEngine_->Enable(OperatePerm::IMPORT_MONOPOLIZE_PERM);
     StartSyncer();
+    StartWalCheckpointer();
     return errCode;
 }
 
@@ -1558,6 +1597,7 @@ void SQLiteSingleVerNaturalStore::InitDataBaseOption(const KvDBProperties &kvDBP
     option = {uri, isCreateNecessary, isMemoryDb, createTableSqls, cipherType, passwd, schemaStr, subDir, securityOpt};
     option.conflictReslovePolicy = kvDBProp.GetIntProp(KvDBProperties::CONFLICT_RESOLVE_POLICY, DEFAULT_LAST_WIN);
     option.createDirByStoreIdOnly = kvDBProp.GetBoolProp(KvDBProperties::CREATE_DIR_BY_STORE_ID_ONLY, false);
+    option.profile = kvDBProp.GetStorageProfile();
 }
 
 int SQLiteSingleVerNaturalStore::TransObserverTypeToRegisterFunctionType(
@@ -2164,6 +2204,32 @@ void SQLiteSingleVerNaturalStore::SetDataInterceptor(const PushDataInterceptor &
     dataInterceptor_ = interceptor;
 }
 
+bool SQLiteSingleVerNaturalStore::HasDataInterceptor() const
+{
+    std::shared_lock<std::shared_mutex> lock(dataInterceptorMutex_);
+    return dataInterceptor_ != nullptr;
+}
+
+std::shared_ptr<SyncDataCompressCache> SQLiteSingleVerNaturalStore::GetSyncDataCompressCache() const
+{
+    return syncDataCompressCache_;
+}
+
+int SQLiteSingleVerNaturalStore::GetSyncDigest(SyncDigest &digest) const
+{
+    if (!MyProp().GetBoolProp(KvDBProperties::DIGEST_SYNC, false)) {
+        return -E_NOT_SUPPORT;
+    }
+    int errCode = E_OK;
+    SQLiteSingleVerStorageExecutor *handle = GetHandle(false, errCode);
+    if (handle == nullptr) {
+        return errCode;
+    }
+    errCode = handle->GetSyncDigest(digest);
+    ReleaseHandle(handle);
+    return errCode;
+}
+
 int SQLiteSingleVerNaturalStore::InterceptData(std::vector<SingleVerKvEntry *> &entries, const std::string &sourceID,
     const std::string &targetID) const
 {
@@ -2220,13 +2286,21 @@ int SQLiteSingleVerNaturalStore::AddSubscribe(const std::string &subscribeId, co
         return errCode;
     }
 
-    errCode = handle->AddSubscribeTrigger(queryInner, subscribeId);
+    // the write handle is exclusive, no other subscribe changes the conditions before it is released.
+    std::map<std::string, SubscribeCondition> conditions = storageEngine_->GetSubscribeConditions();
+    errCode = handle->GetSubscribeCondition(queryInner, conditions[subscribeId]);
+    if (errCode == E_OK) {
+        errCode = handle->UpdateSubscribeTrigger(conditions);
+    }
     if (errCode != E_OK) {
         LOGE("Add subscribe trigger failed: %d", errCode);
         (void)handle->Rollback();
     } else {
         errCode = handle->Commit();
     }
+    if (errCode == E_OK) {
+        storageEngine_->SetSubscribeConditions(std::move(conditions));
+    }
     ReleaseHandle(handle);
     return errCode;
 }
@@ -2244,7 +2318,11 @@ int SQLiteSingleVerNaturalStore::RemoveSubscribe(const std::vector<std::string>
         ReleaseHandle(handle);
         return errCode;
     }
-    errCode = handle->RemoveSubscribeTrigger(subscribeIds);
+    std::map<std::string, SubscribeCondition> conditions = storageEngine_->GetSubscribeConditions();
+    for (const auto &id : subscribeIds) {
+        conditions.erase(id);
+    }
+    errCode = handle->UpdateSubscribeTrigger(conditions);
     if (errCode != E_OK) {
         LOGE("Remove subscribe trigger failed: %d", errCode);
         goto ERR;
@@ -2259,6 +2337,9 @@ ERR:
     } else {
         (void)handle->Rollback();
     }
+    if (errCode == E_OK) {
+        storageEngine_->SetSubscribeConditions(std::move(conditions));
+    }
     ReleaseHandle(handle);
     return errCode;
 }
@@ -2272,6 +2353,7 @@ int SQLiteSingleVerNaturalStore::SetMaxLogSize(uint64_t limit)
 {
     LOGI("Set the max log size to %" PRIu64, limit);
     maxLogSize_.store(limit);
+    walCheckpointer_.SetMaxLogSize(limit);
     return E_OK;
 }
 uint64_t SQLiteSingleVerNaturalStore::GetMaxLogSize() const
@@ -2279,6 +2361,32 @@ uint64_t SQLiteSingleVerNaturalStore::GetMaxLogSize() const
     return maxLogSize_.load();
 }
 
+WalCheckpointMetrics SQLiteSingleVerNaturalStore::GetWalCheckpointMetrics() const
+{
+    return walCheckpointer_.GetMetrics();
+}
+
+SyncDataCacheMetrics SQLiteSingleVerNaturalStore::GetSyncDataCacheMetrics() const
+{
+    SyncDataCacheMetrics metrics;
+    syncDataReadCache_.GetMetrics(metrics.readBuildCount, metrics.readHitCount);
+    syncDataCompressCache_->GetMetrics(metrics.compressBuildCount, metrics.compressHitCount);
+    return metrics;
+}
+
+void SQLiteSingleVerNaturalStore::StartWalCheckpointer()
+{
+    StorageProfile profile = MyProp().GetStorageProfile();
+    if (!profile.backgroundCheckpoint || MyProp().GetBoolProp(KvDBProperties::MEMORY_MODE, false)) {
+        return;
+    }
+    int errCode = walCheckpointer_.Start(storageEngine_, profile, GetMaxLogSize());
+    if (errCode != E_OK) {
+        // The wal hooks of the connections checkpoint on commit instead, as wal_autocheckpoint does
+        LOGE("[SqlSinStore] Start the wal checkpointer failed, checkpoint on commit. %d", errCode);
+    }
+}
+
 int SQLiteSingleVerNaturalStore::RemoveAllSubscribe()
 {
     int errCode = E_OK;
@@ -2318,6 +2426,41 @@ END:
     } else {
         (void)handle->Rollback();
     }
+    if (errCode == E_OK) {
+        storageEngine_->SetSubscribeConditions({});
+    }
+    ReleaseHandle(handle);
+    return errCode;
+}
+
+int SQLiteSingleVerNaturalStore::InitSyncDigest(bool isEnable, bool isForceRebuild)
+{
+    int errCode = E_OK;
+    SQLiteSingleVerStorageExecutor *handle = GetHandle(true, errCode);
+    if (handle == nullptr) {
+        return errCode;
+    }
+    // Most opens find the digest as configured, the write transaction is only taken when it must be changed.
+    if (!isForceRebuild) {
+        bool isReady = false;
+        errCode = handle->CheckSyncDigest(isEnable, isReady);
+        if (errCode != E_OK || isReady) {
+            ReleaseHandle(handle);
+            return errCode;
+        }
+    }
+    errCode = handle->StartTransaction(TransactType::IMMEDIATE);
+    if (errCode != E_OK) {
+        ReleaseHandle(handle);
+        return errCode;
+    }
+    errCode = handle->InitSyncDigest(isEnable, isForceRebuild);
+    if (errCode == E_OK) {
+        errCode = handle->Commit();
+    } else {
+        LOGE("Init sync digest failed. %d", errCode);
+        (void)handle->Rollback();
+    }
     ReleaseHandle(handle);
     return errCode;
 }
@@ -25,8 +25,19 @@
 #include "kv_store_nb_conflict_data_impl.h"
 #include "runtime_context.h"
 #include "sqlite_single_ver_continue_token.h"
+#include "sync_data_compress_cache.h"
+#include "sync_data_read_cache.h"
+#include "sqlite_wal_checkpointer.h"
 
 namespace DistributedDB {
+// The sync data shared by the devices pushed with the same range, the builds read or compress the data.
+struct SyncDataCacheMetrics {
+    uint64_t readBuildCount = 0;
+    uint64_t readHitCount = 0;
+    uint64_t compressBuildCount = 0;
+    uint64_t compressHitCount = 0;
+};
+
 class SQLiteSingleVerNaturalStore : public SyncAbleKvDB, public SingleVerKvDBSyncInterface {
 public:
     SQLiteSingleVerNaturalStore();
@@ -179,6 +190,12 @@ public:
 
     void SetDataInterceptor(const PushDataInterceptor &interceptor) override;
 
+    bool HasDataInterceptor() const override;
+
+    std::shared_ptr<SyncDataCompressCache> GetSyncDataCompressCache() const override;
+
+    int GetSyncDigest(SyncDigest &digest) const override;
+
     int AddSubscribe(const std::string &subscribeId, const QueryObject &query, bool needCacheSubscribe) override;
 
     int RemoveSubscribe(const std::string &subscribeId) override;
@@ -189,6 +206,10 @@ public:
 
     uint64_t GetMaxLogSize() const;
 
+    WalCheckpointMetrics GetWalCheckpointMetrics() const;
+
+    SyncDataCacheMetrics GetSyncDataCacheMetrics() const;
+
 private:
     struct TransPair {
         int index;
@@ -263,6 +284,9 @@ private:
     int GetSyncDataForQuerySync(std::vector<DataItem> &dataItems, SQLiteSingleVerContinueToken *&continueStmtToken,
         const DataSizeSpecInfo &dataSizeInfo) const;
 
+    int GetSyncDataByTimestamp(SQLiteSingleVerStorageExecutor *handle, Timestamp begin, Timestamp end,
+        const DataSizeSpecInfo &dataSizeInfo, std::vector<DataItem> &dataItems) const;
+
     int SaveCreateDBTime();
     int SaveCreateDBTimeIfNotExisted();
 
@@ -270,6 +294,10 @@ private:
 
     int RemoveAllSubscribe();
 
+    int InitSyncDigest(bool isEnable, bool isForceRebuild);
+
+    void StartWalCheckpointer();
+
     DECLARE_OBJECT_TAG(SQLiteSingleVerNaturalStore);
 
     Timestamp currentMaxTimestamp_ = 0;
@@ -291,6 +319,12 @@ private:
     mutable std::shared_mutex dataInterceptorMutex_;
     PushDataInterceptor dataInterceptor_;
     std::atomic<uint64_t> maxLogSize_;
+
+    // shared by the sync tasks pushing the same range to different devices.
+    mutable SyncDataReadCache syncDataReadCache_;
+    std::shared_ptr<SyncDataCompressCache> syncDataCompressCache_;
+
+    SQLiteWalCheckpointer walCheckpointer_;
 };
 }
 #endif
@@ -1694,7 +1694,8 @@ int SQLiteSingleVerNaturalStoreConnection::PragmaResultSetCacheMode(PragmaData i
         return -E_INVALID_ARGS;
     }
     auto mode = *(static_cast<ResultSetCacheMode *>(inMode));
-    if (mode != ResultSetCacheMode::CACHE_FULL_ENTRY && mode != ResultSetCacheMode::CACHE_ENTRY_ID_ONLY) {
+    if (mode != ResultSetCacheMode::CACHE_FULL_ENTRY && mode != ResultSetCacheMode::CACHE_ENTRY_ID_ONLY &&
+        mode != ResultSetCacheMode::CACHE_ENTRY_PREFETCH) {
         return -E_INVALID_ARGS;
     }
     cacheModeForNewResultSet_.store(mode);
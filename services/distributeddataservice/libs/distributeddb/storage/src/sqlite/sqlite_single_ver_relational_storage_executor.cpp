@@ -902,16 +902,20 @@ int SQLiteSingleVerRelationalStorageExecutor::SaveSyncDataItems(const QueryObjec
         fieldInfos.push_back(col.second);
     }
 
-    for (auto &item : dataItems) {
-        if (item.neglect) { // Do not save this record if it is neglected
-            continue;
-        }
-        errCode = SaveSyncDataItem(fieldInfos, deviceName, item);
-        if (errCode != E_OK) {
-            break;
+    if (IsBulkApplyAvailable(dataItems)) {
+        errCode = SaveSyncDataItemsInBulk(dataItems, deviceName, fieldInfos);
+    } else {
+        for (auto &item : dataItems) {
+            if (item.neglect) { // Do not save this record if it is neglected
+                continue;
+            }
+            errCode = SaveSyncDataItem(fieldInfos, deviceName, item);
+            if (errCode != E_OK) {
+                break;
+            }
+            // Need not reset rmDataStmt and rmLogStmt here.
+            saveStmt_.ResetStatements(false);
         }
-        // Need not reset rmDataStmt and rmLogStmt here.
-        saveStmt_.ResetStatements(false);
     }
     if (errCode == -E_NOT_FOUND) {
         errCode = E_OK;
@@ -1122,13 +1126,16 @@ int SQLiteSingleVerRelationalStorageExecutor::DeleteDistributedDeviceTable(const
     }
 
     LOGD("Begin to delete device table: deviceTable[%zu]", deviceTables.size());
+    if (deviceTables.empty()) {
+        return E_OK;
+    }
+    std::string deleteSql;
     for (const auto &table : deviceTables) {
-        std::string deleteSql = "DROP TABLE IF EXISTS " + table + ";"; // drop the found table
-        errCode = SQLiteUtils::ExecuteRawSQL(dbHandle_, deleteSql);
-        if (errCode != E_OK) {
-            LOGE("Delete device data failed. %d", errCode);
-            break;
-        }
+        deleteSql += "DROP TABLE IF EXISTS " + table + ";"; // drop the found table
+    }
+    errCode = SQLiteUtils::ExecuteRawSQL(dbHandle_, deleteSql);
+    if (errCode != E_OK) {
+        LOGE("Delete device data failed. %d", errCode);
     }
     return errCode;
 }
@@ -1192,7 +1199,7 @@ int SQLiteSingleVerRelationalStorageExecutor::CheckAndCleanDistributedTable(cons
 }
 
 int SQLiteSingleVerRelationalStorageExecutor::CreateDistributedDeviceTable(const std::string &device,
-    const TableInfo &baseTbl)
+    const TableInfo &baseTbl, RelationalDeviceTableManager &tableManager)
 {
     if (dbHandle_ == nullptr) {
         return -E_INVALID_DB;
@@ -1203,19 +1210,25 @@ int SQLiteSingleVerRelationalStorageExecutor::CreateDistributedDeviceTable(const
     }
 
     std::string deviceTableName = DBCommon::GetDistributedTableName(device, baseTbl.GetTableName());
-    int errCode = SQLiteUtils::CreateSameStuTable(dbHandle_, baseTbl, deviceTableName);
+    std::string sql;
+    int errCode = tableManager.GetCreateSql(dbHandle_, baseTbl, deviceTableName, sql);
     if (errCode != E_OK) {
-        LOGE("Create device table failed. %d", errCode);
+        LOGE("Get create device table sql failed. %d", errCode);
         return errCode;
     }
 
-    errCode = SQLiteUtils::CloneIndexes(dbHandle_, baseTbl.GetTableName(), deviceTableName);
+    errCode = SQLiteUtils::ExecuteRawSQL(dbHandle_, sql);
     if (errCode != E_OK) {
-        LOGE("Copy index to device table failed. %d", errCode);
+        LOGE("Create device table failed. %d", errCode);
     }
     return errCode;
 }
 
+int SQLiteSingleVerRelationalStorageExecutor::GetSchemaVersion(int &version) const
+{
+    return SQLiteUtils::GetSchemaVersion(dbHandle_, version);
+}
+
 int SQLiteSingleVerRelationalStorageExecutor::CheckQueryObjectLegal(const TableInfo &table, QueryObject &query)
 {
     if (dbHandle_ == nullptr) {
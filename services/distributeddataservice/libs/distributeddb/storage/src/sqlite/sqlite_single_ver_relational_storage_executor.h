@@ -19,6 +19,7 @@
 #include "data_transformer.h"
 #include "db_types.h"
 #include "macro_utils.h"
+#include "relational_device_table_manager.h"
 #include "sqlite_utils.h"
 #include "sqlite_storage_executor.h"
 #include "relational_store_delegate.h"
@@ -66,7 +67,10 @@ public:
     int CheckAndCleanDistributedTable(const std::vector<std::string> &tableNames,
         std::vector<std::string> &missingTables);
 
-    int CreateDistributedDeviceTable(const std::string &device, const TableInfo &baseTbl);
+    int CreateDistributedDeviceTable(const std::string &device, const TableInfo &baseTbl,
+        RelationalDeviceTableManager &tableManager);
+
+    int GetSchemaVersion(int &version) const;
 
     int CheckQueryObjectLegal(const TableInfo &table, QueryObject &query);
 
@@ -105,6 +109,15 @@ private:
     int PrepareForSavingLog(const QueryObject &object, const std::string &deviceName,
         sqlite3_stmt *&statement,  sqlite3_stmt *&queryStmt) const;
 
+    // Apply the batch through a temp staging table, in sqlite_single_ver_relational_storage_executor_bulk.cpp
+    bool IsBulkApplyAvailable(const std::vector<DataItem> &dataItems) const;
+    int SaveSyncDataItemsInBulk(std::vector<DataItem> &dataItems, const std::string &deviceName,
+        const std::vector<FieldInfo> &fieldInfos);
+    int StageSyncDataItem(sqlite3_stmt *stageStmt, const DataItem &item, int64_t rowid);
+    int ExecuteStagedSql(const std::string &sql, const std::string &deviceName);
+    int RemoveStagedData(const std::string &deviceName);
+    int SaveStagedLog(const std::string &deviceName);
+
     int AlterAuxTableForUpgrade(const TableInfo &oldTableInfo, const TableInfo &newTableInfo);
 
     int DeleteSyncLog(const DataItem &item, sqlite3_stmt *&rmLogStmt);
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef RELATIONAL_STORE
+#include "sqlite_single_ver_relational_storage_executor.h"
+#include <set>
+#include "db_common.h"
+#include "db_constant.h"
+#include "db_errno.h"
+#include "log_print.h"
+
+namespace DistributedDB {
+namespace {
+    // A smaller batch is saved item by item, the staging costs more than it saves
+    const size_t BULK_APPLY_MIN_ITEMS = 16;
+    const std::string SYNC_STAGING_TABLE = DBConstant::RELATIONAL_PREFIX + "sync_staging";
+    const std::string DELETE_FLAG = std::to_string(DataItem::DELETE_FLAG);
+    const std::string MISS_QUERY_FLAG = std::to_string(DataItem::REMOTE_DEVICE_DATA_MISS_QUERY);
+
+    // The items which remove the data row, they are applied before the other items
+    bool IsRemovingItem(const DataItem &item)
+    {
+        return (item.flag & DataItem::DELETE_FLAG) != 0 || (item.flag & DataItem::REMOTE_DEVICE_DATA_MISS_QUERY) != 0;
+    }
+}
+
+bool SQLiteSingleVerRelationalStorageExecutor::IsBulkApplyAvailable(const std::vector<DataItem> &dataItems) const
+{
+    // Each item only looks at the log of its own hash key, so the batch can be applied together only if the hash keys
+    // are different, otherwise the later item must see what the earlier one has written.
+    std::set<Key> hashKeys;
+    for (const auto &item : dataItems) {
+        if (item.neglect) {
+            continue;
+        }
+        if (!hashKeys.insert(item.hashKey).second) {
+            LOGD("[RelationalStorageExecutor] Same hash key in the batch, save item by item.");
+            return false;
+        }
+    }
+    return hashKeys.size() >= BULK_APPLY_MIN_ITEMS;
+}
+
+int SQLiteSingleVerRelationalStorageExecutor::SaveSyncDataItemsInBulk(std::vector<DataItem> &dataItems,
+    const std::string &deviceName, const std::vector<FieldInfo> &fieldInfos)
+{
+    const std::string sql = "CREATE TEMP TABLE IF NOT EXISTS " + SYNC_STAGING_TABLE + "(" \
+        "hash_key BLOB NOT NULL PRIMARY KEY, data_key INT, timestamp INT, wtimestamp INT, flag INT);" \
+        "DELETE FROM " + SYNC_STAGING_TABLE + ";";
+    int errCode = SQLiteUtils::ExecuteRawSQL(dbHandle_, sql);
+    if (errCode != E_OK) {
+        LOGE("[RelationalStorageExecutor] Prepare staging table failed. %d", errCode);
+        return errCode;
+    }
+    sqlite3_stmt *stageStmt = nullptr;
+    errCode = SQLiteUtils::GetStatement(dbHandle_, "INSERT INTO " + SYNC_STAGING_TABLE +
+        " (hash_key, data_key, timestamp, wtimestamp, flag) VALUES(?, ?, ?, ?, ?);", stageStmt);
+    if (errCode != E_OK) {
+        LOGE("[RelationalStorageExecutor] Get staging statement failed. %d", errCode);
+        return errCode;
+    }
+
+    // Stage the removing items and remove their rows first, so they only remove the rows before this batch
+    for (auto &item : dataItems) {
+        if (item.neglect || !IsRemovingItem(item)) {
+            continue;
+        }
+        item.dev = deviceName;
+        errCode = StageSyncDataItem(stageStmt, item, -1); // -1 means no data row for the removed item
+        if (errCode != E_OK) {
+            break;
+        }
+    }
+    if (errCode == E_OK) {
+        errCode = RemoveStagedData(deviceName);
+    }
+    for (auto &item : dataItems) {
+        if (errCode != E_OK) {
+            break;
+        }
+        if (item.neglect || IsRemovingItem(item)) {
+            continue;
+        }
+        item.dev = deviceName;
+        int64_t rowid = -1;
+        errCode = SaveSyncDataItem(item, saveStmt_.saveDataStmt, saveStmt_.rmDataStmt, fieldInfos, rowid);
+        SQLiteUtils::ResetStatement(saveStmt_.saveDataStmt, false, errCode);
+        if (errCode == E_OK) {
+            errCode = StageSyncDataItem(stageStmt, item, rowid);
+        }
+    }
+    if (errCode == E_OK) {
+        errCode = SaveStagedLog(deviceName);
+    }
+    SQLiteUtils::ResetStatement(stageStmt, true, errCode);
+    int innerCode = SQLiteUtils::ExecuteRawSQL(dbHandle_, "DELETE FROM " + SYNC_STAGING_TABLE + ";");
+    return (errCode != E_OK) ? errCode : innerCode;
+}
+
+int SQLiteSingleVerRelationalStorageExecutor::StageSyncDataItem(sqlite3_stmt *stageStmt, const DataItem &item,
+    int64_t rowid)
+{
+    int errCode = SQLiteUtils::BindBlobToStatement(stageStmt, 1, item.hashKey); // 1 means hash_key index
+    if (errCode != E_OK) {
+        return errCode;
+    }
+    SQLiteUtils::BindInt64ToStatement(stageStmt, 2, rowid); // 2 means data_key index
+    SQLiteUtils::BindInt64ToStatement(stageStmt, 3, item.timestamp); // 3 means timestamp index
+    SQLiteUtils::BindInt64ToStatement(stageStmt, 4, item.writeTimestamp); // 4 means wtimestamp index
+    SQLiteUtils::BindInt64ToStatement(stageStmt, 5, item.flag); // 5 means flag index
+    errCode = SQLiteUtils::StepWithRetry(stageStmt, isMemDb_);
+    if (errCode == SQLiteUtils::MapSQLiteErrno(SQLITE_DONE)) {
+        errCode = E_OK;
+    }
+    SQLiteUtils::ResetStatement(stageStmt, false, errCode);
+    return errCode;
+}
+
+int SQLiteSingleVerRelationalStorageExecutor::ExecuteStagedSql(const std::string &sql, const std::string &deviceName)
+{
+    sqlite3_stmt *stmt = nullptr;
+    int errCode = SQLiteUtils::GetStatement(dbHandle_, sql, stmt);
+    if (errCode != E_OK) {
+        LOGE("[RelationalStorageExecutor] Get staged statement failed. %d", errCode);
+        return errCode;
+    }
+    errCode = SQLiteUtils::BindTextToStatement(stmt, 1, deviceName); // 1 means device index
+    if (errCode == E_OK) {
+        errCode = SQLiteUtils::StepWithRetry(stmt, isMemDb_);
+        if (errCode == SQLiteUtils::MapSQLiteErrno(SQLITE_DONE)) {
+            errCode = E_OK;
+        }
+    }
+    SQLiteUtils::ResetStatement(stmt, true, errCode);
+    return errCode;
+}
+
+int SQLiteSingleVerRelationalStorageExecutor::RemoveStagedData(const std::string &deviceName)
+{
+    // The miss query item is defeated by the local log which is not earlier than it
+    const std::string logTable = DBConstant::RELATIONAL_PREFIX + baseTblName_ + "_log";
+    const std::string joinLog = SYNC_STAGING_TABLE + " AS s, " + logTable + " AS l "
+        "WHERE l.hash_key = s.hash_key AND l.device = ?1 ";
+    const std::string notDefeated = "(s.flag&" + MISS_QUERY_FLAG + "=0 OR s.timestamp > l.timestamp)";
+    int errCode = ExecuteStagedSql("DELETE FROM " + table_.GetTableName() + " WHERE rowid IN ("
+        "SELECT l.data_key FROM " + joinLog + "AND l.flag&" + DELETE_FLAG + "=0 AND " + notDefeated + ");",
+        deviceName);
+    if (errCode != E_OK) {
+        LOGE("[RelationalStorageExecutor] Remove staged data failed. %d", errCode);
+        return errCode;
+    }
+    errCode = ExecuteStagedSql("DELETE FROM " + logTable + " WHERE device = ?1 AND hash_key IN ("
+        "SELECT s.hash_key FROM " + joinLog + "AND s.flag&" + MISS_QUERY_FLAG + "<>0 AND " + notDefeated + ");",
+        deviceName);
+    if (errCode != E_OK) {
+        LOGE("[RelationalStorageExecutor] Remove staged miss query log failed. %d", errCode);
+    }
+    return errCode;
+}
+
+int SQLiteSingleVerRelationalStorageExecutor::SaveStagedLog(const std::string &deviceName)
+{
+    // Same as SaveSyncLog: the write timestamp and the origin device of an existing log are kept
+    const std::string logTable = DBConstant::RELATIONAL_PREFIX + baseTblName_ + "_log";
+    const std::string sql = "INSERT OR REPLACE INTO " + logTable +
+        " (data_key, device, ori_device, timestamp, wtimestamp, flag, hash_key) "
+        "SELECT s.data_key, ?1, CASE WHEN l.hash_key IS NULL THEN CAST(?1 AS BLOB) ELSE l.ori_device END, "
+        "s.timestamp, CASE WHEN l.hash_key IS NULL THEN s.wtimestamp ELSE l.wtimestamp END, s.flag, s.hash_key "
+        "FROM " + SYNC_STAGING_TABLE + " AS s LEFT JOIN " + logTable + " AS l "
+        "ON l.hash_key = s.hash_key AND l.device = ?1 WHERE s.flag&" + MISS_QUERY_FLAG + "=0;";
+    int errCode = ExecuteStagedSql(sql, deviceName);
+    if (errCode != E_OK) {
+        LOGE("[RelationalStorageExecutor] Save staged log failed. %d", errCode);
+    }
+    return errCode;
+}
+} // namespace DistributedDB
+#endif
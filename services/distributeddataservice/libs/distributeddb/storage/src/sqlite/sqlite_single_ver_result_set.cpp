@@ -17,6 +17,7 @@
 #include <algorithm>
 #include "log_print.h"
 #include "db_errno.h"
+#include "runtime_context.h"
 #include "sqlite_single_ver_forward_cursor.h"
 #include "sqlite_single_ver_natural_store.h"
 #include "sqlite_single_ver_storage_executor.h"
@@ -27,6 +28,9 @@ namespace {
     const double MEM_WINDOW_SCALE = 0.5; // set default window size to 2G
     const double DEFAULT_WINDOW_SCALE = 1; // For non-mem db
     const int64_t WINDOW_SIZE_MB_UNIT = 1024 * 1024; // 1024 is scale
+    const uint32_t MIN_PREFETCH_ENTRIES = 8;
+    const uint32_t DEFAULT_PREFETCH_ENTRIES = 64; // Before the size of the entries is known
+    const uint32_t MAX_PREFETCH_ENTRIES = 512; // Less than the max bind variables of sqlite, 999 by default
 }
 
 SQLiteSingleVerResultSet::SQLiteSingleVerResultSet(SQLiteSingleVerNaturalStore *kvDB, const Key &keyPrefix,
@@ -37,6 +41,11 @@ SQLiteSingleVerResultSet::SQLiteSingleVerResultSet(SQLiteSingleVerNaturalStore *
 
 SQLiteSingleVerResultSet::~SQLiteSingleVerResultSet()
 {
+    {
+        // The prefetch task refers to this, normally it is already waited by Close
+        std::unique_lock<std::mutex> lock(mutex_);
+        prefetchCv_.wait(lock, [this]() { return !isPrefetching_; });
+    }
     isOpen_ = false;
     count_ = 0;
     position_ = INIT_POSTION;
@@ -214,6 +223,7 @@ int SQLiteSingleVerResultSet::MoveToForCacheEntryIdMode(int position) const
     // Clear rowId cache to accept new rowIds
     cachedRowIds_.clear();
     int errCode;
+    std::lock_guard<std::mutex> handleLock(handleMutex_);
     if (type_ == ResultSetType::KEYPREFIX) {
         errCode = handle_->ReloadResultSetForCacheRowIdMode(keyPrefix_, cachedRowIds_, cacheLimit, newCacheStartPos);
     } else {
@@ -237,7 +247,7 @@ int SQLiteSingleVerResultSet::MoveToForCacheEntryIdMode(int position) const
 
 int SQLiteSingleVerResultSet::GetEntry(Entry &entry) const
 {
-    std::lock_guard<std::mutex> lockGuard(mutex_);
+    std::unique_lock<std::mutex> lock(mutex_);
     if (!isOpen_ || count_ == 0) {
         return -E_NO_SUCH_ENTRY;
     }
@@ -245,32 +255,204 @@ int SQLiteSingleVerResultSet::GetEntry(Entry &entry) const
         // If position_ in the valid range, it can be guaranteed that everything is ok without errors
         if (option_.cacheMode == ResultSetCacheMode::CACHE_FULL_ENTRY) {
             return window_->GetEntry(entry);
+        } else if (option_.cacheMode == ResultSetCacheMode::CACHE_ENTRY_PREFETCH) {
+            return GetEntryForCacheEntryPrefetchMode(lock, entry);
         } else {
-            // It can be guaranteed position_ in the range [cacheStartPosition_, cacheEndPosition)
-            // For CodeDex false alarm, we still do the check which is not necessary
-            int cacheIndex = position_ - cacheStartPosition_;
-            if (cacheIndex < 0 || cacheIndex >= static_cast<int>(cachedRowIds_.size())) { // Not Possible
-                LOGE("[SqlSinResSet][GetEntry] Internal Error: Position=%d, CacheStartPos=%d, cached=%zu.", position_,
-                    cacheStartPosition_, cachedRowIds_.size());
-                return -E_INTERNAL_ERROR;
+            return GetEntryForCacheEntryIdMode(entry);
+        }
+    }
+    return -E_NO_SUCH_ENTRY;
+}
+
+int SQLiteSingleVerResultSet::GetEntryForCacheEntryIdMode(Entry &entry) const
+{
+    // It can be guaranteed position_ in the range [cacheStartPosition_, cacheEndPosition)
+    // For CodeDex false alarm, we still do the check which is not necessary
+    int cacheIndex = position_ - cacheStartPosition_;
+    if (cacheIndex < 0 || cacheIndex >= static_cast<int>(cachedRowIds_.size())) { // Not Possible
+        LOGE("[SqlSinResSet][GetEntry] Internal Error: Position=%d, CacheStartPos=%d, cached=%zu.", position_,
+            cacheStartPosition_, cachedRowIds_.size());
+        return -E_INTERNAL_ERROR;
+    }
+    std::lock_guard<std::mutex> handleLock(handleMutex_);
+    int errCode = handle_->GetEntryByRowId(cachedRowIds_[cacheIndex], entry);
+    if (errCode != E_OK) {
+        LOGE("[SqlSinResSet][GetEntry] GetEntryByRowId fail, errCode=%d.", errCode);
+        return errCode;
+    }
+    return E_OK;
+}
+
+int SQLiteSingleVerResultSet::GetEntryForCacheEntryPrefetchMode(std::unique_lock<std::mutex> &lock,
+    Entry &entry) const
+{
+    if (lastEntryPosition_ != INIT_POSTION && lastEntryPosition_ != position_) {
+        isForward_ = (position_ > lastEntryPosition_);
+    }
+    auto isInWindow = [this](int position) {
+        return position >= entryWindowStart_ && position < entryWindowStart_ + static_cast<int>(entryWindow_.size());
+    };
+    if (!isInWindow(position_)) {
+        if (isPrefetching_) {
+            // The prefetching window most likely contains the position, wait for it rather than load again
+            prefetchCv_.wait(lock, [this]() { return !isPrefetching_; });
+            if (!isOpen_ || position_ <= INIT_POSTION || position_ >= count_) {
+                return -E_NO_SUCH_ENTRY;
             }
-            int errCode = handle_->GetEntryByRowId(cachedRowIds_[cacheIndex], entry);
+        }
+        if (!isInWindow(position_)) {
+            int errCode = LoadEntryWindow(position_);
             if (errCode != E_OK) {
-                LOGE("[SqlSinResSet][GetEntry] GetEntryByRowId fail, errCode=%d.", errCode);
                 return errCode;
             }
-            return E_OK;
         }
     }
-    return -E_NO_SUCH_ENTRY;
+    lastEntryPosition_ = position_;
+    TriggerPrefetch(position_);
+    if (!entryWindowFound_[position_ - entryWindowStart_]) {
+        // Not possible in the snapshot, fail only this position if it is not found
+        LOGE("[SqlSinResSet][GetEntry] The entry at position=%d is deleted.", position_);
+        return -E_UNEXPECTED_DATA;
+    }
+    entry = entryWindow_[position_ - entryWindowStart_];
+    return E_OK;
 }
 
-void SQLiteSingleVerResultSet::Close()
+int SQLiteSingleVerResultSet::LoadEntryWindow(int position) const
+{
+    if (prefetchedStart_ != INIT_POSTION && position >= prefetchedStart_ &&
+        position < prefetchedStart_ + static_cast<int>(prefetchedEntries_.size())) {
+        entryWindow_ = std::move(prefetchedEntries_);
+        entryWindowFound_ = std::move(prefetchedFound_);
+        entryWindowStart_ = prefetchedStart_;
+        prefetchedEntries_.clear();
+        prefetchedFound_.clear();
+        prefetchedStart_ = INIT_POSTION;
+        return E_OK;
+    }
+    // The window is within the cached rowids and contains the position, extended in the scan direction
+    int windowSize = static_cast<int>(GetPrefetchWindowSize());
+    int cacheEndPosition = cacheStartPosition_ + static_cast<int>(cachedRowIds_.size());
+    int startPosition = std::max(isForward_ ? position : (position - windowSize + 1), cacheStartPosition_);
+    int endPosition = std::min(startPosition + windowSize, cacheEndPosition);
+    if (position < startPosition || position >= endPosition) { // Not Possible
+        LOGE("[SqlSinResSet][LoadWindow] Internal Error: Position=%d, CacheStartPos=%d, cached=%zu.", position,
+            cacheStartPosition_, cachedRowIds_.size());
+        return -E_INTERNAL_ERROR;
+    }
+    std::vector<int64_t> rowIds(cachedRowIds_.begin() + (startPosition - cacheStartPosition_),
+        cachedRowIds_.begin() + (endPosition - cacheStartPosition_));
+    std::vector<Entry> entries;
+    std::vector<bool> isFound;
+    int errCode;
+    {
+        std::lock_guard<std::mutex> handleLock(handleMutex_);
+        errCode = handle_->GetEntriesByRowIds(rowIds, entries, isFound);
+    }
+    if (errCode != E_OK) {
+        LOGE("[SqlSinResSet][LoadWindow] Load window at position=%d fail, errCode=%d.", startPosition, errCode);
+        return errCode;
+    }
+    UpdateAverageEntrySize(entries);
+    entryWindow_ = std::move(entries);
+    entryWindowFound_ = std::move(isFound);
+    entryWindowStart_ = startPosition;
+    return E_OK;
+}
+
+void SQLiteSingleVerResultSet::TriggerPrefetch(int position) const
+{
+    int windowEnd = entryWindowStart_ + static_cast<int>(entryWindow_.size());
+    int cacheEndPosition = cacheStartPosition_ + static_cast<int>(cachedRowIds_.size());
+    int windowSize = static_cast<int>(GetPrefetchWindowSize());
+    int startPosition;
+    int endPosition;
+    // Prefetch once half of the window is passed in the scan direction, not beyond the cached rowids
+    if (isForward_) {
+        if (position - entryWindowStart_ < static_cast<int>(entryWindow_.size()) / 2) {
+            return;
+        }
+        startPosition = windowEnd;
+        endPosition = std::min(windowEnd + windowSize, cacheEndPosition);
+    } else {
+        if (windowEnd - position <= static_cast<int>(entryWindow_.size()) / 2) {
+            return;
+        }
+        startPosition = std::max(entryWindowStart_ - windowSize, cacheStartPosition_);
+        endPosition = entryWindowStart_;
+    }
+    if (isPrefetching_ || startPosition >= endPosition ||
+        (prefetchedStart_ == startPosition && !prefetchedEntries_.empty())) {
+        return;
+    }
+    std::vector<int64_t> rowIds(cachedRowIds_.begin() + (startPosition - cacheStartPosition_),
+        cachedRowIds_.begin() + (endPosition - cacheStartPosition_));
+    isPrefetching_ = true;
+    int errCode = RuntimeContext::GetInstance()->ScheduleTask([this, startPosition, rowIds]() {
+        PrefetchEntries(startPosition, rowIds);
+    });
+    if (errCode != E_OK) {
+        LOGW("[SqlSinResSet][Prefetch] Schedule prefetch fail, errCode=%d.", errCode);
+        isPrefetching_ = false;
+    }
+}
+
+void SQLiteSingleVerResultSet::PrefetchEntries(int startPosition, const std::vector<int64_t> &rowIds) const
 {
+    std::vector<Entry> entries;
+    std::vector<bool> isFound;
+    int errCode;
+    {
+        std::lock_guard<std::mutex> handleLock(handleMutex_);
+        errCode = handle_->GetEntriesByRowIds(rowIds, entries, isFound);
+    }
     std::lock_guard<std::mutex> lockGuard(mutex_);
+    if (errCode == E_OK) {
+        UpdateAverageEntrySize(entries);
+        prefetchedEntries_ = std::move(entries);
+        prefetchedFound_ = std::move(isFound);
+        prefetchedStart_ = startPosition;
+    } else {
+        // Not fatal, the window is loaded when the position arrives
+        LOGW("[SqlSinResSet][Prefetch] Prefetch at position=%d fail, errCode=%d.", startPosition, errCode);
+    }
+    isPrefetching_ = false;
+    prefetchCv_.notify_all();
+}
+
+uint32_t SQLiteSingleVerResultSet::GetPrefetchWindowSize() const
+{
+    if (averageEntrySize_ == 0) {
+        return DEFAULT_PREFETCH_ENTRIES;
+    }
+    // The window and the prefetched window share the cacheMaxSize which is within [1,16]
+    uint64_t windowSize = static_cast<uint64_t>(option_.cacheMaxSize) * WINDOW_SIZE_MB_UNIT / 2 / averageEntrySize_;
+    return static_cast<uint32_t>(std::max<uint64_t>(MIN_PREFETCH_ENTRIES,
+        std::min<uint64_t>(windowSize, MAX_PREFETCH_ENTRIES)));
+}
+
+void SQLiteSingleVerResultSet::UpdateAverageEntrySize(const std::vector<Entry> &entries) const
+{
+    if (entries.empty()) {
+        return;
+    }
+    uint64_t totalSize = 0;
+    for (const auto &entry : entries) {
+        totalSize += entry.key.size() + entry.value.size();
+    }
+    uint64_t entrySize = std::max<uint64_t>(totalSize / entries.size(), 1); // at least 1 byte
+    // Half of the history is kept, so the window follows the size change of the entries soon
+    averageEntrySize_ = (averageEntrySize_ == 0) ? entrySize : (averageEntrySize_ + entrySize) / 2;
+}
+
+void SQLiteSingleVerResultSet::Close()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
     if (!isOpen_) {
         return;
     }
+    // The prefetch task uses the handle, which is released below
+    prefetchCv_.wait(lock, [this]() { return !isPrefetching_; });
     if (option_.cacheMode == ResultSetCacheMode::CACHE_FULL_ENTRY) {
         CloseForCacheFullEntryMode();
     } else {
@@ -297,6 +479,13 @@ void SQLiteSingleVerResultSet::CloseForCacheEntryIdMode()
 {
     cacheStartPosition_ = INIT_POSTION;
     cachedRowIds_.clear();
+    entryWindow_.clear();
+    entryWindowFound_.clear();
+    entryWindowStart_ = INIT_POSTION;
+    prefetchedEntries_.clear();
+    prefetchedFound_.clear();
+    prefetchedStart_ = INIT_POSTION;
+    lastEntryPosition_ = INIT_POSTION;
     // In Fact : handle_ and kvDB_ is guaranteed to be not nullptr
     if (handle_ != nullptr) {
         handle_->CloseResultSet();
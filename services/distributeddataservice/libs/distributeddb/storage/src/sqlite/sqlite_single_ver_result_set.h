@@ -16,6 +16,7 @@
 #ifndef SQLITE_SINGLE_VER_RESULT_SET_H
 #define SQLITE_SINGLE_VER_RESULT_SET_H
 
+#include <condition_variable>
 #include <mutex>
 #include <vector>
 
@@ -79,6 +80,14 @@ private:
     void CloseForCacheFullEntryMode();
     void CloseForCacheEntryIdMode();
 
+    int GetEntryForCacheEntryIdMode(Entry &entry) const;
+    int GetEntryForCacheEntryPrefetchMode(std::unique_lock<std::mutex> &lock, Entry &entry) const;
+    int LoadEntryWindow(int position) const;
+    void TriggerPrefetch(int position) const;
+    void PrefetchEntries(int startPosition, const std::vector<int64_t> &rowIds) const;
+    uint32_t GetPrefetchWindowSize() const;
+    void UpdateAverageEntrySize(const std::vector<Entry> &entries) const;
+
     const Option option_;
 
     // Common Part Of Two ResultSet Mode.
@@ -102,6 +111,21 @@ private:
     SQLiteSingleVerStorageExecutor *handle_ = nullptr;
     mutable std::vector<int64_t> cachedRowIds_;
     mutable int cacheStartPosition_ = INIT_POSTION; // The offset of the first cached rowid in all result rowids
+    mutable std::mutex handleMutex_; // The handle_ is used by the prefetch task as well
+
+    // Cache Entry Prefetch Mode Using The Cached RowIds Above, Load The Entries Of A Window In One Query, And The Next
+    // Window In The Scan Direction On The Task Pool. Both Read The Snapshot Of The Transaction Opened With The RowIds.
+    mutable std::condition_variable prefetchCv_;
+    mutable std::vector<Entry> entryWindow_;
+    mutable std::vector<bool> entryWindowFound_; // False for the entry deleted before the window is loaded
+    mutable int entryWindowStart_ = INIT_POSTION; // The position of the first entry in entryWindow_
+    mutable std::vector<Entry> prefetchedEntries_;
+    mutable std::vector<bool> prefetchedFound_;
+    mutable int prefetchedStart_ = INIT_POSTION;
+    mutable bool isPrefetching_ = false;
+    mutable bool isForward_ = true;
+    mutable int lastEntryPosition_ = INIT_POSTION; // The position of the last GetEntry, to know the scan direction
+    mutable uint64_t averageEntrySize_ = 0; // Observed from the loaded entries, decides the window size
 };
 } // namespace DistributedDB
 
@@ -197,6 +197,27 @@ int SQLiteSingleVerStorageEngine::ReleaseHandleTransiently(SQLiteSingleVerStorag
     return errCode;
 }
 
+int SQLiteSingleVerStorageEngine::AddSubscribeTriggerInMigrate(SQLiteSingleVerStorageExecutor *handle)
+{
+    std::map<std::string, SubscribeCondition> conditions = subscribeConditions_;
+    for (auto item : subscribeQuery_) {
+        SubscribeCondition condition;
+        int errCode = handle->GetSubscribeCondition(item.second, condition);
+        if (errCode != E_OK) {
+            LOGE("Add subscribe trigger failed: %d id: %s", errCode, item.first.c_str());
+            continue;
+        }
+        conditions[item.first] = std::move(condition);
+    }
+    subscribeQuery_.clear();
+    int errCode = handle->UpdateSubscribeTrigger(conditions);
+    // Not rollback even if some triggers add failed. Users don’t perceive errors, add triggers as much as possible
+    if (handle->Commit() == E_OK && errCode == E_OK) {
+        subscribeConditions_ = std::move(conditions);
+    }
+    return errCode;
+}
+
 int SQLiteSingleVerStorageEngine::AddSubscribeToMainDBInMigrate()
 {
     LOGD("Add subscribe to mainDB from cache. %d", engineState_);
@@ -211,19 +232,9 @@ int SQLiteSingleVerStorageEngine::AddSubscribeToMainDBInMigrate()
         return errCode;
     }
     errCode = handle->StartTransaction(TransactType::IMMEDIATE);
-    if (errCode != E_OK) {
-        goto END;
-    }
-    for (auto item : subscribeQuery_) {
-        errCode = handle->AddSubscribeTrigger(item.second, item.first);
-        if (errCode != E_OK) {
-            LOGE("Add subscribe trigger failed: %d id: %s", errCode, item.first.c_str());
-        }
+    if (errCode == E_OK) {
+        errCode = AddSubscribeTriggerInMigrate(handle);
     }
-    subscribeQuery_.clear();
-    // Not rollback even if some triggers add failed. Users don’t perceive errors, add triggers as much as possible
-    (void)handle->Commit();
-END:
     ReleaseExecutor(handle);
     return errCode;
 }
@@ -979,6 +990,12 @@ void SQLiteSingleVerStorageEngine::RegisterFunctionIfNeed(sqlite3 *dbHandle) con
     if (errCode != E_OK) {
         LOGW("[SqlSinEngine] RegisterMetaDataUpdateFunction fail, errCode = %d", errCode);
     }
+
+    // This function is used to maintain the sync digest in triggers if the digest sync is enabled
+    errCode = SQLiteUtils::RegisterSyncDigestFunction(dbHandle);
+    if (errCode != E_OK) {
+        LOGW("[SqlSinEngine] RegisterSyncDigestFunction fail, errCode = %d", errCode);
+    }
 }
 
 int SQLiteSingleVerStorageEngine::AttachMetaDatabase(sqlite3 *dbHandle, const OpenDbProperties &option) const
@@ -1138,4 +1155,16 @@ void SQLiteSingleVerStorageEngine::CacheSubscribe(const std::string &subscribeId
     std::lock_guard<std::mutex> lock(subscribeMutex_);
     subscribeQuery_[subscribeId] = query;
 }
+
+std::map<std::string, SubscribeCondition> SQLiteSingleVerStorageEngine::GetSubscribeConditions()
+{
+    std::lock_guard<std::mutex> lock(subscribeMutex_);
+    return subscribeConditions_;
+}
+
+void SQLiteSingleVerStorageEngine::SetSubscribeConditions(std::map<std::string, SubscribeCondition> conditions)
+{
+    std::lock_guard<std::mutex> lock(subscribeMutex_);
+    subscribeConditions_ = std::move(conditions);
+}
 }
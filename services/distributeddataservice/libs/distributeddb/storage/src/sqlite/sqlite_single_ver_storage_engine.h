@@ -60,6 +60,10 @@ public:
 
     void CacheSubscribe(const std::string &subscribeId, const QueryObject &query);
 
+    // The conditions of the subscribe queries whose triggers are in the main db, the triggers are rebuilt from them.
+    std::map<std::string, SubscribeCondition> GetSubscribeConditions();
+    void SetSubscribeConditions(std::map<std::string, SubscribeCondition> conditions);
+
 protected:
     StorageExecutor *NewSQLiteStorageExecutor(sqlite3 *dbHandle, bool isWrite, bool isMemDb) override;
 
@@ -112,6 +116,8 @@ private:
 
     // For subscribe
     int AddSubscribeToMainDBInMigrate();
+    // Called with the subscribeMutex_ locked, the transaction of the handle is committed here.
+    int AddSubscribeTriggerInMigrate(SQLiteSingleVerStorageExecutor *handle);
 
     mutable std::mutex migrateLock_;
     std::atomic<uint64_t> cacheRecordVersion_;
@@ -121,6 +127,7 @@ private:
 
     std::mutex subscribeMutex_;
     std::map<std::string, QueryObject> subscribeQuery_;
+    std::map<std::string, SubscribeCondition> subscribeConditions_;
 };
 } // namespace DistributedDB
 
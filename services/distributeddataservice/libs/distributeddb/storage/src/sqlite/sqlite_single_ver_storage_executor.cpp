@@ -16,6 +16,7 @@
 #include "sqlite_single_ver_storage_executor.h"
 
 #include <algorithm>
+#include <map>
 
 #include "log_print.h"
 #include "db_constant.h"
@@ -990,6 +991,66 @@ int SQLiteSingleVerStorageExecutor::GetEntryByRowId(int64_t rowId, Entry &entry)
     }
 }
 
+int SQLiteSingleVerStorageExecutor::GetEntriesByRowIds(const std::vector<int64_t> &rowIds,
+    std::vector<Entry> &entries, std::vector<bool> &isFound)
+{
+    entries.clear();
+    isFound.clear();
+    if (rowIds.empty()) {
+        return E_OK;
+    }
+    std::string sql = SELECT_SYNC_DATA_BY_ROWIDS_SQL_PREFIX;
+    for (size_t i = 0; i < rowIds.size(); i++) {
+        sql += (i == 0) ? "?" : ",?";
+    }
+    sql += ");";
+    sqlite3_stmt *stmt = nullptr;
+    int errCode = SQLiteUtils::GetStatement(dbHandle_, sql, stmt);
+    if (errCode != E_OK) {
+        LOGE("[SqlSinExe][GetEntriesByRowids] Get stmt fail, errCode=%d.", errCode);
+        return CheckCorruptedStatus(errCode);
+    }
+    std::map<int64_t, size_t> indexes;
+    for (size_t i = 0; i < rowIds.size(); i++) {
+        SQLiteUtils::BindInt64ToStatement(stmt, static_cast<int>(i + 1), rowIds[i]); // bind index start from 1
+        indexes[rowIds[i]] = i;
+    }
+    entries.resize(rowIds.size());
+    isFound.resize(rowIds.size(), false);
+    size_t found = 0;
+    while ((errCode = SQLiteUtils::StepWithRetry(stmt, isMemDb_)) == SQLiteUtils::MapSQLiteErrno(SQLITE_ROW)) {
+        auto iter = indexes.find(sqlite3_column_int64(stmt, 0));
+        if (iter == indexes.end()) { // Not possible
+            continue;
+        }
+        Entry &entry = entries[iter->second];
+        errCode = SQLiteUtils::GetColumnBlobValue(stmt, 1, entry.key);
+        if (errCode == E_OK) {
+            errCode = SQLiteUtils::GetColumnBlobValue(stmt, 2, entry.value); // 2 is the index of value
+        }
+        if (errCode != E_OK) {
+            LOGE("[SqlSinExe][GetEntriesByRowids] Get entry failed, errCode=%d.", errCode);
+            break;
+        }
+        isFound[iter->second] = true;
+        found++;
+    }
+    if (errCode == SQLiteUtils::MapSQLiteErrno(SQLITE_DONE)) {
+        errCode = E_OK;
+        if (found != indexes.size()) {
+            LOGW("[SqlSinExe][GetEntriesByRowids] %zu of %zu entries not found.", indexes.size() - found,
+                indexes.size());
+        }
+    }
+    SQLiteUtils::ResetStatement(stmt, true, errCode);
+    if (errCode != E_OK) {
+        LOGE("[SqlSinExe][GetEntriesByRowids] Get %zu entries failed, errCode=%d.", rowIds.size(), errCode);
+        entries.clear();
+        isFound.clear();
+    }
+    return CheckCorruptedStatus(errCode);
+}
+
 void SQLiteSingleVerStorageExecutor::CloseResultSet()
 {
     int errCode = E_OK;
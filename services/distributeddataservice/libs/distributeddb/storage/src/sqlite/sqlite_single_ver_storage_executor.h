@@ -22,6 +22,7 @@
 #include "sqlite_utils.h"
 #include "sqlite_storage_executor.h"
 #include "single_ver_natural_store_commit_notify_data.h"
+#include "sync_digest.h"
 
 namespace DistributedDB {
 enum class SingleVerDataType {
@@ -44,6 +45,12 @@ enum class ExecutorState {
     CACHE_ATTACH_MAIN, // while cacheDb migrating to mainDb
 };
 
+// The compiled conditions of one subscribe query, the subscribe triggers of all the queries are built from them.
+struct SubscribeCondition {
+    std::string insertCondition;
+    std::string updateCondition;
+};
+
 struct DataOperStatus {
     DataStatus preStatus = DataStatus::NOEXISTED;
     bool isDeleted = false;
@@ -172,6 +179,11 @@ public:
 
     int GetEntryByRowId(int64_t rowId, Entry &entry);
 
+    // Get the entries in one query, in the order of the rowIds. Not bound to the statements of the result set.
+    // The entry deleted since is not found, it is left empty.
+    int GetEntriesByRowIds(const std::vector<int64_t> &rowIds, std::vector<Entry> &entries,
+        std::vector<bool> &isFound);
+
     void CloseResultSet();
 
     int StartTransaction(TransactType type);
@@ -231,9 +243,10 @@ public:
 
     static size_t GetDataItemSerialSize(const DataItem &item, size_t appendLen);
 
-    int AddSubscribeTrigger(QueryObject &query, const std::string &subscribeId);
+    int GetSubscribeCondition(QueryObject &query, SubscribeCondition &condition) const;
 
-    int RemoveSubscribeTrigger(const std::vector<std::string> &subscribeIds);
+    // Rebuild the consolidated subscribe triggers with the conditions of all the active subscribe queries.
+    int UpdateSubscribeTrigger(const std::map<std::string, SubscribeCondition> &conditions);
 
     int RemoveSubscribeTriggerWaterMark(const std::vector<std::string> &subscribeIds);
 
@@ -241,6 +254,14 @@ public:
 
     int RemoveTrigger(const std::vector<std::string> &triggers);
 
+    // Create the sync digest table and its triggers, or drop them if not enabled. Rebuilt if forced or just created.
+    int InitSyncDigest(bool isEnable, bool isForceRebuild);
+
+    // Check without write if the sync digest table and its triggers already exist or not as enabled.
+    int CheckSyncDigest(bool isEnable, bool &isReady);
+
+    int GetSyncDigest(SyncDigest &digest) const;
+
     int GetSyncDataWithQuery(const QueryObject &query, size_t appendLength, const DataSizeSpecInfo &dataSizeInfo,
         const std::pair<Timestamp, Timestamp> &timeRange, std::vector<DataItem> &dataItems) const;
 
@@ -285,6 +306,8 @@ private:
 
     int GetSyncDataPreByHashKey(const Key &hashKey, DataItem &itemGet) const;
 
+    int RebuildSyncDigest();
+
     int PrepareForSyncDataByTime(Timestamp begin, Timestamp end, sqlite3_stmt *&statement, bool getDeletedData = false)
         const;
 
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sqlite_single_ver_storage_executor.h"
+
+#include "log_print.h"
+#include "db_constant.h"
+#include "db_errno.h"
+#include "sqlite_single_ver_storage_executor_sql.h"
+
+namespace DistributedDB {
+using namespace TriggerMode;
+
+namespace {
+    std::string FormatDigestUpdateSql(const std::string &reference)
+    {
+        return "    UPDATE sync_digest SET digest=" + DBConstant::SYNC_DIGEST_RECORD_FUNC + "(digest, " + reference +
+            "hash_key, " + reference + "value, " + reference + "flag) WHERE bucket=" +
+            DBConstant::SYNC_DIGEST_BUCKET_FUNC + "(" + reference + "hash_key);\n";
+    }
+
+    // The record is xor out of its bucket with the old value and xor in with the new value.
+    std::string FormatDigestTriggerSql(TriggerModeEnum mode)
+    {
+        std::string body;
+        if (mode != TriggerModeEnum::INSERT) {
+            body += FormatDigestUpdateSql(DBConstant::TRIGGER_REFERENCES_OLD);
+        }
+        if (mode != TriggerModeEnum::DELETE) {
+            body += FormatDigestUpdateSql(DBConstant::TRIGGER_REFERENCES_NEW);
+        }
+        std::string triggerModeString = GetTriggerModeString(mode);
+        return "CREATE TRIGGER IF NOT EXISTS " + SYNC_DIGEST_TRIGGER_PREFIX + triggerModeString + " AFTER " +
+            triggerModeString + " \n"
+            "ON sync_data\n"
+            "BEGIN\n" + body +
+            "END;";
+    }
+}
+
+int SQLiteSingleVerStorageExecutor::InitSyncDigest(bool isEnable, bool isForceRebuild)
+{
+    std::vector<std::string> triggers;
+    int errCode = GetTriggers(SYNC_DIGEST_TRIGGER_PREFIX, triggers);
+    if (errCode != E_OK) {
+        LOGE("Get sync digest triggers failed. %d", errCode);
+        return errCode;
+    }
+    if (!isEnable) {
+        errCode = RemoveTrigger(triggers);
+        if (errCode != E_OK) {
+            LOGE("Remove sync digest triggers failed. %d", errCode);
+            return errCode;
+        }
+        return SQLiteUtils::ExecuteRawSQL(dbHandle_, DROP_SYNC_DIGEST_TABLE_SQL);
+    }
+    // The triggers are created with the table in one transaction, the table is consistent if they exist.
+    if (!triggers.empty() && !isForceRebuild) {
+        return E_OK;
+    }
+    errCode = SQLiteUtils::ExecuteRawSQL(dbHandle_, CREATE_SYNC_DIGEST_TABLE_SQL);
+    if (errCode != E_OK) {
+        LOGE("Create sync digest table failed. %d", errCode);
+        return errCode;
+    }
+    for (auto mode : {TriggerModeEnum::INSERT, TriggerModeEnum::UPDATE, TriggerModeEnum::DELETE}) {
+        errCode = SQLiteUtils::ExecuteRawSQL(dbHandle_, FormatDigestTriggerSql(mode));
+        if (errCode != E_OK) {
+            LOGE("Create sync digest trigger failed. mode: %u, errCode: %d", static_cast<unsigned>(mode), errCode);
+            return errCode;
+        }
+    }
+    return RebuildSyncDigest();
+}
+
+int SQLiteSingleVerStorageExecutor::CheckSyncDigest(bool isEnable, bool &isReady)
+{
+    std::vector<std::string> triggers;
+    int errCode = GetTriggers(SYNC_DIGEST_TRIGGER_PREFIX, triggers);
+    if (errCode != E_OK) {
+        LOGE("Get sync digest triggers failed. %d", errCode);
+        return errCode;
+    }
+    sqlite3_stmt *stmt = nullptr;
+    errCode = SQLiteUtils::GetStatement(dbHandle_, CHECK_SYNC_DIGEST_TABLE_SQL, stmt);
+    if (errCode != E_OK) {
+        LOGE("Get sync digest table check statement failed. %d", errCode);
+        return errCode;
+    }
+    bool isTableExisted = false;
+    errCode = SQLiteUtils::StepWithRetry(stmt, isMemDb_);
+    if (errCode == SQLiteUtils::MapSQLiteErrno(SQLITE_ROW)) {
+        isTableExisted = (sqlite3_column_int64(stmt, 0) > 0);
+        errCode = E_OK;
+    } else {
+        LOGE("Check sync digest table failed. %d", errCode);
+    }
+    SQLiteUtils::ResetStatement(stmt, true, errCode);
+    if (errCode != E_OK) {
+        return errCode;
+    }
+    isReady = isEnable ? (isTableExisted && !triggers.empty()) : (!isTableExisted && triggers.empty());
+    return E_OK;
+}
+
+int SQLiteSingleVerStorageExecutor::RebuildSyncDigest()
+{
+    sqlite3_stmt *stmt = nullptr;
+    int errCode = SQLiteUtils::GetStatement(dbHandle_, SELECT_SYNC_DIGEST_RECORD_SQL, stmt);
+    if (errCode != E_OK) {
+        LOGE("Get sync digest record statement failed. %d", errCode);
+        return errCode;
+    }
+    SyncDigest digest;
+    do {
+        errCode = SQLiteUtils::StepWithRetry(stmt, isMemDb_);
+        if (errCode == SQLiteUtils::MapSQLiteErrno(SQLITE_DONE)) {
+            errCode = E_OK;
+            break;
+        } else if (errCode != SQLiteUtils::MapSQLiteErrno(SQLITE_ROW)) {
+            LOGE("Get sync digest record failed. %d", errCode);
+            break;
+        }
+        auto hashKey = static_cast<const uint8_t *>(sqlite3_column_blob(stmt, 0));
+        int hashKeyLen = sqlite3_column_bytes(stmt, 0);
+        auto value = static_cast<const uint8_t *>(sqlite3_column_blob(stmt, 1));
+        int valueLen = sqlite3_column_bytes(stmt, 1);
+        if (hashKey == nullptr || hashKeyLen <= 0) {
+            continue;
+        }
+        uint64_t flag = static_cast<uint64_t>(sqlite3_column_int64(stmt, 2)); // 2 is the flag
+        digest.AddRecord(SyncDigest::GetBucket(hashKey, static_cast<uint32_t>(hashKeyLen)),
+            SyncDigest::CalcRecordDigest(hashKey, static_cast<uint32_t>(hashKeyLen), value,
+            (value == nullptr) ? 0 : static_cast<uint32_t>(valueLen), flag));
+    } while (true);
+    SQLiteUtils::ResetStatement(stmt, true, errCode);
+    if (errCode != E_OK) {
+        return errCode;
+    }
+
+    errCode = SQLiteUtils::GetStatement(dbHandle_, UPSERT_SYNC_DIGEST_SQL, stmt);
+    if (errCode != E_OK) {
+        LOGE("Get sync digest update statement failed. %d", errCode);
+        return errCode;
+    }
+    for (uint32_t bucket = 0; bucket < SyncDigest::LEAF_NUM; bucket++) {
+        errCode = sqlite3_bind_int64(stmt, 1, bucket);
+        if (errCode == SQLITE_OK) {
+            errCode = sqlite3_bind_int64(stmt, 2, static_cast<int64_t>(digest.GetLeaf(bucket))); // 2 is digest
+        }
+        if (errCode != SQLITE_OK) {
+            errCode = SQLiteUtils::MapSQLiteErrno(errCode);
+            LOGE("Bind sync digest failed. %d", errCode);
+            break;
+        }
+        errCode = SQLiteUtils::StepWithRetry(stmt, isMemDb_);
+        if (errCode != SQLiteUtils::MapSQLiteErrno(SQLITE_DONE)) {
+            LOGE("Update sync digest failed. %d", errCode);
+            break;
+        }
+        errCode = E_OK;
+        SQLiteUtils::ResetStatement(stmt, false, errCode);
+        if (errCode != E_OK) {
+            break;
+        }
+    }
+    SQLiteUtils::ResetStatement(stmt, true, errCode);
+    return errCode;
+}
+
+int SQLiteSingleVerStorageExecutor::GetSyncDigest(SyncDigest &digest) const
+{
+    // Read the max timestamp first, so all the records not later than it are covered by the digest read after.
+    sqlite3_stmt *stmt = nullptr;
+    int errCode = SQLiteUtils::GetStatement(dbHandle_, SELECT_MAX_SYNC_TIMESTAMP_SQL, stmt);
+    if (errCode != E_OK) {
+        return errCode;
+    }
+    errCode = SQLiteUtils::StepWithRetry(stmt, isMemDb_);
+    if (errCode == SQLiteUtils::MapSQLiteErrno(SQLITE_ROW)) {
+        digest.SetTimestamp(static_cast<Timestamp>(sqlite3_column_int64(stmt, 0)));
+        errCode = E_OK;
+    } else {
+        LOGE("Get max timestamp of the sync digest failed. %d", errCode);
+    }
+    SQLiteUtils::ResetStatement(stmt, true, errCode);
+    if (errCode != E_OK) {
+        return errCode;
+    }
+
+    errCode = SQLiteUtils::GetStatement(dbHandle_, SELECT_SYNC_DIGEST_SQL, stmt);
+    if (errCode != E_OK) {
+        return errCode;
+    }
+    do {
+        errCode = SQLiteUtils::StepWithRetry(stmt, isMemDb_);
+        if (errCode == SQLiteUtils::MapSQLiteErrno(SQLITE_DONE)) {
+            errCode = E_OK;
+            break;
+        } else if (errCode != SQLiteUtils::MapSQLiteErrno(SQLITE_ROW)) {
+            LOGE("Get sync digest failed. %d", errCode);
+            break;
+        }
+        digest.SetLeaf(static_cast<uint32_t>(sqlite3_column_int64(stmt, 0)),
+            static_cast<uint64_t>(sqlite3_column_int64(stmt, 1)));
+    } while (true);
+    SQLiteUtils::ResetStatement(stmt, true, errCode);
+    return errCode;
+}
+} // namespace DistributedDB
@@ -134,6 +134,10 @@ namespace DistributedDB {
     const std::string SELECT_SYNC_DATA_BY_ROWID_SQL =
         "SELECT key, value FROM sync_data WHERE rowid=?;";
 
+    // Followed by the binding of each rowid, as "?,?);". The deleted since the rowids are got is not selected.
+    const std::string SELECT_SYNC_DATA_BY_ROWIDS_SQL_PREFIX =
+        "SELECT rowid, key, value FROM sync_data WHERE (flag&0x01=0) AND rowid IN (";
+
     const std::string SELECT_LOCAL_PREFIX_SQL =
         "SELECT key, value FROM local_data WHERE key>=? AND key<=? ORDER BY key ASC;";
 
@@ -208,6 +212,24 @@ namespace DistributedDB {
     const std::string GET_SYNC_DATA_TIRGGER_SQL =
         "SELECT name FROM SQLITE_MASTER WHERE TYPE = 'trigger' AND TBL_NAME = 'sync_data' AND name like ?;";
 
+    const std::string CREATE_SYNC_DIGEST_TABLE_SQL =
+        "CREATE TABLE IF NOT EXISTS sync_digest(bucket INTEGER PRIMARY KEY, digest INTEGER NOT NULL DEFAULT 0);";
+
+    const std::string DROP_SYNC_DIGEST_TABLE_SQL = "DROP TABLE IF EXISTS sync_digest;";
+
+    const std::string CHECK_SYNC_DIGEST_TABLE_SQL =
+        "SELECT COUNT(*) FROM SQLITE_MASTER WHERE TYPE = 'table' AND name = 'sync_digest';";
+
+    const std::string UPSERT_SYNC_DIGEST_SQL = "INSERT OR REPLACE INTO sync_digest(bucket, digest) VALUES(?, ?);";
+
+    const std::string SELECT_SYNC_DIGEST_SQL = "SELECT bucket, digest FROM sync_digest;";
+
+    const std::string SELECT_SYNC_DIGEST_RECORD_SQL = "SELECT hash_key, value, flag FROM sync_data;";
+
+    const std::string SELECT_MAX_SYNC_TIMESTAMP_SQL = "SELECT MAX(timestamp) FROM sync_data;";
+
+    const std::string SYNC_DIGEST_TRIGGER_PREFIX = "sync_digest_ON_";
+
     const int BIND_KV_KEY_INDEX = 1;
     const int BIND_KV_VAL_INDEX = 2;
     const int BIND_LOCAL_TIMESTAMP_INDEX = 3;
@@ -127,26 +127,61 @@ int SQLiteSingleVerStorageExecutor::CheckDataWithQuery(QueryObject query, std::v
 }
 
 namespace {
-std::string FormatSubscribeTriggerSql(const std::string &subscribeId, const std::string &subscribeCondition,
-    TriggerModeEnum mode)
+// Keep below the default SQLITE_MAX_FUNCTION_ARG(127), the queries beyond it are evaluated by the next statement.
+constexpr int MAX_SUBSCRIBE_FUNC_ARGS = 100;
+
+std::string GetSubscribeMetaKeyHex(const std::string &subscribeId)
 {
-    std::string triggerModeString = GetTriggerModeString(mode);
-    std::string accessString = ((mode == TriggerModeEnum::DELETE) ?
-        DBConstant::TRIGGER_REFERENCES_OLD : DBConstant::TRIGGER_REFERENCES_NEW);
     std::string keyStr = DBConstant::SUBSCRIBE_QUERY_PREFIX + DBCommon::TransferHashString(subscribeId);
     Key key {keyStr.begin(), keyStr.end()};
-    std::string hexKeyStr = DBCommon::VectorToHexString(key);
-    std::string triggerName = DBConstant::SUBSCRIBE_QUERY_PREFIX + subscribeId + "_ON_" + triggerModeString;
+    return "x'" + DBCommon::VectorToHexString(key) + "'";
+}
+
+// The queries with the same condition share one evaluation of it, all the conditions of one statement share the
+// parsed value of the json_extract_by_path.
+std::string FormatSubscribeTriggerSql(const std::map<std::string, SubscribeCondition> &conditions,
+    TriggerModeEnum mode)
+{
+    std::map<std::string, std::vector<std::string>> groups;
+    for (const auto &[subscribeId, condition] : conditions) {
+        const std::string &conditionStr = ((mode == TriggerModeEnum::INSERT) ?
+            condition.insertCondition : condition.updateCondition);
+        groups[conditionStr].push_back(GetSubscribeMetaKeyHex(subscribeId));
+    }
+    std::string body;
+    std::string args;
+    int argCount = 0;
+    for (const auto &[conditionStr, keys] : groups) {
+        bool isConditionAdded = false;
+        for (const auto &key : keys) {
+            if (argCount + (isConditionAdded ? 1 : 2) > MAX_SUBSCRIBE_FUNC_ARGS) { // 2: the condition and key
+                body += "    SELECT " + DBConstant::UPDATE_SUBSCRIBE_META_FUNC + "(NEW.TIMESTAMP" + args + ");\n";
+                args.clear();
+                argCount = 0;
+                isConditionAdded = false;
+            }
+            if (!isConditionAdded) {
+                args += ",\n        (" + conditionStr + ")";
+                argCount++;
+                isConditionAdded = true;
+            }
+            args += ", " + key;
+            argCount++;
+        }
+    }
+    if (argCount != 0) {
+        body += "    SELECT " + DBConstant::UPDATE_SUBSCRIBE_META_FUNC + "(NEW.TIMESTAMP" + args + ");\n";
+    }
+    std::string triggerModeString = GetTriggerModeString(mode);
+    std::string triggerName = DBConstant::SUBSCRIBE_QUERY_PREFIX + "ON_" + triggerModeString;
     return "CREATE TRIGGER IF NOT EXISTS " + triggerName + " AFTER " + triggerModeString + " \n"
         "ON sync_data\n"
-        "WHEN " + subscribeCondition + "\n"
-        "BEGIN\n"
-        "    SELECT " + DBConstant::UPDATE_META_FUNC + "(x'" + hexKeyStr + "', NEW.TIMESTAMP);\n"
+        "BEGIN\n" + body +
         "END;";
 }
 }
 
-int SQLiteSingleVerStorageExecutor::AddSubscribeTrigger(QueryObject &query, const std::string &subscribeId)
+int SQLiteSingleVerStorageExecutor::GetSubscribeCondition(QueryObject &query, SubscribeCondition &condition) const
 {
     if (executorState_ == ExecutorState::CACHEDB || executorState_ == ExecutorState::CACHE_ATTACH_MAIN) {
         LOGE("Not support add subscribe in cache db.");
@@ -160,50 +195,48 @@ int SQLiteSingleVerStorageExecutor::AddSubscribeTrigger(QueryObject &query, cons
     }
     // check if sqlite function is registered or not
     sqlite3_stmt *stmt = nullptr;
-    errCode = SQLiteUtils::GetStatement(dbHandle_, "SELECT " + DBConstant::UPDATE_META_FUNC + "('K', 0);", stmt);
+    errCode = SQLiteUtils::GetStatement(dbHandle_, "SELECT " + DBConstant::UPDATE_SUBSCRIBE_META_FUNC + "(0);", stmt);
     if (errCode != E_OK) {
-        LOGE("sqlite function %s has not been created.", DBConstant::UPDATE_META_FUNC.c_str());
+        LOGE("sqlite function %s has not been created.", DBConstant::UPDATE_SUBSCRIBE_META_FUNC.c_str());
         return -E_NOT_SUPPORT;
     }
     SQLiteUtils::ResetStatement(stmt, true, errCode);
 
     // Delete data API is actually an update operation, there is no need for DELETE trigger
     for (auto mode : {TriggerModeEnum::INSERT, TriggerModeEnum::UPDATE}) {
-        std::string subscribeCondition;
-        errCode = helper.GetSubscribeSql(subscribeId, mode, subscribeCondition);
+        std::string &subscribeCondition = ((mode == TriggerModeEnum::INSERT) ?
+            condition.insertCondition : condition.updateCondition);
+        subscribeCondition.clear();
+        errCode = helper.GetSubscribeSql("", mode, subscribeCondition);
         if (errCode != E_OK) {
             LOGE("Get subscribe trigger create sql failed. mode: %u, errCode: %d", static_cast<unsigned>(mode),
                 errCode);
             return errCode;
         }
-        std::string sql = FormatSubscribeTriggerSql(subscribeId, subscribeCondition, mode);
-        errCode = SQLiteUtils::ExecuteRawSQL(dbHandle_, sql);
-        if (errCode != E_OK) {
-            LOGE("Add subscribe trigger failed. mode: %u, errCode: %d", static_cast<unsigned>(mode), errCode);
-            return errCode;
-        }
     }
     return E_OK;
 }
 
-int SQLiteSingleVerStorageExecutor::RemoveSubscribeTrigger(const std::vector<std::string> &subscribeIds)
+int SQLiteSingleVerStorageExecutor::UpdateSubscribeTrigger(const std::map<std::string, SubscribeCondition> &conditions)
 {
-    int errCode = E_OK;
-    for (const auto &id : subscribeIds) {
-        for (auto mode : {TriggerModeEnum::INSERT, TriggerModeEnum::UPDATE}) {
-            const std::string trigger = DBConstant::SUBSCRIBE_QUERY_PREFIX + id + "_ON_" + GetTriggerModeString(mode);
-            errCode = SQLiteUtils::DropTriggerByName(dbHandle_, trigger);
-            if (errCode != E_OK) {
-                LOGE("remove subscribe trigger failed. %d", errCode);
-                break;
-            }
+    for (auto mode : {TriggerModeEnum::INSERT, TriggerModeEnum::UPDATE}) {
+        const std::string trigger = DBConstant::SUBSCRIBE_QUERY_PREFIX + "ON_" + GetTriggerModeString(mode);
+        int errCode = SQLiteUtils::ExecuteRawSQL(dbHandle_, "DROP TRIGGER IF EXISTS " + trigger + ";");
+        if (errCode != E_OK) {
+            LOGE("remove subscribe trigger failed. mode: %u, errCode: %d", static_cast<unsigned>(mode), errCode);
+            return errCode;
         }
+        if (conditions.empty()) {
+            continue;
+        }
+        errCode = SQLiteUtils::ExecuteRawSQL(dbHandle_, FormatSubscribeTriggerSql(conditions, mode));
         if (errCode != E_OK) {
-            LOGE("remove subscribe trigger for id %s failed. %d", id.c_str(), errCode);
-            break;
+            LOGE("Add subscribe trigger failed. mode: %u, errCode: %d", static_cast<unsigned>(mode), errCode);
+            return errCode;
         }
     }
-    return errCode;
+    LOGD("Subscribe trigger updated, query count: %zu", conditions.size());
+    return E_OK;
 }
 
 int SQLiteSingleVerStorageExecutor::RemoveTrigger(const std::vector<std::string> &triggers)
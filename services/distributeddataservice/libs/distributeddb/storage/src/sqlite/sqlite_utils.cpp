@@ -34,6 +34,8 @@
 #include "schema_constant.h"
 #include "time_helper.h"
 #include "platform_specific.h"
+#include "sync_digest.h"
+#include "sqlite_wal_checkpointer.h"
 
 namespace DistributedDB {
 namespace {
@@ -87,6 +89,29 @@ namespace {
         }
     }
 
+    // The page size is set before the journal mode, the others after it
+    void GetStorageProfileSqls(const StorageProfile &profile, std::vector<std::string> &sqls)
+    {
+        const int64_t bytesPerKb = 1024;
+        if (profile.cacheSize >= 0) {
+            // The negative cache_size means the size in KB, instead of the pages
+            sqls.push_back("PRAGMA cache_size=-" + std::to_string(profile.cacheSize) + ";");
+        }
+        if (profile.mmapSize >= 0) {
+            sqls.push_back("PRAGMA mmap_size=" + std::to_string(profile.mmapSize * bytesPerKb) + ";");
+        }
+        if (profile.tempStore >= 0) {
+            sqls.push_back("PRAGMA temp_store=" + std::to_string(profile.tempStore) + ";");
+        }
+        // The wal hook set after open takes the place of wal_autocheckpoint
+        if (!profile.backgroundCheckpoint && profile.walAutoCheckpoint >= 0) {
+            sqls.push_back("PRAGMA wal_autocheckpoint=" + std::to_string(profile.walAutoCheckpoint) + ";");
+        }
+        if (profile.journalSizeLimit >= 0) {
+            sqls.push_back("PRAGMA journal_size_limit=" + std::to_string(profile.journalSizeLimit * bytesPerKb) + ";");
+        }
+    }
+
     // statement must not be null
     std::string GetColString(sqlite3_stmt *statement, int nCol)
     {
@@ -130,9 +155,18 @@ int SQLiteUtils::CreateDataBase(const OpenDbProperties &properties, sqlite3 *&db
     }
     std::string defaultAttachCipher = DEFAULT_ATTACH_CIPHER + cipherName + ";";
     std::vector<std::string> sqls {defaultAttachCipher, DEFAULT_ATTACH_KDF_ITER};
+    if (properties.profile.pageSize > 0) {
+        if (properties.passwd.GetSize() == 0) {
+            // Only takes effect when the database file is created, which is done by setting the journal mode
+            sqls.push_back("PRAGMA page_size=" + std::to_string(properties.profile.pageSize) + ";");
+        } else {
+            LOGW("[SQLite] The page size of encrypted database is decided by the cipher, ignore the profile.");
+        }
+    }
     if (setWal) {
         sqls.push_back(WAL_MODE_SQL);
     }
+    GetStorageProfileSqls(properties.profile, sqls);
 
     std::string fileUrl = DBConstant::SQLITE_URL_PRE + properties.uri;
     int errCode = sqlite3_open_v2(fileUrl.c_str(), &dbTemp, flag, nullptr);
@@ -147,6 +181,9 @@ int SQLiteUtils::CreateDataBase(const OpenDbProperties &properties, sqlite3 *&db
         LOGE("[SQLite] SetDataBaseProperty failed: %d", errCode);
         goto END;
     }
+    if (properties.profile.backgroundCheckpoint) {
+        SQLiteWalCheckpointer::SetWalHook(dbTemp, properties.profile.walAutoCheckpoint);
+    }
 
 END:
     if (errCode != E_OK && dbTemp != nullptr) {
@@ -912,12 +949,21 @@ END:
 }
 
 int SQLiteUtils::GetVersion(sqlite3 *db, int &version)
+{
+    return GetPragmaIntValue(db, "PRAGMA user_version;", version);
+}
+
+int SQLiteUtils::GetSchemaVersion(sqlite3 *db, int &version)
+{
+    return GetPragmaIntValue(db, "PRAGMA schema_version;", version);
+}
+
+int SQLiteUtils::GetPragmaIntValue(sqlite3 *db, const std::string &strSql, int &value)
 {
     if (db == nullptr) {
         return -E_INVALID_DB;
     }
 
-    std::string strSql = "PRAGMA user_version;";
     sqlite3_stmt *statement = nullptr;
     int errCode = sqlite3_prepare(db, strSql.c_str(), -1, &statement, nullptr);
     if (errCode != SQLITE_OK || statement == nullptr) {
@@ -927,10 +973,10 @@ int SQLiteUtils::GetVersion(sqlite3 *db, int &version)
     }
 
     if (sqlite3_step(statement) == SQLITE_ROW) {
-        // Get pragma user_version at first column
-        version = sqlite3_column_int(statement, 0);
+        // Get pragma value at first column
+        value = sqlite3_column_int(statement, 0);
     } else {
-        LOGE("[SqlUtil][GetVer] Get db user_version failed.");
+        LOGE("[SqlUtil][GetVer] Get db pragma value failed.");
         errCode = SQLiteUtils::MapSQLiteErrno(SQLITE_ERROR);
     }
 
@@ -1413,26 +1459,33 @@ int SQLiteUtils::AddRelationalLogTableTrigger(sqlite3 *db, const TableInfo &tabl
     return E_OK;
 }
 
-int SQLiteUtils::CreateSameStuTable(sqlite3 *db, const TableInfo &baseTbl, const std::string &newTableName)
+std::string SQLiteUtils::GetTableFieldsDefine(const TableInfo &table)
 {
-    std::string sql = "CREATE TABLE IF NOT EXISTS " + newTableName + "(";
-    const std::map<FieldName, FieldInfo> &fields = baseTbl.GetFields();
+    std::string fieldsDefine;
+    const std::map<FieldName, FieldInfo> &fields = table.GetFields();
     for (uint32_t cid = 0; cid < fields.size(); ++cid) {
-        std::string fieldName = baseTbl.GetFieldName(cid);
-        sql += fieldName + " " + fields.at(fieldName).GetDataType();
+        std::string fieldName = table.GetFieldName(cid);
+        fieldsDefine += fieldName + " " + fields.at(fieldName).GetDataType();
         if (fields.at(fieldName).IsNotNull()) {
-            sql += " NOT NULL";
+            fieldsDefine += " NOT NULL";
         }
         if (fields.at(fieldName).HasDefaultValue()) {
-            sql += " DEFAULT " + fields.at(fieldName).GetDefaultValue();
+            fieldsDefine += " DEFAULT " + fields.at(fieldName).GetDefaultValue();
         }
-        if (fieldName == baseTbl.GetPrimaryKey()) {
-            sql += " PRIMARY KEY";
+        if (fieldName == table.GetPrimaryKey()) {
+            fieldsDefine += " PRIMARY KEY";
         }
-        sql += ",";
+        fieldsDefine += ",";
+    }
+    if (!fieldsDefine.empty()) {
+        fieldsDefine.pop_back();
     }
-    sql.pop_back();
-    sql += ");";
+    return fieldsDefine;
+}
+
+int SQLiteUtils::CreateSameStuTable(sqlite3 *db, const TableInfo &baseTbl, const std::string &newTableName)
+{
+    std::string sql = "CREATE TABLE IF NOT EXISTS " + newTableName + "(" + GetTableFieldsDefine(baseTbl) + ");";
     int errCode = SQLiteUtils::ExecuteRawSQL(db, sql);
     if (errCode != E_OK) {
         LOGE("[SQLite] execute create table sql failed");
@@ -1589,6 +1642,70 @@ END:
     SQLiteUtils::ResetStatement(stmt, true, errCode);
 }
 
+// The arguments are the timestamp followed by the groups of all the subscribe queries, each group is the result of one
+// subscribe condition followed by the meta keys(blob) of the queries sharing it, such as (ts, c1, k1, k2, c2, k3).
+void SQLiteUtils::UpdateSubscribeMetaDataWithinTrigger(sqlite3_context *ctx, int argc, sqlite3_value **argv)
+{
+    if (ctx == nullptr || argc < 1 || argv == nullptr) {
+        LOGE("[UpdateSubscribeMetaDataWithinTrigger] Invalid parameter, argc=%d.", argc);
+        return;
+    }
+    auto *handle = static_cast<sqlite3 *>(sqlite3_user_data(ctx));
+    if (handle == nullptr) {
+        sqlite3_result_error(ctx, "Sqlite context is invalid.", USING_STR_LEN);
+        LOGE("Sqlite context is invalid.");
+        return;
+    }
+    auto val = sqlite3_value_int64(argv[0]); // 0 : first argv for value
+    bool isMatched = false;
+    sqlite3_stmt *stmt = nullptr;
+    int errCode = E_OK;
+    for (int i = 1; i < argc; i++) {
+        if (sqlite3_value_type(argv[i]) != SQLITE_BLOB) {
+            // NULL result of the condition means not matched.
+            isMatched = (sqlite3_value_type(argv[i]) != SQLITE_NULL && sqlite3_value_int(argv[i]) != 0);
+            continue;
+        }
+        if (!isMatched) {
+            continue;
+        }
+        auto *keyPtr = static_cast<const uint8_t *>(sqlite3_value_blob(argv[i]));
+        int keyLen = sqlite3_value_bytes(argv[i]);
+        if (keyPtr == nullptr || keyLen <= 0 || keyLen > static_cast<int>(DBConstant::MAX_KEY_SIZE)) {
+            sqlite3_result_error(ctx, "key is invalid.", USING_STR_LEN);
+            LOGE("key is invalid.");
+            break;
+        }
+        // the statement is prepared once for all the matched queries of this row.
+        if (stmt == nullptr) {
+            errCode = SQLiteUtils::GetStatement(handle, UPDATE_META_SQL, stmt);
+            if (errCode != E_OK) {
+                sqlite3_result_error(ctx, "Get update meta_data statement failed.", USING_STR_LEN);
+                LOGE("Get update meta_data statement failed. %d", errCode);
+                return;
+            }
+        }
+        Key key(keyPtr, keyPtr + keyLen);
+        errCode = SQLiteUtils::BindBlobToStatement(stmt, BIND_KEY_INDEX, key, false);
+        if (errCode == E_OK) {
+            errCode = SQLiteUtils::BindInt64ToStatement(stmt, BIND_VAL_INDEX, val);
+        }
+        if (errCode != E_OK) {
+            sqlite3_result_error(ctx, "Bind meta_data to statement failed.", USING_STR_LEN);
+            LOGE("Bind meta_data to statement failed. %d", errCode);
+            break;
+        }
+        errCode = SQLiteUtils::StepWithRetry(stmt, false);
+        if (errCode != SQLiteUtils::MapSQLiteErrno(SQLITE_DONE)) {
+            sqlite3_result_error(ctx, "Execute the update meta_data attach failed.", USING_STR_LEN);
+            LOGE("Execute the update meta_data attach failed. %d", errCode);
+            break;
+        }
+        SQLiteUtils::ResetStatement(stmt, false, errCode);
+    }
+    SQLiteUtils::ResetStatement(stmt, true, errCode);
+}
+
 int SQLiteUtils::RegisterMetaDataUpdateFunction(sqlite3 *db)
 {
     int errCode = sqlite3_create_function_v2(db, DBConstant::UPDATE_META_FUNC.c_str(),
@@ -1596,6 +1713,73 @@ int SQLiteUtils::RegisterMetaDataUpdateFunction(sqlite3 *db)
         SQLITE_UTF8 | SQLITE_DETERMINISTIC, db, &SQLiteUtils::UpdateMetaDataWithinTrigger, nullptr, nullptr, nullptr);
     if (errCode != SQLITE_OK) {
         LOGE("sqlite3_create_function_v2 about %s returned %d", DBConstant::UPDATE_META_FUNC.c_str(), errCode);
+        return SQLiteUtils::MapSQLiteErrno(errCode);
+    }
+    errCode = sqlite3_create_function_v2(db, DBConstant::UPDATE_SUBSCRIBE_META_FUNC.c_str(),
+        -1, // -1: variable argc, the conditions and keys of all the subscribe queries
+        SQLITE_UTF8, db, &SQLiteUtils::UpdateSubscribeMetaDataWithinTrigger, nullptr, nullptr, nullptr);
+    if (errCode != SQLITE_OK) {
+        LOGE("sqlite3_create_function_v2 about %s returned %d", DBConstant::UPDATE_SUBSCRIBE_META_FUNC.c_str(),
+            errCode);
+    }
+    return SQLiteUtils::MapSQLiteErrno(errCode);
+}
+
+void SQLiteUtils::GetSyncDigestBucket(sqlite3_context *ctx, int argc, sqlite3_value **argv)
+{
+    // 1 means that the function only needs one parameter, namely hash_key
+    if (ctx == nullptr || argc != 1 || argv == nullptr) {
+        LOGE("Parameter does not meet restrictions.");
+        return;
+    }
+    auto hashKey = static_cast<const uint8_t *>(sqlite3_value_blob(argv[0]));
+    int hashKeyLen = sqlite3_value_bytes(argv[0]);
+    if (hashKey == nullptr || hashKeyLen <= 0) {
+        sqlite3_result_error(ctx, "Parameters is invalid.", USING_STR_LEN);
+        LOGE("Parameters is invalid.");
+        return;
+    }
+    sqlite3_result_int64(ctx, SyncDigest::GetBucket(hashKey, static_cast<uint32_t>(hashKeyLen)));
+}
+
+void SQLiteUtils::XorSyncDigestRecord(sqlite3_context *ctx, int argc, sqlite3_value **argv)
+{
+    // 4 means the digest of the bucket, the hash_key, the value and the flag of the record
+    if (ctx == nullptr || argc != 4 || argv == nullptr) { // 4 is param counts
+        LOGE("Parameter does not meet restrictions.");
+        return;
+    }
+    auto hashKey = static_cast<const uint8_t *>(sqlite3_value_blob(argv[1]));
+    int hashKeyLen = sqlite3_value_bytes(argv[1]);
+    if (hashKey == nullptr || hashKeyLen <= 0) {
+        sqlite3_result_error(ctx, "Parameters is invalid.", USING_STR_LEN);
+        LOGE("Parameters is invalid.");
+        return;
+    }
+    // the value is null for the deleted records
+    auto value = static_cast<const uint8_t *>(sqlite3_value_blob(argv[2]));
+    int valueLen = sqlite3_value_bytes(argv[2]);
+    uint64_t flag = static_cast<uint64_t>(sqlite3_value_int64(argv[3])); // 3 is the flag
+    uint64_t digest = static_cast<uint64_t>(sqlite3_value_int64(argv[0]));
+    digest ^= SyncDigest::CalcRecordDigest(hashKey, static_cast<uint32_t>(hashKeyLen), value,
+        (value == nullptr) ? 0 : static_cast<uint32_t>(valueLen), flag);
+    sqlite3_result_int64(ctx, static_cast<int64_t>(digest));
+}
+
+int SQLiteUtils::RegisterSyncDigestFunction(sqlite3 *db)
+{
+    int errCode = sqlite3_create_function_v2(db, DBConstant::SYNC_DIGEST_BUCKET_FUNC.c_str(),
+        1, // 1: argc for register function
+        SQLITE_UTF8 | SQLITE_DETERMINISTIC, nullptr, &SQLiteUtils::GetSyncDigestBucket, nullptr, nullptr, nullptr);
+    if (errCode != SQLITE_OK) {
+        LOGE("sqlite3_create_function_v2 about %s returned %d", DBConstant::SYNC_DIGEST_BUCKET_FUNC.c_str(), errCode);
+        return SQLiteUtils::MapSQLiteErrno(errCode);
+    }
+    errCode = sqlite3_create_function_v2(db, DBConstant::SYNC_DIGEST_RECORD_FUNC.c_str(),
+        4, // 4: argc for register function
+        SQLITE_UTF8 | SQLITE_DETERMINISTIC, nullptr, &SQLiteUtils::XorSyncDigestRecord, nullptr, nullptr, nullptr);
+    if (errCode != SQLITE_OK) {
+        LOGE("sqlite3_create_function_v2 about %s returned %d", DBConstant::SYNC_DIGEST_RECORD_FUNC.c_str(), errCode);
     }
     return SQLiteUtils::MapSQLiteErrno(errCode);
 }
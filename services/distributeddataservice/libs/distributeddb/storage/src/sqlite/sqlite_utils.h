@@ -63,6 +63,7 @@ struct OpenDbProperties {
     SecurityOption securityOpt {};
     int conflictReslovePolicy = DEFAULT_LAST_WIN;
     bool createDirByStoreIdOnly = false;
+    StorageProfile profile {};
 };
 
 class SQLiteUtils {
@@ -116,6 +117,9 @@ public:
 
     static int GetVersion(sqlite3 *db, int &version);
 
+    // The schema version is changed by every DDL on the database
+    static int GetSchemaVersion(sqlite3 *db, int &version);
+
     static int GetJournalMode(sqlite3 *db, std::string &mode);
 
     static int SetUserVer(const OpenDbProperties &properties, int version);
@@ -146,6 +150,9 @@ public:
 
     static int RegisterMetaDataUpdateFunction(sqlite3 *db);
 
+    // Register the functions used by the triggers which maintain the sync digest table
+    static int RegisterSyncDigestFunction(sqlite3 *db);
+
     static int GetDbSize(const std::string &dir, const std::string &dbName, uint64_t &size);
 
     static int ExplainPlan(sqlite3 *db, const std::string &execSql, bool isQueryPlan);
@@ -167,6 +174,7 @@ public:
     static int AddRelationalLogTableTrigger(sqlite3 *db, const TableInfo &table);
     static int AnalysisSchema(sqlite3 *db, const std::string &tableName, TableInfo &table);
 
+    static std::string GetTableFieldsDefine(const TableInfo &table);
     static int CreateSameStuTable(sqlite3 *db, const TableInfo &baseTbl, const std::string &newTableName);
     static int CloneIndexes(sqlite3 *db, const std::string &oriTableName, const std::string &newTableName);
 #endif
@@ -191,6 +199,8 @@ private:
 
     static int SetBusyTimeout(sqlite3 *db, int timeout);
 
+    static int GetPragmaIntValue(sqlite3 *db, const std::string &strSql, int &value);
+
     static void JsonExtractByPath(sqlite3_context *ctx, int argc, sqlite3_value **argv);
 
     static void JsonExtractInnerFunc(sqlite3_context *ctx, const ValueObject &inValue, const FieldPath &inPath);
@@ -218,6 +228,12 @@ private:
 #endif
 
     static void UpdateMetaDataWithinTrigger(sqlite3_context *ctx, int argc, sqlite3_value **argv);
+
+    static void UpdateSubscribeMetaDataWithinTrigger(sqlite3_context *ctx, int argc, sqlite3_value **argv);
+
+    static void GetSyncDigestBucket(sqlite3_context *ctx, int argc, sqlite3_value **argv);
+
+    static void XorSyncDigestRecord(sqlite3_context *ctx, int argc, sqlite3_value **argv);
 };
 } // namespace DistributedDB
 
@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sqlite_wal_checkpointer.h"
+
+#include <algorithm>
+#include <map>
+
+#include "db_errno.h"
+#include "log_print.h"
+#include "platform_specific.h"
+#include "sqlite_storage_executor.h"
+#include "sqlite_utils.h"
+
+namespace DistributedDB {
+namespace {
+    int GetPageSize(sqlite3 *db, int64_t &pageSize)
+    {
+        sqlite3_stmt *stmt = nullptr;
+        int errCode = SQLiteUtils::GetStatement(db, "PRAGMA page_size;", stmt);
+        if (errCode != E_OK) {
+            return errCode;
+        }
+        errCode = SQLiteUtils::StepWithRetry(stmt, false);
+        if (errCode == SQLiteUtils::MapSQLiteErrno(SQLITE_ROW)) {
+            pageSize = sqlite3_column_int64(stmt, 0);
+            errCode = E_OK;
+        }
+        SQLiteUtils::ResetStatement(stmt, true, errCode);
+        return errCode;
+    }
+
+    std::mutex g_commitStatesLock;
+    // Never removed, the wal hooks of the connections refer to them
+    std::map<std::string, std::shared_ptr<WalCommitState>> g_commitStates;
+}
+
+SQLiteWalCheckpointer::~SQLiteWalCheckpointer()
+{
+    Stop();
+}
+
+int SQLiteWalCheckpointer::Start(StorageEngine *engine, const StorageProfile &profile, uint64_t maxLogSize)
+{
+    if (engine == nullptr) {
+        return -E_INVALID_ARGS;
+    }
+    std::lock_guard<std::mutex> lock(lock_);
+    if (isStarted_) {
+        return E_OK;
+    }
+    int errCode = E_OK;
+    StorageExecutor *handle = engine->FindExecutor(false, OperatePerm::NORMAL_PERM, errCode);
+    if (handle == nullptr) {
+        LOGE("[WalCheckpointer] Get handle failed when start. %d", errCode);
+        return errCode;
+    }
+    sqlite3 *db = nullptr;
+    int64_t pageSize = 0;
+    errCode = static_cast<SQLiteStorageExecutor *>(handle)->GetDbHandle(db);
+    if (errCode == E_OK) {
+        const char *fileName = sqlite3_db_filename(db, "main");
+        if (fileName != nullptr && fileName[0] != '\0') {
+            walPath_ = std::string(fileName) + "-wal";
+            commitState_ = GetCommitState(fileName);
+        }
+        errCode = GetPageSize(db, pageSize);
+    }
+    engine->Recycle(handle);
+    if (errCode != E_OK || commitState_ == nullptr) {
+        LOGE("[WalCheckpointer] Get the wal of db failed. %d", errCode);
+        return (errCode != E_OK) ? errCode : -E_INVALID_DB;
+    }
+    uint64_t pages = (profile.walAutoCheckpoint > 0) ? static_cast<uint64_t>(profile.walAutoCheckpoint) :
+        DEFAULT_THRESHOLD_PAGES;
+    threshold_ = pages * static_cast<uint64_t>(pageSize);
+    maxLogSize_ = maxLogSize;
+
+    TimerAction action = [this](TimerId timerId) -> int {
+        (void)timerId;
+        return CheckOnTimer();
+    };
+    errCode = RuntimeContext::GetInstance()->SetTimer(CHECK_INTERVAL, action, nullptr, timerId_);
+    if (errCode != E_OK) {
+        LOGE("[WalCheckpointer] Set timer failed. %d", errCode);
+        return errCode;
+    }
+    engine_ = engine;
+    lastWriteTime_ = std::chrono::steady_clock::now();
+    isStarted_ = true;
+    commitState_->isInBackground = true;
+    LOGI("[WalCheckpointer] Started, checkpoint when the wal reaches %" PRIu64 " bytes.", threshold_);
+    return E_OK;
+}
+
+void SQLiteWalCheckpointer::Stop()
+{
+    TimerId timerId = 0;
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        if (!isStarted_) {
+            return;
+        }
+        isStarted_ = false;
+        commitState_->isInBackground = false; // The connections checkpoint on commit again
+        timerId = timerId_;
+        timerId_ = 0;
+    }
+    // After return, the timer rely no more on the checkpointer.
+    RuntimeContext::GetInstance()->RemoveTimer(timerId, true);
+    std::unique_lock<std::mutex> lock(lock_);
+    runningCv_.wait(lock, [this]() { return !isRunning_; });
+    engine_ = nullptr;
+}
+
+void SQLiteWalCheckpointer::SetMaxLogSize(uint64_t maxLogSize)
+{
+    maxLogSize_ = maxLogSize;
+}
+
+WalCheckpointMetrics SQLiteWalCheckpointer::GetMetrics() const
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    return metrics_;
+}
+
+void SQLiteWalCheckpointer::SetWalHook(sqlite3 *db, int autoCheckpointPages)
+{
+    const char *fileName = sqlite3_db_filename(db, "main");
+    if (fileName == nullptr || fileName[0] == '\0') {
+        return; // The memory db has no wal
+    }
+    std::shared_ptr<WalCommitState> state = GetCommitState(fileName);
+    state->autoCheckpointPages = (autoCheckpointPages > 0) ? autoCheckpointPages :
+        static_cast<int>(DEFAULT_THRESHOLD_PAGES);
+    (void)sqlite3_wal_hook(db, &SQLiteWalCheckpointer::WalHook, state.get());
+}
+
+std::shared_ptr<WalCommitState> SQLiteWalCheckpointer::GetCommitState(const std::string &dbPath)
+{
+    std::lock_guard<std::mutex> lock(g_commitStatesLock);
+    auto &state = g_commitStates[dbPath];
+    if (state == nullptr) {
+        state = std::make_shared<WalCommitState>();
+    }
+    return state;
+}
+
+int SQLiteWalCheckpointer::WalHook(void *arg, sqlite3 *db, const char *dbName, int pages)
+{
+    auto state = static_cast<WalCommitState *>(arg);
+    state->commitCount++;
+    if (!state->isInBackground && pages >= state->autoCheckpointPages) {
+        (void)sqlite3_wal_checkpoint(db, dbName);
+    }
+    return SQLITE_OK;
+}
+
+int SQLiteWalCheckpointer::CheckOnTimer()
+{
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(lock_);
+    if (!isStarted_) {
+        return E_OK;
+    }
+    uint64_t writes = commitState_->commitCount.exchange(0);
+    if (writes > 0) {
+        lastWriteTime_ = now;
+        isDirty_ = true;
+    }
+    if (isRunning_ || (!isDirty_ && !isOversized_)) {
+        return E_OK;
+    }
+    bool isIdle = (now - lastWriteTime_ >= IDLE_TIME);
+    if (!isIdle) {
+        if (!isDirty_) {
+            return E_OK; // The wal file is only shrunk when idle
+        }
+        // The wal file is not shrunk unless truncated, so its size is the most the wal could be
+        uint64_t walSize = GetWalSize();
+        if (walSize < threshold_ || (writes >= BURST_WRITES && walSize < threshold_ * URGENT_TIMES)) {
+            return E_OK;
+        }
+    }
+    isRunning_ = true;
+    int errCode = RuntimeContext::GetInstance()->ScheduleTask([this, isIdle]() { RunCheckpoint(isIdle); });
+    if (errCode != E_OK) {
+        LOGW("[WalCheckpointer] Schedule checkpoint failed. %d", errCode);
+        isRunning_ = false;
+    }
+    return E_OK;
+}
+
+void SQLiteWalCheckpointer::RunCheckpoint(bool isIdle)
+{
+    StorageEngine *engine = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        engine = isStarted_ ? engine_ : nullptr;
+    }
+    if (engine != nullptr && engine->GetEngineState() == EngineState::MAINDB) {
+        int errCode = E_OK;
+        // Not wait for the handle, the store is busy reading, try in the next interval
+        StorageExecutor *handle = engine->FindExecutor(false, OperatePerm::NORMAL_PERM, errCode, 0);
+        if (handle != nullptr) {
+            sqlite3 *db = nullptr;
+            if (static_cast<SQLiteStorageExecutor *>(handle)->GetDbHandle(db) == E_OK) {
+                Checkpoint(engine, db, isIdle);
+            }
+            engine->Recycle(handle);
+        }
+    }
+    std::lock_guard<std::mutex> lock(lock_);
+    isRunning_ = false;
+    runningCv_.notify_all();
+}
+
+void SQLiteWalCheckpointer::Checkpoint(StorageEngine *engine, sqlite3 *db, bool isIdle)
+{
+    auto start = std::chrono::steady_clock::now();
+    uint64_t walSizeBefore = GetWalSize();
+    // The writes after the check are checkpointed by the next one
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        isDirty_ = false;
+    }
+    CheckpointResult result = ExecCheckpoint(db, SQLITE_CHECKPOINT_PASSIVE, 0);
+    bool isFinished = (result.errCode == SQLITE_OK && result.checkpointedFrames == result.logFrames);
+    bool isEscalated = false;
+    if (!isFinished) {
+        uint32_t longReaders = engine->GetLongHeldReadExecutorNum(CHECK_INTERVAL);
+        uint64_t maxLogSize = maxLogSize_;
+        if (longReaders == 0 && walSizeBefore >= threshold_ * URGENT_TIMES) {
+            int mode = (maxLogSize > 0 && walSizeBefore >= maxLogSize / 2) ? SQLITE_CHECKPOINT_TRUNCATE :
+                SQLITE_CHECKPOINT_RESTART;
+            result = ExecCheckpoint(db, mode, ESCALATE_BUSY_TIMEOUT);
+            isFinished = (result.errCode == SQLITE_OK);
+            isEscalated = true;
+        } else if (longReaders > 0) {
+            LOGW("[WalCheckpointer] %" PRIu32 " readers held over %dms keep the wal from checkpoint, wal size %"
+                PRIu64, longReaders, CHECK_INTERVAL, walSizeBefore);
+        }
+    } else if (isIdle && walSizeBefore > threshold_ && engine->GetLongHeldReadExecutorNum(CHECK_INTERVAL) == 0) {
+        // All the frames are in the db, shrink the wal file while no one writes
+        result = ExecCheckpoint(db, SQLITE_CHECKPOINT_TRUNCATE, ESCALATE_BUSY_TIMEOUT);
+        isEscalated = true;
+    }
+    uint64_t duration = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+    UpdateMetrics(duration, walSizeBefore, GetWalSize(), !isFinished, isEscalated);
+}
+
+SQLiteWalCheckpointer::CheckpointResult SQLiteWalCheckpointer::ExecCheckpoint(sqlite3 *db, int mode,
+    int busyTimeout) const
+{
+    CheckpointResult result;
+    if (busyTimeout > 0) {
+        (void)sqlite3_busy_timeout(db, busyTimeout);
+    }
+    result.errCode = sqlite3_wal_checkpoint_v2(db, nullptr, mode, &result.logFrames, &result.checkpointedFrames);
+    if (busyTimeout > 0) {
+        (void)sqlite3_busy_timeout(db, RESTORE_BUSY_TIMEOUT);
+    }
+    if (result.errCode != SQLITE_OK && result.errCode != SQLITE_BUSY) {
+        LOGW("[WalCheckpointer] Checkpoint mode %d failed. %d", mode, result.errCode);
+    }
+    return result;
+}
+
+void SQLiteWalCheckpointer::UpdateMetrics(uint64_t duration, uint64_t walSizeBefore, uint64_t walSizeAfter,
+    bool isBlocked, bool isEscalated)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    metrics_.checkpointCount++;
+    metrics_.lastDuration = duration;
+    metrics_.maxDuration = std::max(metrics_.maxDuration, duration);
+    metrics_.totalDuration += duration;
+    metrics_.walSize = walSizeAfter;
+    metrics_.maxWalSize = std::max(metrics_.maxWalSize, walSizeBefore);
+    isOversized_ = (walSizeAfter > threshold_);
+    if (isEscalated) {
+        metrics_.escalatedCount++;
+    }
+    if (isBlocked) {
+        metrics_.blockedCount++;
+        isDirty_ = true; // Try again in the next interval
+    }
+    if (isBlocked != isBlocked_) {
+        LOGI("[WalCheckpointer] Checkpoint %s, wal size %" PRIu64 ", cost %" PRIu64 "us.",
+            isBlocked ? "blocked" : "recovered", walSizeAfter, duration);
+        isBlocked_ = isBlocked;
+    }
+    LOGD("[WalCheckpointer] Checkpoint wal %" PRIu64 " to %" PRIu64 " bytes, cost %" PRIu64 "us.", walSizeBefore,
+        walSizeAfter, duration);
+}
+
+uint64_t SQLiteWalCheckpointer::GetWalSize() const
+{
+    uint64_t fileSize = 0;
+    if (OS::CalFileSize(walPath_, fileSize) != E_OK) {
+        return 0;
+    }
+    return fileSize;
+}
+} // namespace DistributedDB
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SQLITE_WAL_CHECKPOINTER_H
+#define SQLITE_WAL_CHECKPOINTER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "macro_utils.h"
+#include "runtime_context.h"
+#include "sqlite_import.h"
+#include "storage_engine.h"
+#include "store_types.h"
+
+namespace DistributedDB {
+struct WalCheckpointMetrics {
+    uint64_t checkpointCount = 0;
+    uint64_t blockedCount = 0; // The checkpoints left frames in the wal, mostly a reader keeps an old snapshot
+    uint64_t escalatedCount = 0; // The checkpoints restarted or truncated the wal
+    uint64_t lastDuration = 0; // In microseconds, so are the others
+    uint64_t maxDuration = 0;
+    uint64_t totalDuration = 0;
+    uint64_t walSize = 0; // The wal file size after the last checkpoint, in bytes
+    uint64_t maxWalSize = 0; // The largest wal file size seen before a checkpoint
+};
+
+// The commits to one db file, counted by the wal hook of all its connections. While no checkpointer runs on the
+// file, the hook checkpoints on commit as wal_autocheckpoint does.
+struct WalCommitState {
+    std::atomic<uint64_t> commitCount = 0;
+    std::atomic<bool> isInBackground = false;
+    std::atomic<int> autoCheckpointPages = 0;
+};
+
+// Checkpoints the wal of a store on the task pool, so the committing write never does it. A timer checks the wal
+// every second: it is checkpointed once the store is idle, or when it grows over the pages of walAutoCheckpoint.
+// A write burst defers it until the wal is much larger. The checkpoint is PASSIVE first, if it could not finish and
+// the wal is still large, it is escalated to RESTART, or to TRUNCATE when the wal nears the max log size.
+class SQLiteWalCheckpointer final {
+public:
+    SQLiteWalCheckpointer() = default;
+    ~SQLiteWalCheckpointer();
+    DISABLE_COPY_ASSIGN_MOVE(SQLiteWalCheckpointer);
+
+    int Start(StorageEngine *engine, const StorageProfile &profile, uint64_t maxLogSize);
+
+    // The engine is not used any more after return, the running checkpoint is waited.
+    void Stop();
+
+    void SetMaxLogSize(uint64_t maxLogSize);
+
+    WalCheckpointMetrics GetMetrics() const;
+
+    // Replaces the wal_autocheckpoint of the connection, so every commit through it is seen by the checkpointer.
+    static void SetWalHook(sqlite3 *db, int autoCheckpointPages);
+
+private:
+    struct CheckpointResult {
+        int errCode = SQLITE_OK;
+        int logFrames = 0;
+        int checkpointedFrames = 0;
+    };
+
+    int CheckOnTimer();
+    void RunCheckpoint(bool isIdle);
+    void Checkpoint(StorageEngine *engine, sqlite3 *db, bool isIdle);
+    CheckpointResult ExecCheckpoint(sqlite3 *db, int mode, int busyTimeout) const;
+    void UpdateMetrics(uint64_t duration, uint64_t walSizeBefore, uint64_t walSizeAfter, bool isBlocked,
+        bool isEscalated);
+    uint64_t GetWalSize() const;
+
+    static std::shared_ptr<WalCommitState> GetCommitState(const std::string &dbPath);
+    static int WalHook(void *arg, sqlite3 *db, const char *dbName, int pages);
+
+    static constexpr int CHECK_INTERVAL = 1000; // 1s
+    static constexpr auto IDLE_TIME = std::chrono::milliseconds(2000); // No write in 2s
+    static constexpr uint64_t BURST_WRITES = 100; // Over 100 commits in a check interval
+    static constexpr uint64_t URGENT_TIMES = 4; // The wal over 4 times of the threshold is checkpointed in a burst
+    static constexpr uint64_t DEFAULT_THRESHOLD_PAGES = 1000; // Same as the default of wal_autocheckpoint
+    static constexpr int ESCALATE_BUSY_TIMEOUT = 100; // 100ms, the writers are blocked no longer than it
+    static constexpr int RESTORE_BUSY_TIMEOUT = 3000; // Same as the busy timeout of all the connections
+
+    StorageEngine *engine_ = nullptr;
+    std::string walPath_;
+    uint64_t threshold_ = 0; // In bytes
+    std::atomic<uint64_t> maxLogSize_ = 0;
+    std::shared_ptr<WalCommitState> commitState_;
+
+    mutable std::mutex lock_;
+    std::condition_variable runningCv_;
+    TimerId timerId_ = 0;
+    bool isStarted_ = false;
+    bool isRunning_ = false; // A checkpoint task is scheduled or running
+    bool isDirty_ = false; // Written since the last finished checkpoint
+    bool isOversized_ = false; // The wal file is larger than the threshold, to be truncated when idle
+    bool isBlocked_ = false;
+    std::chrono::steady_clock::time_point lastWriteTime_;
+    WalCheckpointMetrics metrics_;
+};
+} // namespace DistributedDB
+#endif // SQLITE_WAL_CHECKPOINTER_H
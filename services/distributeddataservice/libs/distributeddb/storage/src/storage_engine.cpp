@@ -208,6 +208,7 @@ void StorageEngine::Recycle(StorageExecutor *&handle)
         auto iter = std::find(readUsingList_.begin(), readUsingList_.end(), handle);
         if (iter != readUsingList_.end()) {
             readUsingList_.remove(handle);
+            readFetchTime_.erase(handle);
             if (readIdleList_.size() >= 1) {
                 delete handle;
                 handle = nullptr;
@@ -221,6 +222,19 @@ void StorageEngine::Recycle(StorageExecutor *&handle)
     handle = nullptr;
 }
 
+uint32_t StorageEngine::GetLongHeldReadExecutorNum(uint64_t heldTime)
+{
+    std::lock_guard<std::mutex> lock(readMutex_);
+    auto now = std::chrono::steady_clock::now();
+    uint32_t count = 0;
+    for (const auto &item : readFetchTime_) {
+        if (now - item.second >= std::chrono::milliseconds(heldTime)) {
+            count++;
+        }
+    }
+    return count;
+}
+
 void StorageEngine::ClearCorruptedFlag()
 {
     return;
@@ -413,6 +427,9 @@ StorageExecutor *StorageEngine::FetchStorageExecutor(bool isWrite, std::list<Sto
     auto item = idleList.front();
     usingList.push_back(item);
     idleList.remove(item);
+    if (!isWrite) {
+        readFetchTime_[item] = std::chrono::steady_clock::now();
+    }
     LOGD("Get executor[%d] from [%.6s], using[%zu]", isWrite,
         DBCommon::TransferStringToHex(identifier_).c_str(), usingList.size());
     errCode = E_OK;
@@ -16,8 +16,10 @@
 #ifndef STORAGE_ENGINE_H
 #define STORAGE_ENGINE_H
 
+#include <chrono>
 #include <condition_variable>
 #include <list>
+#include <map>
 #include <mutex>
 #include <shared_mutex>
 
@@ -80,6 +82,9 @@ public:
 
     virtual bool IsMigrating() const;
 
+    // The read executors held longer than the time in ms, such a reader may keep an old snapshot of the wal
+    uint32_t GetLongHeldReadExecutorNum(uint64_t heldTime);
+
 protected:
     virtual int CreateNewExecutor(bool isWrite, StorageExecutor *&handle) = 0;
 
@@ -126,6 +131,7 @@ private:
     std::list<StorageExecutor *> writeIdleList_;
     std::list<StorageExecutor *> readUsingList_;
     std::list<StorageExecutor *> readIdleList_;
+    std::map<StorageExecutor *, std::chrono::steady_clock::time_point> readFetchTime_; // guarded by readMutex_
     std::atomic<bool> isExistConnection_;
 };
 } // namespace DistributedDB
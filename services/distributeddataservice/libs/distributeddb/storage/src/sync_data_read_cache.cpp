@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sync_data_read_cache.h"
+
+namespace DistributedDB {
+uint64_t SyncDataReadCache::GetVersion() const
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    return version_;
+}
+
+bool SyncDataReadCache::Get(Timestamp begin, Timestamp end, const DataSizeSpecInfo &sizeInfo,
+    std::vector<DataItem> &dataItems, int &errCode) const
+{
+    std::shared_ptr<const std::vector<DataItem>> cachedItems;
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        auto now = std::chrono::steady_clock::now();
+        for (const auto &read : reads_) {
+            if (read.begin == begin && read.end == end && read.blockSize == sizeInfo.blockSize &&
+                read.packetSize == sizeInfo.packetSize && now - read.readTime < VALID_TIME) {
+                cachedItems = read.dataItems;
+                errCode = read.errCode;
+                hitCount_++;
+                break;
+            }
+        }
+    }
+    if (cachedItems == nullptr) {
+        return false;
+    }
+    // copied out of the lock, the items are never changed once cached.
+    dataItems = *cachedItems;
+    return true;
+}
+
+void SyncDataReadCache::Put(uint64_t version, Timestamp begin, Timestamp end, const DataSizeSpecInfo &sizeInfo,
+    const std::vector<DataItem> &dataItems, int errCode)
+{
+    if (errCode != E_OK && errCode != -E_UNFINISHED) {
+        return;
+    }
+    auto cachedItems = std::make_shared<const std::vector<DataItem>>(dataItems);
+    std::lock_guard<std::mutex> lock(lock_);
+    buildCount_++;
+    if (version != version_) {
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    reads_.remove_if([now](const CachedRead &read) {
+        return now - read.readTime >= VALID_TIME;
+    });
+    if (reads_.size() >= MAX_CACHED_READS) {
+        reads_.pop_front();
+    }
+    reads_.push_back({ begin, end, sizeInfo.blockSize, sizeInfo.packetSize, errCode, now, cachedItems });
+}
+
+void SyncDataReadCache::Invalidate()
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    version_++;
+    reads_.clear();
+}
+
+void SyncDataReadCache::GetMetrics(uint64_t &buildCount, uint64_t &hitCount) const
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    buildCount = buildCount_;
+    hitCount = hitCount_;
+}
+} // namespace DistributedDB
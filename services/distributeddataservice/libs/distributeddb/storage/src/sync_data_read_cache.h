@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SYNC_DATA_READ_CACHE_H
+#define SYNC_DATA_READ_CACHE_H
+
+#include <chrono>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "db_errno.h"
+#include "db_types.h"
+#include "macro_utils.h"
+
+namespace DistributedDB {
+// Keeps the recent reads of the sync data by the timestamp range. When a store pushes to several devices with the
+// same water mark, the devices read the same ranges one after another, only the first one reads the database.
+// Any change of the sync data invalidates all the reads, the reads older than the valid time are not used either.
+class SyncDataReadCache final {
+public:
+    SyncDataReadCache() = default;
+    ~SyncDataReadCache() = default;
+    DISABLE_COPY_ASSIGN_MOVE(SyncDataReadCache);
+
+    // Called before reading the database, the read is put only if no change happened after this.
+    uint64_t GetVersion() const;
+
+    // Return true and copy out the data items if the same range was read with the same size limit.
+    bool Get(Timestamp begin, Timestamp end, const DataSizeSpecInfo &sizeInfo, std::vector<DataItem> &dataItems,
+        int &errCode) const;
+
+    // errCode is E_OK or -E_UNFINISHED, the result of the read.
+    void Put(uint64_t version, Timestamp begin, Timestamp end, const DataSizeSpecInfo &sizeInfo,
+        const std::vector<DataItem> &dataItems, int errCode);
+
+    void Invalidate();
+
+    // buildCount is the reads of the database, hitCount is the reads copied from the cache.
+    void GetMetrics(uint64_t &buildCount, uint64_t &hitCount) const;
+
+private:
+    struct CachedRead {
+        Timestamp begin = 0;
+        Timestamp end = 0;
+        uint32_t blockSize = 0;
+        size_t packetSize = 0;
+        int errCode = E_OK;
+        std::chrono::steady_clock::time_point readTime;
+        std::shared_ptr<const std::vector<DataItem>> dataItems;
+    };
+
+    static constexpr size_t MAX_CACHED_READS = 8;
+    static constexpr auto VALID_TIME = std::chrono::seconds(1);
+
+    mutable std::mutex lock_;
+    uint64_t version_ = 0;
+    std::list<CachedRead> reads_;
+    uint64_t buildCount_ = 0;
+    mutable uint64_t hitCount_ = 0;
+};
+} // namespace DistributedDB
+#endif // SYNC_DATA_READ_CACHE_H
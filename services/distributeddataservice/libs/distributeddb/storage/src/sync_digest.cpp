@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sync_digest.h"
+
+namespace DistributedDB {
+namespace {
+    constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+    constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+    constexpr uint8_t DELETED_MARK = 1;
+    constexpr uint8_t EXISTED_MARK = 0;
+
+    uint64_t Fnv1a(uint64_t hash, const uint8_t *data, uint32_t len)
+    {
+        if (data == nullptr) {
+            return hash;
+        }
+        for (uint32_t i = 0; i < len; i++) {
+            hash ^= data[i];
+            hash *= FNV_PRIME;
+        }
+        return hash;
+    }
+
+    // The finalizer of murmur3, spread the bits since the digests are combined by xor.
+    uint64_t Mix(uint64_t hash)
+    {
+        constexpr uint64_t firstMultiplier = 0xff51afd7ed558ccdULL;
+        constexpr uint64_t secondMultiplier = 0xc4ceb9fe1a85ec53ULL;
+        constexpr int shift = 33;
+        hash ^= hash >> shift;
+        hash *= firstMultiplier;
+        hash ^= hash >> shift;
+        hash *= secondMultiplier;
+        hash ^= hash >> shift;
+        return hash;
+    }
+}
+
+SyncDigest::SyncDigest() : leaves_(LEAF_NUM, 0)
+{
+}
+
+uint32_t SyncDigest::GetBucket(const uint8_t *hashKey, uint32_t hashKeyLen)
+{
+    constexpr uint32_t bitsPerByte = 8;
+    uint32_t bucket = 0;
+    for (uint32_t i = 0; i < hashKeyLen && i < sizeof(uint16_t); i++) {
+        bucket = (bucket << bitsPerByte) | hashKey[i];
+    }
+    return bucket % LEAF_NUM;
+}
+
+uint64_t SyncDigest::CalcRecordDigest(const uint8_t *hashKey, uint32_t hashKeyLen, const uint8_t *value,
+    uint32_t valueLen, uint64_t flag)
+{
+    uint64_t hash = Fnv1a(FNV_OFFSET_BASIS, hashKey, hashKeyLen);
+    if ((flag & DataItem::DELETE_FLAG) == DataItem::DELETE_FLAG) {
+        // the value of the deleted record is not cared
+        hash = Fnv1a(hash, &DELETED_MARK, sizeof(DELETED_MARK));
+    } else {
+        hash = Fnv1a(hash, &EXISTED_MARK, sizeof(EXISTED_MARK));
+        hash = Fnv1a(hash, value, valueLen);
+    }
+    return Mix(hash);
+}
+
+void SyncDigest::AddRecord(uint32_t bucket, uint64_t recordDigest)
+{
+    leaves_[bucket % LEAF_NUM] ^= recordDigest;
+}
+
+void SyncDigest::SetLeaf(uint32_t bucket, uint64_t digest)
+{
+    leaves_[bucket % LEAF_NUM] = digest;
+}
+
+uint64_t SyncDigest::GetLeaf(uint32_t bucket) const
+{
+    return leaves_[bucket % LEAF_NUM];
+}
+
+std::vector<uint64_t> SyncDigest::GetNodes() const
+{
+    std::vector<uint64_t> nodes(NODE_NUM, 0);
+    for (uint32_t i = 0; i < LEAF_NUM; i++) {
+        nodes[i / LEAF_NUM_PER_NODE] ^= leaves_[i];
+    }
+    return nodes;
+}
+
+std::vector<uint64_t> SyncDigest::GetNodeLeaves(uint32_t node) const
+{
+    if (node >= NODE_NUM) {
+        return {};
+    }
+    auto begin = leaves_.begin() + node * LEAF_NUM_PER_NODE;
+    return std::vector<uint64_t>(begin, begin + LEAF_NUM_PER_NODE);
+}
+
+void SyncDigest::SetTimestamp(Timestamp timestamp)
+{
+    timestamp_ = timestamp;
+}
+
+Timestamp SyncDigest::GetTimestamp() const
+{
+    return timestamp_;
+}
+} // namespace DistributedDB
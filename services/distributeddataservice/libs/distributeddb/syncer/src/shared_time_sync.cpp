@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "shared_time_sync.h"
+
+#include "db_common.h"
+#include "db_errno.h"
+#include "log_print.h"
+#include "runtime_context.h"
+#include "sync_types.h"
+
+namespace DistributedDB {
+namespace {
+    // Half of the time sync interval of one store, the store refreshing the time later uses the result of the first.
+    constexpr auto SHARED_OFFSET_VALID_TIME = std::chrono::hours(12);
+    constexpr auto SHARED_SYNC_TIMEOUT = std::chrono::milliseconds(TIME_SYNC_WAIT_TIME);
+}
+
+SharedTimeSync *SharedTimeSync::GetInstance()
+{
+    static SharedTimeSync instance;
+    return &instance;
+}
+
+std::string SharedTimeSync::GetDeviceKey(const std::string &userId, const std::string &deviceId)
+{
+    return userId + "-" + deviceId;
+}
+
+int SharedTimeSync::AcquireTimeOffset(const std::string &deviceKey, const void *syncer, const Waiter &waiter,
+    TimeOffset &offset)
+{
+    CheckSyncTimeout(deviceKey);
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        DeviceTimeSync &deviceTimeSync = deviceTimeSyncs_[deviceKey];
+        auto now = std::chrono::steady_clock::now();
+        if (deviceTimeSync.isValid && now - deviceTimeSync.syncTime < SHARED_OFFSET_VALID_TIME) {
+            offset = deviceTimeSync.offset;
+            return E_OK;
+        }
+        if (deviceTimeSync.syncer != nullptr && deviceTimeSync.syncer != syncer) {
+            if (waiter) {
+                deviceTimeSync.waiters.push_back(waiter);
+            }
+            return -E_BUSY;
+        }
+        deviceTimeSync.syncer = syncer;
+        deviceTimeSync.startTime = now;
+    }
+    // The claim is released if the syncer never sends the request or never gets the result
+    SetSyncTimeoutTimer(deviceKey);
+    return -E_NOT_FOUND;
+}
+
+void SharedTimeSync::StartSync(const std::string &deviceKey, const void *syncer)
+{
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        DeviceTimeSync &deviceTimeSync = deviceTimeSyncs_[deviceKey];
+        if (deviceTimeSync.syncer != nullptr && deviceTimeSync.syncer != syncer) {
+            // the waiters keep waiting for the first one
+            return;
+        }
+        deviceTimeSync.syncer = syncer;
+        deviceTimeSync.startTime = std::chrono::steady_clock::now();
+    }
+    SetSyncTimeoutTimer(deviceKey);
+}
+
+void SharedTimeSync::SetSyncTimeoutTimer(const std::string &deviceKey)
+{
+    // The timer is not removed when the sync finished, it only wakes up the waiters of the timeout sync.
+    TimerId timerId = 0;
+    int errCode = RuntimeContext::GetInstance()->SetTimer(static_cast<int>(SHARED_SYNC_TIMEOUT.count()),
+        [this, deviceKey](TimerId) {
+            CheckSyncTimeout(deviceKey);
+            return -E_END_TIMER;
+        }, nullptr, timerId);
+    if (errCode != E_OK) {
+        LOGW("[SharedTimeSync] Set sync timeout timer failed, errCode=%d", errCode);
+    }
+}
+
+void SharedTimeSync::FinishSync(const std::string &deviceKey, const void *syncer, TimeOffset offset)
+{
+    std::vector<Waiter> waiters;
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        DeviceTimeSync &deviceTimeSync = deviceTimeSyncs_[deviceKey];
+        deviceTimeSync.isValid = true;
+        deviceTimeSync.offset = offset;
+        deviceTimeSync.syncTime = std::chrono::steady_clock::now();
+        deviceTimeSync.syncer = nullptr;
+        waiters.swap(deviceTimeSync.waiters);
+    }
+    NotifyWaiters(waiters, true);
+}
+
+void SharedTimeSync::AbortSync(const std::string &deviceKey, const void *syncer)
+{
+    std::vector<Waiter> waiters;
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        auto iter = deviceTimeSyncs_.find(deviceKey);
+        if (iter == deviceTimeSyncs_.end() || iter->second.syncer != syncer) {
+            return;
+        }
+        iter->second.syncer = nullptr;
+        waiters.swap(iter->second.waiters);
+    }
+    NotifyWaiters(waiters, false);
+}
+
+void SharedTimeSync::Invalidate(const std::string &deviceKey)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    auto iter = deviceTimeSyncs_.find(deviceKey);
+    if (iter == deviceTimeSyncs_.end()) {
+        return;
+    }
+    iter->second.isValid = false;
+    if (iter->second.syncer == nullptr) {
+        deviceTimeSyncs_.erase(iter);
+    }
+}
+
+void SharedTimeSync::NotifyWaiters(const std::vector<Waiter> &waiters, bool isSynced)
+{
+    if (!waiters.empty()) {
+        LOGD("[SharedTimeSync] Notify %zu waiters, isSynced=%d", waiters.size(), isSynced);
+    }
+    for (const auto &waiter : waiters) {
+        waiter(isSynced);
+    }
+}
+
+void SharedTimeSync::CheckSyncTimeout(const std::string &deviceKey)
+{
+    std::vector<Waiter> waiters;
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        auto iter = deviceTimeSyncs_.find(deviceKey);
+        if (iter == deviceTimeSyncs_.end() || iter->second.syncer == nullptr ||
+            std::chrono::steady_clock::now() - iter->second.startTime < SHARED_SYNC_TIMEOUT) {
+            return;
+        }
+        LOGI("[SharedTimeSync] Time sync with dev=%s timeout.", STR_MASK(deviceKey));
+        iter->second.syncer = nullptr;
+        waiters.swap(iter->second.waiters);
+    }
+    NotifyWaiters(waiters, false);
+}
+} // namespace DistributedDB
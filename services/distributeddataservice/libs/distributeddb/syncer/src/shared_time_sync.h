@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SHARED_TIME_SYNC_H
+#define SHARED_TIME_SYNC_H
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "db_types.h"
+
+namespace DistributedDB {
+// Shares the time offset negotiated with one device among all the stores of the same user in the process.
+// Only one store sends the time sync request to the device at a time, the others wait for and use its result.
+// The shared offset is the remote time minus the local system time, each store subtracts its own local time offset.
+class SharedTimeSync final {
+public:
+    // Called when the store syncing the time finished, isSynced is false if it failed. Called on the timer or the
+    // communicator thread, so it must not block.
+    using Waiter = std::function<void(bool isSynced)>;
+
+    static SharedTimeSync *GetInstance();
+
+    static std::string GetDeviceKey(const std::string &userId, const std::string &deviceId);
+
+    // E_OK: the offset synced within the valid time is returned;
+    // -E_BUSY: another store is syncing the time with the device, the waiter(if not null) is called when it finished;
+    // -E_NOT_FOUND: the syncer is recorded as the store syncing the time, it should send the time sync request, or
+    // abort it. The record expires after the sync timeout.
+    int AcquireTimeOffset(const std::string &deviceKey, const void *syncer, const Waiter &waiter, TimeOffset &offset);
+
+    // The syncer sent a time sync request, the other stores wait for it until the result or the timeout.
+    void StartSync(const std::string &deviceKey, const void *syncer);
+
+    void FinishSync(const std::string &deviceKey, const void *syncer, TimeOffset offset);
+
+    void AbortSync(const std::string &deviceKey, const void *syncer);
+
+    // The shared offset is dropped when the device is offline or a store detects the drift of the time.
+    void Invalidate(const std::string &deviceKey);
+
+private:
+    struct DeviceTimeSync {
+        bool isValid = false;
+        TimeOffset offset = 0;
+        std::chrono::steady_clock::time_point syncTime;
+        const void *syncer = nullptr;
+        std::chrono::steady_clock::time_point startTime;
+        std::vector<Waiter> waiters;
+    };
+
+    SharedTimeSync() = default;
+    ~SharedTimeSync() = default;
+
+    static void NotifyWaiters(const std::vector<Waiter> &waiters, bool isSynced);
+
+    void SetSyncTimeoutTimer(const std::string &deviceKey);
+
+    void CheckSyncTimeout(const std::string &deviceKey);
+
+    std::mutex lock_;
+    std::map<std::string, DeviceTimeSync> deviceTimeSyncs_;
+};
+} // namespace DistributedDB
+
+#endif // SHARED_TIME_SYNC_H
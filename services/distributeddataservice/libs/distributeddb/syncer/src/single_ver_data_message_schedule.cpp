@@ -18,6 +18,7 @@
 #include "log_print.h"
 #include "version.h"
 #include "single_ver_data_sync.h"
+#include "single_ver_serialize_manager.h"
 
 namespace DistributedDB {
 SingleVerDataMessageSchedule::~SingleVerDataMessageSchedule()
@@ -138,6 +139,7 @@ void SingleVerDataMessageSchedule::UpdateMsgMapInner(std::queue<Message *> &msgT
             delete msg;
         }
     }
+    CompactMsgMap();
 }
 
 Message *SingleVerDataMessageSchedule::GetMsgFromMap(bool &isNeedHandle)
@@ -146,16 +148,18 @@ Message *SingleVerDataMessageSchedule::GetMsgFromMap(bool &isNeedHandle)
     std::lock_guard<std::mutex> lock(lock_);
     while (!messageMap_.empty()) {
         auto iter = messageMap_.begin();
-        Message *msg = iter->second;
+        uint32_t sequenceId = iter->first;
+        if (sequenceId > expectedSequenceId_) {
+            // not need handle, keep it in map
+            return nullptr;
+        }
+        uint64_t packetId = iter->second.packetId;
+        Message *msg = TakeBufferedMsg(iter->second);
         messageMap_.erase(iter);
-        const DataRequestPacket *packet = msg->GetObject<DataRequestPacket>();
-        if (packet == nullptr) {
+        if (msg == nullptr) {
             LOGE("[DataMsgSchedule] expected error");
-            delete msg;
             continue;
         }
-        uint32_t sequenceId = msg->GetSequenceId();
-        uint64_t packetId = packet->GetPacketId();
         if (sequenceId < expectedSequenceId_) {
             uint64_t revisePacketId = finishedPacketId_ - (expectedSequenceId_ - 1 - sequenceId);
             LOGI("[DataMsgSchedule] drop msg because seqId less than exSeqId");
@@ -167,19 +171,14 @@ Message *SingleVerDataMessageSchedule::GetMsgFromMap(bool &isNeedHandle)
             isNeedHandle = false;
             return msg;
         }
-        if (sequenceId == expectedSequenceId_) {
-            if (packetId < finishedPacketId_) {
-                LOGI("[DataMsgSchedule] drop msg because packetId less than finishedPacketId");
-                delete msg;
-                continue;
-            }
-            // if packetId == finishedPacketId_ need handle
-            // it will happened while watermark/need_abilitySync when last ack is missing
-            return msg;
+        if (packetId < finishedPacketId_) {
+            LOGI("[DataMsgSchedule] drop msg because packetId less than finishedPacketId");
+            delete msg;
+            continue;
         }
-        // sequenceId > expectedSequenceId_, not need handle, put into map again
-        messageMap_[sequenceId] = msg;
-        return nullptr;
+        // if packetId == finishedPacketId_ need handle
+        // it will happened while watermark/need_abilitySync when last ack is missing
+        return msg;
     }
     return nullptr;
 }
@@ -209,10 +208,104 @@ void SingleVerDataMessageSchedule::ClearMsgMapWithNoLock()
 {
     LOGD("[DataMsgSchedule] begin to ClearMsgMapWithNoLock");
     for (auto &iter : messageMap_) {
-        delete iter.second;
-        iter.second = nullptr;
+        delete iter.second.msg;
+        iter.second.msg = nullptr;
     }
     messageMap_.clear();
+    bufferedSize_ = 0;
+}
+
+void SingleVerDataMessageSchedule::CompactMsgMap()
+{
+    for (auto &[sequenceId, bufferedMsg] : messageMap_) {
+        if (sequenceId <= expectedSequenceId_ || !bufferedMsg.packet.empty()) {
+            continue;
+        }
+        int errCode = SerializeBufferedMsg(bufferedMsg);
+        if (errCode != E_OK) {
+            // keep the msg as it is, it is only larger
+            LOGW("[DataMsgSchedule] serialize msg seqId=%" PRIu32 " failed %d", sequenceId, errCode);
+            continue;
+        }
+        bufferedSize_ += bufferedMsg.packet.size();
+    }
+    DropMsgOverBudget();
+}
+
+void SingleVerDataMessageSchedule::DropMsgOverBudget()
+{
+    // the msg just after the expected one is always kept, it is handled next
+    while (bufferedSize_ > MAX_BUFFERED_SIZE && messageMap_.size() > 1) {
+        auto iter = std::prev(messageMap_.end());
+        if (iter->first <= expectedSequenceId_ + 1) {
+            break;
+        }
+        LOGI("[DataMsgSchedule] buffered size over budget, drop msg seqId=%" PRIu32 ", label=%s, dev=%s", iter->first,
+            label_.c_str(), STR_MASK(deviceId_));
+        ReleaseBufferedMsg(iter->second);
+        messageMap_.erase(iter);
+    }
+}
+
+int SingleVerDataMessageSchedule::SerializeBufferedMsg(BufferedMsg &bufferedMsg)
+{
+    Message *msg = bufferedMsg.msg;
+    // the compressed data is uncompressed when received, keep it raw or it is lost
+    auto dataPacket = const_cast<DataRequestPacket *>(msg->GetObject<DataRequestPacket>());
+    if (dataPacket != nullptr && dataPacket->IsCompressData()) {
+        dataPacket->ClearCompressDataMark();
+    }
+    uint32_t length = SingleVerSerializeManager::CalculateLen(msg);
+    if (length == 0) {
+        return -E_INVALID_ARGS;
+    }
+    std::vector<uint8_t> packet(length, 0);
+    int errCode = SingleVerSerializeManager::Serialization(packet.data(), length, msg);
+    if (errCode != E_OK) {
+        return errCode;
+    }
+    Message *head = new (std::nothrow) Message(msg->GetMessageId());
+    if (head == nullptr) {
+        return -E_OUT_OF_MEMORY;
+    }
+    head->SetMessageType(msg->GetMessageType());
+    head->SetSessionId(msg->GetSessionId());
+    head->SetSequenceId(msg->GetSequenceId());
+    head->SetErrorNo(msg->GetErrorNo());
+    head->SetTarget(msg->GetTarget());
+    head->SetPriority(msg->GetPriority());
+    head->SetVersion(msg->GetVersion());
+    delete msg;
+    bufferedMsg.msg = head;
+    bufferedMsg.packet = std::move(packet);
+    return E_OK;
+}
+
+Message *SingleVerDataMessageSchedule::TakeBufferedMsg(BufferedMsg &bufferedMsg)
+{
+    Message *msg = bufferedMsg.msg;
+    bufferedMsg.msg = nullptr;
+    if (bufferedMsg.packet.empty()) {
+        return msg;
+    }
+    bufferedSize_ -= bufferedMsg.packet.size();
+    int errCode = SingleVerSerializeManager::DeSerialization(bufferedMsg.packet.data(),
+        static_cast<uint32_t>(bufferedMsg.packet.size()), msg);
+    std::vector<uint8_t>().swap(bufferedMsg.packet);
+    if (errCode != E_OK) {
+        LOGE("[DataMsgSchedule] deserialize buffered msg failed %d", errCode);
+        delete msg;
+        return nullptr;
+    }
+    return msg;
+}
+
+void SingleVerDataMessageSchedule::ReleaseBufferedMsg(BufferedMsg &bufferedMsg)
+{
+    delete bufferedMsg.msg;
+    bufferedMsg.msg = nullptr;
+    bufferedSize_ -= bufferedMsg.packet.size();
+    std::vector<uint8_t>().swap(bufferedMsg.packet);
 }
 
 void SingleVerDataMessageSchedule::ClearMsgQueue()
@@ -320,19 +413,18 @@ int SingleVerDataMessageSchedule::UpdateMsgMapIfNeed(Message *msg)
         finishedPacketId_ = 0;
         expectedSequenceId_ = 1;
     }
-    if (messageMap_.count(sequenceId) > 0) {
-        const auto *cachePacket = messageMap_[sequenceId]->GetObject<DataRequestPacket>();
-        if (cachePacket != nullptr) {
-            if (packetId != 0 && packetId < cachePacket->GetPacketId()) {
-                LOGD("[DataMsgSchedule] drop msg packetId=%" PRIu64 ", cachePacketId=%" PRIu64 ", label=%s, dev=%s",
-                    packetId, cachePacket->GetPacketId(), label_.c_str(), STR_MASK(deviceId_));
-                return -E_INVALID_ARGS;
-            }
+    auto iter = messageMap_.find(sequenceId);
+    if (iter != messageMap_.end()) {
+        uint64_t cachePacketId = iter->second.packetId;
+        if (packetId != 0 && packetId < cachePacketId) {
+            LOGD("[DataMsgSchedule] drop msg packetId=%" PRIu64 ", cachePacketId=%" PRIu64 ", label=%s, dev=%s",
+                packetId, cachePacketId, label_.c_str(), STR_MASK(deviceId_));
+            return -E_INVALID_ARGS;
         }
-        delete messageMap_[sequenceId];
-        messageMap_[sequenceId] = nullptr;
+        ReleaseBufferedMsg(iter->second);
+        messageMap_.erase(iter);
     }
-    messageMap_[sequenceId] = msg;
+    messageMap_[sequenceId] = { msg, {}, packetId };
     LOGD("[DataMsgSchedule] put into msgMap seqId=%" PRIu32 ", packetId=%" PRIu64 ", label=%s, dev=%s", sequenceId,
         packetId, label_.c_str(), STR_MASK(deviceId_));
     return E_OK;
@@ -19,6 +19,7 @@
 #include <map>
 #include <mutex>
 #include <queue>
+#include <vector>
 
 #include "message.h"
 #include "runtime_context.h"
@@ -36,11 +37,24 @@ public:
     void ScheduleInfoHandle(bool isNeedHandleStatus, bool isNeedClearMap, const Message *inMsg);
     void ClearMsg();
 private:
+    // The msg waiting for the msgs of the smaller sequenceId. Only its head is kept with the serialized packet, the
+    // packet is deserialized again when its turn comes.
+    struct BufferedMsg {
+        Message *msg = nullptr;
+        std::vector<uint8_t> packet;
+        uint64_t packetId = 0;
+    };
+
     void UpdateMsgMap();
     void UpdateMsgMapInner(std::queue<Message *> &msgTmpQueue);
     int UpdateMsgMapIfNeed(Message *msg);
     Message *GetMsgFromMap(bool &isNeedHandle);
     Message *GetLastMsgFromQueue();
+    void CompactMsgMap();
+    void DropMsgOverBudget();
+    Message *TakeBufferedMsg(BufferedMsg &bufferedMsg);
+    void ReleaseBufferedMsg(BufferedMsg &bufferedMsg);
+    static int SerializeBufferedMsg(BufferedMsg &bufferedMsg);
     void ClearMsgMap();
     void ClearMsgMapWithNoLock();
     void ClearMsgQueue();
@@ -53,6 +67,9 @@ private:
     int TimeOut(TimerId timerId);
 
     static constexpr int IDLE_TIME_OUT = 5 * 60 * 1000; // 5min
+    // The serialized msgs of a session buffered for the msgs before them, the msgs over it are dropped from the
+    // largest sequenceId, and the remote sends them again after the ack timeout
+    static constexpr size_t MAX_BUFFERED_SIZE = 32 * 1024 * 1024; // 32MB
     std::mutex queueLock_;
     std::queue<Message *> msgQueue_;
     bool isNeedReload_ = false;
@@ -61,7 +78,8 @@ private:
     bool isWorking_ = false;
     // first:sequenceId second:Message*, deal msg from low sequenceId to high sequenceId
     std::mutex lock_;
-    std::map<uint32_t, Message *> messageMap_;
+    std::map<uint32_t, BufferedMsg> messageMap_;
+    size_t bufferedSize_ = 0; // the size of the serialized packets in messageMap_
     uint32_t prevSessionId_ = 0; // drop the msg if msg sessionId is prev sessionId.
     uint32_t currentSessionId_ = 0;
     uint64_t finishedPacketId_ = 0; // next msg packetId should larger than it
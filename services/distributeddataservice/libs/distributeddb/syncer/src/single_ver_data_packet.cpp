@@ -225,6 +225,13 @@ bool DataRequestPacket::IsCompressData() const
     return ((flag_ & IS_COMPRESS_DATA) == IS_COMPRESS_DATA);
 }
 
+void DataRequestPacket::ClearCompressDataMark()
+{
+    flag_ = flag_ & (~IS_COMPRESS_DATA);
+    std::vector<uint8_t>().swap(compressData_);
+    algo_ = CompressAlgorithm::NONE;
+}
+
 void DataRequestPacket::SetCompressAlgo(CompressAlgorithm algo)
 {
     algo_ = algo;
@@ -470,4 +477,89 @@ uint32_t ControlAckPacket::CalculateLen() const
     }
     return len;
 }
+
+void DigestRequestPacket::SetVersion(uint32_t version)
+{
+    version_ = version;
+}
+
+uint32_t DigestRequestPacket::GetVersion() const
+{
+    return version_;
+}
+
+void DigestRequestPacket::SetNodes(const std::vector<uint64_t> &nodes)
+{
+    nodes_ = nodes;
+}
+
+const std::vector<uint64_t> &DigestRequestPacket::GetNodes() const
+{
+    return nodes_;
+}
+
+uint32_t DigestRequestPacket::CalculateLen() const
+{
+    uint64_t len = Parcel::GetUInt32Len(); // version_
+    len += Parcel::GetVectorLen<uint64_t>(nodes_);
+    len = Parcel::GetEightByteAlign(len);
+    if (len > INT32_MAX) {
+        return 0;
+    }
+    return len;
+}
+
+void DigestAckPacket::SetVersion(uint32_t version)
+{
+    version_ = version;
+}
+
+uint32_t DigestAckPacket::GetVersion() const
+{
+    return version_;
+}
+
+void DigestAckPacket::SetRecvCode(int32_t errorCode)
+{
+    recvCode_ = errorCode;
+}
+
+int32_t DigestAckPacket::GetRecvCode() const
+{
+    return recvCode_;
+}
+
+void DigestAckPacket::SetDiffNodes(const std::vector<uint32_t> &diffNodes)
+{
+    diffNodes_ = diffNodes;
+}
+
+const std::vector<uint32_t> &DigestAckPacket::GetDiffNodes() const
+{
+    return diffNodes_;
+}
+
+void DigestAckPacket::SetLeaves(const std::vector<uint64_t> &leaves)
+{
+    leaves_ = leaves;
+}
+
+const std::vector<uint64_t> &DigestAckPacket::GetLeaves() const
+{
+    return leaves_;
+}
+
+uint32_t DigestAckPacket::CalculateLen() const
+{
+    uint64_t len = Parcel::GetUInt32Len(); // version_
+    len += Parcel::GetIntLen(); // recvCode_
+    len = Parcel::GetEightByteAlign(len);
+    len += Parcel::GetVectorLen<uint32_t>(diffNodes_);
+    len += Parcel::GetVectorLen<uint64_t>(leaves_);
+    len = Parcel::GetEightByteAlign(len);
+    if (len > INT32_MAX) {
+        return 0;
+    }
+    return len;
+}
 } // namespace DistributedDB
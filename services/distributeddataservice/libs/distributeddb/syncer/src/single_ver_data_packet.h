@@ -104,6 +104,8 @@ public:
 
     void SetCompressDataMark();
     bool IsCompressData() const;
+    // The received packet has the data uncompressed, clear the mark to serialize it as raw data again
+    void ClearCompressDataMark();
 
     void SetCompressAlgo(CompressAlgorithm algo);
     CompressAlgorithm GetCompressAlgo() const;
@@ -217,6 +219,45 @@ private:
     uint32_t controlCmdType_ = 0;
     uint32_t flag_ = 0;
 };
+
+// Carry the nodes of the sync digest of the pushing device.
+class DigestRequestPacket {
+public:
+    DigestRequestPacket() {};
+    virtual ~DigestRequestPacket() {};
+    void SetVersion(uint32_t version);
+    uint32_t GetVersion() const;
+    void SetNodes(const std::vector<uint64_t> &nodes);
+    const std::vector<uint64_t> &GetNodes() const;
+    uint32_t CalculateLen() const;
+
+private:
+    uint32_t version_ = SOFTWARE_VERSION_CURRENT;
+    std::vector<uint64_t> nodes_;
+};
+
+// Carry the leaves of the nodes which are different on the receiving device.
+class DigestAckPacket {
+public:
+    DigestAckPacket() {};
+    virtual ~DigestAckPacket() {};
+    void SetVersion(uint32_t version);
+    uint32_t GetVersion() const;
+    void SetRecvCode(int32_t errorCode);
+    int32_t GetRecvCode() const;
+    void SetDiffNodes(const std::vector<uint32_t> &diffNodes);
+    const std::vector<uint32_t> &GetDiffNodes() const;
+    // The leaves of the different nodes one after another.
+    void SetLeaves(const std::vector<uint64_t> &leaves);
+    const std::vector<uint64_t> &GetLeaves() const;
+    uint32_t CalculateLen() const;
+
+private:
+    uint32_t version_ = SOFTWARE_VERSION_CURRENT;
+    int32_t recvCode_ = 0;
+    std::vector<uint32_t> diffNodes_;
+    std::vector<uint64_t> leaves_;
+};
 }  // namespace DistributedDB
 
 #endif // SINGLE_VER_DATA_SYNC_NEW_H
\ No newline at end of file
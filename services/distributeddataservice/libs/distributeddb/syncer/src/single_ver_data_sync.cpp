@@ -25,6 +25,7 @@
 #include "single_ver_data_sync_utils.h"
 #include "single_ver_sync_state_machine.h"
 #include "subscribe_manager.h"
+#include "sync_data_compress_cache.h"
 #ifdef RELATIONAL_STORE
 #include "relational_db_sync_interface.h"
 #endif
@@ -297,6 +298,10 @@ int SingleVerDataSync::GetDataWithPerformanceRecord(SingleVerSyncTaskContext *co
         context->SetTaskErrCode(errCode);
         return errCode;
     }
+    int pushMode = SyncOperation::TransferSyncMode(mode_);
+    if (pushMode == SyncModeType::PUSH || pushMode == SyncModeType::PUSH_AND_PULL) {
+        FilterDigestMatchedData(context, syncOutData.entries);
+    }
 
     int innerCode = InterceptData(syncOutData);
     if (innerCode != E_OK) {
@@ -304,10 +309,8 @@ int SingleVerDataSync::GetDataWithPerformanceRecord(SingleVerSyncTaskContext *co
         return innerCode;
     }
 
-    CompressAlgorithm remoteAlgo = context->ChooseCompressAlgo();
-    if (needCompressOnSync && remoteAlgo != CompressAlgorithm::NONE) {
-        int compressCode = GenericSingleVerKvEntry::Compress(syncOutData.entries, syncOutData.compressedEntries,
-            { remoteAlgo, version });
+    if (needCompressOnSync) {
+        int compressCode = CompressData(context, syncOutData, version);
         if (compressCode != E_OK) {
             return compressCode;
         }
@@ -1588,10 +1591,8 @@ int SingleVerDataSync::GetReSendData(SyncEntry &syncData, SingleVerSyncTaskConte
     bool needCompressOnSync = false;
     uint8_t compressionRate = DBConstant::DEFAULT_COMPTRESS_RATE;
     (void)storage_->GetCompressionOption(needCompressOnSync, compressionRate);
-    CompressAlgorithm remoteAlgo = context->ChooseCompressAlgo();
-    if (needCompressOnSync && remoteAlgo != CompressAlgorithm::NONE) {
-        int compressCode = GenericSingleVerKvEntry::Compress(syncData.entries, syncData.compressedEntries,
-            { remoteAlgo, version });
+    if (needCompressOnSync) {
+        int compressCode = CompressData(context, syncData, version);
         if (compressCode != E_OK) {
             return compressCode;
         }
@@ -1686,6 +1687,26 @@ DataSizeSpecInfo SingleVerDataSync::GetDataSizeSpecInfo(size_t packetSize)
     return {blockSize, packetSize};
 }
 
+int SingleVerDataSync::CompressData(SingleVerSyncTaskContext *context, SyncEntry &syncEntry, uint32_t version)
+{
+    CompressAlgorithm remoteAlgo = context->ChooseCompressAlgo();
+    if (remoteAlgo == CompressAlgorithm::NONE) {
+        return E_OK;
+    }
+    CompressInfo compressInfo = { remoteAlgo, version };
+    // the intercepted entries may differ among the devices with the same key and timestamp
+    std::shared_ptr<SyncDataCompressCache> compressCache = storage_->HasDataInterceptor() ?
+        nullptr : storage_->GetSyncDataCompressCache();
+    if (compressCache != nullptr && compressCache->Get(syncEntry.entries, compressInfo, syncEntry.compressedEntries)) {
+        return E_OK;
+    }
+    int errCode = GenericSingleVerKvEntry::Compress(syncEntry.entries, syncEntry.compressedEntries, compressInfo);
+    if (errCode == E_OK && compressCache != nullptr) {
+        compressCache->Put(syncEntry.entries, compressInfo, syncEntry.compressedEntries);
+    }
+    return errCode;
+}
+
 int SingleVerDataSync::InterceptData(SyncEntry &syncEntry)
 {
     if (storage_ == nullptr) {
@@ -1699,6 +1720,46 @@ int SingleVerDataSync::InterceptData(SyncEntry &syncEntry)
     return storage_->InterceptData(syncEntry.entries, GetLocalDeviceName(), GetDeviceId());
 }
 
+void SingleVerDataSync::FilterDigestMatchedData(SingleVerSyncTaskContext *context,
+    std::vector<SendDataItem> &outData) const
+{
+    if (!context->HasDigestMatchedBuckets() || outData.empty()) {
+        return;
+    }
+    // the entry with the max timestamp is always sent, the water marks are updated by it on both devices
+    size_t lastIndex = 0;
+    for (size_t i = 0; i < outData.size(); i++) {
+        if (outData[i] != nullptr && outData[lastIndex] != nullptr &&
+            outData[i]->GetTimestamp() > outData[lastIndex]->GetTimestamp()) {
+            lastIndex = i;
+        }
+    }
+    std::vector<SendDataItem> filteredData;
+    for (size_t i = 0; i < outData.size(); i++) {
+        SendDataItem item = outData[i];
+        if (item == nullptr || i == lastIndex) {
+            filteredData.push_back(item);
+            continue;
+        }
+        // the key of the deleted entry is its hash key
+        Key hashKey = item->GetKey();
+        if ((item->GetFlag() & DataItem::DELETE_FLAG) == 0 &&
+            DBCommon::CalcValueHash(item->GetKey(), hashKey) != E_OK) {
+            filteredData.push_back(item);
+            continue;
+        }
+        uint32_t bucket = SyncDigest::GetBucket(hashKey.data(), static_cast<uint32_t>(hashKey.size()));
+        if (hashKey.empty() || !context->IsDigestMatched(bucket, item->GetTimestamp())) {
+            filteredData.push_back(item);
+            continue;
+        }
+        delete item;
+    }
+    LOGD("[DataSync][FilterDigestMatchedData] skip %zu of %zu entries", outData.size() - filteredData.size(),
+        outData.size());
+    outData = std::move(filteredData);
+}
+
 int SingleVerDataSync::ControlCmdStart(SingleVerSyncTaskContext *context)
 {
     if (context == nullptr) {
@@ -2041,4 +2102,163 @@ void SingleVerDataSync::SetSendConfig(const std::string &dstTarget, bool nonBloc
     sendConf.paramInfo.storeId = storage_->GetDbProperties().GetStringProp(KvDBProperties::STORE_ID, "");
     sendConf.paramInfo.dstTarget = dstTarget;
 }
+
+bool SingleVerDataSync::IsNeedDigestSync(SingleVerSyncTaskContext *context)
+{
+    if (context->IsQuerySync() ||
+        context->GetRemoteDbAbility().GetAbilityItem(SyncConfig::DIGEST_SYNC) != SUPPORT_MARK) {
+        return false;
+    }
+    int mode = context->GetMode();
+    if (mode != SyncModeType::PUSH && mode != SyncModeType::PUSH_AND_PULL) {
+        return false;
+    }
+    // the intercepted data is not the same as the digested one
+    if (storage_->HasDataInterceptor()) {
+        return false;
+    }
+    WaterMark localMark = 0;
+    GetLocalWaterMark(SyncType::MANUAL_FULL_SYNC_TYPE, "", context, localMark);
+    if (localMark != 0) {
+        return false;
+    }
+    localDigest_ = SyncDigest();
+    return storage_->GetSyncDigest(localDigest_) == E_OK;
+}
+
+int SingleVerDataSync::DigestSyncStart(SingleVerSyncTaskContext *context)
+{
+    auto packet = new (std::nothrow) DigestRequestPacket();
+    if (packet == nullptr) {
+        LOGE("[DataSync][DigestSyncStart] new DigestRequestPacket error");
+        return -E_OUT_OF_MEMORY;
+    }
+    packet->SetVersion(std::min(context->GetRemoteSoftwareVersion(), SOFTWARE_VERSION_CURRENT));
+    packet->SetNodes(localDigest_.GetNodes());
+    Message *message = new (std::nothrow) Message(DIGEST_SYNC_MESSAGE);
+    if (message == nullptr) {
+        LOGE("[DataSync][DigestSyncStart] new message error");
+        delete packet;
+        packet = nullptr;
+        return -E_OUT_OF_MEMORY;
+    }
+    uint32_t packetLen = packet->CalculateLen();
+    int errCode = message->SetExternalObject(packet);
+    if (errCode != E_OK) {
+        delete packet;
+        packet = nullptr;
+        delete message;
+        message = nullptr;
+        LOGE("[DataSync][DigestSyncStart] set external object failed errCode=%d", errCode);
+        return errCode;
+    }
+    SingleVerDataSyncUtils::SetMessageHeadInfo(*message, TYPE_REQUEST, context->GetDeviceId(),
+        context->GetSequenceId(), context->GetRequestSessionId());
+    CommErrHandler handler = std::bind(&SyncTaskContext::CommErrHandlerFunc, std::placeholders::_1,
+        context, message->GetSessionId());
+    errCode = Send(context, message, handler, packetLen);
+    if (errCode != E_OK) {
+        delete message;
+        message = nullptr;
+    }
+    return errCode;
+}
+
+int SingleVerDataSync::DigestRequestRecv(SingleVerSyncTaskContext *context, const Message *message)
+{
+    if (context == nullptr || message == nullptr) {
+        return -E_INVALID_ARGS;
+    }
+    const DigestRequestPacket *packet = message->GetObject<DigestRequestPacket>();
+    if (packet == nullptr) {
+        return -E_INVALID_ARGS;
+    }
+    DigestAckPacket ack;
+    ack.SetVersion(std::min(context->GetRemoteSoftwareVersion(), SOFTWARE_VERSION_CURRENT));
+    SyncDigest digest;
+    int errCode = storage_->GetSyncDigest(digest);
+    if (errCode != E_OK || packet->GetNodes().size() != SyncDigest::NODE_NUM) {
+        LOGI("[DataSync][DigestRequestRecv] digest not compared, errCode=%d,label=%s,dev=%s", errCode,
+            label_.c_str(), STR_MASK(GetDeviceId()));
+        ack.SetRecvCode((errCode != E_OK) ? errCode : -E_INVALID_ARGS);
+        return SendDigestAck(context, message, ack);
+    }
+    std::vector<uint64_t> nodes = digest.GetNodes();
+    std::vector<uint32_t> diffNodes;
+    std::vector<uint64_t> leaves;
+    for (uint32_t node = 0; node < SyncDigest::NODE_NUM; node++) {
+        if (nodes[node] == packet->GetNodes()[node]) {
+            continue;
+        }
+        diffNodes.push_back(node);
+        std::vector<uint64_t> nodeLeaves = digest.GetNodeLeaves(node);
+        leaves.insert(leaves.end(), nodeLeaves.begin(), nodeLeaves.end());
+    }
+    ack.SetDiffNodes(diffNodes);
+    ack.SetLeaves(leaves);
+    return SendDigestAck(context, message, ack);
+}
+
+int SingleVerDataSync::SendDigestAck(SingleVerSyncTaskContext *context, const Message *message,
+    const DigestAckPacket &ack)
+{
+    Message *ackMessage = new (std::nothrow) Message(message->GetMessageId());
+    if (ackMessage == nullptr) {
+        LOGE("[DataSync][SendDigestAck] new message error");
+        return -E_OUT_OF_MEMORY;
+    }
+    uint32_t packetLen = ack.CalculateLen();
+    int errCode = ackMessage->SetCopiedObject(ack);
+    if (errCode != E_OK) {
+        delete ackMessage;
+        ackMessage = nullptr;
+        LOGE("[DataSync][SendDigestAck] set copied object failed, errcode=%d", errCode);
+        return errCode;
+    }
+    SingleVerDataSyncUtils::SetMessageHeadInfo(*ackMessage, TYPE_RESPONSE, context->GetDeviceId(),
+        message->GetSequenceId(), message->GetSessionId());
+    errCode = Send(context, ackMessage, nullptr, packetLen);
+    if (errCode != E_OK) {
+        delete ackMessage;
+        ackMessage = nullptr;
+    }
+    return errCode;
+}
+
+int SingleVerDataSync::DigestAckRecv(SingleVerSyncTaskContext *context, const Message *message)
+{
+    const DigestAckPacket *packet = message->GetObject<DigestAckPacket>();
+    if (packet == nullptr) {
+        return -E_INVALID_ARGS;
+    }
+    if (packet->GetRecvCode() != E_OK) {
+        LOGI("[DataSync][DigestAckRecv] remote digest not compared, recvCode=%d", packet->GetRecvCode());
+        return packet->GetRecvCode();
+    }
+    const std::vector<uint32_t> &diffNodes = packet->GetDiffNodes();
+    const std::vector<uint64_t> &leaves = packet->GetLeaves();
+    if (leaves.size() != diffNodes.size() * SyncDigest::LEAF_NUM_PER_NODE) {
+        return -E_INVALID_ARGS;
+    }
+    // the buckets of the same nodes are all matched, the buckets of the different nodes are compared one by one
+    std::vector<bool> matchedBuckets(SyncDigest::LEAF_NUM, true);
+    uint32_t matchedCount = SyncDigest::LEAF_NUM;
+    for (size_t i = 0; i < diffNodes.size(); i++) {
+        if (diffNodes[i] >= SyncDigest::NODE_NUM) {
+            return -E_INVALID_ARGS;
+        }
+        for (uint32_t j = 0; j < SyncDigest::LEAF_NUM_PER_NODE; j++) {
+            uint32_t bucket = diffNodes[i] * SyncDigest::LEAF_NUM_PER_NODE + j;
+            if (localDigest_.GetLeaf(bucket) != leaves[i * SyncDigest::LEAF_NUM_PER_NODE + j] &&
+                matchedBuckets[bucket]) {
+                matchedBuckets[bucket] = false;
+                matchedCount--;
+            }
+        }
+    }
+    LOGI("[DataSync][DigestAckRecv] %u of %u buckets matched,label=%s,dev=%s", matchedCount, SyncDigest::LEAF_NUM,
+        label_.c_str(), STR_MASK(GetDeviceId()));
+    context->SetDigestMatchedBuckets(matchedBuckets, localDigest_.GetTimestamp());
+    return E_OK;
+}
 } // namespace DistributedDB
@@ -105,6 +105,15 @@ public:
 
     int ControlCmdAckRecv(SingleVerSyncTaskContext *context, const Message *message);
 
+    // Only for the full push started without local water mark, when the digest sync is enabled on both devices.
+    bool IsNeedDigestSync(SingleVerSyncTaskContext *context);
+
+    int DigestSyncStart(SingleVerSyncTaskContext *context);
+
+    int DigestRequestRecv(SingleVerSyncTaskContext *context, const Message *message);
+
+    int DigestAckRecv(SingleVerSyncTaskContext *context, const Message *message);
+
     void PutDataMsg(Message *message);
 
     Message *MoveNextDataMsg(SingleVerSyncTaskContext *context, bool &isNeedHandle, bool &isNeedContinue);
@@ -229,8 +238,14 @@ protected:
 
     DataSizeSpecInfo GetDataSizeSpecInfo(size_t packetSize);
 
+    int CompressData(SingleVerSyncTaskContext *context, SyncEntry &syncEntry, uint32_t version);
+
     int InterceptData(SyncEntry &syncEntry);
 
+    void FilterDigestMatchedData(SingleVerSyncTaskContext *context, std::vector<SendDataItem> &outData) const;
+
+    int SendDigestAck(SingleVerSyncTaskContext *context, const Message *message, const DigestAckPacket &ack);
+
     int ControlCmdStartCheck(SingleVerSyncTaskContext *context);
 
     int SendControlPacket(const ControlRequestPacket *packet, SingleVerSyncTaskContext *context);
@@ -269,6 +284,8 @@ protected:
     bool isAllDataHasSent_ = false;
     // in a sync session, the last data timestamp
     Timestamp sessionEndTimestamp_ = 0;
+    // the local digest sent in the digest sync, compared with the leaves in the ack
+    SyncDigest localDigest_;
 
     std::mutex removeDeviceDataLock_;
 };
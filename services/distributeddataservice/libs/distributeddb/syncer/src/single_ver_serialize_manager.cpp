@@ -32,6 +32,9 @@ int SingleVerSerializeManager::Serialization(uint8_t *buffer, uint32_t length, c
     if (inMsg->GetMessageId() == CONTROL_SYNC_MESSAGE) {
         return ControlSerialization(buffer, length, inMsg);
     }
+    if (inMsg->GetMessageId() == DIGEST_SYNC_MESSAGE) {
+        return DigestSerialization(buffer, length, inMsg);
+    }
     return DataSerialization(buffer, length, inMsg);
 }
 
@@ -68,9 +71,24 @@ int SingleVerSerializeManager::DeSerialization(const uint8_t *buffer, uint32_t l
     if (inMsg->GetMessageId() == CONTROL_SYNC_MESSAGE) {
         return ControlDeSerialization(buffer, length, inMsg);
     }
+    if (inMsg->GetMessageId() == DIGEST_SYNC_MESSAGE) {
+        return DigestDeSerialization(buffer, length, inMsg);
+    }
     return DataDeSerialization(buffer, length, inMsg);
 }
 
+int SingleVerSerializeManager::DigestSerialization(uint8_t *buffer, uint32_t length, const Message *inMsg)
+{
+    switch (inMsg->GetMessageType()) {
+        case TYPE_REQUEST:
+            return DigestPacketSerialization(buffer, length, inMsg);
+        case TYPE_RESPONSE:
+            return AckDigestPacketSerialization(buffer, length, inMsg);
+        default:
+            return -E_MESSAGE_TYPE_ERROR;
+    }
+}
+
 int SingleVerSerializeManager::DataDeSerialization(const uint8_t *buffer, uint32_t length, Message *inMsg)
 {
     switch (inMsg->GetMessageType()) {
@@ -96,6 +114,18 @@ int SingleVerSerializeManager::ControlDeSerialization(const uint8_t *buffer, uin
     }
 }
 
+int SingleVerSerializeManager::DigestDeSerialization(const uint8_t *buffer, uint32_t length, Message *inMsg)
+{
+    switch (inMsg->GetMessageType()) {
+        case TYPE_REQUEST:
+            return DigestPacketDeSerialization(buffer, length, inMsg);
+        case TYPE_RESPONSE:
+            return AckDigestPacketDeSerialization(buffer, length, inMsg);
+        default:
+            return -E_MESSAGE_TYPE_ERROR;
+    }
+}
+
 uint32_t SingleVerSerializeManager::CalculateLen(const Message *inMsg)
 {
     if (!(IsPacketValid(inMsg))) {
@@ -104,6 +134,9 @@ uint32_t SingleVerSerializeManager::CalculateLen(const Message *inMsg)
     if (inMsg->GetMessageId() == CONTROL_SYNC_MESSAGE) {
         return CalculateControlLen(inMsg);
     }
+    if (inMsg->GetMessageId() == DIGEST_SYNC_MESSAGE) {
+        return CalculateDigestLen(inMsg);
+    }
     return CalculateDataLen(inMsg);
 }
 
@@ -157,6 +190,19 @@ uint32_t SingleVerSerializeManager::CalculateControlLen(const Message *inMsg)
     }
 }
 
+uint32_t SingleVerSerializeManager::CalculateDigestLen(const Message *inMsg)
+{
+    if (inMsg->GetMessageType() == TYPE_REQUEST) {
+        auto packet = inMsg->GetObject<DigestRequestPacket>();
+        return (packet == nullptr) ? 0 : packet->CalculateLen();
+    }
+    if (inMsg->GetMessageType() == TYPE_RESPONSE) {
+        auto packet = inMsg->GetObject<DigestAckPacket>();
+        return (packet == nullptr) ? 0 : packet->CalculateLen();
+    }
+    return 0;
+}
+
 int SingleVerSerializeManager::RegisterTransformFunc()
 {
     TransformFunc func;
@@ -174,7 +220,11 @@ int SingleVerSerializeManager::RegisterTransformFunc()
     if (errCode != E_OK) {
         return errCode;
     }
-    return MessageTransform::RegTransformFunction(CONTROL_SYNC_MESSAGE, func);
+    errCode = MessageTransform::RegTransformFunction(CONTROL_SYNC_MESSAGE, func);
+    if (errCode != E_OK) {
+        return errCode;
+    }
+    return MessageTransform::RegTransformFunction(DIGEST_SYNC_MESSAGE, func);
 }
 
 int SingleVerSerializeManager::DataPacketSyncerPartSerialization(Parcel &parcel, const DataRequestPacket *packet)
@@ -710,4 +760,100 @@ ERROR:
     packet = nullptr;
     return errCode;
 }
-}  // namespace DistributedDB
\ No newline at end of file
+
+int SingleVerSerializeManager::DigestPacketSerialization(uint8_t *buffer, uint32_t length, const Message *inMsg)
+{
+    auto packet = inMsg->GetObject<DigestRequestPacket>();
+    if (packet == nullptr) {
+        return -E_INVALID_ARGS;
+    }
+    Parcel parcel(buffer, length);
+    parcel.WriteUInt32(packet->GetVersion());
+    parcel.EightByteAlign();
+    parcel.WriteVector<uint64_t>(packet->GetNodes());
+    if (parcel.IsError()) {
+        LOGE("[DigestPacketSerialization] Serialization failed");
+        return -E_INVALID_ARGS;
+    }
+    parcel.EightByteAlign();
+    return E_OK;
+}
+
+int SingleVerSerializeManager::DigestPacketDeSerialization(const uint8_t *buffer, uint32_t length, Message *inMsg)
+{
+    Parcel parcel(const_cast<uint8_t *>(buffer), length);
+    uint32_t version = 0;
+    std::vector<uint64_t> nodes;
+    parcel.ReadUInt32(version);
+    parcel.EightByteAlign();
+    parcel.ReadVector<uint64_t>(nodes);
+    if (parcel.IsError()) {
+        LOGE("[DigestPacketDeSerialization] DeSerialization failed");
+        return -E_INVALID_ARGS;
+    }
+    auto packet = new (std::nothrow) DigestRequestPacket();
+    if (packet == nullptr) {
+        return -E_OUT_OF_MEMORY;
+    }
+    packet->SetVersion(version);
+    packet->SetNodes(nodes);
+    int errCode = inMsg->SetExternalObject<>(packet);
+    if (errCode != E_OK) {
+        delete packet;
+        packet = nullptr;
+    }
+    return errCode;
+}
+
+int SingleVerSerializeManager::AckDigestPacketSerialization(uint8_t *buffer, uint32_t length, const Message *inMsg)
+{
+    auto packet = inMsg->GetObject<DigestAckPacket>();
+    if (packet == nullptr) {
+        return -E_INVALID_ARGS;
+    }
+    Parcel parcel(buffer, length);
+    parcel.WriteUInt32(packet->GetVersion());
+    parcel.WriteInt(packet->GetRecvCode());
+    parcel.EightByteAlign();
+    parcel.WriteVector<uint32_t>(packet->GetDiffNodes());
+    parcel.WriteVector<uint64_t>(packet->GetLeaves());
+    if (parcel.IsError()) {
+        LOGE("[AckDigestPacketSerialization] Serialization failed");
+        return -E_INVALID_ARGS;
+    }
+    parcel.EightByteAlign();
+    return E_OK;
+}
+
+int SingleVerSerializeManager::AckDigestPacketDeSerialization(const uint8_t *buffer, uint32_t length, Message *inMsg)
+{
+    Parcel parcel(const_cast<uint8_t *>(buffer), length);
+    uint32_t version = 0;
+    int32_t recvCode = 0;
+    std::vector<uint32_t> diffNodes;
+    std::vector<uint64_t> leaves;
+    parcel.ReadUInt32(version);
+    parcel.ReadInt(recvCode);
+    parcel.EightByteAlign();
+    parcel.ReadVector<uint32_t>(diffNodes);
+    parcel.ReadVector<uint64_t>(leaves);
+    if (parcel.IsError()) {
+        LOGE("[AckDigestPacketDeSerialization] DeSerialization failed");
+        return -E_INVALID_ARGS;
+    }
+    auto packet = new (std::nothrow) DigestAckPacket();
+    if (packet == nullptr) {
+        return -E_OUT_OF_MEMORY;
+    }
+    packet->SetVersion(version);
+    packet->SetRecvCode(recvCode);
+    packet->SetDiffNodes(diffNodes);
+    packet->SetLeaves(leaves);
+    int errCode = inMsg->SetExternalObject<>(packet);
+    if (errCode != E_OK) {
+        delete packet;
+        packet = nullptr;
+    }
+    return errCode;
+}
+}  // namespace DistributedDB
@@ -40,12 +40,15 @@ private:
 
     static int DataSerialization(uint8_t *buffer, uint32_t length, const Message *inMsg);
     static int ControlSerialization(uint8_t *buffer, uint32_t length, const Message *inMsg);
+    static int DigestSerialization(uint8_t *buffer, uint32_t length, const Message *inMsg);
 
     static int DataDeSerialization(const uint8_t *buffer, uint32_t length, Message *inMsg);
     static int ControlDeSerialization(const uint8_t *buffer, uint32_t length, Message *inMsg);
+    static int DigestDeSerialization(const uint8_t *buffer, uint32_t length, Message *inMsg);
 
     static uint32_t CalculateDataLen(const Message *inMsg);
     static uint32_t CalculateControlLen(const Message *inMsg);
+    static uint32_t CalculateDigestLen(const Message *inMsg);
 
     static int DataPacketSerialization(uint8_t *buffer, uint32_t length, const Message *inMsg);
     static int DataPacketSyncerPartSerialization(Parcel &parcel, const DataRequestPacket *packet);
@@ -78,6 +81,11 @@ private:
     static int SubscribeCalculateLen(const Message *inMsg, uint32_t &len);
     static int SubscribeSerialization(uint8_t *buffer, uint32_t length, const Message *inMsg);
     static int SubscribeDeSerialization(Parcel &parcel, Message *inMsg, ControlRequestPacket &controlPacket);
+
+    static int DigestPacketSerialization(uint8_t *buffer, uint32_t length, const Message *inMsg);
+    static int DigestPacketDeSerialization(const uint8_t *buffer, uint32_t length, Message *inMsg);
+    static int AckDigestPacketSerialization(uint8_t *buffer, uint32_t length, const Message *inMsg);
+    static int AckDigestPacketDeSerialization(const uint8_t *buffer, uint32_t length, Message *inMsg);
 };
 }  // namespace DistributedDB
 
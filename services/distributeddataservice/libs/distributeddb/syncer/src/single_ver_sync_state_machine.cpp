@@ -52,11 +52,16 @@ namespace {
 
         // In ABILITY_SYNC state, compare version num and schema
         {State::ABILITY_SYNC, Event::VERSION_NOT_SUPPOR_EVENT, State::INNER_ERR},
-        {State::ABILITY_SYNC, Event::ABILITY_SYNC_FINISHED_EVENT, State::START_INITIACTIVE_DATA_SYNC},
+        {State::ABILITY_SYNC, Event::ABILITY_SYNC_FINISHED_EVENT, State::DIGEST_SYNC},
         {State::ABILITY_SYNC, Event::TIME_OUT_EVENT, State::SYNC_TIME_OUT},
         {State::ABILITY_SYNC, Event::INNER_ERR_EVENT, State::INNER_ERR},
         {State::ABILITY_SYNC, Event::CONTROL_CMD_EVENT, State::SYNC_CONTROL_CMD},
 
+        // In DIGEST_SYNC state, compare the sync digest with the remote device if need
+        {State::DIGEST_SYNC, Event::DIGEST_SYNC_FINISHED_EVENT, State::START_INITIACTIVE_DATA_SYNC},
+        {State::DIGEST_SYNC, Event::TIME_OUT_EVENT, State::SYNC_TIME_OUT},
+        {State::DIGEST_SYNC, Event::INNER_ERR_EVENT, State::INNER_ERR},
+
         // In START_INITIACTIVE_DATA_SYNC state, send a sync request, and send first packt of data sync
         {State::START_INITIACTIVE_DATA_SYNC, Event::NEED_ABILITY_SYNC_EVENT, State::ABILITY_SYNC},
         {State::START_INITIACTIVE_DATA_SYNC, Event::TIME_OUT_EVENT, State::SYNC_TIME_OUT},
@@ -189,6 +194,9 @@ int SingleVerSyncStateMachine::ReceiveMessageCallback(Message *inMsg)
         case CONTROL_SYNC_MESSAGE:
             errCode = ControlPktRecv(inMsg);
             break;
+        case DIGEST_SYNC_MESSAGE:
+            errCode = DigestPktRecv(inMsg);
+            break;
         default:
             errCode = -E_NOT_SUPPORT;
     }
@@ -350,6 +358,7 @@ void SingleVerSyncStateMachine::InitStateMapping()
     stateMapping_[START_PASSIVE_DATA_SYNC] =
         std::bind(&SingleVerSyncStateMachine::DoPassiveDataSyncWithSlidingWindow, this);
     stateMapping_[SYNC_CONTROL_CMD] = std::bind(&SingleVerSyncStateMachine::DoInitiactiveControlSync, this);
+    stateMapping_[DIGEST_SYNC] = std::bind(&SingleVerSyncStateMachine::DoDigestSync, this);
 }
 
 Event SingleVerSyncStateMachine::DoInitiactiveDataSyncWithSlidingWindow()
@@ -425,6 +434,23 @@ Event SingleVerSyncStateMachine::DoInitiactiveControlSync()
     return TransformErrCodeToEvent(errCode);
 }
 
+Event SingleVerSyncStateMachine::DoDigestSync()
+{
+    context_->SetDigestMatchedBuckets({}, 0);
+    if (!dataSync_->IsNeedDigestSync(context_)) {
+        return Event::DIGEST_SYNC_FINISHED_EVENT;
+    }
+    LOGD("[StateMachine][DigestSync] start digest sync,label=%s,dev=%s", dataSync_->GetLabel().c_str(),
+        STR_MASK(context_->GetDeviceId()));
+    int errCode = dataSync_->DigestSyncStart(context_);
+    if (errCode != E_OK) {
+        // push all the data as usual
+        LOGW("[StateMachine][DigestSync] digest sync start failed,errCode=%d", errCode);
+        return Event::DIGEST_SYNC_FINISHED_EVENT;
+    }
+    return Event::WAIT_ACK_EVENT;
+}
+
 int SingleVerSyncStateMachine::HandleControlAckRecv(const Message *inMsg)
 {
     std::lock_guard<std::mutex> lock(stateMachineLock_);
@@ -456,13 +482,20 @@ Event SingleVerSyncStateMachine::DoWaitForDataRecv() const
 Event SingleVerSyncStateMachine::DoTimeSync()
 {
     if (timeSync_->IsNeedSync()) {
+        int errCode = ShareTimeOffset();
+        if (errCode == E_OK) {
+            return Event::TIME_SYNC_FINISHED_EVENT;
+        }
+        if (errCode == -E_BUSY) {
+            return Event::WAIT_ACK_EVENT;
+        }
         CommErrHandler handler = nullptr;
         // Auto sync need do retry don't use errHandler to return.
         if (!context_->IsAutoSync()) {
             handler = std::bind(&SyncTaskContext::CommErrHandlerFunc, std::placeholders::_1,
                 context_, context_->GetRequestSessionId());
         }
-        int errCode = timeSync_->SyncStart(handler, context_->GetRequestSessionId());
+        errCode = timeSync_->SyncStart(handler, context_->GetRequestSessionId());
         if (errCode == E_OK) {
             return Event::WAIT_ACK_EVENT;
         }
@@ -473,6 +506,35 @@ Event SingleVerSyncStateMachine::DoTimeSync()
     return Event::TIME_SYNC_FINISHED_EVENT;
 }
 
+int SingleVerSyncStateMachine::ShareTimeOffset()
+{
+    // Incref to make sure context still alive before the waiter called.
+    RefObject::IncObjRef(context_);
+    int errCode = timeSync_->ShareTimeOffset([this](bool) {
+        int ret = RuntimeContext::GetInstance()->ScheduleTask([this]() {
+            if (context_->IncUsedCount() == E_OK) {
+                {
+                    std::lock_guard<std::mutex> lock(stateMachineLock_);
+                    // use the result or sync by itself if the other store failed
+                    if (currentState_ == State::TIME_SYNC) {
+                        SyncStepInner();
+                    }
+                }
+                context_->SafeExit();
+            }
+            RefObject::DecObjRef(context_);
+        });
+        if (ret != E_OK) {
+            LOGE("[StateMachine][ShareTimeOffset] ScheduleTask failed errCode %d", ret);
+            RefObject::DecObjRef(context_);
+        }
+    });
+    if (errCode != -E_BUSY) {
+        RefObject::DecObjRef(context_);
+    }
+    return errCode;
+}
+
 Event SingleVerSyncStateMachine::DoAbilitySync()
 {
     uint16_t remoteCommunicatorVersion = 0;
@@ -825,6 +887,15 @@ void SingleVerSyncStateMachine::StepToTimeout(TimerId timerId)
     if (timer != timerId) {
         return;
     }
+    if (currentState_ == State::DIGEST_SYNC) {
+        // the digest is only an optimization, push all the data as usual if the remote device not answered
+        LOGW("[StateMachine][StepToTimeout] digest ack timeout, push all the data,label=%s,dev=%s",
+            dataSync_->GetLabel().c_str(), STR_MASK(context_->GetDeviceId()));
+        context_->SetDigestMatchedBuckets({}, 0);
+        (void)ResetWatchDog();
+        SwitchStateAndStep(Event::DIGEST_SYNC_FINISHED_EVENT);
+        return;
+    }
     SwitchStateAndStep(Event::TIME_OUT_EVENT);
 }
 
@@ -891,6 +962,29 @@ void SingleVerSyncStateMachine::Clear()
     syncInterface_ = nullptr;
 }
 
+int SingleVerSyncStateMachine::DigestPktRecv(Message *inMsg)
+{
+    if (inMsg->GetMessageType() == TYPE_REQUEST) {
+        return dataSync_->DigestRequestRecv(context_, inMsg);
+    }
+    if (inMsg->GetMessageType() != TYPE_RESPONSE) {
+        return -E_INVALID_ARGS;
+    }
+    std::lock_guard<std::mutex> lock(stateMachineLock_);
+    if (currentState_ != State::DIGEST_SYNC) {
+        LOGW("[StateMachine][DigestPktRecv] digest ack not expected,state=%" PRIu8, currentState_);
+        return E_OK;
+    }
+    (void)ResetWatchDog();
+    // the data is pushed as usual if the digest is not compared
+    int errCode = dataSync_->DigestAckRecv(context_, inMsg);
+    if (errCode != E_OK) {
+        LOGW("[StateMachine][DigestPktRecv] digest ack handle failed,errCode=%d", errCode);
+    }
+    SwitchStateAndStep(Event::DIGEST_SYNC_FINISHED_EVENT);
+    return E_OK;
+}
+
 bool SingleVerSyncStateMachine::IsPacketValid(const Message *inMsg) const
 {
     if (inMsg == nullptr) {
@@ -903,7 +997,8 @@ bool SingleVerSyncStateMachine::IsPacketValid(const Message *inMsg) const
     }
     // filter invalid ack at first
     bool isResponseType = (inMsg->GetMessageType() == TYPE_RESPONSE);
-    if (isResponseType && (inMsg->GetMessageId() == CONTROL_SYNC_MESSAGE) &&
+    if (isResponseType && (inMsg->GetMessageId() == CONTROL_SYNC_MESSAGE ||
+        inMsg->GetMessageId() == DIGEST_SYNC_MESSAGE) &&
         (inMsg->GetSessionId() != context_->GetRequestSessionId())) {
         LOGE("[StateMachine][IsPacketValid] Control Message is invalid, label=%s, dev=%s",
             dataSync_->GetLabel().c_str(), STR_MASK(context_->GetDeviceId()));
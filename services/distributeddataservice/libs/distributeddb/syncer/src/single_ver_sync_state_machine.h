@@ -45,7 +45,8 @@ public:
         INNER_ERR,
         START_INITIACTIVE_DATA_SYNC, // used to do sync started by local device, use sliding window
         START_PASSIVE_DATA_SYNC, // used to do pull response, use sliding window
-        SYNC_CONTROL_CMD // used to send control cmd.
+        SYNC_CONTROL_CMD, // used to send control cmd.
+        DIGEST_SYNC // used to compare the sync digest before push, skip the data already same on the remote device
     };
 
     enum Event {
@@ -66,6 +67,7 @@ public:
         WAIT_TIME_OUT_EVENT,
         RE_SEND_DATA_EVENT,
         CONTROL_CMD_EVENT,
+        DIGEST_SYNC_FINISHED_EVENT,
         ANY_EVENT
     };
     SingleVerSyncStateMachine();
@@ -139,6 +141,9 @@ private:
     // Do TimeSync, for first sync
     Event DoTimeSync();
 
+    // Use the time offset synced by another store, if it is syncing, step on after it finished.
+    int ShareTimeOffset();
+
     // Do AbilitySync, for first sync
     Event DoAbilitySync();
 
@@ -160,6 +165,8 @@ private:
 
     Event DoInitiactiveControlSync();
 
+    Event DoDigestSync();
+
     Event GetEventAfterTimeSync(int mode) const;
 
     int HandleControlAckRecv(const Message *inMsg);
@@ -174,6 +181,8 @@ private:
 
     int ControlPktRecv(Message *inMsg);
 
+    int DigestPktRecv(Message *inMsg);
+
     void NeedAbilitySyncHandle();
 
     int HandleDataAckRecv(const Message *inMsg);
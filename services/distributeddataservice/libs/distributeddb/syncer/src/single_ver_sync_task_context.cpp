@@ -212,6 +212,7 @@ void SingleVerSyncTaskContext::Clear()
     SetResponseSessionId(0);
     query_ = QuerySyncObject();
     isQuerySync_ = false;
+    SetDigestMatchedBuckets({}, 0);
 }
 
 void SingleVerSyncTaskContext::Abort(int status)
@@ -475,6 +476,24 @@ std::shared_ptr<SubscribeManager> SingleVerSyncTaskContext::GetSubscribeManager(
 {
     return subManager_;
 }
+
+void SingleVerSyncTaskContext::SetDigestMatchedBuckets(const std::vector<bool> &matchedBuckets,
+    Timestamp digestTimestamp)
+{
+    digestMatchedBuckets_ = matchedBuckets;
+    digestTimestamp_ = digestTimestamp;
+}
+
+bool SingleVerSyncTaskContext::IsDigestMatched(uint32_t bucket, Timestamp timestamp) const
+{
+    return bucket < digestMatchedBuckets_.size() && digestMatchedBuckets_[bucket] && timestamp <= digestTimestamp_;
+}
+
+bool SingleVerSyncTaskContext::HasDigestMatchedBuckets() const
+{
+    return !digestMatchedBuckets_.empty();
+}
+
 DEFINE_OBJECT_TAG_FACILITIES(SingleVerSyncTaskContext)
 
 bool SingleVerSyncTaskContext::IsCurrentSyncTaskCanBeSkipped() const
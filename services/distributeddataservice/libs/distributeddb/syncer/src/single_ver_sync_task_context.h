@@ -133,6 +133,11 @@ public:
     void SetSubscribeManager(std::shared_ptr<SubscribeManager> &subManager);
     std::shared_ptr<SubscribeManager> GetSubscribeManager() const;
 
+    // The buckets same on the remote device by the digest sync, the data not later than the timestamp is skipped.
+    void SetDigestMatchedBuckets(const std::vector<bool> &matchedBuckets, Timestamp digestTimestamp);
+    bool IsDigestMatched(uint32_t bucket, Timestamp timestamp) const;
+    bool HasDigestMatchedBuckets() const;
+
     void SaveLastPushTaskExecStatus(int finalStatus) override;
     void ResetLastPushTaskStatus() override;
 
@@ -171,6 +176,10 @@ private:
     // For subscribe manager
     std::shared_ptr<SubscribeManager> subManager_;
 
+    // For skipping the data already same on the remote device
+    std::vector<bool> digestMatchedBuckets_;
+    Timestamp digestTimestamp_ = 0;
+
     // for merge sync task
     int lastFullSyncTaskStatus_ = SyncOperation::Status::OP_WAITING;
     // <queryId, lastExcuStatus>
@@ -18,12 +18,14 @@ const AbilityItem SyncConfig::DATABASE_COMPRESSION_ZLIB = {0, 1};
 const AbilityItem SyncConfig::ALLPREDICATEQUERY = {1, 1}; // 0b10 {1: start at second bit, 1: 1 bit len}
 const AbilityItem SyncConfig::SUBSCRIBEQUERY = {2, 1}; //   0b100
 const AbilityItem SyncConfig::INKEYS_QUERY = {3, 1}; //    0b1000
+const AbilityItem SyncConfig::DIGEST_SYNC = {4, 1}; //     0b10000
 
 const std::vector<AbilityItem> SyncConfig::ABILITYBITS = {
     DATABASE_COMPRESSION_ZLIB,
     ALLPREDICATEQUERY,
     SUBSCRIBEQUERY,
-    INKEYS_QUERY};
+    INKEYS_QUERY,
+    DIGEST_SYNC};
 
 const std::map<const uint8_t, const AbilityItem> SyncConfig::COMPRESSALGOMAP = {
     {static_cast<uint8_t>(CompressAlgorithm::ZLIB), DATABASE_COMPRESSION_ZLIB},
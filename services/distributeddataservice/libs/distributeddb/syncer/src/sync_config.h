@@ -30,8 +30,8 @@ using AbilityItem = std::pair<uint32_t, uint32_t>;
 /*
 if need to add new ability, just add append to the last ability
 current ability format:
-|first bit|second bit|third bit|
-|DATABASE_COMPRESSION_ZLIB|ALLPREDICATEQUERY|SUBSCRIBEQUERY|
+|first bit|second bit|third bit|fourth bit|fifth bit|
+|DATABASE_COMPRESSION_ZLIB|ALLPREDICATEQUERY|SUBSCRIBEQUERY|INKEYS_QUERY|DIGEST_SYNC|
 */
 class SyncConfig final {
 public:
@@ -39,8 +39,9 @@ public:
     static const AbilityItem ALLPREDICATEQUERY;
     static const AbilityItem SUBSCRIBEQUERY;
     static const AbilityItem INKEYS_QUERY;
+    static const AbilityItem DIGEST_SYNC;
     static const std::vector<AbilityItem> ABILITYBITS;
     static const std::map<const uint8_t, const AbilityItem> COMPRESSALGOMAP;
 };
 }
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
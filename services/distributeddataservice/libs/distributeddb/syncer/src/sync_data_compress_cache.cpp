@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sync_data_compress_cache.h"
+
+namespace DistributedDB {
+bool SyncDataCompressCache::Get(const std::vector<SingleVerKvEntry *> &entries, const CompressInfo &compressInfo,
+    std::vector<uint8_t> &compressedEntries) const
+{
+    if (entries.empty()) {
+        return false;
+    }
+    std::shared_ptr<const std::vector<uint8_t>> cachedData;
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        auto now = std::chrono::steady_clock::now();
+        for (const auto &packet : packets_) {
+            if (packet.compressInfo.compressAlgo == compressInfo.compressAlgo &&
+                packet.compressInfo.targetVersion == compressInfo.targetVersion &&
+                now - packet.compressTime < VALID_TIME && IsSameEntries(packet.tags, entries)) {
+                cachedData = packet.compressedEntries;
+                hitCount_++;
+                break;
+            }
+        }
+    }
+    if (cachedData == nullptr) {
+        return false;
+    }
+    compressedEntries = *cachedData;
+    return true;
+}
+
+void SyncDataCompressCache::Put(const std::vector<SingleVerKvEntry *> &entries, const CompressInfo &compressInfo,
+    const std::vector<uint8_t> &compressedEntries)
+{
+    if (entries.empty()) {
+        return;
+    }
+    CachedPacket packet { compressInfo, {}, std::chrono::steady_clock::now(),
+        std::make_shared<const std::vector<uint8_t>>(compressedEntries) };
+    packet.tags.reserve(entries.size());
+    for (const auto &entry : entries) {
+        packet.tags.push_back({ entry->GetKey(), entry->GetTimestamp(), entry->GetFlag() });
+    }
+    std::lock_guard<std::mutex> lock(lock_);
+    buildCount_++;
+    auto now = packet.compressTime;
+    packets_.remove_if([now](const CachedPacket &cached) {
+        return now - cached.compressTime >= VALID_TIME;
+    });
+    if (packets_.size() >= MAX_CACHED_PACKETS) {
+        packets_.pop_front();
+    }
+    packets_.push_back(std::move(packet));
+}
+
+void SyncDataCompressCache::GetMetrics(uint64_t &buildCount, uint64_t &hitCount) const
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    buildCount = buildCount_;
+    hitCount = hitCount_;
+}
+
+bool SyncDataCompressCache::IsSameEntries(const std::vector<EntryTag> &tags,
+    const std::vector<SingleVerKvEntry *> &entries)
+{
+    if (tags.size() != entries.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < tags.size(); i++) {
+        if (tags[i].timestamp != entries[i]->GetTimestamp() || tags[i].flag != entries[i]->GetFlag() ||
+            tags[i].key != entries[i]->GetKey()) {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace DistributedDB
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SYNC_DATA_COMPRESS_CACHE_H
+#define SYNC_DATA_COMPRESS_CACHE_H
+
+#include <chrono>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "generic_single_ver_kv_entry.h"
+#include "macro_utils.h"
+
+namespace DistributedDB {
+// Keeps the recent compressed packets of one store, the sync tasks sending the same entries to different devices
+// compress them once. The entries are identified by the key, timestamp and flag of each record, so the cache must
+// not be used when the data is changed for each device by the push data interceptor.
+class SyncDataCompressCache final {
+public:
+    SyncDataCompressCache() = default;
+    ~SyncDataCompressCache() = default;
+    DISABLE_COPY_ASSIGN_MOVE(SyncDataCompressCache);
+
+    // Return true and copy out the compressed data if the same entries were compressed with the same info.
+    bool Get(const std::vector<SingleVerKvEntry *> &entries, const CompressInfo &compressInfo,
+        std::vector<uint8_t> &compressedEntries) const;
+
+    void Put(const std::vector<SingleVerKvEntry *> &entries, const CompressInfo &compressInfo,
+        const std::vector<uint8_t> &compressedEntries);
+
+    // buildCount is the compressed packets put, hitCount is the packets copied from the cache.
+    void GetMetrics(uint64_t &buildCount, uint64_t &hitCount) const;
+
+private:
+    struct EntryTag {
+        Key key;
+        Timestamp timestamp = 0;
+        uint64_t flag = 0;
+    };
+    struct CachedPacket {
+        CompressInfo compressInfo;
+        std::vector<EntryTag> tags;
+        std::chrono::steady_clock::time_point compressTime;
+        std::shared_ptr<const std::vector<uint8_t>> compressedEntries;
+    };
+
+    static bool IsSameEntries(const std::vector<EntryTag> &tags, const std::vector<SingleVerKvEntry *> &entries);
+
+    static constexpr size_t MAX_CACHED_PACKETS = 8;
+    static constexpr auto VALID_TIME = std::chrono::seconds(1);
+
+    mutable std::mutex lock_;
+    std::list<CachedPacket> packets_;
+    uint64_t buildCount_ = 0;
+    mutable uint64_t hitCount_ = 0;
+};
+} // namespace DistributedDB
+#endif // SYNC_DATA_COMPRESS_CACHE_H
@@ -16,7 +16,6 @@
 #include "sync_engine.h"
 
 #include <algorithm>
-#include <deque>
 #include <functional>
 
 #include "ability_sync.h"
@@ -27,6 +26,8 @@
 #include "isync_state_machine.h"
 #include "log_print.h"
 #include "runtime_context.h"
+#include "serial_buffer_pool.h"
+#include "shared_time_sync.h"
 #include "single_ver_serialize_manager.h"
 #include "subscribe_manager.h"
 #include "time_sync.h"
@@ -52,13 +53,16 @@ SyncEngine::SyncEngine()
       execTaskCount_(0),
       isSyncRetry_(false),
       communicatorProxy_(nullptr),
-      isActive_(false)
+      isActive_(false),
+      bufferPoolShare_(DEFAULT_CACHE_SIZE)
 {
+    SerialBufferPool::GetInstance()->AddMemoryShare(bufferPoolShare_);
 }
 
 SyncEngine::~SyncEngine()
 {
     LOGD("[SyncEngine] ~SyncEngine!");
+    SerialBufferPool::GetInstance()->RemoveMemoryShare(bufferPoolShare_);
     ClearInnerResource();
     equalIdentifierMap_.clear();
     subManager_ = nullptr;
@@ -134,15 +138,8 @@ int SyncEngine::Close()
 
     ReleaseCommunicators();
     std::lock_guard<std::mutex> msgLock(queueLock_);
-    while (!msgQueue_.empty()) {
-        Message *inMsg = msgQueue_.front();
-        msgQueue_.pop_front();
-        if (inMsg != nullptr) {
-            queueCacheSize_ -= GetMsgSize(inMsg);
-            delete inMsg;
-            inMsg = nullptr;
-        }
-    }
+    queueCacheSize_ -= msgQueue_.CacheSize();
+    msgQueue_.Clear();
     // close db, rekey or import scene, need clear all remote query info
     // local query info will destroy with syncEngine destruct
     if (subManager_ != nullptr) {
@@ -369,12 +366,12 @@ int SyncEngine::DealMsgUtilQueueEmpty()
     Message *inMsg = nullptr;
     {
         std::lock_guard<std::mutex> lock(queueLock_);
-        if (msgQueue_.empty()) {
+        int msgSize = 0;
+        inMsg = msgQueue_.Pop(msgSize);
+        if (inMsg == nullptr) {
             return errCode;
         }
-        inMsg = msgQueue_.front();
-        msgQueue_.pop_front();
-        queueCacheSize_ -= GetMsgSize(inMsg);
+        queueCacheSize_ -= msgSize;
     }
 
     // it will deal with the first message in queue, we should increase object reference counts and sure that resources
@@ -483,7 +480,12 @@ int SyncEngine::MessageReciveCallbackInner(const std::string &targetDev, Message
 
     {
         std::lock_guard<std::mutex> lock(queueLock_);
-        if ((queueCacheSize_ + msgSize) > maxQueueCacheSize_) {
+        int cacheLimit = maxQueueCacheSize_;
+        if (SyncMessageQueue::IsPriorityMessage(inMsg)) {
+            // The acks and control messages are small, they still come in when the data fills up the cache
+            cacheLimit += maxQueueCacheSize_ / PRIORITY_CACHE_RESERVE_RATIO;
+        }
+        if ((queueCacheSize_ + msgSize) > cacheLimit) {
             LOGE("[SyncEngine] The size of message queue is beyond maximum");
             discardMsgNum_++;
             return -E_BUSY;
@@ -507,21 +509,15 @@ int SyncEngine::MessageReciveCallbackInner(const std::string &targetDev, Message
 
 void SyncEngine::PutMsgIntoQueue(const std::string &targetDev, Message *inMsg, int msgSize)
 {
-    if (inMsg->GetMessageId() == LOCAL_DATA_CHANGED) {
-        auto iter = std::find_if(msgQueue_.begin(), msgQueue_.end(),
-            [&targetDev](const Message *msg) {
-                return targetDev == msg->GetTarget() && msg->GetMessageId() == LOCAL_DATA_CHANGED;
-            });
-        if (iter != msgQueue_.end()) {
-            delete inMsg;
-            inMsg = nullptr;
-            return;
-        }
-    }
     inMsg->SetTarget(targetDev);
-    msgQueue_.push_back(inMsg);
+    if (!msgQueue_.Push(inMsg, msgSize)) {
+        LOGD("[SyncEngine] Same message is in queue, msgId = %u", inMsg->GetMessageId());
+        delete inMsg;
+        inMsg = nullptr;
+        return;
+    }
     queueCacheSize_ += msgSize;
-    LOGE("[SyncEngine] The quantity of executing threads is beyond maximum. msgQueueSize = %zu", msgQueue_.size());
+    LOGE("[SyncEngine] The quantity of executing threads is beyond maximum. msgQueueSize = %zu", msgQueue_.Size());
 }
 
 int SyncEngine::GetMsgSize(const Message *inMsg) const
@@ -534,6 +530,7 @@ int SyncEngine::GetMsgSize(const Message *inMsg) const
         case DATA_SYNC_MESSAGE:
         case QUERY_SYNC_MESSAGE:
         case CONTROL_SYNC_MESSAGE:
+        case DIGEST_SYNC_MESSAGE:
             return SingleVerSerializeManager::CalculateLen(inMsg);
 #ifndef OMIT_MULTI_VER
         case COMMIT_HISTORY_SYNC_MESSAGE:
@@ -662,6 +659,13 @@ unsigned int SyncEngine::GetMaxExecNum() const
 void SyncEngine::SetMaxQueueCacheSize(int value)
 {
     maxQueueCacheSize_ = value;
+    if (value > 0) {
+        // The frame buffers of the communicator are bounded by the queue cache of all the engines, add the new share
+        // first so that the limits not drop in between
+        uint64_t oldShare = bufferPoolShare_.exchange(static_cast<uint64_t>(value));
+        SerialBufferPool::GetInstance()->AddMemoryShare(static_cast<uint64_t>(value));
+        SerialBufferPool::GetInstance()->RemoveMemoryShare(oldShare);
+    }
 }
 
 uint8_t SyncEngine::GetPermissionCheckFlag(bool isAutoSync, int syncMode)
@@ -809,6 +813,9 @@ void SyncEngine::OfflineHandleByDevice(const std::string &deviceId)
     }
     // means device is offline, clear local subscribe
     subManager_->ClearLocalSubscribeQuery(deviceId);
+    // the time of the device may be changed before online again
+    std::string userId = syncInterface_->GetDbProperties().GetStringProp(KvDBProperties::USER_ID, "");
+    SharedTimeSync::GetInstance()->Invalidate(SharedTimeSync::GetDeviceKey(userId, deviceId));
     // clear sync task
     if (context != nullptr) {
         context->ClearAllSyncTask();
@@ -25,6 +25,7 @@
 #include "isync_engine.h"
 #include "isync_task_context.h"
 #include "subscribe_manager.h"
+#include "sync_message_queue.h"
 #include "task_pool.h"
 
 namespace DistributedDB {
@@ -194,7 +195,7 @@ private:
     std::function<void(const std::string &)> onRemoteDataChanged_;
     std::function<void(const std::string &)> offlineChanged_;
     std::shared_ptr<Metadata> metadata_;
-    std::deque<Message *> msgQueue_;
+    SyncMessageQueue msgQueue_;
     NotificationChain::Listener *timeChangedListener_;
     uint32_t execTaskCount_;
     std::string label_;
@@ -208,8 +209,10 @@ private:
     static unsigned int discardMsgNum_;
     static const unsigned int MAX_EXEC_NUM = 7; // Set the maximum of threads as 6 < 7
     static constexpr int DEFAULT_CACHE_SIZE = 160 * 1024 * 1024; // Initial the default cache size of queue as 160MB
+    static constexpr int PRIORITY_CACHE_RESERVE_RATIO = 16; // The priority messages may exceed the cache by a 16th
     static std::mutex queueLock_;
     std::atomic<bool> isActive_;
+    std::atomic<uint64_t> bufferPoolShare_; // The memory share of this engine in SerialBufferPool
 
     // key: device value: equalIdentifier
     std::map<std::string, std::string> equalIdentifierMap_;
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sync_message_queue.h"
+
+#include <algorithm>
+
+#include "sync_types.h"
+
+namespace DistributedDB {
+SyncMessageQueue::~SyncMessageQueue()
+{
+    Clear();
+}
+
+bool SyncMessageQueue::Push(Message *inMsg, int msgSize)
+{
+    if (inMsg == nullptr) {
+        return false;
+    }
+    Level level = IsPriorityMessage(inMsg) ? PRIORITY : NORMAL;
+    DeviceQueue &deviceQueue = deviceQueues_[inMsg->GetTarget()];
+    std::deque<QueuedMessage> &messages = deviceQueue.messages[level];
+    auto iter = std::find_if(messages.begin(), messages.end(), [inMsg](const QueuedMessage &queued) {
+        return IsSameMessage(queued.msg, inMsg);
+    });
+    if (iter != messages.end()) {
+        return false;
+    }
+    if (messages.empty()) {
+        turns_[level].push_back(inMsg->GetTarget());
+    }
+    messages.push_back({inMsg, msgSize});
+    size_++;
+    cacheSize_ += msgSize;
+    return true;
+}
+
+Message *SyncMessageQueue::Pop(int &msgSize)
+{
+    for (int level = PRIORITY; level < LEVEL_NUM; level++) {
+        if (turns_[level].empty()) {
+            continue;
+        }
+        std::string device = turns_[level].front();
+        turns_[level].pop_front();
+        auto deviceIter = deviceQueues_.find(device);
+        if (deviceIter == deviceQueues_.end() || deviceIter->second.messages[level].empty()) {
+            continue;
+        }
+        std::deque<QueuedMessage> &messages = deviceIter->second.messages[level];
+        QueuedMessage queued = messages.front();
+        messages.pop_front();
+        if (!messages.empty()) {
+            turns_[level].push_back(device); // The device waits for its next turn behind the others
+        } else if (std::all_of(std::begin(deviceIter->second.messages), std::end(deviceIter->second.messages),
+            [](const std::deque<QueuedMessage> &queue) { return queue.empty(); })) {
+            deviceQueues_.erase(deviceIter);
+        }
+        size_--;
+        cacheSize_ -= queued.size;
+        msgSize = queued.size;
+        return queued.msg;
+    }
+    msgSize = 0;
+    return nullptr;
+}
+
+bool SyncMessageQueue::Empty() const
+{
+    return size_ == 0;
+}
+
+size_t SyncMessageQueue::Size() const
+{
+    return size_;
+}
+
+int SyncMessageQueue::CacheSize() const
+{
+    return cacheSize_;
+}
+
+void SyncMessageQueue::Clear()
+{
+    for (auto &[device, deviceQueue] : deviceQueues_) {
+        (void)device;
+        for (auto &messages : deviceQueue.messages) {
+            for (auto &queued : messages) {
+                delete queued.msg;
+                queued.msg = nullptr;
+            }
+        }
+    }
+    deviceQueues_.clear();
+    for (auto &turn : turns_) {
+        turn.clear();
+    }
+    size_ = 0;
+    cacheSize_ = 0;
+}
+
+bool SyncMessageQueue::IsPriorityMessage(const Message *inMsg)
+{
+    if (inMsg->GetMessageType() == TYPE_RESPONSE) {
+        return true;
+    }
+    uint32_t messageId = inMsg->GetMessageId();
+    return messageId == TIME_SYNC_MESSAGE || messageId == ABILITY_SYNC_MESSAGE || messageId == CONTROL_SYNC_MESSAGE;
+}
+
+bool SyncMessageQueue::IsSameMessage(const Message *left, const Message *right)
+{
+    if (left->GetMessageId() != right->GetMessageId()) {
+        return false;
+    }
+    if (left->GetMessageId() == LOCAL_DATA_CHANGED) {
+        return true; // The remote data is got once for all the notifies not handled yet
+    }
+    // The session id is zero if the message is not in a session, such messages are never the same
+    return left->GetSessionId() != 0 && left->GetMessageType() == right->GetMessageType() &&
+        left->GetSessionId() == right->GetSessionId() && left->GetSequenceId() == right->GetSequenceId();
+}
+} // namespace DistributedDB
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SYNC_MESSAGE_QUEUE_H
+#define SYNC_MESSAGE_QUEUE_H
+
+#include <deque>
+#include <map>
+#include <string>
+
+#include "macro_utils.h"
+#include "message.h"
+
+namespace DistributedDB {
+// The inbound messages waiting for a handler task of the sync engine. Each device has its own queue of each level, the
+// acks, control and time sync messages are taken before the data. The devices take turns within the same level, so
+// one busy device not hold the others back. A retransmit of a queued message is collapsed into it.
+// Not thread safe, the sync engine guards it by its queue lock.
+class SyncMessageQueue final {
+public:
+    SyncMessageQueue() = default;
+    ~SyncMessageQueue();
+    DISABLE_COPY_ASSIGN_MOVE(SyncMessageQueue);
+
+    // Return false if the message is the same as a queued one, the caller still owns and should release it.
+    bool Push(Message *inMsg, int msgSize);
+
+    // Return nullptr if the queue is empty, msgSize is the size given when pushed.
+    Message *Pop(int &msgSize);
+
+    bool Empty() const;
+    size_t Size() const;
+    // The size of all the queued messages
+    int CacheSize() const;
+
+    // Release all the queued messages
+    void Clear();
+
+    // The messages which is small and unblock the remote, they are taken first and may use the reserved cache
+    static bool IsPriorityMessage(const Message *inMsg);
+
+private:
+    enum Level : int {
+        PRIORITY = 0,
+        NORMAL,
+        LEVEL_NUM,
+    };
+    struct QueuedMessage {
+        Message *msg = nullptr;
+        int size = 0;
+    };
+    struct DeviceQueue {
+        std::deque<QueuedMessage> messages[LEVEL_NUM];
+    };
+
+    static bool IsSameMessage(const Message *left, const Message *right);
+
+    std::map<std::string, DeviceQueue> deviceQueues_;
+    std::deque<std::string> turns_[LEVEL_NUM]; // The devices have messages of the level, in the order to take
+    size_t size_ = 0;
+    int cacheSize_ = 0;
+};
+} // namespace DistributedDB
+#endif // SYNC_MESSAGE_QUEUE_H
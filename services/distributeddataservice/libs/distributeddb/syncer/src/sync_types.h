@@ -31,6 +31,7 @@ enum MessageId {
     ABILITY_SYNC_MESSAGE,
     QUERY_SYNC_MESSAGE,
     CONTROL_SYNC_MESSAGE,
+    DIGEST_SYNC_MESSAGE,
     UNKNOW_MESSAGE,
 };
 
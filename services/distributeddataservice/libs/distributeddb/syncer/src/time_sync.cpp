@@ -125,6 +125,7 @@ TimeSync::~TimeSync()
 {
     Finalize();
     driverTimerId_ = 0;
+    SharedTimeSync::GetInstance()->AbortSync(sharedKey_, this);
 
     if (timeChangedListener_ != nullptr) {
         timeChangedListener_->Drop(true);
@@ -162,6 +163,8 @@ int TimeSync::Initialize(ICommunicator *communicator, std::shared_ptr<Metadata>
     communicateHandle_ = communicator;
     metadata_ = metadata;
     deviceId_ = deviceId;
+    sharedKey_ = SharedTimeSync::GetDeviceKey(storage->GetDbProperties().GetStringProp(KvDBProperties::USER_ID, ""),
+        deviceId);
     timeHelper_ = std::make_unique<TimeHelper>();
 
     int errCode = timeHelper_->Initialize(storage, metadata_);
@@ -201,6 +204,7 @@ int TimeSync::SyncStart(const CommErrHandler &handler,  uint32_t sessionId)
 
     Message *message = new (std::nothrow) Message(TIME_SYNC_MESSAGE);
     if (message == nullptr) {
+        SharedTimeSync::GetInstance()->AbortSync(sharedKey_, this);
         return -E_OUT_OF_MEMORY;
     }
     message->SetSessionId(sessionId);
@@ -208,13 +212,16 @@ int TimeSync::SyncStart(const CommErrHandler &handler,  uint32_t sessionId)
     message->SetPriority(Priority::NORMAL);
     int errCode = message->SetCopiedObject<>(packet);
     if (errCode != E_OK) {
+        SharedTimeSync::GetInstance()->AbortSync(sharedKey_, this);
         delete message;
         message = nullptr;
         return errCode;
     }
 
+    SharedTimeSync::GetInstance()->StartSync(sharedKey_, this);
     errCode = SendPacket(deviceId_, message, handler);
     if (errCode != E_OK) {
+        SharedTimeSync::GetInstance()->AbortSync(sharedKey_, this);
         delete message;
         message = nullptr;
     }
@@ -337,6 +344,7 @@ int TimeSync::AckRecv(const Message *message, uint32_t targetSessionId)
         packetData.GetSourceTimeEnd() > TimeHelper::MAX_VALID_TIME ||
         packetData.GetTargetTimeEnd() > TimeHelper::MAX_VALID_TIME) {
         LOGD("[TimeSync][AckRecv] Time valid check failed.");
+        SharedTimeSync::GetInstance()->AbortSync(sharedKey_, this);
         return -E_INVALID_TIME;
     }
     // calculate timeoffset of two devices
@@ -352,6 +360,8 @@ int TimeSync::AckRecv(const Message *message, uint32_t targetSessionId)
 
     // save timeoffset into metadata, maybe a block action
     int errCode = SaveTimeOffset(deviceId_, offset);
+    // share the offset to the local system time, the local time offset differs between the stores.
+    SharedTimeSync::GetInstance()->FinishSync(sharedKey_, this, offset + timeHelper_->GetLocalTimeOffset());
     isSynced_ = true;
     {
         std::lock_guard<std::mutex> lock(cvLock_);
@@ -396,6 +406,7 @@ int TimeSync::RequestRecv(const Message *message)
         (std::abs(metadataTimeoffset - timeoffsetIgnoreRtt) > MAX_TIME_OFFSET_NOISE)) {
         LOGI("[TimeSync][RequestRecv] timeoffSet invalid, should do time sync");
         isSynced_ = false;
+        SharedTimeSync::GetInstance()->Invalidate(sharedKey_);
     }
 
     Message *ackMessage = new (std::nothrow) Message(TIME_SYNC_MESSAGE);
@@ -477,8 +488,11 @@ int TimeSync::TimeSyncDriver(TimerId timerId)
     }
     std::lock_guard<std::mutex> lock(timeDriverLock_);
     int errCode = RuntimeContext::GetInstance()->ScheduleTask([this]() {
-        CommErrHandler handler = std::bind(&TimeSync::CommErrHandlerFunc, std::placeholders::_1, this);
-        (void)this->SyncStart(handler);
+        // another store refreshed the time offset with the device recently, or it is refreshing now
+        if (this->ShareTimeOffset() == -E_NOT_FOUND) {
+            CommErrHandler handler = std::bind(&TimeSync::CommErrHandlerFunc, std::placeholders::_1, this);
+            (void)this->SyncStart(handler);
+        }
         std::lock_guard<std::mutex> innerLock(this->timeDriverLock_);
         this->timeDriverLockCount_--;
         this->timeDriverCond_.notify_all();
@@ -493,6 +507,10 @@ int TimeSync::TimeSyncDriver(TimerId timerId)
 
 int TimeSync::GetTimeOffset(TimeOffset &outOffset, uint32_t timeout, uint32_t sessionId)
 {
+    if (!isSynced_ && WaitSharedTimeOffset(timeout) == -E_TIMEOUT) {
+        LOGD("TimeSync::GetTimeOffset, wait for the shared time offset timeout");
+        return -E_TIMEOUT;
+    }
     if (!isSynced_) {
         {
             std::lock_guard<std::mutex> lock(cvLock_);
@@ -526,6 +544,50 @@ bool TimeSync::IsNeedSync() const
     return !isSynced_;
 }
 
+int TimeSync::ShareTimeOffset(const SharedTimeSync::Waiter &waiter)
+{
+    TimeOffset sharedOffset = 0;
+    int errCode = SharedTimeSync::GetInstance()->AcquireTimeOffset(sharedKey_, this, waiter, sharedOffset);
+    if (errCode != E_OK) {
+        return errCode;
+    }
+    TimeOffset offset = sharedOffset - timeHelper_->GetLocalTimeOffset();
+    errCode = SaveTimeOffset(deviceId_, offset);
+    if (errCode != E_OK) {
+        LOGE("[TimeSync] Save the shared time offset failed, errCode=%d", errCode);
+        return errCode;
+    }
+    LOGD("[TimeSync] Use the shared time offset, dev = %s{private}, offset = %" PRId64, deviceId_.c_str(), offset);
+    isSynced_ = true;
+    return E_OK;
+}
+
+int TimeSync::WaitSharedTimeOffset(uint32_t timeout)
+{
+    struct WaitResult {
+        std::mutex lock;
+        std::condition_variable condition;
+        bool isFinished = false;
+    };
+    auto result = std::make_shared<WaitResult>();
+    int errCode = ShareTimeOffset([result](bool) {
+        std::lock_guard<std::mutex> lock(result->lock);
+        result->isFinished = true;
+        result->condition.notify_all();
+    });
+    if (errCode != -E_BUSY) {
+        return errCode;
+    }
+    {
+        std::unique_lock<std::mutex> lock(result->lock);
+        if (!result->condition.wait_for(lock, std::chrono::milliseconds(timeout),
+            [result]() { return result->isFinished; })) {
+            return -E_TIMEOUT;
+        }
+    }
+    return ShareTimeOffset();
+}
+
 void TimeSync::SetOnline(bool isOnline)
 {
     isOnline_ = isOnline;
@@ -545,6 +607,7 @@ void TimeSync::CommErrHandlerFunc(int errCode, TimeSync *timeSync)
     }
     if (errCode != E_OK) {
         timeSync->SetOnline(false);
+        SharedTimeSync::GetInstance()->AbortSync(timeSync->sharedKey_, timeSync);
     } else {
         timeSync->SetOnline(true);
     }
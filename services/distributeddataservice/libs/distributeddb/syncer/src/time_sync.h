@@ -18,6 +18,7 @@
 
 #include "icommunicator.h"
 #include "meta_data.h"
+#include "shared_time_sync.h"
 #include "sync_task_context.h"
 #include "time_helper.h"
 
@@ -85,6 +86,10 @@ public:
 
     bool IsNeedSync() const;
 
+    // Use the time offset synced with the device by another store of the same user.
+    // E_OK: used; -E_BUSY: another store is syncing, the waiter is called when it finished; -E_NOT_FOUND: sync it.
+    int ShareTimeOffset(const SharedTimeSync::Waiter &waiter = nullptr);
+
     void SetOnline(bool isOnline);
 
     // Used in send msg, as execution is asynchronous, should use this function to handle result.
@@ -101,6 +106,8 @@ private:
 
     int SaveTimeOffset(const DeviceID &deviceID, TimeOffset timeOffset);
 
+    int WaitSharedTimeOffset(uint32_t timeout);
+
     int SendPacket(const DeviceID &deviceId, const Message *message, const CommErrHandler &handler = nullptr);
 
     int TimeSyncDriver(TimerId timerId);
@@ -111,6 +118,7 @@ private:
     std::shared_ptr<Metadata> metadata_;
     std::unique_ptr<TimeHelper> timeHelper_;
     DeviceID deviceId_;
+    std::string sharedKey_;
     int retryTime_;
     TimerId driverTimerId_;
     TimerAction driverCallback_;
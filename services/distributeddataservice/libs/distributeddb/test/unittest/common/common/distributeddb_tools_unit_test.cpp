@@ -15,10 +15,12 @@
 
 #include "distributeddb_tools_unit_test.h"
 
+#include <cstdlib>
 #include <cstring>
 #include <dirent.h>
 #include <fstream>
 #include <gtest/gtest.h>
+#include <iostream>
 #include <openssl/rand.h>
 #include <random>
 #include <set>
@@ -854,6 +856,26 @@ void DistributedDBToolsUnitTest::PrintTestCaseInfo()
     LOGI("Start unit test: %s.%s", testInfo->test_case_name(), testInfo->name());
 }
 
+uint64_t DistributedDBToolsUnitTest::GetEnvValue(const char *name, uint64_t defaultValue)
+{
+    const char *value = getenv(name);
+    if (value == nullptr) {
+        return defaultValue;
+    }
+    return strtoull(value, nullptr, 10); // 10 is decimal
+}
+
+void DistributedDBToolsUnitTest::PrintBenchmarkResult(const std::string &json, const char *outputEnv)
+{
+    std::cout << json << std::endl;
+    const char *output = (outputEnv == nullptr) ? nullptr : getenv(outputEnv);
+    if (output == nullptr) {
+        return;
+    }
+    std::ofstream file(output, std::ios::app);
+    file << json << std::endl;
+}
+
 int DistributedDBToolsUnitTest::BuildMessage(const DataSyncMessageInfo &messageInfo,
     DistributedDB::Message *&message)
 {
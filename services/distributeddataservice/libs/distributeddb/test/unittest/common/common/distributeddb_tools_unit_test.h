@@ -213,6 +213,12 @@ public:
 
     static void PrintTestCaseInfo();
 
+    // Read an unsigned decimal from the environment, return defaultValue if it is not set.
+    static uint64_t GetEnvValue(const char *name, uint64_t defaultValue);
+
+    // Print one json line of a benchmark result, and append it to the file named by outputEnv if it is set.
+    static void PrintBenchmarkResult(const std::string &json, const char *outputEnv);
+
     static int BuildMessage(const DataSyncMessageInfo &messageInfo, DistributedDB::Message *&message);
 
 private:
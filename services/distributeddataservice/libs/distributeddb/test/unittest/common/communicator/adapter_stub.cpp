@@ -17,6 +17,7 @@
 #include <memory>
 #include "db_errno.h"
 #include "endian_convert.h"
+#include "frame_checksum.h"
 #include "frame_header.h"
 #include "iprocess_communicator.h"
 #include "log_print.h"
@@ -102,6 +103,9 @@ int AdapterStub::SendBytes(const std::string &dstTarget, const uint8_t *bytes, u
     }
 
     ApplySendBitError(bytes, length);
+    if (length >= sizeof(CommPhyHeader)) {
+        lastSendVersion_ = NetToHost(reinterpret_cast<const CommPhyHeader *>(bytes)->version);
+    }
 
     AdapterStub *toAdapter = targetMapAdapter_[dstTarget];
     toAdapter->DeliverBytes(localTarget_, bytes, length);
@@ -356,18 +360,20 @@ bool AdapterStub::QuerySendTotalLoss()
     return isTotalLossSimulated_;
 }
 
+uint16_t AdapterStub::GetLastSendVersion() const
+{
+    return lastSendVersion_;
+}
+
 namespace {
-uint64_t CalculateXorSum(const uint8_t *bytes, uint32_t length)
+const uint16_t PROTOCOL_VERSION_CRC32C = 1;
+uint64_t CalculateSum(uint16_t version, const uint8_t *bytes, uint32_t length)
 {
-    if (length % sizeof(uint64_t) != 0) {
-        return 0;
+    if (version == PROTOCOL_VERSION_CRC32C) {
+        return FrameChecksum::CalculateCrc32c(bytes, length);
     }
-    int count = length / sizeof(uint64_t);
-    auto array = reinterpret_cast<const uint64_t *>(bytes);
     uint64_t outSum = 0;
-    for (int i = 0; i < count; i++) {
-        outSum ^= array[i];
-    }
+    (void)FrameChecksum::CalculateXorSum(bytes, length, outSum);
     return outSum;
 }
 const uint32_t LENGTH_BEFORE_SUM_RANGE = sizeof(uint64_t) + sizeof(uint64_t);
@@ -407,7 +413,7 @@ void AdapterStub::ApplySendBitError(const uint8_t *bytes, uint32_t length)
     auto msgHeader = reinterpret_cast<MessageHeader *>(edibleBytes);
     if (doChangeMessageIdFlag_) {
         msgHeader->messageId = HostToNet(messageIdField_);
-        phyHeader->checkSum = HostToNet(CalculateXorSum(bytes + LENGTH_BEFORE_SUM_RANGE,
+        phyHeader->checkSum = HostToNet(CalculateSum(NetToHost(phyHeader->version), bytes + LENGTH_BEFORE_SUM_RANGE,
             length - LENGTH_BEFORE_SUM_RANGE));
     }
 }
@@ -81,6 +81,9 @@ public:
     void SimulateSendBitErrorInPacketTypeField(bool doFlag, uint8_t inPacketType);
     void SimulateSendBitErrorInPaddingLenField(bool doFlag, uint8_t inPaddingLen);
     void SimulateSendBitErrorInMessageIdField(bool doFlag, uint32_t inMessageId);
+
+    // The version field of the last packet sent, which tells the checkSum used
+    uint16_t GetLastSendVersion() const;
 private:
     void Connect(AdapterStub *inStub);
     void Disconnect(AdapterStub *inStub);
@@ -116,6 +119,8 @@ private:
 
     std::atomic<bool> isTotalLossSimulated_{false};
 
+    std::atomic<uint16_t> lastSendVersion_{0};
+
     bool doChangeMagicFlag_ = false;
     bool doChangeVersionFlag_ = false;
     bool doChangeCheckSumFlag_ = false;
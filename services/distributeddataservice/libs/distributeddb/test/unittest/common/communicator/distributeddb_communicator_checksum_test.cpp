@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <gtest/gtest.h>
+#include <random>
+#include <thread>
+#include "db_errno.h"
+#include "distributeddb_communicator_common.h"
+#include "distributeddb_tools_unit_test.h"
+#include "frame_checksum.h"
+#include "hash.h"
+#include "log_print.h"
+#include "protocol_proto.h"
+#include "serial_buffer.h"
+
+using namespace std;
+using namespace testing::ext;
+using namespace DistributedDB;
+using namespace DistributedDBUnitTest;
+
+/*
+ * The benchmark case prints the throughput of the checksums as one json line, the size of the frame and the times
+ * to calculate are read from the environment:
+ *   DDB_CHECKSUM_BENCH_FRAME_SIZE   the bytes of the frame, default 4194304
+ *   DDB_CHECKSUM_BENCH_ROUNDS       default 100
+ *   DDB_CHECKSUM_BENCH_OUTPUT       the file to append the json line, optional
+ */
+namespace {
+    const string DEVICE_NAME = "DeviceA";
+    const uint32_t MAX_WORD_COUNT = 300;
+    const uint32_t MAX_OFFSET = 8;
+    const uint32_t LABEL_COUNT = 10;
+    const uint32_t TEST_MTU_SIZE = 128;
+    const uint32_t CRC32C_POLY = 0x82F63B78;
+    const uint32_t CRC32C_INIT = 0xFFFFFFFF;
+    const uint32_t BYTE_BITS = 8;
+
+    uint64_t RefXorSum(const uint8_t *bytes, uint32_t length)
+    {
+        uint64_t sum = 0;
+        for (uint32_t i = 0; i < length / sizeof(uint64_t); i++) {
+            uint64_t word = 0;
+            memcpy(&word, bytes + i * sizeof(uint64_t), sizeof(uint64_t));
+            sum ^= word;
+        }
+        return sum;
+    }
+
+    uint32_t RefCrc32c(const uint8_t *bytes, uint32_t length)
+    {
+        uint32_t crc = CRC32C_INIT;
+        for (uint32_t i = 0; i < length; i++) {
+            crc ^= bytes[i];
+            for (uint32_t bit = 0; bit < BYTE_BITS; bit++) {
+                crc = ((crc & 1) != 0) ? ((crc >> 1) ^ CRC32C_POLY) : (crc >> 1);
+            }
+        }
+        return crc ^ CRC32C_INIT;
+    }
+
+    vector<uint8_t> RandomBytes(uint32_t length)
+    {
+        static mt19937 generator(0); // fixed seed to reproduce
+        uniform_int_distribution<int> distribution(0, UINT8_MAX);
+        vector<uint8_t> bytes(length);
+        for (auto &byte : bytes) {
+            byte = static_cast<uint8_t>(distribution(generator));
+        }
+        return bytes;
+    }
+
+    SerialBuffer *BuildLabelExchangeFrame(bool isCrc32cSum)
+    {
+        set<LabelType> labels;
+        for (uint32_t i = 0; i < LABEL_COUNT; i++) {
+            labels.insert(LabelType(COMM_LABEL_LENGTH, static_cast<uint8_t>(i)));
+        }
+        int errCode = E_OK;
+        SerialBuffer *buffer = ProtocolProto::BuildLabelExchange(1, 1, labels, errCode);
+        if (errCode != E_OK) {
+            return nullptr;
+        }
+        PhyHeaderInfo info{Hash::HashFunc(DEVICE_NAME), 1, FrameType::COMMUNICATION_LABEL_EXCHANGE, isCrc32cSum};
+        errCode = ProtocolProto::SetPhyHeader(buffer, info);
+        if (errCode != E_OK) {
+            delete buffer;
+            return nullptr;
+        }
+        return buffer;
+    }
+}
+
+class DistributedDBCommunicatorChecksumTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {};
+    static void TearDownTestCase(void) {};
+    void SetUp();
+    void TearDown() {};
+};
+
+void DistributedDBCommunicatorChecksumTest::SetUp()
+{
+    DistributedDBToolsUnitTest::PrintTestCaseInfo();
+}
+
+/**
+ * @tc.name: XorSum001
+ * @tc.desc: Test the xor sum is the same as the word by word xor for all the length and address alignment.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author: xiaozhenjian
+ */
+HWTEST_F(DistributedDBCommunicatorChecksumTest, XorSum001, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. calculate the xor sum of the bytes at different offsets with different word count
+     * @tc.expected: step1. the sum equal to the word by word xor.
+     */
+    vector<uint8_t> bytes = RandomBytes(MAX_WORD_COUNT * sizeof(uint64_t) + MAX_OFFSET);
+    for (uint32_t offset = 0; offset < MAX_OFFSET; offset++) {
+        for (uint32_t count = 0; count <= MAX_WORD_COUNT; count++) {
+            uint32_t length = count * sizeof(uint64_t);
+            uint64_t sum = 0;
+            ASSERT_EQ(FrameChecksum::CalculateXorSum(bytes.data() + offset, length, sum), E_OK);
+            ASSERT_EQ(sum, RefXorSum(bytes.data() + offset, length));
+        }
+    }
+    /**
+     * @tc.steps: step2. calculate the xor sum with the length not multiple of eight
+     * @tc.expected: step2. return -E_LENGTH_ERROR.
+     */
+    uint64_t sum = 0;
+    EXPECT_EQ(FrameChecksum::CalculateXorSum(bytes.data(), sizeof(uint64_t) + 1, sum), -E_LENGTH_ERROR);
+}
+
+/**
+ * @tc.name: Crc32c001
+ * @tc.desc: Test the crc32c is the same as the bit by bit crc32c.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author: xiaozhenjian
+ */
+HWTEST_F(DistributedDBCommunicatorChecksumTest, Crc32c001, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. calculate the crc32c of the standard check string
+     * @tc.expected: step1. the crc32c is 0xE3069283.
+     */
+    const string checkString = "123456789";
+    EXPECT_EQ(FrameChecksum::CalculateCrc32c(reinterpret_cast<const uint8_t *>(checkString.c_str()),
+        checkString.size()), 0xE3069283u);
+    LOGI("[UT][Checksum] crc32c accelerated=%d.", FrameChecksum::IsCrc32cAccelerated());
+    /**
+     * @tc.steps: step2. calculate the crc32c of the bytes at different offsets with different length
+     * @tc.expected: step2. the crc32c equal to the bit by bit crc32c.
+     */
+    vector<uint8_t> bytes = RandomBytes(MAX_WORD_COUNT + MAX_OFFSET);
+    for (uint32_t offset = 0; offset < MAX_OFFSET; offset++) {
+        for (uint32_t length = 0; length <= MAX_WORD_COUNT; length++) {
+            ASSERT_EQ(FrameChecksum::CalculateCrc32c(bytes.data() + offset, length),
+                RefCrc32c(bytes.data() + offset, length));
+        }
+    }
+}
+
+/**
+ * @tc.name: FrameChecksum001
+ * @tc.desc: Test the packets with xor sum and crc32c checkSum are both accepted and the broken ones are rejected.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author: xiaozhenjian
+ */
+HWTEST_F(DistributedDBCommunicatorChecksumTest, FrameChecksum001, TestSize.Level1)
+{
+    for (bool isCrc32cSum : {false, true}) {
+        /**
+         * @tc.steps: step1. build a label exchange frame with xor sum or crc32c checkSum
+         * @tc.expected: step1. the frame is parsed, the crc32c support of local is carried by the frame.
+         */
+        SerialBuffer *buffer = BuildLabelExchangeFrame(isCrc32cSum);
+        ASSERT_NE(buffer, nullptr);
+        auto bytesLen = buffer->GetReadOnlyBytesForEntireBuffer();
+        vector<uint8_t> packet(bytesLen.first, bytesLen.first + bytesLen.second);
+        ParseResult result;
+        EXPECT_EQ(ProtocolProto::CheckAndParsePacket(DEVICE_NAME, packet.data(), packet.size(), result), E_OK);
+        EXPECT_EQ(result.IsCrc32cSupport(), ProtocolProto::IsCrc32cSumEnable());
+        EXPECT_EQ(result.GetLatestCommLabels().size(), LABEL_COUNT);
+        /**
+         * @tc.steps: step2. split the frame into fragments
+         * @tc.expected: step2. all the fragments are parsed.
+         */
+        vector<pair<vector<uint8_t>, uint32_t>> pieces;
+        ASSERT_EQ(ProtocolProto::SplitFrameIntoPacketsIfNeed(buffer, TEST_MTU_SIZE, pieces), E_OK);
+        EXPECT_GT(pieces.size(), 1u);
+        for (auto &piece : pieces) {
+            ParseResult pieceResult;
+            EXPECT_EQ(ProtocolProto::CheckAndParsePacket(DEVICE_NAME, piece.first.data(), piece.first.size(),
+                pieceResult), E_OK);
+        }
+        delete buffer;
+        buffer = nullptr;
+        /**
+         * @tc.steps: step3. change one byte of the payload
+         * @tc.expected: step3. the packet is rejected by the checkSum.
+         */
+        packet[packet.size() - 1] ^= 1;
+        EXPECT_EQ(ProtocolProto::CheckAndParsePacket(DEVICE_NAME, packet.data(), packet.size(), result),
+            -E_SUM_MISMATCH);
+    }
+}
+
+/**
+ * @tc.name: FrameChecksum002
+ * @tc.desc: Test the checkSum between two devices with the crc32c checkSum disabled and enabled.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author: xiaozhenjian
+ */
+HWTEST_F(DistributedDBCommunicatorChecksumTest, FrameChecksum002, TestSize.Level1)
+{
+    bool isEnableBefore = ProtocolProto::IsCrc32cSumEnable();
+    EnvHandle envDeviceA;
+    EnvHandle envDeviceB;
+    ASSERT_TRUE(SetUpEnv(envDeviceA, DEVICE_NAME_A));
+    ASSERT_TRUE(SetUpEnv(envDeviceB, DEVICE_NAME_B));
+    DoRegTransformFunction();
+    int errCode = E_OK;
+    ICommunicator *commAA = envDeviceA.commAggrHandle->AllocCommunicator(LABEL_A, errCode);
+    ASSERT_NOT_NULL_AND_ACTIVATE(commAA);
+    ICommunicator *commBA = envDeviceB.commAggrHandle->AllocCommunicator(LABEL_A, errCode);
+    ASSERT_NOT_NULL_AND_ACTIVATE(commBA);
+    std::atomic<int> receivedCount{0};
+    auto onMessage = [&receivedCount](const std::string &, Message *inMsg) {
+        receivedCount++;
+        delete inMsg;
+    };
+    commAA->RegOnMessageCallback(onMessage, nullptr);
+    commBA->RegOnMessageCallback(onMessage, nullptr);
+    AdapterStub::ConnectAdapterStub(envDeviceA.adapterHandle, envDeviceB.adapterHandle);
+
+    for (bool isEnable : {true, false}) {
+        /**
+         * @tc.steps: step1. enable or disable the crc32c checkSum, device B sends to device A first
+         * @tc.expected: step1. device A receives it and learns the crc32c support of device B
+         */
+        ProtocolProto::SetCrc32cSumEnable(isEnable);
+        bool isCrc32cUsed = isEnable && FrameChecksum::IsCrc32cAccelerated();
+        EXPECT_EQ(ProtocolProto::IsCrc32cSumEnable(), isCrc32cUsed);
+        receivedCount = 0;
+        SendConfig conf = {false, false, 0};
+        EXPECT_EQ(commBA->SendMessage(DEVICE_NAME_A, BuildRegedTinyMessage(), conf), E_OK);
+        std::this_thread::sleep_for(std::chrono::milliseconds(200)); // sleep 200 ms
+        EXPECT_EQ(receivedCount, 1);
+        /**
+         * @tc.steps: step2. device A sends to device B
+         * @tc.expected: step2. device B receives it, the packet is of crc32c checkSum only if enabled
+         */
+        EXPECT_EQ(commAA->SendMessage(DEVICE_NAME_B, BuildRegedTinyMessage(), conf), E_OK);
+        std::this_thread::sleep_for(std::chrono::milliseconds(200)); // sleep 200 ms
+        EXPECT_EQ(receivedCount, 2); // 2 messages received
+        EXPECT_EQ(envDeviceA.adapterHandle->GetLastSendVersion(), isCrc32cUsed ? 1u : 0u); // 1 is crc32c version
+    }
+
+    AdapterStub::DisconnectAdapterStub(envDeviceA.adapterHandle, envDeviceB.adapterHandle);
+    envDeviceA.commAggrHandle->ReleaseCommunicator(commAA);
+    envDeviceB.commAggrHandle->ReleaseCommunicator(commBA);
+    std::this_thread::sleep_for(std::chrono::seconds(1)); // Wait 1 s to make sure all thread quiet
+    TearDownEnv(envDeviceA);
+    TearDownEnv(envDeviceB);
+    ProtocolProto::SetCrc32cSumEnable(isEnableBefore);
+}
+
+/**
+ * @tc.name: ChecksumBenchmark001
+ * @tc.desc: Print the throughput of the xor sum and crc32c of a big frame.
+ * @tc.type: PERF
+ * @tc.require:
+ * @tc.author: xiaozhenjian
+ */
+HWTEST_F(DistributedDBCommunicatorChecksumTest, ChecksumBenchmark001, TestSize.Level3)
+{
+    uint32_t frameSize = static_cast<uint32_t>(DistributedDBToolsUnitTest::GetEnvValue(
+        "DDB_CHECKSUM_BENCH_FRAME_SIZE", 4 * 1024 * 1024)); // 4 MB, 1024 is scale
+    frameSize -= frameSize % sizeof(uint64_t);
+    uint32_t rounds = static_cast<uint32_t>(
+        DistributedDBToolsUnitTest::GetEnvValue("DDB_CHECKSUM_BENCH_ROUNDS", 100)); // default 100 rounds
+    ASSERT_GT(frameSize, 0u);
+    ASSERT_GT(rounds, 0u);
+    vector<uint8_t> bytes = RandomBytes(frameSize);
+
+    auto measure = [&bytes, rounds](const function<uint64_t()> &func) -> double {
+        uint64_t result = 0;
+        auto begin = chrono::steady_clock::now();
+        for (uint32_t i = 0; i < rounds; i++) {
+            result ^= func();
+        }
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - begin;
+        EXPECT_NE(result, UINT64_MAX); // keep the result used
+        return (static_cast<double>(bytes.size()) * rounds) / (1024 * 1024) / elapsed.count(); // 1024 is scale
+    };
+    double scalarXor = measure([&bytes]() { return RefXorSum(bytes.data(), bytes.size()); });
+    double xorSum = measure([&bytes]() {
+        uint64_t sum = 0;
+        FrameChecksum::CalculateXorSum(bytes.data(), bytes.size(), sum);
+        return sum;
+    });
+    double crc32c = measure([&bytes]() {
+        return static_cast<uint64_t>(FrameChecksum::CalculateCrc32c(bytes.data(), bytes.size()));
+    });
+    string json = "{\"case\":\"ChecksumBenchmark001\",\"frameSize\":" + to_string(frameSize) +
+        ",\"rounds\":" + to_string(rounds) +
+        ",\"scalarXorMBps\":" + to_string(scalarXor) +
+        ",\"xorSumMBps\":" + to_string(xorSum) +
+        ",\"crc32cMBps\":" + to_string(crc32c) +
+        ",\"crc32cAccelerated\":" + (FrameChecksum::IsCrc32cAccelerated() ? "true" : "false") + "}";
+    DistributedDBToolsUnitTest::PrintBenchmarkResult(json, "DDB_CHECKSUM_BENCH_OUTPUT");
+}
@@ -20,6 +20,8 @@
 #include "distributeddb_tools_unit_test.h"
 #include "endian_convert.h"
 #include "log_print.h"
+#include "serial_buffer.h"
+#include "serial_buffer_pool.h"
 
 using namespace std;
 using namespace testing::ext;
@@ -81,6 +83,10 @@ void DistributedDBCommunicatorTest::TearDownTestCase(void)
 void DistributedDBCommunicatorTest::SetUp()
 {
     DistributedDBUnitTest::DistributedDBToolsUnitTest::PrintTestCaseInfo();
+    /**
+     * @tc.setup: Free the idle blocks of the SerialBufferPool left by the previous cases
+     */
+    SerialBufferPool::GetInstance()->ReleaseIdleBlocks();
 }
 
 void DistributedDBCommunicatorTest::TearDown()
@@ -762,3 +768,150 @@ HWTEST_F(DistributedDBCommunicatorTest, ReDeliverMessage003, TestSize.Level2)
     g_envDeviceB.commAggrHandle->RegCommunicatorLackCallback(nullptr, nullptr);
     AdapterStub::DisconnectAdapterStub(g_envDeviceA.adapterHandle, g_envDeviceB.adapterHandle);
 }
+
+/**
+ * @tc.name: SerialBufferPool 001
+ * @tc.desc: Test the blocks of the SerialBufferPool are reused and the idle blocks are bounded by the idle limit
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author: xiaozhenjian
+ */
+HWTEST_F(DistributedDBCommunicatorTest, SerialBufferPool001, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. allocate 5 MB from a private pool and release it, then allocate 6 MB
+     * @tc.expected: step1. the block is rounded up to 8 MB and the same block is reused.
+     */
+    SerialBufferPool pool;
+    uint32_t blockSize = 0;
+    uint8_t *block = pool.Allocate(5 * 1024 * 1024, blockSize); // 5 MB, 1024 is scale
+    ASSERT_NE(block, nullptr);
+    EXPECT_EQ(blockSize, SerialBufferPool::MAX_BLOCK_SIZE);
+    EXPECT_EQ(pool.GetStat().inUseBytes, SerialBufferPool::MAX_BLOCK_SIZE);
+    pool.Release(block, blockSize, 5 * 1024 * 1024); // 5 MB, 1024 is scale
+    EXPECT_EQ(pool.GetStat().idleBytes, SerialBufferPool::MAX_BLOCK_SIZE);
+
+    uint32_t reuseBlockSize = 0;
+    uint8_t *reuseBlock = pool.Allocate(6 * 1024 * 1024, reuseBlockSize); // 6 MB, 1024 is scale
+    EXPECT_EQ(reuseBlock, block);
+    EXPECT_EQ(reuseBlockSize, blockSize);
+    EXPECT_EQ(pool.GetStat().allocCount, 2u);
+    EXPECT_EQ(pool.GetStat().hitCount, 1u);
+    /**
+     * @tc.steps: step2. add a share of 10 MB which lowers the idle limit to 1 MB and release the block
+     * @tc.expected: step2. the block is freed rather than kept.
+     */
+    pool.AddMemoryShare(10 * 1024 * 1024); // 10 MB, 1024 is scale
+    EXPECT_EQ(pool.GetStat().idleLimit, 1024u * 1024u); // 1 MB, 1024 is scale
+    pool.Release(reuseBlock, reuseBlockSize, 6 * 1024 * 1024); // 6 MB, 1024 is scale
+    EXPECT_EQ(pool.GetStat().idleBytes, 0u);
+    /**
+     * @tc.steps: step3. allocate more than the largest block
+     * @tc.expected: step3. the block is the requested size.
+     */
+    uint32_t hugeLength = SerialBufferPool::MAX_BLOCK_SIZE + 1;
+    block = pool.Allocate(hugeLength, blockSize);
+    ASSERT_NE(block, nullptr);
+    EXPECT_EQ(blockSize, hugeLength);
+    EXPECT_EQ(pool.GetStat().peakInUseBytes, hugeLength);
+    pool.Release(block, blockSize, hugeLength);
+    EXPECT_EQ(pool.GetStat().inUseBytes, 0u);
+}
+
+/**
+ * @tc.name: SerialBufferPool 002
+ * @tc.desc: Test the SerialBuffer allocated in one thread can be released and reused in another thread
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author: xiaozhenjian
+ */
+HWTEST_F(DistributedDBCommunicatorTest, SerialBufferPool002, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. allocate a SerialBuffer with external memory and convert it in a thread
+     * @tc.expected: step1. the converted buffer has the same bytes.
+     */
+    std::vector<uint8_t> external(1000, 'a'); // 1000 bytes
+    SerialBuffer *buffer = nullptr;
+    std::thread convertThread([&buffer, &external]() {
+        buffer = new (std::nothrow) SerialBuffer();
+        ASSERT_NE(buffer, nullptr);
+        EXPECT_EQ(buffer->SetExternalBuff(external.data(), external.size(), 0), E_OK);
+        EXPECT_EQ(buffer->ConvertForCrossThread(), E_OK);
+    });
+    convertThread.join();
+    ASSERT_NE(buffer, nullptr);
+    auto bytes = buffer->GetReadOnlyBytesForEntireBuffer();
+    ASSERT_NE(bytes.first, nullptr);
+    EXPECT_EQ(std::vector<uint8_t>(bytes.first, bytes.first + bytes.second), external);
+    const uint8_t *firstAddr = bytes.first;
+    /**
+     * @tc.steps: step2. release it in another new thread and allocate the same size there
+     * @tc.expected: step2. the block is kept in the empty cache of the new thread and reused by it.
+     */
+    const uint8_t *reuseAddr = nullptr;
+    std::thread reuseThread([&buffer, &external, &reuseAddr]() {
+        delete buffer;
+        buffer = new (std::nothrow) SerialBuffer();
+        ASSERT_NE(buffer, nullptr);
+        EXPECT_EQ(buffer->AllocBufferByTotalLength(external.size(), 0), E_OK);
+        reuseAddr = buffer->GetReadOnlyBytesForEntireBuffer().first;
+        delete buffer;
+        buffer = nullptr;
+    });
+    reuseThread.join();
+    EXPECT_EQ(reuseAddr, firstAddr);
+}
+
+/**
+ * @tc.name: SerialBufferPool 003
+ * @tc.desc: Test the limits of the SerialBufferPool are derived from the shares of all the users
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author: xiaozhenjian
+ */
+HWTEST_F(DistributedDBCommunicatorTest, SerialBufferPool003, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. add the shares of 100 MB and 50 MB, in any order
+     * @tc.expected: step1. the idle limit is a tenth of the largest share and the memory limit is the sum.
+     */
+    const uint64_t largeShare = 100 * 1024 * 1024; // 100 MB, 1024 is scale
+    const uint64_t smallShare = 50 * 1024 * 1024; // 50 MB, 1024 is scale
+    SerialBufferPool pool;
+    pool.AddMemoryShare(largeShare);
+    pool.AddMemoryShare(smallShare);
+    EXPECT_EQ(pool.GetStat().idleLimit, largeShare / SerialBufferPool::IDLE_SHARE_RATIO);
+    EXPECT_EQ(pool.GetStat().memoryLimit, largeShare + smallShare);
+    /**
+     * @tc.steps: step2. remove the large share, then the small share is the only one
+     * @tc.expected: step2. the memory limit is not less than the minimum.
+     */
+    pool.RemoveMemoryShare(largeShare);
+    EXPECT_EQ(pool.GetStat().idleLimit, smallShare / SerialBufferPool::IDLE_SHARE_RATIO);
+    EXPECT_EQ(pool.GetStat().memoryLimit, smallShare);
+    pool.RemoveMemoryShare(smallShare);
+    pool.AddMemoryShare(1024 * 1024); // 1 MB, 1024 is scale
+    EXPECT_EQ(pool.GetStat().memoryLimit, SerialBufferPool::MIN_MEMORY_LIMIT);
+    /**
+     * @tc.steps: step3. allocate the largest blocks until the memory limit
+     * @tc.expected: step3. the allocation over the memory limit fails, and succeeds again after a release.
+     */
+    std::vector<uint8_t *> blocks;
+    uint32_t blockSize = 0;
+    for (uint64_t inUse = 0; inUse < SerialBufferPool::MIN_MEMORY_LIMIT; inUse += SerialBufferPool::MAX_BLOCK_SIZE) {
+        uint8_t *block = pool.Allocate(SerialBufferPool::MAX_BLOCK_SIZE, blockSize);
+        ASSERT_NE(block, nullptr);
+        blocks.push_back(block);
+    }
+    EXPECT_EQ(pool.Allocate(1, blockSize), nullptr);
+    pool.Release(blocks.back(), SerialBufferPool::MAX_BLOCK_SIZE, SerialBufferPool::MAX_BLOCK_SIZE);
+    blocks.pop_back();
+    uint8_t *block = pool.Allocate(1, blockSize);
+    ASSERT_NE(block, nullptr);
+    pool.Release(block, blockSize, 1);
+    for (uint8_t *each : blocks) {
+        pool.Release(each, SerialBufferPool::MAX_BLOCK_SIZE, SerialBufferPool::MAX_BLOCK_SIZE);
+    }
+    EXPECT_EQ(pool.GetStat().inUseBytes, 0u);
+}
@@ -1337,6 +1337,37 @@ HWTEST_F(DistributedDBInterfacesDatabaseTest, FreqOpenClose001, TestSize.Level2)
     EXPECT_EQ(g_mgr.DeleteKvStore(storeId), OK);
 }
 
+/**
+  * @tc.name: FreqOpenClose002
+  * @tc.desc: Open and close different kv stores concurrently.
+  * @tc.type: FUNC
+  * @tc.require:
+  * @tc.author: wangbingquan
+  */
+HWTEST_F(DistributedDBInterfacesDatabaseTest, FreqOpenClose002, TestSize.Level2)
+{
+    /**
+     * @tc.steps: step1. open and close 4 different stores in 4 threads.
+     * @tc.expected: step1. the opens of different identifiers do not block each other.
+     */
+    std::vector<std::string> storeIds = {"FrqOpenClose002_1", "FrqOpenClose002_2", "FrqOpenClose002_3",
+        "FrqOpenClose002_4"};
+    std::vector<std::thread> threads;
+    for (const auto &storeId : storeIds) {
+        threads.emplace_back(OpenCloseDatabase, storeId);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    /**
+     * @tc.steps: step2. delete the stores.
+     * @tc.expected: step2. all the latches are released, the stores can be deleted.
+     */
+    for (const auto &storeId : storeIds) {
+        EXPECT_EQ(g_mgr.DeleteKvStore(storeId), OK);
+    }
+}
+
 /**
   * @tc.name: CheckKvStoreDir001
   * @tc.desc: Delete the kv store with the option that createDirByStoreIdOnly is true.
@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <gtest/gtest.h>
+
+#include "db_errno.h"
+#include "distributeddb_data_generate_unit_test.h"
+#include "distributeddb_tools_unit_test.h"
+#include "kv_store_nb_delegate.h"
+#include "relational_store_manager.h"
+#include "sqlite_utils.h"
+
+using namespace testing::ext;
+using namespace DistributedDB;
+using namespace DistributedDBUnitTest;
+using namespace std;
+
+/*
+ * The benchmark of the storage profiles, the shape of the run is read from the environment, the result of each
+ * profile is printed as one json line and appended to DDB_PROFILE_BENCH_OUTPUT if set:
+ *   DDB_PROFILE_BENCH_ENTRIES      the entries written and read, default 2000
+ *   DDB_PROFILE_BENCH_VALUE_SIZE   default 1024
+ */
+namespace {
+    string g_testDir;
+    const string STORE_ID = "kv_storage_profile";
+    const uint32_t BATCH_SIZE = 100;
+
+    KvStoreDelegateManager g_mgr(APP_ID, USER_ID);
+    KvStoreConfig g_config;
+    DBStatus g_kvDelegateStatus = INVALID_ARGS;
+    KvStoreNbDelegate* g_kvDelegatePtr = nullptr;
+
+    auto g_kvDelegateCallback = bind(&DistributedDBToolsUnitTest::KvStoreNbDelegateCallback,
+        placeholders::_1, placeholders::_2, std::ref(g_kvDelegateStatus), std::ref(g_kvDelegatePtr));
+
+    int64_t GetPragmaValue(sqlite3 *db, const string &pragma)
+    {
+        sqlite3_stmt *stmt = nullptr;
+        if (SQLiteUtils::GetStatement(db, "PRAGMA " + pragma + ";", stmt) != E_OK) {
+            return -1;
+        }
+        int64_t value = -1;
+        if (SQLiteUtils::StepWithRetry(stmt, false) == SQLiteUtils::MapSQLiteErrno(SQLITE_ROW)) {
+            value = sqlite3_column_int64(stmt, 0);
+        }
+        int errCode = E_OK;
+        SQLiteUtils::ResetStatement(stmt, true, errCode);
+        return value;
+    }
+
+    uint64_t GetCostTime(const chrono::steady_clock::time_point &start)
+    {
+        return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    }
+
+    void RunProfileBenchmark(const string &name, const StorageProfile &profile)
+    {
+        uint32_t entryNum = std::max<uint64_t>(
+            DistributedDBToolsUnitTest::GetEnvValue("DDB_PROFILE_BENCH_ENTRIES", 2000), 1); // default 2000
+        uint32_t valueSize =
+            DistributedDBToolsUnitTest::GetEnvValue("DDB_PROFILE_BENCH_VALUE_SIZE", 1024); // default 1024
+        KvStoreNbDelegate::Option option;
+        option.profile = profile;
+        g_mgr.GetKvStore(STORE_ID, option, g_kvDelegateCallback);
+        ASSERT_EQ(g_kvDelegateStatus, OK);
+        ASSERT_TRUE(g_kvDelegatePtr != nullptr);
+
+        auto start = chrono::steady_clock::now();
+        for (uint32_t i = 0; i < entryNum; i += BATCH_SIZE) {
+            vector<Entry> entries;
+            for (uint32_t j = i; j < std::min(i + BATCH_SIZE, entryNum); j++) {
+                Entry entry;
+                string key = "key_" + to_string(j);
+                entry.key.assign(key.begin(), key.end());
+                DistributedDBToolsUnitTest::GetRandomKeyValue(entry.value, valueSize);
+                entries.push_back(std::move(entry));
+            }
+            ASSERT_EQ(g_kvDelegatePtr->PutBatch(entries), OK);
+        }
+        uint64_t writeTime = GetCostTime(start);
+
+        start = chrono::steady_clock::now();
+        for (uint32_t i = 0; i < entryNum; i++) {
+            string keyStr = "key_" + to_string(i);
+            Value value;
+            EXPECT_EQ(g_kvDelegatePtr->Get(Key(keyStr.begin(), keyStr.end()), value), OK);
+        }
+        uint64_t readTime = GetCostTime(start);
+
+        start = chrono::steady_clock::now();
+        vector<Entry> allEntries;
+        EXPECT_EQ(g_kvDelegatePtr->GetEntries(Key {'k'}, allEntries), OK);
+        EXPECT_EQ(allEntries.size(), entryNum);
+        uint64_t scanTime = GetCostTime(start);
+
+        string json = "{\"profile\":\"" + name + "\"" +
+            ",\"entries\":" + to_string(entryNum) +
+            ",\"valueSize\":" + to_string(valueSize) +
+            ",\"writeTime\":" + to_string(writeTime) +
+            ",\"readTime\":" + to_string(readTime) +
+            ",\"scanTime\":" + to_string(scanTime) + "}";
+        DistributedDBToolsUnitTest::PrintBenchmarkResult(json, "DDB_PROFILE_BENCH_OUTPUT");
+        EXPECT_EQ(g_mgr.CloseKvStore(g_kvDelegatePtr), OK);
+        g_kvDelegatePtr = nullptr;
+        EXPECT_EQ(g_mgr.DeleteKvStore(STORE_ID), OK);
+    }
+}
+
+class DistributedDBInterfacesStorageProfileTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void DistributedDBInterfacesStorageProfileTest::SetUpTestCase(void)
+{
+    DistributedDBToolsUnitTest::TestDirInit(g_testDir);
+    g_config.dataDir = g_testDir;
+    g_mgr.SetKvStoreConfig(g_config);
+}
+
+void DistributedDBInterfacesStorageProfileTest::TearDownTestCase(void)
+{
+    if (DistributedDBToolsUnitTest::RemoveTestDbFiles(g_testDir) != 0) {
+        LOGE("rm test db files error!");
+    }
+}
+
+void DistributedDBInterfacesStorageProfileTest::SetUp(void)
+{
+    DistributedDBToolsUnitTest::PrintTestCaseInfo();
+}
+
+void DistributedDBInterfacesStorageProfileTest::TearDown(void)
+{
+    if (g_kvDelegatePtr != nullptr) {
+        EXPECT_EQ(g_mgr.CloseKvStore(g_kvDelegatePtr), OK);
+        g_kvDelegatePtr = nullptr;
+        EXPECT_EQ(g_mgr.DeleteKvStore(STORE_ID), OK);
+    }
+}
+
+/**
+ * @tc.name: StorageProfile001
+ * @tc.desc: Test the storage profile is applied to the connection opened.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author: zhangqiquan
+ */
+HWTEST_F(DistributedDBInterfacesStorageProfileTest, StorageProfile001, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. open a new database with the profile
+     * @tc.expected: step1. open ok
+     */
+    OpenDbProperties option;
+    option.uri = g_testDir + "/profile.db";
+    option.profile = { 2048, 1024, 8192, 2, 200, 512 }; // 2MB cache, 1MB mmap, 8KB page, 200 pages, 512KB wal kept
+    sqlite3 *db = nullptr;
+    ASSERT_EQ(SQLiteUtils::OpenDatabase(option, db), E_OK);
+    ASSERT_NE(db, nullptr);
+    /**
+     * @tc.steps: step2. check the pragmas of the connection
+     * @tc.expected: step2. same as the profile
+     */
+    const int64_t bytesPerKb = 1024;
+    EXPECT_EQ(GetPragmaValue(db, "cache_size"), -2048); // negative means KB
+    EXPECT_EQ(GetPragmaValue(db, "mmap_size"), 1024 * bytesPerKb);
+    EXPECT_EQ(GetPragmaValue(db, "page_size"), 8192);
+    EXPECT_EQ(GetPragmaValue(db, "temp_store"), 2);
+    EXPECT_EQ(GetPragmaValue(db, "wal_autocheckpoint"), 200);
+    EXPECT_EQ(GetPragmaValue(db, "journal_size_limit"), 512 * bytesPerKb);
+    (void)sqlite3_close_v2(db);
+    /**
+     * @tc.steps: step3. open the database again with the default profile
+     * @tc.expected: step3. the page size is kept by the database file
+     */
+    option.profile = {};
+    db = nullptr;
+    ASSERT_EQ(SQLiteUtils::OpenDatabase(option, db), E_OK);
+    EXPECT_EQ(GetPragmaValue(db, "page_size"), 8192);
+    EXPECT_NE(GetPragmaValue(db, "wal_autocheckpoint"), 200);
+    (void)sqlite3_close_v2(db);
+}
+
+/**
+ * @tc.name: StorageProfile002
+ * @tc.desc: Test the storage profile is checked when the store is opened.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author: zhangqiquan
+ */
+HWTEST_F(DistributedDBInterfacesStorageProfileTest, StorageProfile002, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. get the kv store with the invalid profile
+     * @tc.expected: step1. INVALID_ARGS
+     */
+    KvStoreNbDelegate::Option option;
+    for (int pageSize : { 0, 256, 1000, 131072 }) {
+        option.profile = {};
+        option.profile.pageSize = pageSize;
+        g_mgr.GetKvStore(STORE_ID, option, g_kvDelegateCallback);
+        EXPECT_EQ(g_kvDelegateStatus, INVALID_ARGS);
+        EXPECT_TRUE(g_kvDelegatePtr == nullptr);
+    }
+    option.profile = {};
+    option.profile.tempStore = 3; // 3 is not a valid temp store
+    g_mgr.GetKvStore(STORE_ID, option, g_kvDelegateCallback);
+    EXPECT_EQ(g_kvDelegateStatus, INVALID_ARGS);
+    sqlite3 *db = RelationalTestUtils::CreateDataBase(g_testDir + "/relational.db");
+    ASSERT_NE(db, nullptr);
+    (void)sqlite3_close_v2(db);
+    RelationalStoreManager relationalMgr(APP_ID, USER_ID);
+    RelationalStoreDelegate::Option relationalOption;
+    relationalOption.profile.pageSize = 1000; // 1000 is not a power of two
+    RelationalStoreDelegate *delegate = nullptr;
+    EXPECT_EQ(relationalMgr.OpenStore(g_testDir + "/relational.db", STORE_ID, relationalOption, delegate),
+        INVALID_ARGS);
+    EXPECT_TRUE(delegate == nullptr);
+    /**
+     * @tc.steps: step2. get the kv store with each preset, put and get
+     * @tc.expected: step2. all ok
+     */
+    for (const auto &profile : { StorageProfilePreset::READ_HEAVY, StorageProfilePreset::WRITE_HEAVY,
+        StorageProfilePreset::LOW_MEMORY }) {
+        option.profile = profile;
+        g_mgr.GetKvStore(STORE_ID, option, g_kvDelegateCallback);
+        ASSERT_EQ(g_kvDelegateStatus, OK);
+        ASSERT_TRUE(g_kvDelegatePtr != nullptr);
+        EXPECT_EQ(g_kvDelegatePtr->Put(KEY_1, VALUE_1), OK);
+        Value value;
+        EXPECT_EQ(g_kvDelegatePtr->Get(KEY_1, value), OK);
+        EXPECT_EQ(value, VALUE_1);
+        EXPECT_EQ(g_mgr.CloseKvStore(g_kvDelegatePtr), OK);
+        g_kvDelegatePtr = nullptr;
+        EXPECT_EQ(g_mgr.DeleteKvStore(STORE_ID), OK);
+    }
+}
+
+/**
+ * @tc.name: StorageProfileBenchmark001
+ * @tc.desc: Compare the write, read and scan of the default profile and the presets.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author: zhangqiquan
+ */
+HWTEST_F(DistributedDBInterfacesStorageProfileTest, StorageProfileBenchmark001, TestSize.Level4)
+{
+    /**
+     * @tc.steps: step1. write, read and scan the entries in a new store of each profile
+     * @tc.expected: step1. all ok, the cost of each profile is printed
+     */
+    RunProfileBenchmark("default", StorageProfile {});
+    RunProfileBenchmark("readHeavy", StorageProfilePreset::READ_HEAVY);
+    RunProfileBenchmark("writeHeavy", StorageProfilePreset::WRITE_HEAVY);
+    RunProfileBenchmark("lowMemory", StorageProfilePreset::LOW_MEMORY);
+}
@@ -751,3 +751,137 @@ HWTEST_F(DistributedDBMultiVerVacuumTest, MultipleTaskNormalStatusSwitch002, Tes
     stepFive = CheckVacuumTaskStatus(vacuum, DB_IDENTITY_C, VacuumTaskStatus::FINISH, 1); // only 1 time
     EXPECT_EQ(stepFive, true);
 }
+
+/**
+ * @tc.name: MultipleTaskConcurrentExecute001
+ * @tc.desc: Test multiple task executed at the same time under the policy of concurrent tasks
+ * @tc.type: FUNC
+ * @tc.require: AR000C6TRV AR000CQDTM
+ * @tc.author: xiaozhenjian
+ */
+HWTEST_F(DistributedDBMultiVerVacuumTest, MultipleTaskConcurrentExecute001, TestSize.Level1)
+{
+    // Preset
+    MultiVerVacuum vacuum(VacuumPolicy {2, 0, 0}); // 2 tasks at the same time, 0 for unlimited budget
+    MultiVerVacuumExecutorStub databaseA(DbScale {1, 1, 2, 2}, 100); // 1, 2 For Scale, 100 For TimeCost, 1.7s in Total
+    MultiVerVacuumExecutorStub databaseB(DbScale {1, 1, 2, 2}, 100); // 1, 2 For Scale, 100 For TimeCost, 1.7s in Total
+    MultiVerVacuumExecutorStub databaseC(DbScale {1, 1, 2, 2}, 100); // 1, 2 For Scale, 100 For TimeCost, 1.7s in Total
+
+    /**
+     * @tc.steps: step1. launch dbTaskA,B,C for databaseA,B,C
+     * @tc.expected: step1. dbTaskA RUN_NING and dbTaskB RUN_NING and dbTaskC RUN_WAIT
+     */
+    EXPECT_EQ(vacuum.Launch(DB_IDENTITY_A, &databaseA), E_OK);
+    EXPECT_EQ(vacuum.Launch(DB_IDENTITY_B, &databaseB), E_OK);
+    EXPECT_EQ(vacuum.Launch(DB_IDENTITY_C, &databaseC), E_OK);
+    bool stepOne = CheckVacuumTaskStatus(vacuum, DB_IDENTITY_A, VacuumTaskStatus::RUN_NING);
+    EXPECT_EQ(stepOne, true);
+    stepOne = CheckVacuumTaskStatus(vacuum, DB_IDENTITY_B, VacuumTaskStatus::RUN_NING);
+    EXPECT_EQ(stepOne, true);
+    stepOne = CheckVacuumTaskStatus(vacuum, DB_IDENTITY_C, VacuumTaskStatus::RUN_WAIT, 1); // only 1 time
+    EXPECT_EQ(stepOne, true);
+
+    /**
+     * @tc.steps: step2. wait dbTaskA,B FINISH
+     * @tc.expected: step2. dbTaskA FINISH and dbTaskB FINISH and dbTaskC RUN_NING
+     */
+    bool stepTwo = CheckVacuumTaskStatus(vacuum, DB_IDENTITY_A, VacuumTaskStatus::FINISH, 3, 1000); // 3 time, 1000 ms
+    EXPECT_EQ(stepTwo, true);
+    stepTwo = CheckVacuumTaskStatus(vacuum, DB_IDENTITY_B, VacuumTaskStatus::FINISH, 1); // only 1 time
+    EXPECT_EQ(stepTwo, true);
+    stepTwo = CheckVacuumTaskStatus(vacuum, DB_IDENTITY_C, VacuumTaskStatus::RUN_NING);
+    EXPECT_EQ(stepTwo, true);
+
+    /**
+     * @tc.steps: step3. wait dbTaskC FINISH
+     * @tc.expected: step3. dbTaskC FINISH
+     */
+    bool stepThree = CheckVacuumTaskStatus(vacuum, DB_IDENTITY_C, VacuumTaskStatus::FINISH, 3, 1000); // 3 time, 1s
+    EXPECT_EQ(stepThree, true);
+}
+
+/**
+ * @tc.name: SingleTaskSliceCommit001
+ * @tc.desc: Test the transaction is committed when the row budget used up and the statistics of the task
+ * @tc.type: FUNC
+ * @tc.require: AR000C6TRV AR000CQDTM
+ * @tc.author: xiaozhenjian
+ */
+HWTEST_F(DistributedDBMultiVerVacuumTest, SingleTaskSliceCommit001, TestSize.Level1)
+{
+    // Preset
+    MultiVerVacuum vacuum(VacuumPolicy {1, 2, 0}); // 1 task at the same time, 2 rows each transaction
+    MultiVerVacuumExecutorStub databaseA(DbScale {1, 1, 2, 2}, 10); // 1, 2 For Scale, 10 For TimeCost
+
+    /**
+     * @tc.steps: step1. launch dbTaskA for databaseA, then pause it while running
+     * @tc.expected: step1. dbTaskA PAUSE_DONE and the pause wait recorded
+     */
+    EXPECT_EQ(vacuum.Launch(DB_IDENTITY_A, &databaseA), E_OK);
+    bool stepOne = CheckVacuumTaskStatus(vacuum, DB_IDENTITY_A, VacuumTaskStatus::RUN_NING);
+    EXPECT_EQ(stepOne, true);
+    EXPECT_EQ(vacuum.Pause(DB_IDENTITY_A), E_OK);
+    stepOne = CheckVacuumTaskStatus(vacuum, DB_IDENTITY_A, VacuumTaskStatus::PAUSE_DONE, 1); // only 1 time
+    EXPECT_EQ(stepOne, true);
+    VacuumTaskStatistics statistics;
+    EXPECT_EQ(vacuum.QueryStatistics(DB_IDENTITY_A, statistics), E_OK);
+    EXPECT_EQ(statistics.pauseWaitCount, 1ULL);
+    EXPECT_LE(statistics.maxPauseWaitTime, statistics.totalPauseWaitTime);
+
+    /**
+     * @tc.steps: step2. continue dbTaskA and wait it FINISH
+     * @tc.expected: step2. dbTaskA FINISH, every record and commit vacuumed in more than one transaction
+     */
+    EXPECT_EQ(vacuum.Continue(DB_IDENTITY_A, false), E_OK);
+    bool stepTwo = CheckVacuumTaskStatus(vacuum, DB_IDENTITY_A, VacuumTaskStatus::FINISH, 3, 1000); // 3 time, 1000 ms
+    EXPECT_EQ(stepTwo, true);
+    EXPECT_EQ(vacuum.QueryStatistics(DB_IDENTITY_A, statistics), E_OK);
+    EXPECT_EQ(statistics.recordsReclaimed, 6ULL); // 2 * 2 shadow records of left and 2 vacuum need records of right
+    EXPECT_EQ(statistics.commitsVacuumed, 2ULL); // 1 left commit and 1 right commit
+    EXPECT_GT(statistics.slicesCommitted, 2ULL); // 10 rows changed, 2 rows each transaction
+    EXPECT_EQ(databaseA.IsTransactionOccupied(), false);
+    EXPECT_EQ(vacuum.QueryStatistics(DB_IDENTITY_B, statistics), -E_NOT_FOUND);
+}
+
+/**
+ * @tc.name: MultipleTaskSliceYield001
+ * @tc.desc: Test the task yields to the waiting task when its budget used up
+ * @tc.type: FUNC
+ * @tc.require: AR000C6TRV AR000CQDTM
+ * @tc.author: xiaozhenjian
+ */
+HWTEST_F(DistributedDBMultiVerVacuumTest, MultipleTaskSliceYield001, TestSize.Level1)
+{
+    // Preset
+    MultiVerVacuum vacuum(VacuumPolicy {1, 1, 0}); // 1 task at the same time, 1 row each transaction
+    MultiVerVacuumExecutorStub databaseA(DbScale {20, 20, 2, 2}, 50); // 2, 20 For Scale, 50 For TimeCost, 20s in Total
+    MultiVerVacuumExecutorStub databaseB(DbScale {1, 1, 1, 1}, 10); // 1 For Scale, 10 For TimeCost
+
+    /**
+     * @tc.steps: step1. launch dbTaskA for databaseA, then launch dbTaskB for databaseB
+     * @tc.expected: step1. dbTaskA RUN_NING
+     */
+    EXPECT_EQ(vacuum.Launch(DB_IDENTITY_A, &databaseA), E_OK);
+    bool stepOne = CheckVacuumTaskStatus(vacuum, DB_IDENTITY_A, VacuumTaskStatus::RUN_NING);
+    EXPECT_EQ(stepOne, true);
+    EXPECT_EQ(vacuum.Launch(DB_IDENTITY_B, &databaseB), E_OK);
+
+    /**
+     * @tc.steps: step2. wait dbTaskB FINISH
+     * @tc.expected: step2. dbTaskB FINISH before dbTaskA
+     */
+    bool stepTwo = CheckVacuumTaskStatus(vacuum, DB_IDENTITY_B, VacuumTaskStatus::FINISH, 10, 1000); // 10 time, 1s
+    EXPECT_EQ(stepTwo, true);
+    VacuumTaskStatus statusA = VacuumTaskStatus::FINISH;
+    EXPECT_EQ(vacuum.QueryStatus(DB_IDENTITY_A, statusA), E_OK);
+    EXPECT_NE(statusA, VacuumTaskStatus::FINISH);
+
+    /**
+     * @tc.steps: step3. abort dbTaskA
+     * @tc.expected: step3. dbTaskA ABORT_DONE and the transaction not occupied
+     */
+    EXPECT_EQ(vacuum.Abort(DB_IDENTITY_A), E_OK);
+    bool stepThree = CheckVacuumTaskStatus(vacuum, DB_IDENTITY_A, VacuumTaskStatus::ABORT_DONE, 1); // only 1 time
+    EXPECT_EQ(stepThree, true);
+    EXPECT_EQ(databaseA.IsTransactionOccupied(), false);
+}
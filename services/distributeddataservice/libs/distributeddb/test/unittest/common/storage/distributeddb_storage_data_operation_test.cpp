@@ -13,7 +13,9 @@
  * limitations under the License.
  */
 
+#include <chrono>
 #include <gtest/gtest.h>
+#include <set>
 
 #include "db_common.h"
 #include "db_constant.h"
@@ -31,6 +33,41 @@ using namespace std;
 namespace {
     string g_testDir;
     SQLiteLocalKvDBConnection *g_connection = nullptr;
+    const size_t EDIT_VALUE_SIZE = 1024 * 1024; // 1M
+    const size_t FIXED_BLOCK_SIZE = 65536; // 64K, the same as the avg size of the content defined slices
+
+    // The hashes of the slices of the value, in the order of the slices.
+    std::vector<ValueSliceHash> GetSliceHashes(const MultiVerNaturalStoreTransferData &transferData,
+        const Value &value, std::vector<Value> &partValues)
+    {
+        std::vector<ValueSliceHash> hashes;
+        partValues.clear();
+        EXPECT_EQ(transferData.SegmentAndTransferValueToHash(value, partValues), E_OK);
+        for (const auto &part : partValues) {
+            ValueSliceHash hash;
+            EXPECT_EQ(DBCommon::CalcValueHash(part, hash), E_OK);
+            hashes.push_back(std::move(hash));
+        }
+        return hashes;
+    }
+
+    // The bytes of the new value in the slices shared with the old value, which need no transfer.
+    double GetDedupRatio(const MultiVerNaturalStoreTransferData &transferData, const Value &oldValue,
+        const Value &newValue)
+    {
+        std::vector<Value> oldParts;
+        std::vector<ValueSliceHash> oldHashes = GetSliceHashes(transferData, oldValue, oldParts);
+        std::set<ValueSliceHash> oldHashSet(oldHashes.begin(), oldHashes.end());
+        std::vector<Value> newParts;
+        std::vector<ValueSliceHash> newHashes = GetSliceHashes(transferData, newValue, newParts);
+        size_t sharedBytes = 0;
+        for (size_t i = 0; i < newHashes.size(); i++) {
+            if (oldHashSet.count(newHashes[i]) != 0) {
+                sharedBytes += newParts[i].size();
+            }
+        }
+        return static_cast<double>(sharedBytes) / newValue.size();
+    }
 }
 
 class DistributedDBStorageDataOperationTest : public testing::Test {
@@ -639,4 +676,124 @@ HWTEST_F(DistributedDBStorageDataOperationTest, CutValueIntoBlock002, TestSize.L
     CheckSplitData(value2, 0ul, valueDic, savedValue);
     CheckRecoverData(savedValue, valueDic, value2);
     EXPECT_EQ(valueDic.size(), 0ul);
-}
\ No newline at end of file
+}
+
+/**
+  * @tc.name: ContentDefinedSlice001
+  * @tc.desc: Slice the value by the content.
+  * @tc.type: FUNC
+  * @tc.require:
+  * @tc.author: zhangqiquan
+  */
+HWTEST_F(DistributedDBStorageDataOperationTest, ContentDefinedSlice001, TestSize.Level1)
+{
+    /**
+     * @tc.steps:step1. Set the invalid sizes of the content defined slice.
+     * @tc.expected: step1. Return -E_INVALID_ARGS.
+     */
+    MultiVerNaturalStoreTransferData transferData;
+    EXPECT_EQ(transferData.SetContentDefinedSlice(0, 1024, 4096), -E_INVALID_ARGS); // 1024 avg, 4096 max
+    EXPECT_EQ(transferData.SetContentDefinedSlice(4096, 1024, 8192), -E_INVALID_ARGS); // min over avg
+    EXPECT_EQ(transferData.SetContentDefinedSlice(1024, 8192, 8192), -E_INVALID_ARGS); // avg equal to max
+
+    /**
+     * @tc.steps:step2. Slice a 1M value by the default content defined sizes.
+     * @tc.expected: step2. Each slice is within the min and the max, the last one may be less than the min.
+     *     The slices make up the value, and the same value is sliced the same.
+     */
+    transferData.SetSliceLengthThreshold(CONTENT_DEFINED_SLICE_MAX_SIZE);
+    ASSERT_EQ(transferData.SetContentDefinedSlice(CONTENT_DEFINED_SLICE_MIN_SIZE, CONTENT_DEFINED_SLICE_AVG_SIZE,
+        CONTENT_DEFINED_SLICE_MAX_SIZE), E_OK);
+    Value value;
+    DistributedDBToolsUnitTest::GetRandomKeyValue(value, EDIT_VALUE_SIZE);
+    std::vector<Value> partValues;
+    std::vector<ValueSliceHash> hashes = GetSliceHashes(transferData, value, partValues);
+    ASSERT_GT(partValues.size(), 1ul);
+    Value joinedValue;
+    for (size_t i = 0; i < partValues.size(); i++) {
+        EXPECT_LE(partValues[i].size(), CONTENT_DEFINED_SLICE_MAX_SIZE);
+        if (i + 1 < partValues.size()) {
+            EXPECT_GT(partValues[i].size(), CONTENT_DEFINED_SLICE_MIN_SIZE);
+        }
+        joinedValue.insert(joinedValue.end(), partValues[i].begin(), partValues[i].end());
+    }
+    EXPECT_EQ(joinedValue, value);
+    std::vector<Value> otherPartValues;
+    EXPECT_EQ(GetSliceHashes(transferData, value, otherPartValues), hashes);
+
+    /**
+     * @tc.steps:step3. Slice the value not over the threshold.
+     * @tc.expected: step3. Return -E_UNEXPECTED_DATA.
+     */
+    Value smallValue(CONTENT_DEFINED_SLICE_MAX_SIZE, 'v');
+    partValues.clear();
+    EXPECT_EQ(transferData.SegmentAndTransferValueToHash(smallValue, partValues), -E_UNEXPECTED_DATA);
+    EXPECT_TRUE(partValues.empty());
+}
+
+/**
+  * @tc.name: ContentDefinedSlice002
+  * @tc.desc: Benchmark the dedup of the slices of the value edited, by the fixed size and by the content.
+  * @tc.type: PERF
+  * @tc.require:
+  * @tc.author: zhangqiquan
+  */
+HWTEST_F(DistributedDBStorageDataOperationTest, ContentDefinedSlice002, TestSize.Level2)
+{
+    /**
+     * @tc.steps:step1. Prepare the slicer by the fixed 64K and the one by the content of 64K avg.
+     */
+    MultiVerNaturalStoreTransferData fixedData;
+    fixedData.SetSliceLengthThreshold(FIXED_BLOCK_SIZE);
+    fixedData.SetBlockSizeByte(FIXED_BLOCK_SIZE);
+    MultiVerNaturalStoreTransferData contentData;
+    contentData.SetSliceLengthThreshold(CONTENT_DEFINED_SLICE_MAX_SIZE);
+    ASSERT_EQ(contentData.SetContentDefinedSlice(CONTENT_DEFINED_SLICE_MIN_SIZE, CONTENT_DEFINED_SLICE_AVG_SIZE,
+        CONTENT_DEFINED_SLICE_MAX_SIZE), E_OK);
+
+    /**
+     * @tc.steps:step2. Edit a 1M value by inserting, deleting and overwriting some bytes in the middle,
+     *     and by appending to the tail.
+     */
+    Value oriValue;
+    DistributedDBToolsUnitTest::GetRandomKeyValue(oriValue, EDIT_VALUE_SIZE);
+    const size_t editPos = EDIT_VALUE_SIZE / 3; // edit at the first third
+    const size_t editSize = 100; // 100 bytes edited
+    struct Edit {
+        std::string name;
+        Value value;
+        bool isShifted = false; // the bytes after the edit are moved
+    };
+    std::vector<Edit> edits;
+    Value inserted = oriValue;
+    inserted.insert(inserted.begin() + editPos, editSize, 'i');
+    edits.push_back({ "insert", inserted, true });
+    Value deleted = oriValue;
+    deleted.erase(deleted.begin() + editPos, deleted.begin() + editPos + editSize);
+    edits.push_back({ "delete", deleted, true });
+    Value overwritten = oriValue;
+    std::fill(overwritten.begin() + editPos, overwritten.begin() + editPos + editSize, 'o');
+    edits.push_back({ "overwrite", overwritten, false });
+    Value appended = oriValue;
+    appended.insert(appended.end(), editSize, 'a');
+    edits.push_back({ "append", appended, false });
+
+    /**
+     * @tc.steps:step3. Compare the bytes of the edited value in the slices shared with the original value.
+     * @tc.expected: step3. The content defined slices share most of the value for all the edits,
+     *     the fixed size slices share less once the edit shifts the bytes after it.
+     */
+    for (const auto &edit : edits) {
+        auto start = std::chrono::steady_clock::now();
+        double contentRatio = GetDedupRatio(contentData, oriValue, edit.value);
+        auto cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        double fixedRatio = GetDedupRatio(fixedData, oriValue, edit.value);
+        LOGI("[ContentDefinedSlice] %s: dedup %.3f by content(cost %lldus), %.3f by fixed size.",
+            edit.name.c_str(), contentRatio, static_cast<long long>(cost.count()), fixedRatio);
+        EXPECT_GT(contentRatio, 0.7); // 0.7 is at most 1 or 2 of the 256K slices changed in the 1M value
+        if (edit.isShifted) {
+            EXPECT_GT(contentRatio, fixedRatio);
+        }
+    }
+    EXPECT_LT(GetDedupRatio(fixedData, oriValue, inserted), 0.5); // 0.5 as the slices after the insert all change
+}
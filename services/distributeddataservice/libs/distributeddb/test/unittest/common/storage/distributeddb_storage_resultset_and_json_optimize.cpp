@@ -36,6 +36,8 @@ namespace {
     const int INSERT_NUMBER = 10;
     const Key EMPTY_KEY;
     const SQLiteSingleVerResultSet::Option OPTION = {ResultSetCacheMode::CACHE_ENTRY_ID_ONLY, 1};
+    const SQLiteSingleVerResultSet::Option PREFETCH_OPTION = {ResultSetCacheMode::CACHE_ENTRY_PREFETCH, 1};
+    const Key PREFETCH_PREFIX = {'p'};
 
     string g_testDir;
     string g_identifier;
@@ -44,6 +46,41 @@ namespace {
     KvDBProperties g_Property;
     const string STORE_ID = STORE_ID_SYNC;
 }
+namespace {
+    Key GetPrefetchKey(int index)
+    {
+        Key key = PREFETCH_PREFIX;
+        key.push_back(static_cast<uint8_t>(index >> 8)); // 8 is the bits of the high byte
+        key.push_back(static_cast<uint8_t>(index & 0xFF));
+        return key;
+    }
+
+    Value GetPrefetchValue(int index, size_t valueSize)
+    {
+        Value value(valueSize, static_cast<uint8_t>(index & 0xFF));
+        value.push_back(static_cast<uint8_t>(index >> 8)); // 8 is the bits of the high byte
+        return value;
+    }
+
+    void PutPrefetchEntries(int number, size_t valueSize)
+    {
+        IOption option;
+        option.dataType = IOption::SYNC_DATA;
+        for (int i = 0; i < number; i++) {
+            ASSERT_EQ(g_connection->Put(option, GetPrefetchKey(i), GetPrefetchValue(i, valueSize)), E_OK);
+        }
+    }
+
+    void CheckPrefetchEntry(const SQLiteSingleVerResultSet &resultSet, int position, size_t valueSize)
+    {
+        Entry entry;
+        ASSERT_EQ(resultSet.MoveTo(position), E_OK);
+        ASSERT_EQ(resultSet.GetEntry(entry), E_OK);
+        EXPECT_EQ(entry.key, GetPrefetchKey(position));
+        EXPECT_EQ(entry.value, GetPrefetchValue(position, valueSize));
+    }
+}
+
 class DistributedDBStorageResultAndJsonOptimizeTest : public testing::Test {
 public:
     static void SetUpTestCase(void);
@@ -312,4 +349,179 @@ HWTEST_F(DistributedDBStorageResultAndJsonOptimizeTest, ResultSetGetEntry001, Te
      */
     resultSet->Close();
 }
-#endif
\ No newline at end of file
+
+/**
+  * @tc.name: ResultSetPrefetch001
+  * @tc.desc: Test the sequential scan of the SQLiteSingleVerResultSet in CACHE_ENTRY_PREFETCH mode.
+  * @tc.type: FUNC
+  * @tc.require:
+  * @tc.author: zhangqiquan
+  */
+HWTEST_F(DistributedDBStorageResultAndJsonOptimizeTest, ResultSetPrefetch001, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. Put 1000 entries and open a result set of them in CACHE_ENTRY_PREFETCH mode.
+     * @tc.expected: step1. Expect the count is 1000.
+     */
+    const int entryNumber = 1000;
+    const size_t valueSize = 100;
+    PutPrefetchEntries(entryNumber, valueSize);
+    std::unique_ptr<SQLiteSingleVerResultSet> resultSet =
+        std::make_unique<SQLiteSingleVerResultSet>(g_store, PREFETCH_PREFIX, PREFETCH_OPTION);
+    ASSERT_EQ(resultSet->Open(false), E_OK);
+    EXPECT_EQ(resultSet->GetCount(), entryNumber);
+
+    /**
+     * @tc.steps: step2. Scan the entries forward, and then backward.
+     * @tc.expected: step2. Expect each entry is the one of the position.
+     */
+    for (int i = 0; i < entryNumber; i++) {
+        CheckPrefetchEntry(*resultSet, i, valueSize);
+    }
+    for (int i = entryNumber - 1; i >= 0; i--) {
+        CheckPrefetchEntry(*resultSet, i, valueSize);
+    }
+
+    /**
+     * @tc.steps: step3. Close the ResultSet right after a move which prefetches.
+     * @tc.expected: step3. Expect the ResultSet is closed and no entry is got after.
+     */
+    CheckPrefetchEntry(*resultSet, entryNumber / 2, valueSize);
+    resultSet->Close();
+    Entry entry;
+    EXPECT_EQ(resultSet->GetEntry(entry), -E_NO_SUCH_ENTRY);
+}
+
+/**
+  * @tc.name: ResultSetPrefetch002
+  * @tc.desc: Test the random move of the SQLiteSingleVerResultSet in CACHE_ENTRY_PREFETCH mode with large entries.
+  * @tc.type: FUNC
+  * @tc.require:
+  * @tc.author: zhangqiquan
+  */
+HWTEST_F(DistributedDBStorageResultAndJsonOptimizeTest, ResultSetPrefetch002, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. Put 100 entries of 64K and open a result set of them in CACHE_ENTRY_PREFETCH mode.
+     */
+    const int entryNumber = 100;
+    const size_t valueSize = 64 * 1024; // 64K makes the window shrink
+    PutPrefetchEntries(entryNumber, valueSize);
+    std::unique_ptr<SQLiteSingleVerResultSet> resultSet =
+        std::make_unique<SQLiteSingleVerResultSet>(g_store, PREFETCH_PREFIX, PREFETCH_OPTION);
+    ASSERT_EQ(resultSet->Open(false), E_OK);
+    EXPECT_EQ(resultSet->GetCount(), entryNumber);
+
+    /**
+     * @tc.steps: step2. Move in jumps, back and forth, and scan forward in between.
+     * @tc.expected: step2. Expect each entry is the one of the position.
+     */
+    const std::vector<int> positions = { 50, 3, 99, 0, 70, 69, 68, 20, 21, 22, 23, 98, 1 };
+    for (int position : positions) {
+        CheckPrefetchEntry(*resultSet, position, valueSize);
+    }
+    for (int i = 0; i < entryNumber; i++) {
+        CheckPrefetchEntry(*resultSet, i, valueSize);
+    }
+
+    /**
+     * @tc.steps: step3. Move out of the range.
+     * @tc.expected: step3. Expect no entry is got.
+     */
+    Entry entry;
+    EXPECT_EQ(resultSet->MoveTo(entryNumber), -E_INVALID_ARGS);
+    EXPECT_EQ(resultSet->GetEntry(entry), -E_NO_SUCH_ENTRY);
+    resultSet->Close();
+}
+
+/**
+  * @tc.name: ResultSetPrefetch003
+  * @tc.desc: Test the SQLiteSingleVerResultSet in CACHE_ENTRY_PREFETCH mode reads the snapshot of its open.
+  * @tc.type: FUNC
+  * @tc.require:
+  * @tc.author: zhangqiquan
+  */
+HWTEST_F(DistributedDBStorageResultAndJsonOptimizeTest, ResultSetPrefetch003, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. Put 1000 entries, open a result set of them in CACHE_ENTRY_PREFETCH mode and get the first.
+     * @tc.expected: step1. Expect the first window is loaded.
+     */
+    const int entryNumber = 1000;
+    const size_t valueSize = 100;
+    PutPrefetchEntries(entryNumber, valueSize);
+    std::unique_ptr<SQLiteSingleVerResultSet> resultSet =
+        std::make_unique<SQLiteSingleVerResultSet>(g_store, PREFETCH_PREFIX, PREFETCH_OPTION);
+    ASSERT_EQ(resultSet->Open(false), E_OK);
+    EXPECT_EQ(resultSet->GetCount(), entryNumber);
+    CheckPrefetchEntry(*resultSet, 0, valueSize);
+
+    /**
+     * @tc.steps: step2. Delete an entry in the loaded window, and one in the middle of a window not loaded yet.
+     */
+    IOption option;
+    option.dataType = IOption::SYNC_DATA;
+    EXPECT_EQ(g_connection->Delete(option, GetPrefetchKey(10)), E_OK); // 10 is in the first window
+    EXPECT_EQ(g_connection->Delete(option, GetPrefetchKey(300)), E_OK); // 300 is in a later window
+
+    /**
+     * @tc.steps: step3. Scan the entries forward.
+     * @tc.expected: step3. Expect all the entries are got as they were when the result set is opened.
+     */
+    for (int i = 0; i < entryNumber; i++) {
+        CheckPrefetchEntry(*resultSet, i, valueSize);
+    }
+    resultSet->Close();
+}
+
+/**
+  * @tc.name: GetEntriesByRowIds001
+  * @tc.desc: Test the entries got by rowids in one query when some of the rowids are deleted or not exist.
+  * @tc.type: FUNC
+  * @tc.require:
+  * @tc.author: zhangqiquan
+  */
+HWTEST_F(DistributedDBStorageResultAndJsonOptimizeTest, GetEntriesByRowIds001, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. Put 3 entries, get their rowids and delete the middle one.
+     */
+    const int entryNumber = 3;
+    const size_t valueSize = 100;
+    PutPrefetchEntries(entryNumber, valueSize);
+    int errCode = E_OK;
+    SQLiteSingleVerStorageExecutor *handle = g_store->GetHandle(false, errCode);
+    ASSERT_NE(handle, nullptr);
+    sqlite3 *db = nullptr;
+    ASSERT_EQ(handle->GetDbHandle(db), E_OK);
+    std::vector<int64_t> rowIds;
+    for (int i = 0; i < entryNumber; i++) {
+        sqlite3_stmt *stmt = nullptr;
+        ASSERT_EQ(SQLiteUtils::GetStatement(db, "SELECT rowid FROM sync_data WHERE key=?;", stmt), E_OK);
+        EXPECT_EQ(SQLiteUtils::BindBlobToStatement(stmt, 1, GetPrefetchKey(i), false), E_OK);
+        EXPECT_EQ(SQLiteUtils::StepWithRetry(stmt), SQLiteUtils::MapSQLiteErrno(SQLITE_ROW));
+        rowIds.push_back(sqlite3_column_int64(stmt, 0));
+        SQLiteUtils::ResetStatement(stmt, true, errCode);
+    }
+    IOption option;
+    option.dataType = IOption::SYNC_DATA;
+    EXPECT_EQ(g_connection->Delete(option, GetPrefetchKey(1)), E_OK);
+
+    /**
+     * @tc.steps: step2. Get the entries of the rowids and a rowid not exist.
+     * @tc.expected: step2. Expect only the deleted and the not exist ones are not found, the others are got.
+     */
+    rowIds.push_back(rowIds.back() + 1000); // 1000 more than the last rowid does not exist
+    std::vector<Entry> entries;
+    std::vector<bool> isFound;
+    EXPECT_EQ(handle->GetEntriesByRowIds(rowIds, entries, isFound), E_OK);
+    ASSERT_EQ(entries.size(), rowIds.size());
+    ASSERT_EQ(isFound.size(), rowIds.size());
+    EXPECT_EQ(isFound, std::vector<bool>({ true, false, true, false }));
+    EXPECT_EQ(entries[0].key, GetPrefetchKey(0));
+    EXPECT_EQ(entries[0].value, GetPrefetchValue(0, valueSize));
+    EXPECT_EQ(entries[2].key, GetPrefetchKey(2)); // 2 is the index of the last put entry
+    EXPECT_EQ(entries[2].value, GetPrefetchValue(2, valueSize)); // 2 is the index of the last put entry
+    g_store->ReleaseHandle(handle);
+}
+#endif
@@ -13,11 +13,14 @@
  * limitations under the License.
  */
 
+#include <functional>
 #include <gtest/gtest.h>
+#include <thread>
 
 #include "db_constant.h"
 #include "db_common.h"
 #include "distributeddb_storage_single_ver_natural_store_testcase.h"
+#include "platform_specific.h"
 
 using namespace testing::ext;
 using namespace DistributedDB;
@@ -33,6 +36,67 @@ namespace {
 
     DistributedDB::SQLiteSingleVerNaturalStore *g_store = nullptr;
     DistributedDB::SQLiteSingleVerNaturalStoreConnection *g_connection = nullptr;
+
+    const std::string CHECKPOINT_STORE_ID = "TestWalCheckpoint";
+    const int CHECKPOINT_PAGES = 100; // The wal over 100 pages is checkpointed
+
+    SQLiteSingleVerNaturalStore *OpenCheckpointStore(const std::string &identifier, std::string &walPath)
+    {
+        KvDBProperties property;
+        property.SetStringProp(KvDBProperties::DATA_DIR, g_testDir);
+        property.SetStringProp(KvDBProperties::STORE_ID, CHECKPOINT_STORE_ID);
+        property.SetStringProp(KvDBProperties::IDENTIFIER_DIR, identifier);
+        property.SetStringProp(KvDBProperties::IDENTIFIER_DATA, identifier); // not share the engine of g_store
+        property.SetIntProp(KvDBProperties::DATABASE_TYPE, KvDBProperties::SINGLE_VER_TYPE);
+        StorageProfile profile;
+        profile.walAutoCheckpoint = CHECKPOINT_PAGES;
+        profile.backgroundCheckpoint = true;
+        property.SetStorageProfile(profile);
+        walPath = g_testDir + "/" + identifier + "/" + DBConstant::SINGLE_SUB_DIR + "/" + DBConstant::MAINDB_DIR +
+            "/" + DBConstant::SINGLE_VER_DATA_STORE + ".db-wal";
+
+        auto store = new (std::nothrow) SQLiteSingleVerNaturalStore;
+        if (store == nullptr) {
+            return nullptr;
+        }
+        if (store->Open(property) != E_OK) {
+            RefObject::KillAndDecObjRef(store);
+            return nullptr;
+        }
+        return store;
+    }
+
+    void PutEntries(IKvDBConnection *connection, int begin, int end)
+    {
+        const uint32_t valueSize = 10240; // 10KB
+        IOption option;
+        for (int i = begin; i < end; i++) {
+            std::string keyStr = "key_" + std::to_string(i);
+            Value value;
+            DistributedDBToolsUnitTest::GetRandomKeyValue(value, valueSize);
+            EXPECT_EQ(connection->Put(option, Key(keyStr.begin(), keyStr.end()), value), E_OK);
+        }
+    }
+
+    uint64_t GetFileSize(const std::string &path)
+    {
+        uint64_t size = 0;
+        (void)OS::CalFileSize(path, size);
+        return size;
+    }
+
+    // The checkpointer checks every second, poll until it did the expected work or the deadline is reached
+    bool WaitUntil(const std::function<bool()> &condition)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10); // 10s at most
+        while (!condition()) {
+            if (std::chrono::steady_clock::now() >= deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(100)); // poll every 100ms
+        }
+        return true;
+    }
 }
 
 class DistributedDBStorageSQLiteSingleVerNaturalStoreTest : public testing::Test {
@@ -1079,3 +1143,165 @@ HWTEST_F(DistributedDBStorageSQLiteSingleVerNaturalStoreTest, DeleteUserKeyValue
     DistributedDBStorageSingleVerNaturalStoreTestCase::DeleteUserKeyValue006(g_store, g_connection, url);
 }
 
+/**
+  * @tc.name: BackgroundCheckpoint001
+  * @tc.desc: Test the wal is checkpointed in the background instead of by the write.
+  * @tc.type: FUNC
+  * @tc.require:
+  * @tc.author: zhangqiquan
+  */
+HWTEST_F(DistributedDBStorageSQLiteSingleVerNaturalStoreTest, BackgroundCheckpoint001, TestSize.Level2)
+{
+    /**
+     * @tc.steps: step1. open the store checkpointing in the background, put the entries over the checkpoint pages
+     * @tc.expected: step1. the wal is not checkpointed by the write
+     */
+    std::string identifier = DBCommon::TransferStringToHex(CHECKPOINT_STORE_ID);
+    std::string walPath;
+    SQLiteSingleVerNaturalStore *store = OpenCheckpointStore(identifier, walPath);
+    ASSERT_NE(store, nullptr);
+    int errCode = E_OK;
+    IKvDBConnection *connection = store->GetDBConnection(errCode);
+    ASSERT_NE(connection, nullptr);
+    const int entryNum = 200;
+    PutEntries(connection, 0, entryNum);
+    const uint64_t pageSize = 4096;
+    EXPECT_GT(GetFileSize(walPath), CHECKPOINT_PAGES * pageSize * 4); // 4 times of the checkpoint pages at least
+    /**
+     * @tc.steps: step2. wait the store to be idle
+     * @tc.expected: step2. the wal is checkpointed and truncated, the metrics are recorded
+     */
+    EXPECT_TRUE(WaitUntil([&walPath]() { return GetFileSize(walPath) == 0; }));
+    WalCheckpointMetrics metrics = store->GetWalCheckpointMetrics();
+    EXPECT_GE(metrics.checkpointCount, 1u);
+    EXPECT_EQ(metrics.blockedCount, 0u);
+    EXPECT_GT(metrics.maxWalSize, CHECKPOINT_PAGES * pageSize);
+    EXPECT_EQ(metrics.walSize, 0u);
+    EXPECT_GT(metrics.totalDuration, 0u);
+    EXPECT_GE(metrics.maxDuration, metrics.lastDuration);
+
+    EXPECT_EQ(connection->Close(), E_OK);
+    RefObject::KillAndDecObjRef(store);
+    DistributedDBToolsUnitTest::RemoveTestDbFiles(g_testDir + "/" + identifier + "/" + DBConstant::SINGLE_SUB_DIR);
+}
+
+/**
+  * @tc.name: BackgroundCheckpoint002
+  * @tc.desc: Test the reader held long blocks the background checkpoint until it is released.
+  * @tc.type: FUNC
+  * @tc.require:
+  * @tc.author: zhangqiquan
+  */
+HWTEST_F(DistributedDBStorageSQLiteSingleVerNaturalStoreTest, BackgroundCheckpoint002, TestSize.Level2)
+{
+    /**
+     * @tc.steps: step1. open the store checkpointing in the background, hold a read handle in a read transaction
+     */
+    std::string identifier = DBCommon::TransferStringToHex(CHECKPOINT_STORE_ID);
+    std::string walPath;
+    SQLiteSingleVerNaturalStore *store = OpenCheckpointStore(identifier, walPath);
+    ASSERT_NE(store, nullptr);
+    int errCode = E_OK;
+    IKvDBConnection *connection = store->GetDBConnection(errCode);
+    ASSERT_NE(connection, nullptr);
+    PutEntries(connection, 0, 1);
+    SQLiteSingleVerStorageExecutor *handle = store->GetHandle(false, errCode);
+    ASSERT_NE(handle, nullptr);
+    sqlite3 *db = nullptr;
+    ASSERT_EQ(handle->GetDbHandle(db), E_OK);
+    EXPECT_EQ(SQLiteUtils::ExecuteRawSQL(db, "BEGIN; SELECT count(*) FROM sync_data;"), E_OK);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100)); // the reader is held over 1s
+    /**
+     * @tc.steps: step2. put the entries and wait the store to be idle
+     * @tc.expected: step2. the checkpoint is blocked by the reader and not escalated
+     */
+    const int entryNum = 200;
+    PutEntries(connection, 1, entryNum);
+    uint64_t walSize = GetFileSize(walPath);
+    EXPECT_TRUE(WaitUntil([store]() { return store->GetWalCheckpointMetrics().blockedCount >= 1; }));
+    WalCheckpointMetrics metrics = store->GetWalCheckpointMetrics();
+    EXPECT_EQ(metrics.escalatedCount, 0u);
+    EXPECT_EQ(GetFileSize(walPath), walSize);
+    /**
+     * @tc.steps: step3. release the reader and wait again
+     * @tc.expected: step3. the wal is checkpointed and truncated
+     */
+    EXPECT_EQ(SQLiteUtils::ExecuteRawSQL(db, "COMMIT;"), E_OK);
+    store->ReleaseHandle(handle);
+    EXPECT_TRUE(WaitUntil([&walPath]() { return GetFileSize(walPath) == 0; }));
+    EXPECT_GE(store->GetWalCheckpointMetrics().escalatedCount, 1u);
+
+    EXPECT_EQ(connection->Close(), E_OK);
+    RefObject::KillAndDecObjRef(store);
+    DistributedDBToolsUnitTest::RemoveTestDbFiles(g_testDir + "/" + identifier + "/" + DBConstant::SINGLE_SUB_DIR);
+}
+
+/**
+  * @tc.name: BackgroundCheckpoint003
+  * @tc.desc: Test the writes not through the connection are checkpointed in the background too.
+  * @tc.type: FUNC
+  * @tc.require:
+  * @tc.author: zhangqiquan
+  */
+HWTEST_F(DistributedDBStorageSQLiteSingleVerNaturalStoreTest, BackgroundCheckpoint003, TestSize.Level2)
+{
+    /**
+     * @tc.steps: step1. open the store checkpointing in the background, put the meta data over the checkpoint pages
+     */
+    std::string identifier = DBCommon::TransferStringToHex(CHECKPOINT_STORE_ID);
+    std::string walPath;
+    SQLiteSingleVerNaturalStore *store = OpenCheckpointStore(identifier, walPath);
+    ASSERT_NE(store, nullptr);
+    const int entryNum = 200;
+    const uint32_t valueSize = 10240; // 10KB
+    for (int i = 0; i < entryNum; i++) {
+        std::string keyStr = "meta_" + std::to_string(i);
+        Value value;
+        DistributedDBToolsUnitTest::GetRandomKeyValue(value, valueSize);
+        EXPECT_EQ(store->PutMetaData(Key(keyStr.begin(), keyStr.end()), value), E_OK);
+    }
+    const uint64_t pageSize = 4096;
+    EXPECT_GT(GetFileSize(walPath), CHECKPOINT_PAGES * pageSize);
+    /**
+     * @tc.steps: step2. wait the store to be idle
+     * @tc.expected: step2. the wal is checkpointed and truncated
+     */
+    EXPECT_TRUE(WaitUntil([&walPath]() { return GetFileSize(walPath) == 0; }));
+    EXPECT_GE(store->GetWalCheckpointMetrics().checkpointCount, 1u);
+
+    RefObject::KillAndDecObjRef(store);
+    DistributedDBToolsUnitTest::RemoveTestDbFiles(g_testDir + "/" + identifier + "/" + DBConstant::SINGLE_SUB_DIR);
+}
+
+/**
+  * @tc.name: BackgroundCheckpoint004
+  * @tc.desc: Test the connection checkpoints on commit while no checkpointer runs on the db.
+  * @tc.type: FUNC
+  * @tc.require:
+  * @tc.author: zhangqiquan
+  */
+HWTEST_F(DistributedDBStorageSQLiteSingleVerNaturalStoreTest, BackgroundCheckpoint004, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. open the db with the background checkpoint profile, but start no checkpointer on it
+     */
+    OpenDbProperties option;
+    option.uri = g_testDir + "/background_checkpoint.db";
+    option.profile.walAutoCheckpoint = CHECKPOINT_PAGES;
+    option.profile.backgroundCheckpoint = true;
+    sqlite3 *db = nullptr;
+    ASSERT_EQ(SQLiteUtils::OpenDatabase(option, db), E_OK);
+    ASSERT_NE(db, nullptr);
+    /**
+     * @tc.steps: step2. write over 4 times of the checkpoint pages
+     * @tc.expected: step2. the wal is checkpointed on commit and reused, never much larger than the checkpoint pages
+     */
+    EXPECT_EQ(SQLiteUtils::ExecuteRawSQL(db, "CREATE TABLE IF NOT EXISTS data(value BLOB);"), E_OK);
+    const int entryNum = 200;
+    for (int i = 0; i < entryNum; i++) {
+        EXPECT_EQ(SQLiteUtils::ExecuteRawSQL(db, "INSERT INTO data VALUES(randomblob(10240));"), E_OK); // 10KB
+    }
+    const uint64_t pageSize = 4096;
+    EXPECT_LT(GetFileSize(option.uri + "-wal"), CHECKPOINT_PAGES * pageSize * 2); // less than 2 times
+    (void)sqlite3_close_v2(db);
+}
@@ -671,4 +671,72 @@ HWTEST_F(DistributedDBStorageSubscribeQueryTest, AddSubscribeTest002, TestSize.L
      */
     RefObject::KillAndDecObjRef(store);
     KvDBManager::ReleaseDatabaseConnection(conn);
-}
\ No newline at end of file
+}
+namespace {
+bool IsSubscribeWaterMarkExist(SQLiteSingleVerNaturalStore *store, const std::string &subscribeId)
+{
+    std::string keyStr = DBConstant::SUBSCRIBE_QUERY_PREFIX + DBCommon::TransferHashString(subscribeId);
+    Key key(keyStr.begin(), keyStr.end());
+    Value value;
+    return store->GetMetaData(key, value) == E_OK;
+}
+}
+
+/**
+  * @tc.name: AddSubscribeTest003
+  * @tc.desc: Multiple subscribe queries share the consolidated triggers, only the matched ones update the water mark
+  * @tc.type: FUNC
+  * @tc.require: AR000FN6G9
+  * @tc.author: xulianhui
+  */
+HWTEST_F(DistributedDBStorageSubscribeQueryTest, AddSubscribeTest003, TestSize.Level1)
+{
+    /**
+     * @tc.steps:step1. Create a json schema db, get the natural store instance.
+     * @tc.expected: Get results OK and non-null store.
+     */
+    SQLiteSingleVerNaturalStoreConnection *conn = nullptr;
+    SQLiteSingleVerNaturalStore *store = nullptr;
+    CreateAndGetStore("SubscribeTest03", SCHEMA_STRING, conn, store);
+
+    /**
+     * @tc.steps:step2. Add three subscribe queries, two of them have the same condition.
+     * @tc.expected: step2. add success.
+     */
+    QueryObject queryA(Query::Select().EqualTo("field_name3", 30));
+    QueryObject queryB(Query::Select().EqualTo("field_name1", true));
+    EXPECT_EQ(store->AddSubscribe("subscribe_A", queryA, false), E_OK);
+    EXPECT_EQ(store->AddSubscribe("subscribe_B", queryB, false), E_OK);
+    EXPECT_EQ(store->AddSubscribe("subscribe_C", queryA, false), E_OK);
+
+    /**
+     * @tc.steps:step3. Put data matches the condition of A and C.
+     * @tc.expected: step3. the water mark of A and C is updated, B is not.
+     */
+    std::string json = R"({"field_name1":false,"field_name2":true,"field_name3":30})";
+    Value value(json.begin(), json.end());
+    IOption option;
+    option.dataType = IOption::SYNC_DATA;
+    EXPECT_EQ(conn->Put(option, KEY1, value), E_OK);
+    EXPECT_TRUE(IsSubscribeWaterMarkExist(store, "subscribe_A"));
+    EXPECT_FALSE(IsSubscribeWaterMarkExist(store, "subscribe_B"));
+    EXPECT_TRUE(IsSubscribeWaterMarkExist(store, "subscribe_C"));
+
+    /**
+     * @tc.steps:step4. Remove A and C, update the data to match B.
+     * @tc.expected: step4. the water mark of B is updated.
+     */
+    EXPECT_EQ(store->RemoveSubscribe(std::vector<std::string> {"subscribe_A", "subscribe_C"}), E_OK);
+    json = R"({"field_name1":true,"field_name2":true,"field_name3":40})";
+    value.assign(json.begin(), json.end());
+    EXPECT_EQ(conn->Put(option, KEY1, value), E_OK);
+    EXPECT_TRUE(IsSubscribeWaterMarkExist(store, "subscribe_B"));
+    EXPECT_EQ(store->RemoveSubscribe("subscribe_B"), E_OK);
+
+    /**
+     * @tc.steps:step5. Close natural store
+     * @tc.expected: step5. Close ok
+     */
+    RefObject::KillAndDecObjRef(store);
+    KvDBManager::ReleaseDatabaseConnection(conn);
+}
@@ -1590,3 +1590,78 @@ HWTEST_F(DistributedDBStorageTransactionDataTest, GetBranchTag001, TestSize.Leve
         }
     }
 }
+
+/**
+  * @tc.name: ValueSliceDedup001
+  * @tc.desc: Test the slices of the large value edited are stored once.
+  * @tc.type: FUNC
+  * @tc.require:
+  * @tc.author: zhangqiquan
+  */
+HWTEST_F(DistributedDBStorageTransactionDataTest, ValueSliceDedup001, TestSize.Level1)
+{
+    /**
+     * @tc.steps:step1. Put a 1M value.
+     * @tc.expected: step1. The value is sliced and no slice is duplicated.
+     */
+    ASSERT_NE(g_naturalStore, nullptr);
+    Value value;
+    DistributedDBToolsUnitTest::GetRandomKeyValue(value, 1024 * 1024); // 1M
+    PutAndCommitEntry(KEY_1, value);
+    ValueEqualByKey(KEY_1, value);
+    ValueSliceStatistics statistics = g_naturalStore->GetValueSliceStatistics();
+    EXPECT_GT(statistics.sliceCount, 1ULL);
+    EXPECT_EQ(statistics.sliceBytes, value.size());
+    EXPECT_EQ(statistics.duplicatedCount, 0ULL);
+
+    /**
+     * @tc.steps:step2. Put the value with 100 bytes inserted in the middle.
+     * @tc.expected: step2. Most slices of the new value are stored already, and the value could be read.
+     */
+    Value editedValue = value;
+    editedValue.insert(editedValue.begin() + editedValue.size() / 2, 100, 'e'); // insert 100 bytes
+    PutAndCommitEntry(KEY_1, editedValue);
+    ValueEqualByKey(KEY_1, editedValue);
+    ValueSliceStatistics editedStatistics = g_naturalStore->GetValueSliceStatistics();
+    uint64_t editedBytes = editedStatistics.sliceBytes - statistics.sliceBytes;
+    EXPECT_EQ(editedBytes, editedValue.size());
+    EXPECT_GT(editedStatistics.duplicatedCount, 0ULL);
+    EXPECT_GT(editedStatistics.duplicatedBytes * 2, editedBytes); // over half of the bytes are deduplicated
+}
+
+/**
+  * @tc.name: ValueSliceDedup002
+  * @tc.desc: Test the slices synced are counted as skipped or received.
+  * @tc.type: FUNC
+  * @tc.require:
+  * @tc.author: zhangqiquan
+  */
+HWTEST_F(DistributedDBStorageTransactionDataTest, ValueSliceDedup002, TestSize.Level1)
+{
+    /**
+     * @tc.steps:step1. Check a slice not stored as the value slice sync does, then put it.
+     * @tc.expected: step1. The slice is not existed, and it is counted as received once put.
+     */
+    ASSERT_NE(g_naturalStore, nullptr);
+    ValueSliceStatistics statistics = g_naturalStore->GetValueSliceStatistics();
+    ValueSlice slice;
+    DistributedDBToolsUnitTest::GetRandomKeyValue(slice, 64 * 1024); // 64K
+    ValueSliceHash sliceHash;
+    ASSERT_EQ(DBCommon::CalcValueHash(slice, sliceHash), E_OK);
+    EXPECT_FALSE(g_naturalStore->IsValueSliceExisted(sliceHash));
+    EXPECT_EQ(g_naturalStore->PutValueSlice(sliceHash, slice), E_OK);
+    ValueSliceStatistics receivedStatistics = g_naturalStore->GetValueSliceStatistics();
+    EXPECT_EQ(receivedStatistics.syncSkippedCount, statistics.syncSkippedCount);
+    EXPECT_EQ(receivedStatistics.syncReceivedCount, statistics.syncReceivedCount + 1);
+    EXPECT_EQ(receivedStatistics.syncReceivedBytes, statistics.syncReceivedBytes + slice.size());
+
+    /**
+     * @tc.steps:step2. Check the slice again.
+     * @tc.expected: step2. The slice is existed and counted as skipped, no more bytes are received.
+     */
+    EXPECT_TRUE(g_naturalStore->IsValueSliceExisted(sliceHash));
+    ValueSliceStatistics skippedStatistics = g_naturalStore->GetValueSliceStatistics();
+    EXPECT_EQ(skippedStatistics.syncSkippedCount, statistics.syncSkippedCount + 1);
+    EXPECT_EQ(skippedStatistics.syncReceivedCount, receivedStatistics.syncReceivedCount);
+    EXPECT_EQ(skippedStatistics.syncReceivedBytes, receivedStatistics.syncReceivedBytes);
+}
@@ -23,6 +23,7 @@
 #include "ref_object.h"
 #include "single_ver_data_sync.h"
 #include "single_ver_sync_engine.h"
+#include "sync_message_queue.h"
 #include "version.h"
 #include "virtual_communicator_aggregator.h"
 #include "virtual_single_ver_sync_db_Interface.h"
@@ -59,6 +60,19 @@ namespace {
     VirtualCommunicator *g_communicator = nullptr;
     VirtualSingleVerSyncDBInterface *g_syncInterface = nullptr;
 
+    Message *BuildQueueMessage(const std::string &target, uint16_t type, uint32_t messageId, uint32_t sessionId,
+        uint32_t sequenceId)
+    {
+        Message *message = new (std::nothrow) Message(messageId);
+        if (message != nullptr) {
+            message->SetMessageType(type);
+            message->SetTarget(target);
+            message->SetSessionId(sessionId);
+            message->SetSequenceId(sequenceId);
+        }
+        return message;
+    }
+
     auto g_kvDelegateCallback = bind(&DistributedDBToolsUnitTest::KvStoreNbDelegateCallback,
         placeholders::_1, placeholders::_2, std::ref(g_kvDelegateStatus), std::ref(g_kvDelegatePtr));
 }
@@ -313,4 +327,105 @@ HWTEST_F(DistributeddbAntiDosSyncTest, AntiDosAttackSync003, TestSize.Level3)
     EXPECT_TRUE(g_syncEngine->GetDiscardMsgNum() > 0);
     EXPECT_TRUE(g_syncEngine->GetQueueCacheSize() > 0);
     g_communicatorAggregator->SetBlockValue(false);
+}
+
+/**
+ * @tc.name: Anti Dos attack Sync 004
+ * @tc.desc: Check the queued messages are taken by priority and device in turn, the retransmit is collapsed.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author: zhangqiquan
+ */
+HWTEST_F(DistributeddbAntiDosSyncTest, AntiDosAttackSync004, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. push two data requests of device A, one of device B, and then an ack of device A
+     * @tc.expected: step1. all of them are pushed, the retransmit of the first request is collapsed
+     */
+    SyncMessageQueue queue;
+    Message *dataA1 = BuildQueueMessage("A", TYPE_REQUEST, DATA_SYNC_MESSAGE, 1, 1);
+    Message *dataA2 = BuildQueueMessage("A", TYPE_REQUEST, DATA_SYNC_MESSAGE, 1, 2); // 2 is the second packet
+    Message *dataB = BuildQueueMessage("B", TYPE_REQUEST, DATA_SYNC_MESSAGE, 1, 1);
+    Message *ackA = BuildQueueMessage("A", TYPE_RESPONSE, DATA_SYNC_MESSAGE, 1, 1);
+    Message *resendA1 = BuildQueueMessage("A", TYPE_REQUEST, DATA_SYNC_MESSAGE, 1, 1);
+    ASSERT_TRUE(dataA1 != nullptr && dataA2 != nullptr && dataB != nullptr && ackA != nullptr && resendA1 != nullptr);
+    const int msgSize = 10; // 10 is the size of each message
+    EXPECT_TRUE(queue.Push(dataA1, msgSize));
+    EXPECT_TRUE(queue.Push(dataA2, msgSize));
+    EXPECT_TRUE(queue.Push(dataB, msgSize));
+    EXPECT_TRUE(queue.Push(ackA, msgSize));
+    EXPECT_FALSE(queue.Push(resendA1, msgSize));
+    delete resendA1;
+    EXPECT_EQ(queue.Size(), 4u); // 4 messages are queued
+    EXPECT_EQ(queue.CacheSize(), 4 * msgSize); // 4 messages are queued
+    /**
+     * @tc.steps: step2. pop all the messages
+     * @tc.expected: step2. the ack is the first, then device A and device B take turns
+     */
+    std::vector<Message *> expectOrder = {ackA, dataA1, dataB, dataA2};
+    for (Message *expect : expectOrder) {
+        int size = 0;
+        Message *message = queue.Pop(size);
+        EXPECT_EQ(message, expect);
+        EXPECT_EQ(size, msgSize);
+        delete message;
+    }
+    int size = 0;
+    EXPECT_EQ(queue.Pop(size), nullptr);
+    EXPECT_TRUE(queue.Empty());
+    EXPECT_EQ(queue.CacheSize(), 0);
+}
+
+/**
+ * @tc.name: Anti Dos attack Sync 005
+ * @tc.desc: Check the ack still enters the queue when the data fills up the cache.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author: zhangqiquan
+ */
+HWTEST_F(DistributeddbAntiDosSyncTest, AntiDosAttackSync005, TestSize.Level3)
+{
+    /**
+     * @tc.steps: step1. set block in function DispatchMessage and send data until some of them are discarded.
+     */
+    g_communicatorAggregator->SetBlockValue(true);
+    const std::string srcTarget = "001";
+    for (unsigned int index = 0; index < g_syncEngine->GetMaxExecNum() + TEST_THREE_THREAD; index++) {
+        std::vector<SendDataItem> outData;
+        DataRequestPacket *packet = new (std::nothrow) DataRequestPacket;
+        ASSERT_TRUE(packet != nullptr);
+        for (int outIndex = 0; outIndex < TEST_THREE_OUTDATA; outIndex++) {
+            GenericSingleVerKvEntry *kvEntry = new (std::nothrow) GenericSingleVerKvEntry();
+            ASSERT_TRUE(kvEntry != nullptr);
+            outData.push_back(kvEntry);
+        }
+        packet->SetData(outData);
+        packet->SetSendCode(E_OK);
+        packet->SetVersion(SOFTWARE_VERSION_CURRENT);
+        Message *message = BuildQueueMessage(srcTarget, TYPE_REQUEST, DATA_SYNC_MESSAGE, index + 1, index + 1);
+        ASSERT_TRUE(message != nullptr);
+        ASSERT_EQ(message->SetExternalObject(packet), E_OK);
+        g_communicator->CallbackOnMessage(srcTarget, message);
+    }
+    unsigned int discardMsgNum = g_syncEngine->GetDiscardMsgNum();
+    int queueCacheSize = g_syncEngine->GetQueueCacheSize();
+    EXPECT_TRUE(discardMsgNum > 0);
+
+    /**
+     * @tc.steps: step2. limit the cache to the queued data and send an ack
+     * @tc.expected: step2. the ack is not discarded and enters the queue
+     */
+    g_syncEngine->SetMaxQueueCacheSize(queueCacheSize);
+    DataAckPacket *ackPacket = new (std::nothrow) DataAckPacket;
+    ASSERT_TRUE(ackPacket != nullptr);
+    ackPacket->SetData(0);
+    ackPacket->SetRecvCode(E_OK);
+    ackPacket->SetVersion(SOFTWARE_VERSION_CURRENT);
+    Message *ack = BuildQueueMessage(srcTarget, TYPE_RESPONSE, DATA_SYNC_MESSAGE, 1, 1);
+    ASSERT_TRUE(ack != nullptr);
+    ASSERT_EQ(ack->SetExternalObject(ackPacket), E_OK);
+    g_communicator->CallbackOnMessage(srcTarget, ack);
+    EXPECT_EQ(g_syncEngine->GetDiscardMsgNum(), discardMsgNum);
+    EXPECT_TRUE(g_syncEngine->GetQueueCacheSize() > queueCacheSize);
+    g_communicatorAggregator->SetBlockValue(false);
 }
\ No newline at end of file
@@ -13,6 +13,7 @@
 * limitations under the License.
 */
 #ifdef RELATIONAL_STORE
+#include <atomic>
 #include <gtest/gtest.h>
 
 #include "db_common.h"
@@ -551,6 +552,63 @@ namespace {
         EXPECT_EQ(property.storeId, STORE_ID_1);
         EXPECT_EQ(property.userId, USER_ID);
     }
+
+    void PutBatchToVirtualDevice(int begin, int end, Timestamp timestamp, uint64_t flag)
+    {
+        std::vector<VirtualRowData> dataList;
+        for (int id = begin; id < end; ++id) {
+            std::map<std::string, DataValue> dataMap;
+            GenerateValue(dataMap, g_fieldInfoList);
+            dataMap["ID"] = static_cast<int64_t>(id);
+            dataMap["AGE"] = static_cast<int64_t>(timestamp);
+            VirtualRowData virtualRowData;
+            for (const auto &item : dataMap) {
+                virtualRowData.objectData.PutDataValue(item.first, item.second);
+            }
+            std::string hashKey = "hash_" + std::to_string(id);
+            virtualRowData.logInfo.hashKey.assign(hashKey.begin(), hashKey.end());
+            virtualRowData.logInfo.timestamp = timestamp + static_cast<Timestamp>(id);
+            virtualRowData.logInfo.wTimestamp = virtualRowData.logInfo.timestamp;
+            virtualRowData.logInfo.flag = flag;
+            dataList.push_back(std::move(virtualRowData));
+        }
+        g_deviceB->PutData(g_tableName, dataList);
+    }
+
+    int64_t GetCount(const std::string &sql)
+    {
+        sqlite3 *db = nullptr;
+        EXPECT_EQ(GetDB(db), SQLITE_OK);
+        sqlite3_stmt *stmt = nullptr;
+        int64_t count = -1;
+        if (SQLiteUtils::GetStatement(db, sql, stmt) == E_OK) {
+            if (SQLiteUtils::StepWithRetry(stmt, false) == SQLiteUtils::MapSQLiteErrno(SQLITE_ROW)) {
+                count = sqlite3_column_int64(stmt, 0);
+            }
+            int errCode = E_OK;
+            SQLiteUtils::ResetStatement(stmt, true, errCode);
+        }
+        sqlite3_close(db);
+        return count;
+    }
+
+    // The DDL on the device table of device B run by the connections opened after EnableDeviceTableDdlTrace
+    std::atomic<int> g_deviceTableDdlCount = 0;
+
+    int TraceDeviceTableDdl(unsigned, void *, void *, void *sql)
+    {
+        std::string text = static_cast<const char *>(sql);
+        if (text.find("CREATE") != std::string::npos &&
+            text.find(GetDeviceTableName(g_tableName)) != std::string::npos) {
+            g_deviceTableDdlCount++;
+        }
+        return 0;
+    }
+
+    int EnableDeviceTableDdlTrace(sqlite3 *db, const char **, const struct sqlite3_api_routines *)
+    {
+        return sqlite3_trace_v2(db, SQLITE_TRACE_STMT, TraceDeviceTableDdl, nullptr);
+    }
 }
 
 class DistributedDBRelationalVerP2PSyncTest : public testing::Test {
@@ -1238,4 +1296,109 @@ HWTEST_F(DistributedDBRelationalVerP2PSyncTest, observer002, TestSize.Level3)
     std::this_thread::sleep_for(std::chrono::minutes(1));
     delete observer;
 }
+
+/**
+* @tc.name: BulkSync001
+* @tc.desc: Test a big batch of insert, update and delete data is saved by the bulk apply.
+* @tc.type: FUNC
+* @tc.require:
+* @tc.author: zhangqiquan
+*/
+HWTEST_F(DistributedDBRelationalVerP2PSyncTest, BulkSync001, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. device B put 100 records and push to device A
+     * @tc.expected: step1. device A has 100 records and 100 logs of device B
+     */
+    const int recordCount = 100;
+    std::vector<RelationalVirtualDevice *> remoteDevices = {g_deviceB};
+    PrepareBasicTable(g_tableName, g_fieldInfoList, remoteDevices);
+    PutBatchToVirtualDevice(0, recordCount, 1, 0);
+    Query query = Query::Select(g_tableName);
+    EXPECT_EQ(g_deviceB->GenericVirtualDevice::Sync(SYNC_MODE_PUSH_ONLY, query, true), E_OK);
+    const std::string deviceTable = GetDeviceTableName(g_tableName);
+    const std::string logTable = DBConstant::RELATIONAL_PREFIX + g_tableName + "_log";
+    EXPECT_EQ(GetCount("SELECT COUNT(*) FROM " + deviceTable + ";"), recordCount);
+    EXPECT_EQ(GetCount("SELECT COUNT(*) FROM " + logTable + " WHERE data_key IN (SELECT rowid FROM " +
+        deviceTable + ");"), recordCount);
+    const std::string sumWriteTimestamp = "SELECT SUM(wtimestamp) FROM " + logTable + ";";
+    int64_t oldSumWriteTimestamp = GetCount(sumWriteTimestamp);
+    /**
+     * @tc.steps: step2. device B delete the first half, update the second half and push to device A
+     * @tc.expected: step2. device A has the second half updated, the logs of the first half are deleted
+     */
+    const Timestamp newTimestamp = 1000; // later than all the records before
+    PutBatchToVirtualDevice(0, recordCount / 2, newTimestamp, DataItem::DELETE_FLAG); // 2 is half
+    PutBatchToVirtualDevice(recordCount / 2, recordCount, newTimestamp, 0); // 2 is half
+    EXPECT_EQ(g_deviceB->GenericVirtualDevice::Sync(SYNC_MODE_PUSH_ONLY, query, true), E_OK);
+    EXPECT_EQ(GetCount("SELECT COUNT(*) FROM " + deviceTable + " WHERE AGE = " + std::to_string(newTimestamp) +
+        ";"), recordCount / 2); // 2 is half
+    EXPECT_EQ(GetCount("SELECT COUNT(*) FROM " + deviceTable + ";"), recordCount / 2); // 2 is half
+    EXPECT_EQ(GetCount("SELECT COUNT(*) FROM " + logTable + " WHERE flag&0x01<>0 AND data_key=-1;"),
+        recordCount / 2); // 2 is half
+    EXPECT_EQ(GetCount(sumWriteTimestamp), oldSumWriteTimestamp); // the write timestamp of the existing log is kept
+}
+
+/**
+* @tc.name: DeviceTable001
+* @tc.desc: Test the device tables of the devices are created once and kept by the later sync.
+* @tc.type: FUNC
+* @tc.require:
+* @tc.author: zhangqiquan
+*/
+HWTEST_F(DistributedDBRelationalVerP2PSyncTest, DeviceTable001, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. reopen the store to trace the DDL on all its connections
+     * @tc.expected: step1. open store ok
+     */
+    ASSERT_EQ(sqlite3_auto_extension(reinterpret_cast<void (*)(void)>(EnableDeviceTableDdlTrace)), SQLITE_OK);
+    ASSERT_EQ(g_mgr.CloseStore(g_rdbDelegatePtr), OK);
+    g_rdbDelegatePtr = nullptr;
+    OpenStore();
+    g_deviceTableDdlCount = 0;
+    /**
+     * @tc.steps: step2. device B push twice to device A
+     * @tc.expected: step2. device A has the data of device B, the second push runs no DDL on the device table
+     */
+    std::vector<RelationalVirtualDevice *> remoteDevices = {g_deviceB, g_deviceC};
+    PrepareBasicTable(g_tableName, g_fieldInfoList, remoteDevices);
+    Query query = Query::Select(g_tableName);
+    PutBatchToVirtualDevice(0, 1, 1, 0);
+    EXPECT_EQ(g_deviceB->GenericVirtualDevice::Sync(SYNC_MODE_PUSH_ONLY, query, true), E_OK);
+    const std::string deviceTable = GetDeviceTableName(g_tableName);
+    EXPECT_EQ(GetCount("SELECT COUNT(*) FROM " + deviceTable + ";"), 1);
+    int ddlCount = g_deviceTableDdlCount.load();
+    EXPECT_GT(ddlCount, 0);
+    int64_t schemaVersion = GetCount("PRAGMA schema_version;");
+    PutBatchToVirtualDevice(1, 2, 2, 0); // 2 is the second record
+    EXPECT_EQ(g_deviceB->GenericVirtualDevice::Sync(SYNC_MODE_PUSH_ONLY, query, true), E_OK);
+    EXPECT_EQ(GetCount("SELECT COUNT(*) FROM " + deviceTable + ";"), 2); // 2 records
+    EXPECT_EQ(g_deviceTableDdlCount.load(), ddlCount);
+    EXPECT_EQ(GetCount("PRAGMA schema_version;"), schemaVersion);
+    /**
+     * @tc.steps: step3. device B offline and online again, then device A push to device B
+     * @tc.expected: step3. the ability sync of device B runs again and keeps its device table without any DDL
+     */
+    g_communicatorAggregator->OfflineDevice(DEVICE_B);
+    g_communicatorAggregator->OnlineDevice(DEVICE_B);
+    BlockSync(SyncMode::SYNC_MODE_PUSH_ONLY, OK, {DEVICE_B});
+    EXPECT_EQ(g_deviceTableDdlCount.load(), ddlCount);
+    EXPECT_EQ(GetCount("PRAGMA schema_version;"), schemaVersion);
+    /**
+     * @tc.steps: step4. device C push to device A, then device B push again
+     * @tc.expected: step4. the device table of device C is created, device B still push to its own table
+     */
+    EXPECT_EQ(g_deviceC->GenericVirtualDevice::Sync(SYNC_MODE_PUSH_ONLY, query, true), E_OK);
+    const std::string deviceTableC = DBConstant::RELATIONAL_PREFIX + g_tableName + "_" +
+        DBCommon::TransferStringToHex(DBCommon::TransferHashString(DEVICE_C));
+    EXPECT_EQ(GetCount("SELECT COUNT(*) FROM sqlite_master WHERE type='table' AND name='" + deviceTableC + "';"), 1);
+    schemaVersion = GetCount("PRAGMA schema_version;");
+    PutBatchToVirtualDevice(2, 3, 3, 0); // 3 is the third record
+    EXPECT_EQ(g_deviceB->GenericVirtualDevice::Sync(SYNC_MODE_PUSH_ONLY, query, true), E_OK);
+    EXPECT_EQ(GetCount("SELECT COUNT(*) FROM " + deviceTable + ";"), 3); // 3 records
+    EXPECT_EQ(g_deviceTableDdlCount.load(), ddlCount);
+    EXPECT_EQ(GetCount("PRAGMA schema_version;"), schemaVersion);
+    EXPECT_EQ(sqlite3_cancel_auto_extension(reinterpret_cast<void (*)(void)>(EnableDeviceTableDdlTrace)), 1);
+}
 #endif
\ No newline at end of file
@@ -16,9 +16,11 @@
 #include <gtest/gtest.h>
 
 #include "distributeddb_tools_unit_test.h"
+#include "generic_single_ver_kv_entry.h"
 #include "single_ver_data_message_schedule.h"
 #include "single_ver_data_packet.h"
 #include "single_ver_kv_sync_task_context.h"
+#include "single_ver_serialize_manager.h"
 
 using namespace testing::ext;
 using namespace DistributedDB;
@@ -26,6 +28,106 @@ using namespace DistributedDBUnitTest;
 using namespace std;
 
 namespace {
+    // The msg as received from the peer, serialized and deserialized like the communicator does
+    void ReceiveMsg(DistributedDB::Message *&message)
+    {
+        uint32_t length = SingleVerSerializeManager::CalculateLen(message);
+        ASSERT_GT(length, 0u);
+        std::vector<uint8_t> buffer(length, 0);
+        ASSERT_EQ(SingleVerSerializeManager::Serialization(buffer.data(), length, message), E_OK);
+        auto *received = new (std::nothrow) DistributedDB::Message(message->GetMessageId());
+        ASSERT_TRUE(received != nullptr);
+        received->SetMessageType(message->GetMessageType());
+        received->SetSessionId(message->GetSessionId());
+        received->SetSequenceId(message->GetSequenceId());
+        received->SetTarget(message->GetTarget());
+        delete message;
+        message = received;
+        ASSERT_EQ(SingleVerSerializeManager::DeSerialization(buffer.data(), length, message), E_OK);
+    }
+
+    void CheckBufferedMsgData(bool isCompressed)
+    {
+        /**
+         * @tc.steps: step1. put data msg sequence_3, sequence_2 and then sequence_1
+         * @tc.expected: get nullptr until sequence_1 is put
+         */
+        SingleVerDataMessageSchedule msgSchedule;
+        auto *context = new SingleVerKvSyncTaskContext();
+        context->SetRemoteSoftwareVersion(SOFTWARE_VERSION_CURRENT);
+        DataSyncMessageInfo info;
+        info.messageId_ = DATA_SYNC_MESSAGE;
+        info.messageType_ = TYPE_REQUEST;
+        info.sessionId_ = 10;
+        info.version_ = SOFTWARE_VERSION_CURRENT;
+        bool isNeedHandle = true;
+        bool isNeedContinue = true;
+        const uint32_t itemCount = 10;
+        for (uint32_t i = 3; i >= 1; i--) {
+            info.sequenceId_ = i;
+            info.packetId_ = i;
+            DistributedDB::Message *message = nullptr;
+            DistributedDBToolsUnitTest::BuildMessage(info, message);
+            ASSERT_TRUE(message != nullptr);
+            std::vector<SendDataItem> data;
+            for (uint32_t j = 0; j < itemCount; j++) {
+                auto *kvEntry = new (std::nothrow) GenericSingleVerKvEntry();
+                ASSERT_TRUE(kvEntry != nullptr);
+                kvEntry->SetKey(Key(1, static_cast<uint8_t>(i)));
+                kvEntry->SetValue(Value(j + 1, static_cast<uint8_t>(i)));
+                kvEntry->SetTimestamp(i * itemCount + j);
+                data.push_back(kvEntry);
+            }
+            auto *packet = const_cast<DataRequestPacket *>(message->GetObject<DataRequestPacket>());
+            packet->SetData(data);
+            message->SetTarget("DEVICE_A");
+            if (isCompressed) {
+                std::vector<uint8_t> compressData;
+                ASSERT_EQ(GenericSingleVerKvEntry::Compress(packet->GetData(), compressData,
+                    { CompressAlgorithm::ZLIB, SOFTWARE_VERSION_CURRENT }), E_OK);
+                packet->SetCompressData(compressData);
+                packet->SetCompressDataMark();
+                packet->SetCompressAlgo(CompressAlgorithm::ZLIB);
+                ReceiveMsg(message);
+                ASSERT_TRUE(message->GetObject<DataRequestPacket>()->IsCompressData());
+            }
+            msgSchedule.PutMsg(message);
+            if (i > 1) {
+                Message *msg = msgSchedule.MoveNextMsg(context, isNeedHandle, isNeedContinue);
+                ASSERT_TRUE(msg == nullptr);
+            }
+        }
+        /**
+         * @tc.steps: step2. get msg
+         * @tc.expected: get msg by sequence_1, sequence_2, sequence_3 with the same head and data as put,
+         *     and the msgs buffered after sequence_1 are serialized as raw data
+         */
+        for (uint32_t i = 1; i <= 3; i++) {
+            Message *msg = msgSchedule.MoveNextMsg(context, isNeedHandle, isNeedContinue);
+            ASSERT_TRUE(msg != nullptr);
+            EXPECT_EQ(isNeedHandle, true);
+            EXPECT_EQ(msg->GetMessageId(), static_cast<uint32_t>(DATA_SYNC_MESSAGE));
+            EXPECT_EQ(msg->GetMessageType(), TYPE_REQUEST);
+            EXPECT_EQ(msg->GetSessionId(), 10u);
+            EXPECT_EQ(msg->GetSequenceId(), i);
+            EXPECT_EQ(msg->GetTarget(), "DEVICE_A");
+            const DataRequestPacket *packet = msg->GetObject<DataRequestPacket>();
+            ASSERT_TRUE(packet != nullptr);
+            EXPECT_EQ(packet->GetPacketId(), i);
+            EXPECT_EQ(packet->IsCompressData(), isCompressed && i == 1);
+            const std::vector<SendDataItem> &data = packet->GetData();
+            ASSERT_EQ(data.size(), itemCount);
+            for (uint32_t j = 0; j < itemCount; j++) {
+                EXPECT_EQ(data[j]->GetKey(), Key(1, static_cast<uint8_t>(i)));
+                EXPECT_EQ(data[j]->GetValue(), Value(j + 1, static_cast<uint8_t>(i)));
+                EXPECT_EQ(data[j]->GetTimestamp(), i * itemCount + j);
+            }
+            msgSchedule.ScheduleInfoHandle(isNeedHandle, false, msg);
+            delete msg;
+        }
+        RefObject::KillAndDecObjRef(context);
+        context = nullptr;
+    }
 }
 
 class DistributedDBSingleVerMsgScheduleTest : public testing::Test {
@@ -454,4 +556,17 @@ HWTEST_F(DistributedDBSingleVerMsgScheduleTest, MsgSchedule007, TestSize.Level0)
     }
     RefObject::KillAndDecObjRef(context);
     context = nullptr;
+}
+
+/**
+ * @tc.name: MsgSchedule008
+ * @tc.desc: Test MsgSchedule function keep the data of the raw or compressed msg waiting for the lower sequenceId
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author: zhangqiquan
+ */
+HWTEST_F(DistributedDBSingleVerMsgScheduleTest, MsgSchedule008, TestSize.Level0)
+{
+    CheckBufferedMsgData(false);
+    CheckBufferedMsgData(true);
 }
\ No newline at end of file
@@ -17,12 +17,16 @@
 #include <gtest/gtest.h>
 #include <thread>
 
+#include "db_common.h"
 #include "db_constant.h"
 #include "distributeddb_data_generate_unit_test.h"
 #include "distributeddb_tools_unit_test.h"
 #include "kv_store_nb_delegate.h"
 #include "kv_virtual_device.h"
+#include "kvdb_manager.h"
 #include "platform_specific.h"
+#include "single_ver_data_packet.h"
+#include "sqlite_single_ver_natural_store.h"
 
 using namespace testing::ext;
 using namespace DistributedDB;
@@ -52,6 +56,28 @@ namespace {
     // the type of g_kvDelegateCallback is function<void(DBStatus, KvStoreDelegate*)>
     auto g_kvDelegateCallback = bind(&DistributedDBToolsUnitTest::KvStoreNbDelegateCallback,
         placeholders::_1, placeholders::_2, std::ref(g_kvDelegateStatus), std::ref(g_kvDelegatePtr));
+
+    SyncDataCacheMetrics GetSyncDataCacheMetrics()
+    {
+        KvDBProperties prop;
+        prop.SetStringProp(KvDBProperties::USER_ID, USER_ID);
+        prop.SetStringProp(KvDBProperties::APP_ID, APP_ID);
+        prop.SetStringProp(KvDBProperties::STORE_ID, STORE_ID);
+        std::string identifier = DBCommon::TransferHashString(USER_ID + "-" + APP_ID + "-" + STORE_ID);
+        prop.SetStringProp(KvDBProperties::IDENTIFIER_DATA, identifier);
+        prop.SetStringProp(KvDBProperties::IDENTIFIER_DIR, DBCommon::TransferStringToHex(identifier));
+        prop.SetStringProp(KvDBProperties::DATA_DIR, g_testDir);
+        prop.SetIntProp(KvDBProperties::DATABASE_TYPE, KvDBProperties::SINGLE_VER_TYPE);
+        int errCode = E_OK;
+        // the store is opened by the delegate, this only takes one more reference of it.
+        auto store = static_cast<SQLiteSingleVerNaturalStore *>(KvDBManager::OpenDatabase(prop, errCode));
+        if (store == nullptr) {
+            return {};
+        }
+        SyncDataCacheMetrics metrics = store->GetSyncDataCacheMetrics();
+        RefObject::DecObjRef(store);
+        return metrics;
+    }
 }
 
 class DistributedDBSingleVerP2PSyncTest : public testing::Test {
@@ -2288,3 +2314,235 @@ HWTEST_F(DistributedDBSingleVerP2PSyncTest, DatabaseOfflineCallback001, TestSize
     StoreStatusNotifier nullCallback;
     g_mgr.SetStoreStatusNotifier(nullCallback);
 }
+
+/**
+ * @tc.name: MultiDevicePushSync001
+ * @tc.desc: Test push the data of several packets to devices, the devices share the data read and compressed.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author: zhangqiquan
+ */
+HWTEST_F(DistributedDBSingleVerP2PSyncTest, MultiDevicePushSync001, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. deviceA reopen the store with compression and put the data larger than one packet
+     * @tc.expected: step1. put should return OK.
+     */
+    ASSERT_EQ(g_mgr.CloseKvStore(g_kvDelegatePtr), OK);
+    g_kvDelegatePtr = nullptr;
+    KvStoreNbDelegate::Option option;
+    option.isNeedCompressOnSync = true;
+    option.compressionRate = 100; // 100 means compress the data whatever the rate is
+    g_mgr.GetKvStore(STORE_ID, option, g_kvDelegateCallback);
+    ASSERT_EQ(g_kvDelegateStatus, OK);
+    ASSERT_TRUE(g_kvDelegatePtr != nullptr);
+    const int recordCount = 10;
+    const size_t valueSize = 1024 * 1024; // 1M
+    std::vector<Key> keys;
+    for (int i = 0; i < recordCount; i++) {
+        Key key = {'k', static_cast<uint8_t>('0' + i)};
+        Value value(valueSize, static_cast<uint8_t>('a' + i));
+        ASSERT_EQ(g_kvDelegatePtr->Put(key, value), OK);
+        keys.push_back(key);
+    }
+    /**
+     * @tc.steps: step2. deviceA push to deviceB and then to deviceC with the same water mark
+     * @tc.expected: step2. deviceB reads and compresses each packet once, deviceC copies all of them from the cache.
+     */
+    std::vector<std::string> devices;
+    devices.push_back(g_deviceB->GetDeviceId());
+    devices.push_back(g_deviceC->GetDeviceId());
+    std::map<std::string, DBStatus> result;
+    for (const auto &device : devices) {
+        ASSERT_EQ(g_tool.SyncTest(g_kvDelegatePtr, { device }, SYNC_MODE_PUSH_ONLY, result), OK);
+        ASSERT_EQ(result.size(), 1u);
+        EXPECT_EQ(result[device], OK);
+        result.clear();
+        if (device == devices.front()) {
+            SyncDataCacheMetrics firstMetrics = GetSyncDataCacheMetrics();
+            EXPECT_GT(firstMetrics.readBuildCount, 0u);
+            EXPECT_EQ(firstMetrics.readHitCount, 0u);
+            EXPECT_GT(firstMetrics.compressBuildCount, 0u);
+            EXPECT_EQ(firstMetrics.compressHitCount, 0u);
+        }
+    }
+    SyncDataCacheMetrics metrics = GetSyncDataCacheMetrics();
+    EXPECT_EQ(metrics.readHitCount, metrics.readBuildCount);
+    EXPECT_EQ(metrics.compressHitCount, metrics.compressBuildCount);
+    for (int i = 0; i < recordCount; i++) {
+        Value value(valueSize, static_cast<uint8_t>('a' + i));
+        VirtualDataItem item;
+        EXPECT_EQ(g_deviceB->GetData(keys[i], item), E_OK);
+        EXPECT_EQ(item.value, value);
+        EXPECT_EQ(g_deviceC->GetData(keys[i], item), E_OK);
+        EXPECT_EQ(item.value, value);
+    }
+    /**
+     * @tc.steps: step3. deviceA update one record and push to deviceB and deviceC at the same time
+     * @tc.expected: step3. deviceB and deviceC get the new value instead of the read before.
+     */
+    Value newValue = {'n', 'e', 'w'};
+    ASSERT_EQ(g_kvDelegatePtr->Put(keys[0], newValue), OK);
+    ASSERT_EQ(g_tool.SyncTest(g_kvDelegatePtr, devices, SYNC_MODE_PUSH_ONLY, result), OK);
+    ASSERT_EQ(result.size(), devices.size());
+    for (const auto &pair : result) {
+        EXPECT_EQ(pair.second, OK);
+    }
+    VirtualDataItem item;
+    EXPECT_EQ(g_deviceB->GetData(keys[0], item), E_OK);
+    EXPECT_EQ(item.value, newValue);
+    EXPECT_EQ(g_deviceC->GetData(keys[0], item), E_OK);
+    EXPECT_EQ(item.value, newValue);
+}
+
+/**
+ * @tc.name: DigestSync001
+ * @tc.desc: Test the first push only sends the data of the buckets different from the remote digest.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author: zhangqiquan
+ */
+HWTEST_F(DistributedDBSingleVerP2PSyncTest, DigestSync001, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. reopen deviceA with digest sync, put 100 records then update 5 and delete 5 of them
+     * @tc.expected: step1. put, update and delete should return OK.
+     */
+    ASSERT_EQ(g_mgr.CloseKvStore(g_kvDelegatePtr), OK);
+    g_kvDelegatePtr = nullptr;
+    ASSERT_EQ(g_mgr.DeleteKvStore(STORE_ID), OK);
+    KvStoreNbDelegate::Option option;
+    option.isNeedDigestSync = true;
+    g_mgr.GetKvStore(STORE_ID, option, g_kvDelegateCallback);
+    ASSERT_TRUE(g_kvDelegateStatus == OK);
+    ASSERT_TRUE(g_kvDelegatePtr != nullptr);
+    const int recordCount = 100;
+    const int changedCount = 5;
+    std::vector<Key> keys;
+    for (int i = 0; i < recordCount; i++) {
+        Key key = {'k', static_cast<uint8_t>(i)};
+        ASSERT_EQ(g_kvDelegatePtr->Put(key, {'v', static_cast<uint8_t>(i)}), OK);
+        keys.push_back(key);
+    }
+    Value newValue = {'n', 'e', 'w'};
+    for (int i = 0; i < changedCount; i++) {
+        ASSERT_EQ(g_kvDelegatePtr->Put(keys[i], newValue), OK);
+        ASSERT_EQ(g_kvDelegatePtr->Delete(keys[i + changedCount]), OK);
+    }
+    /**
+     * @tc.steps: step2. deviceB has the first 90 records before they are changed
+     */
+    const int remoteCount = 90;
+    for (int i = 0; i < remoteCount; i++) {
+        ASSERT_EQ(g_deviceB->PutData(keys[i], {'v', static_cast<uint8_t>(i)}, i + 1, 0), E_OK);
+    }
+    g_deviceB->SetDigestEnable(true);
+    /**
+     * @tc.steps: step3. deviceA push to deviceB
+     * @tc.expected: step3. sync should return OK, most of the same records are not sent.
+     */
+    std::atomic<size_t> sentCount(0);
+    g_communicatorAggregator->RegOnDispatch([&sentCount](const std::string &target, DistributedDB::Message *msg) {
+        if (target == DEVICE_B && msg->GetMessageId() == DATA_SYNC_MESSAGE &&
+            msg->GetMessageType() == TYPE_REQUEST) {
+            const DataRequestPacket *packet = msg->GetObject<DataRequestPacket>();
+            if (packet != nullptr) {
+                sentCount += packet->GetData().size();
+            }
+        }
+    });
+    std::vector<std::string> devices = {g_deviceB->GetDeviceId()};
+    std::map<std::string, DBStatus> result;
+    DBStatus status = g_tool.SyncTest(g_kvDelegatePtr, devices, SYNC_MODE_PUSH_ONLY, result);
+    g_communicatorAggregator->RegOnDispatch(nullptr);
+    ASSERT_EQ(status, OK);
+    EXPECT_EQ(result[DEVICE_B], OK);
+    EXPECT_LT(sentCount, static_cast<size_t>(recordCount / 2)); // 2 is half of the records
+    /**
+     * @tc.steps: step4. check the changed, the deleted and the new records on deviceB
+     * @tc.expected: step4. deviceB has the new value of all the records, and the deleted records are deleted.
+     */
+    for (int i = 0; i < changedCount; i++) {
+        VirtualDataItem item;
+        EXPECT_EQ(g_deviceB->GetData(keys[i], item), E_OK);
+        EXPECT_EQ(item.value, newValue);
+    }
+    for (int i = changedCount; i < changedCount * 2; i++) { // 2 is the updated and the deleted
+        Key hashKey;
+        DistributedDBToolsUnitTest::CalcHash(keys[i], hashKey);
+        VirtualDataItem item;
+        EXPECT_EQ(g_deviceB->GetData(hashKey, item), E_OK);
+        EXPECT_TRUE((item.flag & VirtualDataItem::DELETE_FLAG) != 0);
+    }
+    for (int i = remoteCount; i < recordCount; i++) {
+        VirtualDataItem item;
+        EXPECT_EQ(g_deviceB->GetData(keys[i], item), E_OK);
+        EXPECT_EQ(item.value, Value({'v', static_cast<uint8_t>(i)}));
+    }
+}
+
+/**
+ * @tc.name: DigestSync002
+ * @tc.desc: Test all the data is pushed when the remote device not answers the digest.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author: zhangqiquan
+ */
+HWTEST_F(DistributedDBSingleVerP2PSyncTest, DigestSync002, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. reopen deviceA with digest sync and put 10 records, deviceB has the same records
+     * @tc.expected: step1. put should return OK.
+     */
+    ASSERT_EQ(g_mgr.CloseKvStore(g_kvDelegatePtr), OK);
+    g_kvDelegatePtr = nullptr;
+    ASSERT_EQ(g_mgr.DeleteKvStore(STORE_ID), OK);
+    KvStoreNbDelegate::Option option;
+    option.isNeedDigestSync = true;
+    g_mgr.GetKvStore(STORE_ID, option, g_kvDelegateCallback);
+    ASSERT_TRUE(g_kvDelegateStatus == OK);
+    ASSERT_TRUE(g_kvDelegatePtr != nullptr);
+    const int recordCount = 10;
+    std::vector<Key> keys;
+    for (int i = 0; i < recordCount; i++) {
+        Key key = {'k', static_cast<uint8_t>(i)};
+        Value value = {'v', static_cast<uint8_t>(i)};
+        ASSERT_EQ(g_kvDelegatePtr->Put(key, value), OK);
+        ASSERT_EQ(g_deviceB->PutData(key, value, i + 1, 0), E_OK);
+        keys.push_back(key);
+    }
+    g_deviceB->SetDigestEnable(true);
+    /**
+     * @tc.steps: step2. drop all the digest acks of deviceB, deviceA push to deviceB
+     * @tc.expected: step2. sync should return OK, all the records are sent after the digest ack timeout.
+     */
+    const uint32_t dropTimes = 10; // 10 is more than the retry times of the digest request
+    g_communicatorAggregator->SetDropMessageTypeByDevice(DEVICE_B, DIGEST_SYNC_MESSAGE, dropTimes);
+    std::atomic<size_t> sentCount(0);
+    g_communicatorAggregator->RegOnDispatch([&sentCount](const std::string &target, DistributedDB::Message *msg) {
+        if (target == DEVICE_B && msg->GetMessageId() == DATA_SYNC_MESSAGE &&
+            msg->GetMessageType() == TYPE_REQUEST) {
+            const DataRequestPacket *packet = msg->GetObject<DataRequestPacket>();
+            if (packet != nullptr) {
+                sentCount += packet->GetData().size();
+            }
+        }
+    });
+    std::vector<std::string> devices = {g_deviceB->GetDeviceId()};
+    std::map<std::string, DBStatus> result;
+    DBStatus status = g_tool.SyncTest(g_kvDelegatePtr, devices, SYNC_MODE_PUSH_ONLY, result);
+    g_communicatorAggregator->RegOnDispatch(nullptr);
+    g_communicatorAggregator->SetDropMessageTypeByDevice(DEVICE_B, DIGEST_SYNC_MESSAGE, 0);
+    ASSERT_EQ(status, OK);
+    EXPECT_EQ(result[DEVICE_B], OK);
+    EXPECT_GE(sentCount, static_cast<size_t>(recordCount));
+    /**
+     * @tc.steps: step3. check the records on deviceB
+     * @tc.expected: step3. deviceB has all the records.
+     */
+    for (int i = 0; i < recordCount; i++) {
+        VirtualDataItem item;
+        EXPECT_EQ(g_deviceB->GetData(keys[i], item), E_OK);
+        EXPECT_EQ(item.value, Value({'v', static_cast<uint8_t>(i)}));
+    }
+}
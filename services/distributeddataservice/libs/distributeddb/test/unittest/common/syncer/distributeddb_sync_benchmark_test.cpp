@@ -0,0 +1,417 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <sys/resource.h>
+
+#include "distributeddb_data_generate_unit_test.h"
+#include "distributeddb_tools_unit_test.h"
+#include "kv_store_nb_delegate.h"
+#include "kv_virtual_device.h"
+#include "platform_specific.h"
+#include "time_helper.h"
+
+using namespace testing::ext;
+using namespace DistributedDB;
+using namespace DistributedDBUnitTest;
+using namespace std;
+
+/*
+ * The benchmark of the sync between the local store and the virtual devices, the shape of the run is read from the
+ * environment, the result of each case is printed as one json line and appended to DDB_SYNC_BENCH_OUTPUT if set:
+ *   DDB_SYNC_BENCH_DEVICES      the number of the virtual devices, default 3
+ *   DDB_SYNC_BENCH_ROUNDS       the number of the syncs, default 10
+ *   DDB_SYNC_BENCH_ENTRIES      the entries written before each sync, default 100
+ *   DDB_SYNC_BENCH_KEY_SIZE     default 16
+ *   DDB_SYNC_BENCH_VALUE_SIZE   default 1024
+ *   DDB_SYNC_BENCH_LATENCY      the one way delay of the link in ms, default 0
+ *   DDB_SYNC_BENCH_BANDWIDTH    the bytes per second sent by each device, default 0 means unlimited
+ *   DDB_SYNC_BENCH_LOSS_RATE    the lost messages per ten thousand, default 0
+ */
+namespace {
+    string g_testDir;
+    const string STORE_ID = "kv_sync_benchmark";
+    const string DEVICE_PREFIX = "benchDevice";
+    const string QUERY_PREFIX = "Q";
+
+    KvStoreDelegateManager g_mgr(APP_ID, USER_ID);
+    KvStoreConfig g_config;
+    DistributedDBToolsUnitTest g_tool;
+    DBStatus g_kvDelegateStatus = INVALID_ARGS;
+    KvStoreNbDelegate* g_kvDelegatePtr = nullptr;
+    VirtualCommunicatorAggregator* g_communicatorAggregator = nullptr;
+    vector<KvVirtualDevice *> g_devices;
+
+    auto g_kvDelegateCallback = bind(&DistributedDBToolsUnitTest::KvStoreNbDelegateCallback,
+        placeholders::_1, placeholders::_2, std::ref(g_kvDelegateStatus), std::ref(g_kvDelegatePtr));
+
+    struct BenchmarkConfig {
+        uint32_t deviceNum = 3;
+        uint32_t rounds = 10;
+        uint32_t entries = 100;
+        uint32_t keySize = 16;
+        uint32_t valueSize = 1024;
+        VirtualLinkConfig link;
+    };
+    BenchmarkConfig g_benchConfig;
+
+    struct BenchmarkResult {
+        uint64_t entries = 0;
+        uint64_t failedSyncs = 0;
+        vector<uint64_t> latencies; // us of each sync
+        uint64_t elapsedTime = 0; // us of all the syncs
+        uint64_t cpuTime = 0; // us of user and system
+    };
+
+    uint64_t GetCpuTime()
+    {
+        struct rusage usage {};
+        getrusage(RUSAGE_SELF, &usage);
+        constexpr uint64_t microsecondsPerSecond = 1000000;
+        return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * microsecondsPerSecond +
+            usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+    }
+
+    uint64_t GetPeakRss()
+    {
+        struct rusage usage {};
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss; // KB on linux
+    }
+
+    void GenerateEntry(const string &prefix, uint32_t round, uint32_t index, Key &key, Value &value)
+    {
+        string keyStr = prefix + to_string(round) + "_" + to_string(index);
+        keyStr.resize(std::max<size_t>(keyStr.size(), g_benchConfig.keySize), '0');
+        key.assign(keyStr.begin(), keyStr.end());
+        DistributedDBToolsUnitTest::GetRandomKeyValue(value, g_benchConfig.valueSize);
+    }
+
+    void PutLocalEntries(const string &prefix, uint32_t round)
+    {
+        vector<Entry> entries;
+        for (uint32_t i = 0; i < g_benchConfig.entries; i++) {
+            Entry entry;
+            GenerateEntry(prefix, round, i, entry.key, entry.value);
+            entries.push_back(std::move(entry));
+        }
+        ASSERT_EQ(g_kvDelegatePtr->PutBatch(entries), OK);
+    }
+
+    void PutRemoteEntries(uint32_t round)
+    {
+        for (size_t dev = 0; dev < g_devices.size(); dev++) {
+            for (uint32_t i = 0; i < g_benchConfig.entries; i++) {
+                Key key;
+                Value value;
+                GenerateEntry(g_devices[dev]->GetDeviceId(), round, i, key, value);
+                g_devices[dev]->PutData(key, value,
+                    TimeHelper::GetSysCurrentTime() + g_devices[dev]->GetLocalTimeOffset(), 0);
+            }
+        }
+    }
+
+    uint64_t GetPercentile(vector<uint64_t> latencies, uint32_t percent)
+    {
+        if (latencies.empty()) {
+            return 0;
+        }
+        constexpr uint32_t percentBase = 100;
+        sort(latencies.begin(), latencies.end());
+        size_t index = (latencies.size() * percent + percentBase - 1) / percentBase;
+        return latencies[(index == 0) ? 0 : (index - 1)];
+    }
+
+    void ReportResult(const string &mode, const BenchmarkResult &result)
+    {
+        uint64_t sendBytes = 0;
+        uint64_t sendMessages = 0;
+        uint64_t lostMessages = 0;
+        for (const auto &[device, statistic] : g_communicatorAggregator->GetTrafficStatistics()) {
+            sendBytes += statistic.sendBytes;
+            sendMessages += statistic.sendMessages;
+            lostMessages += statistic.lostMessages;
+        }
+        constexpr double microsecondsPerSecond = 1000000.0;
+        double seconds = std::max<uint64_t>(result.elapsedTime, 1) / microsecondsPerSecond;
+        string json = "{\"mode\":\"" + mode + "\"" +
+            ",\"devices\":" + to_string(g_benchConfig.deviceNum) +
+            ",\"rounds\":" + to_string(g_benchConfig.rounds) +
+            ",\"entriesPerRound\":" + to_string(g_benchConfig.entries) +
+            ",\"keySize\":" + to_string(g_benchConfig.keySize) +
+            ",\"valueSize\":" + to_string(g_benchConfig.valueSize) +
+            ",\"latency\":" + to_string(g_benchConfig.link.latency) +
+            ",\"bandwidth\":" + to_string(g_benchConfig.link.bandwidth) +
+            ",\"lossRate\":" + to_string(g_benchConfig.link.lossRate) +
+            ",\"failedSyncs\":" + to_string(result.failedSyncs) +
+            ",\"entriesPerSecond\":" + to_string(static_cast<uint64_t>(result.entries / seconds)) +
+            ",\"bytesPerSecond\":" + to_string(static_cast<uint64_t>(sendBytes / seconds)) +
+            ",\"messages\":" + to_string(sendMessages) +
+            ",\"lostMessages\":" + to_string(lostMessages) +
+            ",\"p50Latency\":" + to_string(GetPercentile(result.latencies, 50)) + // 50 percentile
+            ",\"p99Latency\":" + to_string(GetPercentile(result.latencies, 99)) + // 99 percentile
+            ",\"peakRss\":" + to_string(GetPeakRss()) +
+            // all the devices run in this process, the cpu time is shared by the local store and the devices.
+            ",\"cpuPerDevice\":" + to_string(result.cpuTime / (g_benchConfig.deviceNum + 1)) + "}";
+        DistributedDBToolsUnitTest::PrintBenchmarkResult(json, "DDB_SYNC_BENCH_OUTPUT");
+    }
+
+    // prepare writes the entries of the round, sync returns the status of each device.
+    BenchmarkResult RunBenchmark(const function<void(uint32_t round)> &prepare,
+        const function<DBStatus(map<string, DBStatus> &)> &sync)
+    {
+        BenchmarkResult result;
+        g_communicatorAggregator->ResetTrafficStatistics();
+        uint64_t cpuStart = GetCpuTime();
+        for (uint32_t round = 0; round < g_benchConfig.rounds; round++) {
+            prepare(round);
+            map<string, DBStatus> statuses;
+            auto start = chrono::steady_clock::now();
+            DBStatus status = sync(statuses);
+            auto cost = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+            result.latencies.push_back(cost);
+            result.elapsedTime += cost;
+            if (status != OK) {
+                result.failedSyncs++;
+                continue;
+            }
+            for (const auto &[device, devStatus] : statuses) {
+                if (devStatus == OK) {
+                    result.entries += g_benchConfig.entries;
+                } else {
+                    LOGE("[SyncBenchmark] sync with %s failed, status=%d", device.c_str(), devStatus);
+                    result.failedSyncs++;
+                }
+            }
+        }
+        result.cpuTime = GetCpuTime() - cpuStart;
+        return result;
+    }
+
+    vector<string> GetDeviceIds()
+    {
+        vector<string> devices;
+        for (const auto &device : g_devices) {
+            devices.push_back(device->GetDeviceId());
+        }
+        return devices;
+    }
+}
+
+class DistributedDBSyncBenchmarkTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void DistributedDBSyncBenchmarkTest::SetUpTestCase(void)
+{
+    /**
+     * @tc.setup: Init datadir, the benchmark config and Virtual Communicator with the link model.
+     */
+    DistributedDBToolsUnitTest::TestDirInit(g_testDir);
+    g_config.dataDir = g_testDir;
+    g_mgr.SetKvStoreConfig(g_config);
+
+    g_benchConfig.deviceNum = std::max<uint64_t>(
+        DistributedDBToolsUnitTest::GetEnvValue("DDB_SYNC_BENCH_DEVICES", g_benchConfig.deviceNum), 1);
+    g_benchConfig.rounds = std::max<uint64_t>(
+        DistributedDBToolsUnitTest::GetEnvValue("DDB_SYNC_BENCH_ROUNDS", g_benchConfig.rounds), 1);
+    g_benchConfig.entries = std::max<uint64_t>(
+        DistributedDBToolsUnitTest::GetEnvValue("DDB_SYNC_BENCH_ENTRIES", g_benchConfig.entries), 1);
+    g_benchConfig.keySize =
+        DistributedDBToolsUnitTest::GetEnvValue("DDB_SYNC_BENCH_KEY_SIZE", g_benchConfig.keySize);
+    g_benchConfig.valueSize =
+        DistributedDBToolsUnitTest::GetEnvValue("DDB_SYNC_BENCH_VALUE_SIZE", g_benchConfig.valueSize);
+    g_benchConfig.link.latency = DistributedDBToolsUnitTest::GetEnvValue("DDB_SYNC_BENCH_LATENCY", 0);
+    g_benchConfig.link.bandwidth = DistributedDBToolsUnitTest::GetEnvValue("DDB_SYNC_BENCH_BANDWIDTH", 0);
+    g_benchConfig.link.lossRate = DistributedDBToolsUnitTest::GetEnvValue("DDB_SYNC_BENCH_LOSS_RATE", 0);
+
+    g_communicatorAggregator = new (std::nothrow) VirtualCommunicatorAggregator();
+    ASSERT_TRUE(g_communicatorAggregator != nullptr);
+    g_communicatorAggregator->SetLinkConfig(g_benchConfig.link);
+    RuntimeContext::GetInstance()->SetCommunicatorAggregator(g_communicatorAggregator);
+}
+
+void DistributedDBSyncBenchmarkTest::TearDownTestCase(void)
+{
+    /**
+     * @tc.teardown: Release virtual Communicator and clear data dir.
+     */
+    if (DistributedDBToolsUnitTest::RemoveTestDbFiles(g_testDir) != 0) {
+        LOGE("rm test db files error!");
+    }
+    RuntimeContext::GetInstance()->SetCommunicatorAggregator(nullptr);
+}
+
+void DistributedDBSyncBenchmarkTest::SetUp(void)
+{
+    DistributedDBToolsUnitTest::PrintTestCaseInfo();
+    /**
+     * @tc.setup: create the virtual devices, and get a KvStoreNbDelegate as the local device
+     */
+    KvStoreNbDelegate::Option option;
+    g_mgr.GetKvStore(STORE_ID, option, g_kvDelegateCallback);
+    ASSERT_TRUE(g_kvDelegateStatus == OK);
+    ASSERT_TRUE(g_kvDelegatePtr != nullptr);
+    for (uint32_t i = 0; i < g_benchConfig.deviceNum; i++) {
+        KvVirtualDevice *device = new (std::nothrow) KvVirtualDevice(DEVICE_PREFIX + to_string(i));
+        ASSERT_TRUE(device != nullptr);
+        g_devices.push_back(device);
+        VirtualSingleVerSyncDBInterface *syncInterface = new (std::nothrow) VirtualSingleVerSyncDBInterface();
+        ASSERT_TRUE(syncInterface != nullptr);
+        ASSERT_EQ(device->Initialize(g_communicatorAggregator, syncInterface), E_OK);
+    }
+    auto permissionCheckCallback = [] (const std::string &userId, const std::string &appId, const std::string &storeId,
+                                const std::string &deviceId, uint8_t flag) -> bool {
+                                return true;};
+    EXPECT_EQ(g_mgr.SetPermissionCheckCallback(permissionCheckCallback), OK);
+}
+
+void DistributedDBSyncBenchmarkTest::TearDown(void)
+{
+    /**
+     * @tc.teardown: Release the local store and the virtual devices
+     */
+    if (g_kvDelegatePtr != nullptr) {
+        ASSERT_EQ(g_mgr.CloseKvStore(g_kvDelegatePtr), OK);
+        g_kvDelegatePtr = nullptr;
+        EXPECT_EQ(g_mgr.DeleteKvStore(STORE_ID), OK);
+    }
+    for (auto &device : g_devices) {
+        delete device;
+        device = nullptr;
+    }
+    g_devices.clear();
+    PermissionCheckCallbackV2 nullCallback;
+    EXPECT_EQ(g_mgr.SetPermissionCheckCallback(nullCallback), OK);
+}
+
+/**
+ * @tc.name: PushSyncBenchmark001
+ * @tc.desc: Measure the push sync from the local store to all the virtual devices.
+ * @tc.type: FUNC
+ * @tc.require: AR000CQS3S
+ * @tc.author: xushaohua
+ */
+HWTEST_F(DistributedDBSyncBenchmarkTest, PushSyncBenchmark001, TestSize.Level4)
+{
+    /**
+     * @tc.steps: step1. put the entries of each round and push them to all the devices
+     * @tc.expected: step1. all the syncs succeed if no message is lost.
+     */
+    vector<string> devices = GetDeviceIds();
+    BenchmarkResult result = RunBenchmark([](uint32_t round) { PutLocalEntries("P", round); },
+        [&devices](map<string, DBStatus> &statuses) {
+            return g_tool.SyncTest(g_kvDelegatePtr, devices, SYNC_MODE_PUSH_ONLY, statuses, true);
+        });
+    ReportResult("push", result);
+    if (g_benchConfig.link.lossRate > 0) {
+        return; // the syncs fail with the lost messages, only the result is reported.
+    }
+    EXPECT_EQ(result.failedSyncs, 0u);
+    /**
+     * @tc.steps: step2. check the last entry on the devices
+     * @tc.expected: step2. the devices have the entry.
+     */
+    Key key;
+    Value value;
+    GenerateEntry("P", g_benchConfig.rounds - 1, g_benchConfig.entries - 1, key, value);
+    for (const auto &device : g_devices) {
+        VirtualDataItem item;
+        EXPECT_EQ(device->GetData(key, item), E_OK);
+    }
+}
+
+/**
+ * @tc.name: PullSyncBenchmark001
+ * @tc.desc: Measure the pull sync from all the virtual devices to the local store.
+ * @tc.type: FUNC
+ * @tc.require: AR000CQS3S
+ * @tc.author: xushaohua
+ */
+HWTEST_F(DistributedDBSyncBenchmarkTest, PullSyncBenchmark001, TestSize.Level4)
+{
+    /**
+     * @tc.steps: step1. the devices put the entries of each round and the local store pulls them
+     * @tc.expected: step1. all the syncs succeed if no message is lost.
+     */
+    vector<string> devices = GetDeviceIds();
+    BenchmarkResult result = RunBenchmark([](uint32_t round) { PutRemoteEntries(round); },
+        [&devices](map<string, DBStatus> &statuses) {
+            return g_tool.SyncTest(g_kvDelegatePtr, devices, SYNC_MODE_PULL_ONLY, statuses, true);
+        });
+    ReportResult("pull", result);
+    if (g_benchConfig.link.lossRate > 0) {
+        return; // the syncs fail with the lost messages, only the result is reported.
+    }
+    EXPECT_EQ(result.failedSyncs, 0u);
+    /**
+     * @tc.steps: step2. check the last entry of the first device in the local store
+     * @tc.expected: step2. the local store has the entry.
+     */
+    Key key;
+    Value value;
+    GenerateEntry(g_devices[0]->GetDeviceId(), g_benchConfig.rounds - 1, g_benchConfig.entries - 1, key, value);
+    Value localValue;
+    EXPECT_EQ(g_kvDelegatePtr->Get(key, localValue), OK);
+}
+
+/**
+ * @tc.name: QuerySyncBenchmark001
+ * @tc.desc: Measure the query push sync, half of the entries match the query.
+ * @tc.type: FUNC
+ * @tc.require: AR000CQS3S
+ * @tc.author: xushaohua
+ */
+HWTEST_F(DistributedDBSyncBenchmarkTest, QuerySyncBenchmark001, TestSize.Level4)
+{
+    /**
+     * @tc.steps: step1. put the matched and the unmatched entries of each round, push with the prefix query
+     * @tc.expected: step1. all the syncs succeed if no message is lost.
+     */
+    vector<string> devices = GetDeviceIds();
+    Key prefix(QUERY_PREFIX.begin(), QUERY_PREFIX.end());
+    Query query = Query::Select().PrefixKey(prefix);
+    BenchmarkResult result = RunBenchmark([](uint32_t round) {
+            PutLocalEntries(QUERY_PREFIX, round);
+            PutLocalEntries("N", round);
+        },
+        [&devices, &query](map<string, DBStatus> &statuses) {
+            return g_tool.SyncTest(g_kvDelegatePtr, devices, SYNC_MODE_PUSH_ONLY, statuses, query);
+        });
+    ReportResult("query", result);
+    if (g_benchConfig.link.lossRate > 0) {
+        return; // the syncs fail with the lost messages, only the result is reported.
+    }
+    EXPECT_EQ(result.failedSyncs, 0u);
+    /**
+     * @tc.steps: step2. check the last entries on the devices
+     * @tc.expected: step2. the devices have the matched entry only.
+     */
+    Key key;
+    Value value;
+    GenerateEntry(QUERY_PREFIX, g_benchConfig.rounds - 1, g_benchConfig.entries - 1, key, value);
+    Key unmatchedKey;
+    GenerateEntry("N", g_benchConfig.rounds - 1, g_benchConfig.entries - 1, unmatchedKey, value);
+    for (const auto &device : g_devices) {
+        VirtualDataItem item;
+        EXPECT_EQ(device->GetData(key, item), E_OK);
+        EXPECT_NE(device->GetData(unmatchedKey, item), E_OK);
+    }
+}
@@ -13,7 +13,9 @@
  * limitations under the License.
  */
 
+#include <condition_variable>
 #include <gtest/gtest.h>
+#include <mutex>
 
 #include "distributeddb_data_generate_unit_test.h"
 #include "distributeddb_tools_unit_test.h"
@@ -98,6 +100,10 @@ void DistributedDBTimeSyncTest::TearDown(void)
     /**
      * @tc.teardown: delete the ptr for testing
      */
+    // the time offset is shared between the cases, each case simulates a different device
+    std::string userId = g_syncInterfaceA->GetDbProperties().GetStringProp(KvDBProperties::USER_ID, "");
+    SharedTimeSync::GetInstance()->Invalidate(SharedTimeSync::GetDeviceKey(userId, DEVICE_A));
+    SharedTimeSync::GetInstance()->Invalidate(SharedTimeSync::GetDeviceKey(userId, DEVICE_B));
     if (g_syncTaskContext != nullptr) {
         RefObject::DecObjRef(g_syncTaskContext);
         g_syncTaskContext = nullptr;
@@ -481,4 +487,154 @@ HWTEST_F(DistributedDBTimeSyncTest, SyncTimeout001, TestSize.Level2)
     TimeOffset offset;
     errCode = g_timeSyncA->GetTimeOffset(offset, TIME_SYNC_WAIT_TIME);
     EXPECT_TRUE(errCode == -E_TIMEOUT);
-}
\ No newline at end of file
+}
+/**
+ * @tc.name: ShareTimeOffset001
+ * @tc.desc: Verify only one syncer syncs the time with one device, the others wait for and use its result.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author: wumin
+ */
+HWTEST_F(DistributedDBTimeSyncTest, ShareTimeOffset001, TestSize.Level0)
+{
+    SharedTimeSync *sharedTimeSync = SharedTimeSync::GetInstance();
+    const std::string deviceKey = SharedTimeSync::GetDeviceKey("user0", "shared_device");
+    int syncerA = 0;
+    int syncerB = 0;
+    TimeOffset offset = 0;
+    /**
+     * @tc.steps: step1. A acquires the offset first, B acquires it when A is syncing
+     * @tc.expected: step1. A should sync the time, B waits for A
+     */
+    EXPECT_EQ(sharedTimeSync->AcquireTimeOffset(deviceKey, &syncerA, nullptr, offset), -E_NOT_FOUND);
+    int waiterCount = 0;
+    bool isSynced = false;
+    EXPECT_EQ(sharedTimeSync->AcquireTimeOffset(deviceKey, &syncerB, [&waiterCount, &isSynced](bool synced) {
+        waiterCount++;
+        isSynced = synced;
+    }, offset), -E_BUSY);
+    EXPECT_EQ(waiterCount, 0);
+
+    /**
+     * @tc.steps: step2. A aborts the sync
+     * @tc.expected: step2. the waiter of B is called with false, then B becomes the syncer
+     */
+    sharedTimeSync->AbortSync(deviceKey, &syncerA);
+    EXPECT_EQ(waiterCount, 1);
+    EXPECT_FALSE(isSynced);
+    EXPECT_EQ(sharedTimeSync->AcquireTimeOffset(deviceKey, &syncerB, nullptr, offset), -E_NOT_FOUND);
+    EXPECT_EQ(sharedTimeSync->AcquireTimeOffset(deviceKey, &syncerA, [&waiterCount, &isSynced](bool synced) {
+        waiterCount++;
+        isSynced = synced;
+    }, offset), -E_BUSY);
+
+    /**
+     * @tc.steps: step3. B finishes the sync
+     * @tc.expected: step3. the waiter of A is called with true, A gets the offset synced by B
+     */
+    const TimeOffset syncedOffset = 100 * 1000 * 1000; // 100 seconds
+    sharedTimeSync->FinishSync(deviceKey, &syncerB, syncedOffset);
+    EXPECT_EQ(waiterCount, 2);
+    EXPECT_TRUE(isSynced);
+    EXPECT_EQ(sharedTimeSync->AcquireTimeOffset(deviceKey, &syncerA, nullptr, offset), E_OK);
+    EXPECT_EQ(offset, syncedOffset);
+
+    /**
+     * @tc.steps: step4. Invalidate the shared offset
+     * @tc.expected: step4. the next one should sync the time again
+     */
+    sharedTimeSync->Invalidate(deviceKey);
+    EXPECT_EQ(sharedTimeSync->AcquireTimeOffset(deviceKey, &syncerA, nullptr, offset), -E_NOT_FOUND);
+    sharedTimeSync->AbortSync(deviceKey, &syncerA);
+    sharedTimeSync->Invalidate(deviceKey);
+}
+
+/**
+ * @tc.name: ShareTimeOffset002
+ * @tc.desc: Verify the store uses the time offset synced by another store of the same user without time sync.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author: wumin
+ */
+HWTEST_F(DistributedDBTimeSyncTest, ShareTimeOffset002, TestSize.Level0)
+{
+    /**
+     * @tc.steps: step1. Time sync A syncs the time with device B
+     * @tc.expected: step1. sync success
+     */
+    g_metadataA->Initialize(g_syncInterfaceA);
+    EXPECT_EQ(g_timeSyncA->Initialize(g_virtualCommunicator, g_metadataA, g_syncInterfaceA, DEVICE_B), E_OK);
+    g_metadataB->Initialize(g_syncInterfaceB);
+    TimeOffset offsetB = 100 * 1000 * 1000; // 100 seconds
+    g_metadataB->SaveLocalTimeOffset(offsetB);
+    EXPECT_EQ(g_timeSyncB->Initialize(g_virtualCommunicator, g_metadataB, g_syncInterfaceB, DEVICE_A), E_OK);
+    g_syncTaskContext->Initialize(DEVICE_B, g_syncInterfaceA, g_metadataA, g_virtualCommunicator);
+    g_virtualCommunicator->SetTimeSync(g_timeSyncA, g_timeSyncB, DEVICE_A, g_syncTaskContext);
+    TimeOffset timeOffsetA = 0;
+    EXPECT_EQ(g_timeSyncA->GetTimeOffset(timeOffsetA, TIME_SYNC_WAIT_TIME), E_OK);
+
+    /**
+     * @tc.steps: step2. Another store C with a different local time offset gets the time offset of device B
+     *  when the communicator is disabled
+     * @tc.expected: step2. C gets the offset without time sync, adjusted by its local time offset
+     */
+    g_virtualCommunicator->Disable();
+    auto syncInterfaceC = std::make_unique<VirtualSingleVerSyncDBInterface>();
+    auto metadataC = std::make_shared<Metadata>();
+    metadataC->Initialize(syncInterfaceC.get());
+    TimeOffset offsetC = 50 * 1000 * 1000; // 50 seconds
+    metadataC->SaveLocalTimeOffset(offsetC);
+    auto timeSyncC = std::make_unique<TimeSync>();
+    EXPECT_EQ(timeSyncC->Initialize(g_virtualCommunicator, metadataC, syncInterfaceC.get(), DEVICE_B), E_OK);
+    EXPECT_TRUE(timeSyncC->IsNeedSync());
+    TimeOffset timeOffsetC = 0;
+    EXPECT_EQ(timeSyncC->GetTimeOffset(timeOffsetC, TIME_SYNC_WAIT_TIME), E_OK);
+    EXPECT_FALSE(timeSyncC->IsNeedSync());
+    EXPECT_EQ(timeOffsetC, timeOffsetA + g_metadataA->GetLocalTimeOffset() - offsetC);
+    timeSyncC = nullptr;
+}
+
+/**
+ * @tc.name: ShareTimeOffset003
+ * @tc.desc: Verify the syncer acquired the time sync but never sent the request is released after the timeout.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author: wumin
+ */
+HWTEST_F(DistributedDBTimeSyncTest, ShareTimeOffset003, TestSize.Level1)
+{
+    SharedTimeSync *sharedTimeSync = SharedTimeSync::GetInstance();
+    const std::string deviceKey = SharedTimeSync::GetDeviceKey("user0", "timeout_device");
+    int syncerA = 0;
+    int syncerB = 0;
+    TimeOffset offset = 0;
+    /**
+     * @tc.steps: step1. A acquires the offset and never sends the request, B waits for A
+     * @tc.expected: step1. A should sync the time, B is busy
+     */
+    EXPECT_EQ(sharedTimeSync->AcquireTimeOffset(deviceKey, &syncerA, nullptr, offset), -E_NOT_FOUND);
+    std::mutex waiterLock;
+    std::condition_variable waiterCv;
+    bool isCalled = false;
+    bool isSynced = true;
+    EXPECT_EQ(sharedTimeSync->AcquireTimeOffset(deviceKey, &syncerB, [&](bool synced) {
+        std::lock_guard<std::mutex> lock(waiterLock);
+        isCalled = true;
+        isSynced = synced;
+        waiterCv.notify_all();
+    }, offset), -E_BUSY);
+
+    /**
+     * @tc.steps: step2. wait for the sync timeout
+     * @tc.expected: step2. the waiter of B is called with false, then B becomes the syncer
+     */
+    {
+        std::unique_lock<std::mutex> lock(waiterLock);
+        EXPECT_TRUE(waiterCv.wait_for(lock, std::chrono::milliseconds(TIME_SYNC_WAIT_TIME * 2), // 2 times of timeout
+            [&isCalled]() { return isCalled; }));
+        EXPECT_FALSE(isSynced);
+    }
+    EXPECT_EQ(sharedTimeSync->AcquireTimeOffset(deviceKey, &syncerB, nullptr, offset), -E_NOT_FOUND);
+    sharedTimeSync->AbortSync(deviceKey, &syncerB);
+    sharedTimeSync->Invalidate(deviceKey);
+}
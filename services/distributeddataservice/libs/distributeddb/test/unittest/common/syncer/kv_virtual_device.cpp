@@ -76,6 +76,12 @@ void KvVirtualDevice::SetSaveDataDelayTime(uint64_t milliDelayTime)
     syncInterface->SetSaveDataDelayTime(milliDelayTime);
 }
 
+void KvVirtualDevice::SetDigestEnable(bool isEnable)
+{
+    VirtualSingleVerSyncDBInterface *syncInterface = static_cast<VirtualSingleVerSyncDBInterface *>(storage_);
+    syncInterface->SetDigestEnable(isEnable);
+}
+
 int KvVirtualDevice::Subscribe(QuerySyncObject query, bool wait, int id)
 {
     auto operation = new (std::nothrow) SyncOperation(id, {remoteDeviceId_}, SUBSCRIBE_QUERY, nullptr, wait);
@@ -33,6 +33,7 @@ public:
     int StartTransaction();
     int Commit();
     void SetSaveDataDelayTime(uint64_t milliDelayTime);
+    void SetDigestEnable(bool isEnable);
 
     int Subscribe(QuerySyncObject query, bool wait, int id);
     int UnSubscribe(QuerySyncObject query, bool wait, int id);
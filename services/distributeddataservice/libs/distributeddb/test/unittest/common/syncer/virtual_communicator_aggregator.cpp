@@ -14,12 +14,14 @@
  */
 #include "virtual_communicator_aggregator.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <thread>
 #include <utility>
 
 #include "db_errno.h"
 #include "log_print.h"
+#include "protocol_proto.h"
 #include "runtime_context.h"
 
 namespace DistributedDB {
@@ -166,6 +168,20 @@ void VirtualCommunicatorAggregator::DispatchMessage(const std::string &srcTarget
         inMsg = nullptr;
         return CallSendEnd(-E_PERIPHERAL_INTERFACE_FAIL, onEnd);
     }
+    if (IsNeedDropMessage(srcTarget, inMsg)) {
+        LOGD("[VirtualCommunicatorAggregator] DispatchMessage, drop message %u of %s", inMsg->GetMessageId(),
+            srcTarget.c_str());
+        delete inMsg;
+        inMsg = nullptr;
+        return CallSendEnd(E_OK, onEnd);
+    }
+    auto deliverTime = std::chrono::steady_clock::now();
+    if (!ApplyLinkModel(srcTarget, inMsg, deliverTime)) {
+        LOGD("[VirtualCommunicatorAggregator] DispatchMessage, message lost on the link to %s", dstTarget.c_str());
+        delete inMsg;
+        inMsg = nullptr;
+        return CallSendEnd(E_OK, onEnd);
+    }
     std::lock_guard<std::mutex> lock(communicatorsLock_);
     auto iter = communicators_.find(dstTarget);
     if (iter != communicators_.end()) {
@@ -181,7 +197,8 @@ void VirtualCommunicatorAggregator::DispatchMessage(const std::string &srcTarget
         msg->SetTarget(srcTarget);
         RefObject::IncObjRef(communicator);
         auto onDispatch = onDispatch_;
-        std::thread thread([communicator, srcTarget, dstTarget, msg, onDispatch]() {
+        std::thread thread([communicator, srcTarget, dstTarget, msg, onDispatch, deliverTime]() {
+            std::this_thread::sleep_until(deliverTime);
             if (onDispatch) {
                 onDispatch(dstTarget, msg);
             }
@@ -242,5 +259,97 @@ void VirtualCommunicatorAggregator::SetCurrentUserId(const std::string &userId)
 {
     userId_ = userId;
 }
+
+void VirtualCommunicatorAggregator::SetLinkConfig(const VirtualLinkConfig &config)
+{
+    std::lock_guard<std::mutex> lock(linkLock_);
+    isLinkModeled_ = true;
+    linkConfig_ = config;
+    linkIdleTime_.clear();
+}
+
+std::map<std::string, VirtualTrafficStatistic> VirtualCommunicatorAggregator::GetTrafficStatistics() const
+{
+    std::lock_guard<std::mutex> lock(linkLock_);
+    return trafficStatistics_;
+}
+
+void VirtualCommunicatorAggregator::ResetTrafficStatistics()
+{
+    std::lock_guard<std::mutex> lock(linkLock_);
+    trafficStatistics_.clear();
+}
+
+void VirtualCommunicatorAggregator::SetDropMessageTypeByDevice(const std::string &deviceId, uint32_t msgId,
+    uint32_t dropTimes)
+{
+    std::lock_guard<std::mutex> lock(dropLock_);
+    if (dropTimes == 0) {
+        dropMessageTimes_[deviceId].erase(msgId);
+        return;
+    }
+    dropMessageTimes_[deviceId][msgId] = dropTimes;
+}
+
+bool VirtualCommunicatorAggregator::IsNeedDropMessage(const std::string &srcTarget, const Message *inMsg)
+{
+    std::lock_guard<std::mutex> lock(dropLock_);
+    auto deviceIter = dropMessageTimes_.find(srcTarget);
+    if (deviceIter == dropMessageTimes_.end()) {
+        return false;
+    }
+    auto iter = deviceIter->second.find(inMsg->GetMessageId());
+    if (iter == deviceIter->second.end()) {
+        return false;
+    }
+    if (--iter->second == 0) {
+        deviceIter->second.erase(iter);
+    }
+    return true;
+}
+
+bool VirtualCommunicatorAggregator::ApplyLinkModel(const std::string &srcTarget, const Message *inMsg,
+    std::chrono::steady_clock::time_point &deliverTime)
+{
+    std::unique_lock<std::mutex> lock(linkLock_);
+    if (!isLinkModeled_) {
+        return true;
+    }
+    VirtualLinkConfig config = linkConfig_;
+    lock.unlock();
+
+    // count the bytes as the real communicator sends, the frame header included.
+    uint64_t length = 0;
+    int errCode = E_OK;
+    std::shared_ptr<ExtendHeaderHandle> extendHandle = nullptr;
+    SerialBuffer *buffer = ProtocolProto::ToSerialBuffer(inMsg, errCode, extendHandle);
+    if (buffer != nullptr) {
+        length = buffer->GetSize();
+        delete buffer;
+        buffer = nullptr;
+    } else {
+        LOGW("[VirtualCommunicatorAggregator] Serialize message %u failed, errCode=%d", inMsg->GetMessageId(), errCode);
+    }
+
+    constexpr uint32_t lossRateBase = 10000;
+    constexpr uint64_t microsecondsPerSecond = 1000000;
+    lock.lock();
+    VirtualTrafficStatistic &statistic = trafficStatistics_[srcTarget];
+    if (config.lossRate > 0 && lossRandom_() % lossRateBase < config.lossRate) {
+        statistic.lostMessages++;
+        return false;
+    }
+    statistic.sendMessages++;
+    statistic.sendBytes += length;
+    if (config.bandwidth > 0) {
+        // the messages of one device queue on its link, each takes the time of its bytes.
+        auto &idleTime = linkIdleTime_[srcTarget];
+        idleTime = std::max(idleTime, deliverTime) +
+            std::chrono::microseconds(length * microsecondsPerSecond / config.bandwidth);
+        deliverTime = idleTime;
+    }
+    deliverTime += std::chrono::milliseconds(config.latency);
+    return true;
+}
 } // namespace DistributedDB
 
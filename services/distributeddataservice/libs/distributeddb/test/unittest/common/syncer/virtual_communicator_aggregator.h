@@ -16,7 +16,9 @@
 #ifndef VIRTUAL_ICOMMUNICATORAGGREGATOR_H
 #define VIRTUAL_ICOMMUNICATORAGGREGATOR_H
 
+#include <chrono>
 #include <cstdint>
+#include <random>
 
 #include "icommunicator_aggregator.h"
 #include "virtual_communicator.h"
@@ -24,6 +26,19 @@
 namespace DistributedDB {
 class ICommunicator;  // Forward Declaration
 
+// The model of the link between the virtual devices, all zero means the messages are dispatched at once.
+struct VirtualLinkConfig {
+    uint32_t latency = 0; // ms, the one way delay of each message
+    uint64_t bandwidth = 0; // bytes per second of the sending side of each device, 0 means unlimited
+    uint32_t lossRate = 0; // the lost messages per ten thousand
+};
+
+struct VirtualTrafficStatistic {
+    uint64_t sendMessages = 0;
+    uint64_t sendBytes = 0;
+    uint64_t lostMessages = 0;
+};
+
 class VirtualCommunicatorAggregator : public ICommunicatorAggregator {
 public:
     // Return 0 as success. Return negative as error
@@ -70,12 +85,29 @@ public:
 
     void SetCurrentUserId(const std::string &userId);
 
+    // The messages are serialized to count the bytes and apply the bandwidth once the link config is set.
+    void SetLinkConfig(const VirtualLinkConfig &config);
+
+    // The statistic of the messages sent by each device since the link config is set.
+    std::map<std::string, VirtualTrafficStatistic> GetTrafficStatistics() const;
+
+    void ResetTrafficStatistics();
+
+    // Drop the next dropTimes messages of the msgId sent by the device.
+    void SetDropMessageTypeByDevice(const std::string &deviceId, uint32_t msgId, uint32_t dropTimes = 1);
+
     ~VirtualCommunicatorAggregator() {};
     VirtualCommunicatorAggregator() {};
 
 private:
     void CallSendEnd(int errCode, const OnSendEnd &onEnd);
 
+    // Return false if the message is lost, else the time to deliver the message.
+    bool IsNeedDropMessage(const std::string &srcTarget, const Message *inMsg);
+
+    bool ApplyLinkModel(const std::string &srcTarget, const Message *inMsg,
+        std::chrono::steady_clock::time_point &deliverTime);
+
     mutable std::mutex communicatorsLock_;
     std::map<std::string, ICommunicator *> communicators_;
     std::string remoteDeviceId_ = "real_device";
@@ -87,6 +119,16 @@ private:
     OnConnectCallback onConnect_;
     std::function<void(const std::string &target, Message *inMsg)> onDispatch_;
     std::string userId_;
+
+    std::mutex dropLock_;
+    std::map<std::string, std::map<uint32_t, uint32_t>> dropMessageTimes_;
+
+    mutable std::mutex linkLock_;
+    bool isLinkModeled_ = false;
+    VirtualLinkConfig linkConfig_;
+    std::map<std::string, std::chrono::steady_clock::time_point> linkIdleTime_;
+    std::map<std::string, VirtualTrafficStatistic> trafficStatistics_;
+    std::mt19937 lossRandom_ { std::random_device()() };
 };
 } // namespace DistributedDB
 
@@ -291,6 +291,35 @@ int VirtualSingleVerSyncDBInterface::GetSecurityOption(SecurityOption &option) c
     return E_OK;
 }
 
+void VirtualSingleVerSyncDBInterface::SetDigestEnable(bool isEnable)
+{
+    isDigestEnable_ = isEnable;
+}
+
+int VirtualSingleVerSyncDBInterface::GetSyncDigest(SyncDigest &digest) const
+{
+    if (!isDigestEnable_) {
+        return -E_NOT_SUPPORT;
+    }
+    Timestamp maxTimestamp = 0;
+    for (const auto &data : dbData_) {
+        // the key of the deleted data is its hash key
+        Key hashKey = data.key;
+        if ((data.flag & VirtualDataItem::DELETE_FLAG) == 0) {
+            int errCode = DBCommon::CalcValueHash(data.key, hashKey);
+            if (errCode != E_OK) {
+                return errCode;
+            }
+        }
+        digest.AddRecord(SyncDigest::GetBucket(hashKey.data(), hashKey.size()),
+            SyncDigest::CalcRecordDigest(hashKey.data(), hashKey.size(), data.value.data(), data.value.size(),
+            data.flag));
+        maxTimestamp = std::max(maxTimestamp, data.timestamp);
+    }
+    digest.SetTimestamp(maxTimestamp);
+    return E_OK;
+}
+
 bool VirtualSingleVerSyncDBInterface::IsReadable() const
 {
     return true;
@@ -95,6 +95,10 @@ public:
 
     void SetSaveDataDelayTime(uint64_t milliDelayTime);
 
+    void SetDigestEnable(bool isEnable);
+
+    int GetSyncDigest(SyncDigest &digest) const override;
+
     int GetSecurityOption(SecurityOption &option) const override;
 
     bool IsReadable() const override;
@@ -140,6 +144,7 @@ private:
     SchemaObject schemaObj_;
     KvDBProperties properties_;
     uint64_t saveDataDelayTime_ = 0;
+    bool isDigestEnable_ = false;
     SecurityOption secOption_;
     bool busy_ = false;
 
@@ -0,0 +1,48 @@
+/*
+* Copyright (c) 2022 Huawei Device Co., Ltd.
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef OHOS_DISTRIBUTED_DATA_SERVICES_CONFIG_MODEL_FLOW_CONTROL_CONFIG_H
+#define OHOS_DISTRIBUTED_DATA_SERVICES_CONFIG_MODEL_FLOW_CONTROL_CONFIG_H
+#include "serializable/serializable.h"
+namespace OHOS {
+namespace DistributedData {
+class FlowControlConfig final : public Serializable {
+public:
+    // the empty bundleName or storeId matches all.
+    struct Policy final : public Serializable {
+        std::string bundleName;
+        std::string storeId;
+        int32_t burstCapacity = 0;
+        int32_t sustainedCapacity = 0;
+        bool sharedByUid = false;
+        bool Marshal(json &node) const override;
+        bool Unmarshal(const json &node) override;
+    };
+    // the capacities of the bucket shared by all stores of one calling uid.
+    int32_t uidBurstCapacity = 0;
+    int32_t uidSustainedCapacity = 0;
+    std::vector<Policy> policies;
+    bool Marshal(json &node) const override;
+    bool Unmarshal(const json &node) override;
+    // the most specific policy is preferred: bundle+store, store, bundle, then the default; nullptr means none.
+    API_EXPORT const Policy *GetPolicy(const std::string &bundleName, const std::string &storeId) const;
+
+private:
+    static constexpr int32_t STORE_SCORE = 2;
+    static constexpr int32_t BUNDLE_SCORE = 1;
+};
+} // namespace DistributedData
+} // namespace OHOS
+#endif // OHOS_DISTRIBUTED_DATA_SERVICES_CONFIG_MODEL_FLOW_CONTROL_CONFIG_H
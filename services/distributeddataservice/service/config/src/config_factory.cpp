@@ -67,5 +67,10 @@ GlobalConfig *ConfigFactory::GetGlobalConfig()
 {
     return &config_;
 }
+
+FlowControlConfig *ConfigFactory::GetFlowControlConfig()
+{
+    return config_.flowControl;
+}
 } // namespace DistributedData
 } // namespace OHOS
@@ -0,0 +1,77 @@
+/*
+* Copyright (c) 2022 Huawei Device Co., Ltd.
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "model/flow_control_config.h"
+namespace OHOS {
+namespace DistributedData {
+bool FlowControlConfig::Policy::Marshal(json &node) const
+{
+    SetValue(node[GET_NAME(bundleName)], bundleName);
+    SetValue(node[GET_NAME(storeId)], storeId);
+    SetValue(node[GET_NAME(burstCapacity)], burstCapacity);
+    SetValue(node[GET_NAME(sustainedCapacity)], sustainedCapacity);
+    SetValue(node[GET_NAME(sharedByUid)], sharedByUid);
+    return true;
+}
+
+bool FlowControlConfig::Policy::Unmarshal(const json &node)
+{
+    GetValue(node, GET_NAME(bundleName), bundleName);
+    GetValue(node, GET_NAME(storeId), storeId);
+    GetValue(node, GET_NAME(burstCapacity), burstCapacity);
+    GetValue(node, GET_NAME(sustainedCapacity), sustainedCapacity);
+    GetValue(node, GET_NAME(sharedByUid), sharedByUid);
+    return true;
+}
+
+bool FlowControlConfig::Marshal(json &node) const
+{
+    SetValue(node[GET_NAME(uidBurstCapacity)], uidBurstCapacity);
+    SetValue(node[GET_NAME(uidSustainedCapacity)], uidSustainedCapacity);
+    SetValue(node[GET_NAME(policies)], policies);
+    return true;
+}
+
+bool FlowControlConfig::Unmarshal(const json &node)
+{
+    GetValue(node, GET_NAME(uidBurstCapacity), uidBurstCapacity);
+    GetValue(node, GET_NAME(uidSustainedCapacity), uidSustainedCapacity);
+    GetValue(node, GET_NAME(policies), policies);
+    return true;
+}
+
+const FlowControlConfig::Policy *FlowControlConfig::GetPolicy(const std::string &bundleName,
+    const std::string &storeId) const
+{
+    // the storeId is more specific than the bundleName, the earlier one wins among the same specificity.
+    const Policy *matched = nullptr;
+    int32_t matchedScore = -1;
+    for (const auto &policy : policies) {
+        if (!policy.bundleName.empty() && policy.bundleName != bundleName) {
+            continue;
+        }
+        if (!policy.storeId.empty() && policy.storeId != storeId) {
+            continue;
+        }
+        int32_t score = (policy.storeId.empty() ? 0 : STORE_SCORE) + (policy.bundleName.empty() ? 0 : BUNDLE_SCORE);
+        if (score > matchedScore) {
+            matched = &policy;
+            matchedScore = score;
+        }
+    }
+    return matched;
+}
+} // namespace DistributedData
+} // namespace OHOS
@@ -68,34 +68,82 @@ bool RdbServiceImpl::ResolveAutoLaunch(const std::string &identifier, Distribute
 {
     std::string identifierHex = TransferStringToHex(identifier);
     ZLOGI("%{public}.6s", identifierHex.c_str());
+    if (!InitAutoLaunchIndex()) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(autoLaunchMutex_);
+    auto it = autoLaunchMetas_.find(identifier);
+    if (it == autoLaunchMetas_.end()) {
+        ZLOGE("not find identifier");
+        return false;
+    }
+    const auto &entry = it->second;
+    ZLOGI("find identifier %{public}s", entry.storeId.c_str());
+    param.userId = entry.user;
+    param.appId = entry.appId;
+    param.storeId = entry.storeId;
+    param.path = entry.dataDir;
+    param.option.storeObserver = &autoLaunchObserver_;
+    return true;
+}
+
+bool RdbServiceImpl::InitAutoLaunchIndex()
+{
+    std::lock_guard<std::mutex> lock(autoLaunchMutex_);
+    if (autoLaunchIndexed_) {
+        return true;
+    }
+    // subscribe before loading, the change during loading waits for the lock and is applied after the loaded one
+    auto prefix = StoreMetaData::GetPrefix({});
+    bool isSubscribed = MetaDataManager::GetInstance().Subscribe(prefix,
+        [this](const std::string &key, const std::string &value, int32_t flag) {
+            return OnStoreMetaChanged(key, value, flag);
+        });
+    if (!isSubscribed) {
+        ZLOGE("subscribe meta failed");
+        return false;
+    }
     std::vector<StoreMetaData> entries;
-    if (!MetaDataManager::GetInstance().LoadMeta(StoreMetaData::GetPrefix({}), entries)) {
+    if (!MetaDataManager::GetInstance().LoadMeta(prefix, entries)) {
         ZLOGE("get meta failed");
+        MetaDataManager::GetInstance().Unsubscribe(prefix);
         return false;
     }
-    ZLOGI("size=%{public}d", static_cast<int32_t>(entries.size()));
-    for (const auto& entry : entries) {
+    for (const auto &entry : entries) {
         if (entry.storeType != RDB_DEVICE_COLLABORATION) {
             continue;
         }
+        IndexStoreMeta(StoreMetaData::GetKey({ entry.user, "default", entry.bundleName, entry.storeId }), entry);
+    }
+    ZLOGI("size=%{public}d, indexed=%{public}d", static_cast<int32_t>(entries.size()),
+        static_cast<int32_t>(autoLaunchMetas_.size()));
+    autoLaunchIndexed_ = true;
+    return true;
+}
 
-        auto aIdentifier = DistributedDB::RelationalStoreManager::GetRelationalStoreIdentifier(
-            entry.user, entry.appId, entry.storeId);
-        ZLOGI("%{public}s %{public}s %{public}s", entry.user.c_str(), entry.appId.c_str(), entry.storeId.c_str());
-        if (aIdentifier != identifier) {
-            continue;
-        }
-        ZLOGI("find identifier %{public}s", entry.storeId.c_str());
-        param.userId = entry.user;
-        param.appId = entry.appId;
-        param.storeId = entry.storeId;
-        param.path = entry.dataDir;
-        param.option.storeObserver = &autoLaunchObserver_;
-        return true;
+bool RdbServiceImpl::OnStoreMetaChanged(const std::string &key, const std::string &value, int32_t flag)
+{
+    StoreMetaData meta;
+    if (flag != MetaDataManager::DELETE) {
+        StoreMetaData::Unmarshall(value, meta);
+    }
+    std::lock_guard<std::mutex> lock(autoLaunchMutex_);
+    auto it = autoLaunchKeys_.find(key);
+    if (it != autoLaunchKeys_.end()) {
+        autoLaunchMetas_.erase(it->second);
+        autoLaunchKeys_.erase(it);
+    }
+    if (flag != MetaDataManager::DELETE && meta.storeType == RDB_DEVICE_COLLABORATION) {
+        IndexStoreMeta(key, meta);
     }
+    return true;
+}
 
-    ZLOGE("not find identifier");
-    return false;
+void RdbServiceImpl::IndexStoreMeta(const std::string &key, const StoreMetaData &meta)
+{
+    auto identifier = RelationalStoreManager::GetRelationalStoreIdentifier(meta.user, meta.appId, meta.storeId);
+    autoLaunchMetas_[identifier] = meta;
+    autoLaunchKeys_[key] = identifier;
 }
 
 void RdbServiceImpl::OnClientDied(pid_t pid)
@@ -23,6 +23,7 @@
 #include <string>
 #include "rdb_syncer.h"
 #include "concurrent_map.h"
+#include "metadata/store_meta_data.h"
 #include "store_observer.h"
 #include "timer.h"
 #include "visibility.h"
@@ -63,6 +64,12 @@ private:
 
     bool ResolveAutoLaunch(const std::string &identifier, DistributedDB::AutoLaunchParam &param);
 
+    bool InitAutoLaunchIndex();
+
+    bool OnStoreMetaChanged(const std::string &key, const std::string &value, int32_t flag);
+
+    void IndexStoreMeta(const std::string &key, const DistributedData::StoreMetaData &meta);
+
     void SyncerTimeout(std::shared_ptr<RdbSyncer> syncer);
 
     std::shared_ptr<RdbSyncer> GetRdbSyncer(const RdbSyncerParam& param);
@@ -86,6 +93,11 @@ private:
     ConcurrentMap<std::string, pid_t> identifiers_;
     Utils::Timer timer_;
     RdbStoreObserverImpl autoLaunchObserver_;
+    // the auto launch identifier of the store meta, built at the first resolve and kept by the meta change
+    std::mutex autoLaunchMutex_;
+    bool autoLaunchIndexed_ = false;
+    std::map<std::string, DistributedData::StoreMetaData> autoLaunchMetas_;
+    std::map<std::string, std::string> autoLaunchKeys_;
 
     static std::string TransferStringToHex(const std::string& origStr);
 
@@ -117,3 +117,56 @@ HWTEST_F(ConfigFactoryTest, NetworkConfig, TestSize.Level0)
     ASSERT_EQ(networks->protocols[0].address, "ohos.distributeddata");
     ASSERT_EQ(networks->protocols[0].transport, "softbus");
 }
+
+/**
+* @tc.name: FlowControlConfig
+* @tc.desc: load the config.json flow control info.
+* @tc.type: FUNC
+* @tc.require:
+* @tc.author: Sven Wang
+*/
+HWTEST_F(ConfigFactoryTest, FlowControlConfig, TestSize.Level0)
+{
+    auto *flowControl = ConfigFactory::GetInstance().GetFlowControlConfig();
+    ASSERT_NE(flowControl, nullptr);
+    ASSERT_EQ(flowControl->uidBurstCapacity, 2000);
+    ASSERT_EQ(flowControl->uidSustainedCapacity, 20000);
+    auto *policy = flowControl->GetPolicy("com.example.app", "store");
+    ASSERT_NE(policy, nullptr);
+    ASSERT_EQ(policy->burstCapacity, 1000);
+    ASSERT_EQ(policy->sustainedCapacity, 10000);
+    ASSERT_FALSE(policy->sharedByUid);
+}
+
+/**
+* @tc.name: FlowControlPolicySpecificity
+* @tc.desc: the most specific flow control policy is matched, regardless of the listed order.
+* @tc.type: FUNC
+* @tc.require:
+* @tc.author: Sven Wang
+*/
+HWTEST_F(ConfigFactoryTest, FlowControlPolicySpecificity, TestSize.Level0)
+{
+    FlowControlConfig flowControl;
+    flowControl.policies.resize(4);
+    flowControl.policies[0].burstCapacity = 1;
+    flowControl.policies[1].bundleName = "com.example.app";
+    flowControl.policies[1].burstCapacity = 2;
+    flowControl.policies[2].storeId = "store";
+    flowControl.policies[2].burstCapacity = 3;
+    flowControl.policies[3].bundleName = "com.example.app";
+    flowControl.policies[3].storeId = "store";
+    flowControl.policies[3].burstCapacity = 4;
+    auto *policy = flowControl.GetPolicy("com.example.app", "store");
+    ASSERT_NE(policy, nullptr);
+    ASSERT_EQ(policy->burstCapacity, 4);
+    policy = flowControl.GetPolicy("com.other.app", "store");
+    ASSERT_NE(policy, nullptr);
+    ASSERT_EQ(policy->burstCapacity, 3);
+    policy = flowControl.GetPolicy("com.example.app", "other");
+    ASSERT_NE(policy, nullptr);
+    ASSERT_EQ(policy->burstCapacity, 2);
+    policy = flowControl.GetPolicy("com.other.app", "other");
+    ASSERT_NE(policy, nullptr);
+    ASSERT_EQ(policy->burstCapacity, 1);
+}